@@ -0,0 +1,4522 @@
+/**
+ * @file BaseConverter.c
+ * @author Itai Tagar <itagar>
+ * @version 1.2
+ * @date 09 Aug 2016
+ *
+ * @brief A library that convert a given number from one base representation to another.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A library that convert a given number from one base representation to another.
+ * Numbers which fit in 64 bits are converted within a single limb, a digit at a time, and their
+ * digits are written straight to their place in the buffer of the caller.
+ * Longer numbers are stored as arrays of 64 bits limbs, and are converted by splitting them by
+ * powers of the base, which takes O(n^1.58 log(n)) time rather than O(n^2). The largest
+ * products are computed by number theoretic transforms, and the parts of a long number are
+ * converted by the pool of threads of the Arena.
+ * A number may also be given, or parsed, as its 64 bits limbs, so a caller which stores numbers
+ * in binary converts them in one direction only.
+ * All the memory of a conversion comes from its Arena, which keeps the released blocks in free
+ * lists of power of 2 sizes rather than returning them to the heap.
+ * A Cache is a hash table of open addressing within buckets of 16 entries, whose fingerprints
+ * share a single cache line, and whose entries are replaced by the CLOCK policy. An entry is
+ * guarded by a sequence lock, so its readers neither lock nor write it.
+ */
+
+
+/*----=  Includes  =-----*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#include "BaseConverter.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+/**
+ * @def VECTOR_DIGITS
+ * @brief A Flag which states that the SSE2 and AVX2 digit functions are compiled in.
+ */
+#define VECTOR_DIGITS
+
+#ifdef __SSE2__
+/**
+ * @def HAS_SSE2 1
+ * @brief A Macro that states whether the CPU supports SSE2, which every x86-64 CPU does, so it
+ *        is checked at run time only by a 32 bits build which does not assume it.
+ */
+#define HAS_SSE2 1
+#else
+#define HAS_SSE2 __builtin_cpu_supports("sse2")
+#endif
+#endif
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def VALID_STATE 0
+ * @brief A Flag for valid state during the program run.
+ */
+#define VALID_STATE 0
+
+/**
+ * @def INVALID_STATE 1
+ * @brief A Flag for invalid state during the program run.
+ */
+#define INVALID_STATE 1
+
+/**
+ * @def STANDARD_BASE 10
+ * @brief A Macro that sets the standard base which we usually use.
+ */
+#define STANDARD_BASE 10
+
+/**
+ * @def INVALID_DIGIT 0xFF
+ * @brief A Macro that sets the value of a character which is not a digit in any base.
+ */
+#define INVALID_DIGIT 0xFF
+
+/**
+ * @def TRUE 1
+ * @brief A Flag for true statement.
+ */
+#define TRUE 1
+
+/**
+ * @def FALSE 0
+ * @brief A Flag for false statement.
+ */
+#define FALSE 0
+
+/**
+ * @def MAX_RESULT_SIZE 64
+ * @brief A Macro that sets the maximum number of digits for the result number after conversion
+ *        within a single limb, which is the number of binary digits of the largest limb.
+ */
+#define MAX_RESULT_SIZE 64
+
+/**
+ * @def ARENA_MIN_CLASS 6
+ * @brief A Macro that sets the size class of the smallest block of an Arena, of 2^6 bytes.
+ */
+#define ARENA_MIN_CLASS 6
+
+/**
+ * @def ARENA_CLASSES 64
+ * @brief A Macro that sets the number of size classes of the blocks of an Arena.
+ */
+#define ARENA_CLASSES 64
+
+/**
+ * @def CACHE_WAYS 16
+ * @brief A Macro that sets the number of entries of a bucket of a Cache, whose fingerprints fill
+ *        a single cache line.
+ */
+#define CACHE_WAYS 16
+
+/**
+ * @def CACHE_ENTRY_WORDS 14
+ * @brief A Macro that sets the number of words holding the characters of an entry of a Cache,
+ *        which are CONVERTER_CACHE_ENTRY_SIZE characters.
+ */
+#define CACHE_ENTRY_WORDS 14
+
+/**
+ * @def CACHE_COUNTER_SHARDS 16
+ * @brief A Macro that sets the number of copies of the counters of a Cache, so the threads
+ *        counting in different buckets count in different cache lines.
+ */
+#define CACHE_COUNTER_SHARDS 16
+
+/**
+ * @def CACHE_KEY_MASK 0xFFFFFF
+ * @brief A Macro that sets the bits of the shape of an entry which belong to its key: the two
+ *        bases and the length of the number, a byte each.
+ */
+#define CACHE_KEY_MASK 0xFFFFFF
+
+/**
+ * @def CACHE_HASH_MULTIPLIER 0x9E3779B97F4A7C15
+ * @brief A Macro that sets the odd multiplier mixing the words of a key, 2^64 over the golden
+ *        ratio.
+ */
+#define CACHE_HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+/**
+ * @def CACHE_LINE_SIZE 64
+ * @brief A Macro that sets the number of bytes of a cache line.
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @def NEGATIVE_SIGN '-'
+ * @brief A Macro that sets the character which starts a negative number.
+ */
+#define NEGATIVE_SIGN '-'
+
+/**
+ * @def POSITIVE_SIGN '+'
+ * @brief A Macro that sets the character which may start a positive number.
+ */
+#define POSITIVE_SIGN '+'
+
+/**
+ * @def LIMB_BITS 64
+ * @brief A Macro that sets the number of bits in a single limb of a big number.
+ */
+#define LIMB_BITS 64
+
+/**
+ * @def KARATSUBA_THRESHOLD 32
+ * @brief A Macro that sets the number of limbs from which numbers are multiplied by Karatsuba's
+ *        method rather than digit by digit.
+ */
+#define KARATSUBA_THRESHOLD 32
+
+/**
+ * @def MULTIPLY_SCRATCH_FACTOR 6
+ * @brief A Macro that sets the number of scratch limbs a multiplication needs per limb of its
+ *        operands.
+ */
+#define MULTIPLY_SCRATCH_FACTOR 6
+
+/**
+ * @def HORNER_THRESHOLD 32
+ * @brief A Macro that sets the number of limbs up to which digits are accumulated one chunk
+ *        at a time rather than split by a power of the base.
+ */
+#define HORNER_THRESHOLD 32
+
+/**
+ * @def DIVISION_THRESHOLD 32
+ * @brief A Macro that sets the number of limbs up to which a number is divided by a single limb
+ *        to emit its digits rather than split by a power of the base.
+ */
+#define DIVISION_THRESHOLD 32
+
+/**
+ * @def RECIPROCAL_THRESHOLD 8
+ * @brief A Macro that sets the number of limbs up to which a reciprocal is computed bit by bit
+ *        rather than by Newton's method.
+ */
+#define RECIPROCAL_THRESHOLD 8
+
+/**
+ * @def MAX_POWER_LEVELS 64
+ * @brief A Macro that sets the maximal number of powers of a base kept in its table, the powers
+ *        are squared from level to level so no number needs more.
+ */
+#define MAX_POWER_LEVELS 64
+
+/**
+ * @def TRANSFORM_THRESHOLD 2048
+ * @brief A Macro that sets the number of limbs from which numbers are multiplied by number
+ *        theoretic transforms rather than by Karatsuba's method.
+ */
+#define TRANSFORM_THRESHOLD 2048
+
+/**
+ * @def TRANSFORM_PRIMES 2
+ * @brief A Macro that sets the number of primes the number theoretic transforms are taken
+ *        modulo.
+ */
+#define TRANSFORM_PRIMES 2
+
+/**
+ * @def TRANSFORM_BLOCK_SIZE 1024
+ * @brief A Macro that sets the number of values up to which a transform is computed layer by
+ *        layer, within the cache, rather than split recursively.
+ */
+#define TRANSFORM_BLOCK_SIZE 1024
+
+/**
+ * @def PIECE_BITS 32
+ * @brief A Macro that sets the number of bits of the pieces limbs are split into for the number
+ *        theoretic transforms.
+ */
+#define PIECE_BITS 32
+
+/**
+ * @def PARALLEL_THRESHOLD 4096
+ * @brief A Macro that sets the number of limbs from which the parts of a conversion are given
+ *        to the threads of the pool.
+ */
+#define PARALLEL_THRESHOLD 4096
+
+/**
+ * @def TASK_PENDING 0
+ * @brief A Flag for a task which no thread has taken yet.
+ */
+#define TASK_PENDING 0
+
+/**
+ * @def TASK_RUNNING 1
+ * @brief A Flag for a task which a thread runs.
+ */
+#define TASK_RUNNING 1
+
+/**
+ * @def TASK_FINISHED 2
+ * @brief A Flag for a task which has finished.
+ */
+#define TASK_FINISHED 2
+
+/**
+ * @def COMMON_BASES_NUMBER 4
+ * @brief A Macro that sets the number of common bases, 2, 8, 10 and 16, whose pairs are
+ *        converted by kernels specialized for the pair.
+ */
+#define COMMON_BASES_NUMBER 4
+
+/**
+ * @def SSE2_WIDTH 16
+ * @brief A Macro that sets the number of digits checked at once with SSE2 instructions.
+ */
+#define SSE2_WIDTH 16
+
+/**
+ * @def AVX2_WIDTH 32
+ * @brief A Macro that sets the number of digits checked at once with AVX2 instructions.
+ */
+#define AVX2_WIDTH 32
+
+/**
+ * @def VECTOR_CHUNK_DIGITS 16
+ * @brief A Macro that sets the number of digits parsed at once with vector instructions.
+ */
+#define VECTOR_CHUNK_DIGITS 16
+
+/**
+ * @def MAX_VECTOR_BASE 15
+ * @brief A Macro that sets the largest base whose digits are parsed with vector instructions,
+ *        VECTOR_CHUNK_DIGITS digits of a larger base do not fit in a single limb.
+ */
+#define MAX_VECTOR_BASE 15
+
+/**
+ * @def LETTER_CASE_BIT 0x20
+ * @brief A Macro that sets the bit which distinguishes a lowercase letter from an uppercase one.
+ */
+#define LETTER_CASE_BIT 0x20
+
+/**
+ * @def LETTERS_NUMBER 26
+ * @brief A Macro that sets the number of letters.
+ */
+#define LETTERS_NUMBER 26
+
+/**
+ * @def LIMB_KERNEL(originalBase, newBase)
+ * @brief A Macro that defines the kernel converting a number of a single limb from the given
+ *        original base to the given new base. Both bases are constants in the kernel, so the
+ *        compiler turns its multiplications and divisions into shifts and multiplications.
+ */
+#define LIMB_KERNEL(originalBase, newBase)                                                      \
+    static size_t convertLimb##originalBase##To##newBase(char const * const digits,             \
+                                                         size_t const length,                   \
+                                                         char * const result)                   \
+    {                                                                                           \
+        return convertLimb(originalBase, newBase, digits, length, result);                      \
+    }
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief A single limb of a big number.
+ */
+typedef uint64_t Limb;
+
+/**
+ * @brief A product of two limbs.
+ */
+__extension__ typedef unsigned __int128 DoubleLimb;
+
+/**
+ * @brief A non negative big number.
+ */
+typedef struct BigNumber
+{
+    /** The limbs of the number, the least significant first. */
+    Limb * limbs;
+    /** The number of limbs, the most significant one is not 0, and 0 is of no limbs. */
+    size_t size;
+} BigNumber;
+
+/**
+ * @brief The powers of a single base which split its numbers.
+ */
+typedef struct RadixTable
+{
+    /** The base. */
+    int base;
+    /** The number of digits which fit in a single limb. */
+    size_t chunkDigits;
+    /** The base raised to the number of digits in a single limb. */
+    Limb chunkPower;
+    /** The powers, the power of level i is the base raised to chunkDigits * 2^i. */
+    BigNumber powers[MAX_POWER_LEVELS];
+    /** The reciprocals of the powers, which are needed for writing numbers only. */
+    BigNumber reciprocals[MAX_POWER_LEVELS];
+    /** The number of powers computed so far. */
+    size_t levels;
+} RadixTable;
+
+/**
+ * @brief A kernel converting a number of a single limb between a fixed pair of bases.
+ * @param digits The digits of the number.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+typedef size_t (* LimbKernel)(char const * const digits, size_t const length,
+                              char * const result);
+
+/**
+ * @brief A task which may run on another thread of the pool while the thread which started it
+ *        goes on.
+ */
+typedef struct ParallelTask
+{
+    /** The body of the task. */
+    void * (* body)(void *);
+    /** The argument of the body. */
+    void * argument;
+    /** TASK_PENDING, TASK_RUNNING or TASK_FINISHED. */
+    int status;
+    /** The task started before it, while both are pending. */
+    struct ParallelTask * next;
+} ParallelTask;
+
+/**
+ * @brief The threads which run the tasks of a conversion.
+ */
+typedef struct ThreadPool
+{
+    /** Guards the tasks and their status. */
+    pthread_mutex_t lock;
+    /** Signaled once a task is pending or the pool stops. */
+    pthread_cond_t wake;
+    /** Signaled once a task has finished. */
+    pthread_cond_t finished;
+    /** The pending tasks, the last started first. */
+    ParallelTask * pending;
+    /** Non zero once the pool stops. */
+    int stopping;
+    /** The number of threads. */
+    size_t threadsNumber;
+    /** The threads. */
+    pthread_t threads[CONVERTER_MAX_THREADS];
+} ThreadPool;
+
+/**
+ * @brief Parsing a part of the digits of a number, as a task.
+ */
+typedef struct ParseTask
+{
+    /** The powers of the base of the digits. */
+    RadixTable const * pTable;
+    /** The digits. */
+    char const * digits;
+    /** The number of digits. */
+    size_t length;
+    /** The parsed number. */
+    BigNumber number;
+    /** The Arena of the conversion, or NULL. */
+    ConverterArena * pArena;
+    /** The state of the parsing. */
+    int state;
+} ParseTask;
+
+/**
+ * @brief Writing a part of the digits of a number, as a task.
+ */
+typedef struct WriteTask
+{
+    /** The powers of the base of the digits. */
+    RadixTable const * pTable;
+    /** The number. */
+    BigNumber const * pNumber;
+    /** The path to write the digits in. */
+    char * digits;
+    /** The number of digits. */
+    size_t length;
+    /** The Arena of the conversion, or NULL. */
+    ConverterArena * pArena;
+    /** The state of the writing. */
+    int state;
+} WriteTask;
+
+/**
+ * @brief The arithmetic modulo a prime in Montgomery's form, where x stands for x * 2^64.
+ */
+typedef struct TransformField
+{
+    /** The prime. */
+    Limb modulus;
+    /** The negated inverse of the prime modulo 2^64. */
+    Limb inverse;
+    /** 2^128 modulo the prime, which brings numbers into Montgomery's form. */
+    Limb square;
+} TransformField;
+
+/**
+ * @brief A number theoretic transform of a part of the values, as a task.
+ */
+typedef struct TransformTask
+{
+    /** The arithmetic of the transform. */
+    TransformField const * pField;
+    /** The values, transformed in place. */
+    Limb * values;
+    /** The number of values, a power of 2. */
+    size_t size;
+    /** The tables of the roots of unity of the whole transform. */
+    Limb const * roots;
+    /** The distance between the roots of this part in the roots of the whole transform. */
+    size_t stride;
+    /** The pool of the conversion, or NULL. */
+    ThreadPool * pPool;
+} TransformTask;
+
+/**
+ * @brief A range of the butterflies of a single layer of a transform, as a task.
+ */
+typedef struct ButterflyTask
+{
+    /** The arithmetic of the transform. */
+    TransformField const * pField;
+    /** The values of the layer. */
+    Limb * values;
+    /** Half the number of values of the layer, the distance between two paired values. */
+    size_t half;
+    /** The tables of the roots of unity of the whole transform. */
+    Limb const * roots;
+    /** The distance between the roots of this layer in the roots of the whole transform. */
+    size_t stride;
+    /** The first butterfly of the range. */
+    size_t begin;
+    /** The butterfly after the last one of the range. */
+    size_t end;
+    /** Non zero for the butterflies of the inverse transform. */
+    int inverse;
+    /** The pool of the conversion, or NULL. */
+    ThreadPool * pPool;
+} ButterflyTask;
+
+/**
+ * @brief The product of two numbers modulo a single prime, as a task.
+ */
+typedef struct PrimeTask
+{
+    /** The arithmetic modulo the prime. */
+    TransformField field;
+    /** A generator of the multiplicative group modulo the prime. */
+    Limb generator;
+    /** The first operand. */
+    Limb const * first;
+    /** The number of limbs in the first operand. */
+    size_t firstSize;
+    /** The second operand. */
+    Limb const * second;
+    /** The number of limbs in the second operand. */
+    size_t secondSize;
+    /** The pieces of the product modulo the prime, allocated by the task. */
+    Limb * residues;
+    /** The size of the transform, a power of 2. */
+    size_t size;
+    /** The Arena of the conversion, or NULL. */
+    ConverterArena * pArena;
+    /** The state of the task. */
+    int state;
+} PrimeTask;
+
+/**
+ * @brief The header of a block of memory of an Arena.
+ */
+typedef struct ArenaBlock
+{
+    /** The next free block of the same size class, while the block is free. */
+    struct ArenaBlock * next;
+    /** The size class of the block, which holds 2^sizeClass bytes along with its header. */
+    size_t sizeClass;
+} ArenaBlock;
+
+/**
+ * @brief The scratch memory, and the threads, of the conversions of a single caller.
+ */
+struct ConverterArena
+{
+    /** Guards the free blocks, which the threads of the pool release as well. */
+    pthread_mutex_t lock;
+    /** The free blocks, indexed by their size class. */
+    ArenaBlock * blocks[ARENA_CLASSES];
+    /** Non zero if the pool has started its threads. */
+    int pooled;
+    /** The threads converting the parts of a long number. */
+    ThreadPool pool;
+};
+
+/**
+ * @brief An entry of a Cache, which fills two cache lines.
+ */
+typedef struct CacheEntry
+{
+    /** Odd while the entry is written and advanced by every write, so a reader which finds the
+     *  same even version before and after reading the entry has read a whole entry. */
+    uint32_t version;
+    /** The fingerprint of the key of the entry, 0 for an empty entry. */
+    uint32_t fingerprint;
+    /** The bases and the lengths of the number and of the converted number, a byte each. */
+    uint64_t shape;
+    /** The characters of the number followed by the characters of the converted number. */
+    uint64_t words[CACHE_ENTRY_WORDS];
+} CacheEntry;
+
+/**
+ * @brief The fingerprints of the entries of a bucket of a Cache, which fill a single cache line,
+ *        so looking a key up reads a single entry unless fingerprints collide.
+ */
+typedef struct CacheBucket
+{
+    /** The fingerprints of the keys of the entries, 0 for an empty entry. */
+    uint32_t fingerprints[CACHE_WAYS];
+} CacheBucket;
+
+/**
+ * @brief A copy of the counters of a Cache, which fills a single cache line.
+ */
+typedef struct CacheCounters
+{
+    /** The number of conversions copied from the Cache. */
+    uint64_t hits;
+    /** The number of conversions which were not found in the Cache. */
+    uint64_t misses;
+    /** The number of converted numbers stored in the Cache. */
+    uint64_t insertions;
+    /** The number of converted numbers which were replaced by others. */
+    uint64_t evictions;
+    /** Keeps the copies in different cache lines. */
+    char padding[CACHE_LINE_SIZE - 4 * sizeof(uint64_t)];
+} CacheCounters;
+
+/**
+ * @brief A bounded memory of converted numbers, shared by the conversions of any number of
+ *        threads.
+ */
+struct ConverterCache
+{
+    /** The memory of the entries, the counters, the buckets and the clocks. */
+    void * memory;
+    /** The entries, CACHE_WAYS of each bucket. */
+    CacheEntry * entries;
+    /** The copies of the counters. */
+    CacheCounters * counters;
+    /** The buckets. */
+    CacheBucket * buckets;
+    /** The clock of each bucket, whose lowest CACHE_WAYS bits mark the entries which were used
+     *  since the hand passed them, and whose higher bits are the hand. */
+    uint32_t * clocks;
+    /** The number of buckets, a power of 2. */
+    size_t bucketsNumber;
+};
+
+
+/*----=  Forward Declarations  =-----*/
+
+
+/**
+ * @brief Separates the sign and the leading zeros of the given number from its digits.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param pDigits The path to store the start of the digits in.
+ * @param pDigitsLength The path to store the number of digits in.
+ * @param pNegative The path to store non zero in for a negative number.
+ * @return 1 if the number has any digits, 0 otherwise.
+ */
+static int separateNumber(char const * const number, size_t const length,
+                          char const ** const pDigits, size_t * const pDigitsLength,
+                          int * const pNegative);
+
+/**
+ * @brief Stores the given digits, after the sign of the number, in the given buffer.
+ * @param digits The digits, which may already be in their place in the buffer.
+ * @param count The number of digits.
+ * @param negative Non zero for a negative number.
+ * @param result The buffer.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the number in.
+ * @return 0 if the number was stored, 3 if it does not fit in the buffer.
+ */
+static int storeResult(char const * const digits, size_t const count, int const negative,
+                       char * const result, size_t const capacity, size_t * const pLength);
+
+/**
+ * @brief Allocates a block of the given number of bytes from the given Arena.
+ * @param pArena The Arena, or NULL for the heap.
+ * @param size The number of bytes.
+ * @return The block, or NULL if there is not enough memory.
+ */
+static void * arenaAllocate(ConverterArena * const pArena, size_t const size);
+
+/**
+ * @brief Gives the given block back to the given Arena.
+ * @param pArena The Arena the block was allocated from, or NULL for the heap.
+ * @param block The block, may be NULL.
+ */
+static void arenaRelease(ConverterArena * const pArena, void * const block);
+
+/**
+ * @brief Returns the pool of the given Arena.
+ * @param pArena The Arena, or NULL.
+ * @return The pool, or NULL if there are no threads other than this thread.
+ */
+static ThreadPool * arenaPool(ConverterArena * const pArena);
+
+/**
+ * @brief Hashes the key of a Cache made of the given bases and number.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number.
+ * @param length The number of characters in the number.
+ * @return The hash.
+ */
+static uint64_t hashKey(int const originalBase, int const newBase, char const * const number,
+                        size_t const length);
+
+/**
+ * @brief Looks the given key up in the given Cache.
+ * @param pCache The Cache.
+ * @param hash The hash of the key.
+ * @param key The bases and the length of the number of the key.
+ * @param number The number of the key.
+ * @param words The words to copy the characters of the entry of the key in.
+ * @param pShape The path to store the shape of the entry in.
+ * @return 1 if the key was found, 0 otherwise.
+ */
+static int findEntry(ConverterCache * const pCache, uint64_t const hash, uint64_t const key,
+                     char const * const number, uint64_t * const words, uint64_t * const pShape);
+
+/**
+ * @brief Reads the given entry of a Cache, if it has the given fingerprint and no thread writes
+ *        it meanwhile.
+ * @param pEntry The entry.
+ * @param fingerprint The fingerprint.
+ * @param words The words to copy the characters of the entry in.
+ * @param pShape The path to store the shape of the entry in.
+ * @return 1 if the entry was read, 0 otherwise.
+ */
+static int readEntry(CacheEntry * const pEntry, uint32_t const fingerprint,
+                     uint64_t * const words, uint64_t * const pShape);
+
+/**
+ * @brief Stores the given number and converted number in the given Cache.
+ * @param pCache The Cache.
+ * @param hash The hash of the key.
+ * @param shape The bases and the lengths of the number and of the converted number.
+ * @param number The number.
+ * @param converted The converted number.
+ */
+static void insertEntry(ConverterCache * const pCache, uint64_t const hash, uint64_t const shape,
+                        char const * const number, char const * const converted);
+
+/**
+ * @brief Starts the given number of threads of the given pool.
+ * @param pPool The pool.
+ * @param threadsNumber The number of threads.
+ * @return 0 if any thread was started, 1 otherwise.
+ */
+static int createThreadPool(ThreadPool * const pPool, size_t const threadsNumber);
+
+/**
+ * @brief Stops the threads of the given pool, once they have no task left.
+ * @param pPool The pool.
+ */
+static void destroyThreadPool(ThreadPool * const pPool);
+
+/**
+ * @brief The body of a thread of the pool, runs the pending tasks until the pool stops.
+ * @param pPool The pool.
+ * @return NULL.
+ */
+static void * runPool(void * pPool);
+
+/**
+ * @brief Starts the given task, which some thread of the given pool runs.
+ * @param pPool The pool, or NULL for running the task once it is finished.
+ * @param pTask The task.
+ * @param body The body of the task.
+ * @param argument The argument of the body.
+ */
+static void startTask(ThreadPool * const pPool, ParallelTask * const pTask, void * (* body)(void *),
+                      void * const argument);
+
+/**
+ * @brief Waits for the given task to finish, running it or other pending tasks meanwhile.
+ * @param pPool The pool the task was started in, or NULL.
+ * @param pTask The task.
+ */
+static void finishTask(ThreadPool * const pPool, ParallelTask * const pTask);
+
+/**
+ * @brief Runs the last started pending task of the given pool, the lock of the pool is held.
+ * @param pPool The pool.
+ */
+static void runPending(ThreadPool * const pPool);
+
+/**
+ * @brief Performs the base conversion from a given bases for the desired given number to convert.
+ *        The function first parses the digits into a single limb, and then writes the limb in
+ *        the desired new base.
+ *        Explanation of the Algorithm: In the description of this function's definition.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param digits The digits of the given number, at most CHUNK_DIGITS[originalBase] of them.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+static size_t baseConverter(int const originalBase, int const newBase,
+                            char const * const digits, size_t const length,
+                            char * const result);
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function parses the digits of the given number into a single limb.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param digits The digits of the given number.
+ * @param length The number of digits.
+ * @return The value of the number.
+ */
+static Limb limbConverter(int const originalBase, char const * const digits, size_t const length);
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function writes the given limb in the new base.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The value of the number.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+static size_t baseConverterHelper(int const newBase, Limb number, char * const result);
+
+/**
+ * @brief Converts a number of a single limb from the original base to the new base, it is
+ *        inlined into the kernel of every pair of common bases.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param digits The digits of the given number.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+static inline size_t convertLimb(int const originalBase, int const newBase,
+                                 char const * const digits, size_t const length,
+                                 char * const result);
+
+/**
+ * @brief Returns the number of digits of the given limb in the given base, it is inlined into
+ *        the kernel of every pair of common bases.
+ * @param base The base.
+ * @param number The limb.
+ * @return The number of digits, 1 for 0.
+ */
+static inline size_t limbDigits(int const base, Limb const number);
+
+/**
+ * @brief Selects the kernel specialized for the given pair of bases.
+ * @param originalBase The base in which the number is currently represented.
+ * @param newBase The base to convert the number representation to.
+ * @return The kernel, or NULL if one of the bases is not a common base.
+ */
+static LimbKernel selectLimbKernel(int const originalBase, int const newBase);
+
+/**
+ * @brief Returns the index of the given base among the common bases.
+ * @param base The base.
+ * @return The index, or -1 if the base is not a common base.
+ */
+static int commonBaseIndex(int const base);
+
+/**
+ * @brief Parses the given digits of a base which is a power of 2 into a big number, by placing
+ *        the bits of every digit.
+ * @param base The base of the digits, a power of 2.
+ * @param digits The digits, the most significant first.
+ * @param length The number of digits.
+ * @param pResult The path to store the number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the digits were parsed, 1 if there is not enough memory.
+ */
+static int packDigits(int const base, char const * const digits, size_t const length,
+                      BigNumber * const pResult, ConverterArena * const pArena);
+
+/**
+ * @brief Writes the given big number in a base which is a power of 2 as exactly the given
+ *        number of digits, by extracting the bits of every digit.
+ * @param base The base of the digits, a power of 2.
+ * @param pNumber The number, it must be less than the base raised to the number of digits.
+ * @param digits The path to write the digits in, the most significant first.
+ * @param length The number of digits to write.
+ */
+static void unpackDigits(int const base, BigNumber const * const pNumber, char * const digits,
+                         size_t const length);
+
+/**
+ * @brief Parses the given digits into a single limb, it is inlined with a constant base for the
+ *        standard base.
+ * @param base The base of the digits.
+ * @param digits The digits, the most significant first.
+ * @param count The number of digits, at most the digits which fit in a single limb.
+ * @return The value of the digits.
+ */
+static inline Limb parseChunk(int const base, char const * const digits, size_t const count);
+
+/**
+ * @brief Writes the given limb as exactly the given number of digits, it is inlined with a
+ *        constant base for the standard base.
+ * @param base The base of the digits.
+ * @param chunk The limb, it must be less than the base raised to the number of digits.
+ * @param digits The path to write the digits in, the most significant first.
+ * @param count The number of digits to write.
+ */
+static inline void emitChunk(int const base, Limb chunk, char * const digits, size_t const count);
+
+/**
+ * @brief Performs the base conversion of a number of any number of digits.
+ *        The digits are parsed into a big number, and the big number is written in the new base.
+ *        Explanation of the Algorithm: In the description of this function's definition.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param digits The digits of the given number, the most significant first.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, without leading zeros, if they fit.
+ * @param capacity The number of characters the result holds.
+ * @param pCount The path to store the number of converted digits in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was converted, 1 if there is not enough memory.
+ */
+static int bigBaseConverter(int const originalBase, int const newBase, char const * const digits,
+                            size_t const length, char * const result, size_t const capacity,
+                            size_t * const pCount, ConverterArena * const pArena);
+
+/**
+ * @brief Parses the given digits of any number of digits into a big number.
+ * @param originalBase The base of the digits.
+ * @param digits The digits, the most significant first.
+ * @param length The number of digits.
+ * @param pNumber The path to store the number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the digits were parsed, 1 if there is not enough memory.
+ */
+static int parseNumber(int const originalBase, char const * const digits, size_t const length,
+                       BigNumber * const pNumber, ConverterArena * const pArena);
+
+/**
+ * @brief Writes the given big number in the given base, without leading zeros.
+ * @param newBase The base to write the number in.
+ * @param pNumber The number.
+ * @param result The path to write the digits in, if they fit.
+ * @param capacity The number of characters the result holds.
+ * @param pCount The path to store the number of digits in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was written, 1 if there is not enough memory.
+ */
+static int writeNumber(int const newBase, BigNumber const * const pNumber, char * const result,
+                       size_t const capacity, size_t * const pCount,
+                       ConverterArena * const pArena);
+
+/**
+ * @brief Parses the given digits into a big number, by splitting them by a power of the base.
+ * @param pTable The powers of the base of the digits, prepared for the digits.
+ * @param digits The digits, the most significant first.
+ * @param length The number of digits.
+ * @param pResult The path to store the number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the digits were parsed, 1 if there is not enough memory.
+ */
+static int digitsToNumber(RadixTable const * const pTable, char const * const digits,
+                          size_t const length, BigNumber * const pResult,
+                          ConverterArena * const pArena);
+
+/**
+ * @brief Writes the given big number as exactly the given number of digits, padded with zeros,
+ *        by splitting it by a power of the base.
+ * @param pTable The powers of the base of the digits, prepared for the digits.
+ * @param pNumber The number, it must be less than the base raised to the number of digits.
+ * @param digits The path to write the digits in, the most significant first.
+ * @param length The number of digits to write.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was written, 1 if there is not enough memory.
+ */
+static int numberToDigits(RadixTable const * const pTable, BigNumber const * const pNumber,
+                          char * const digits, size_t const length,
+                          ConverterArena * const pArena);
+
+/**
+ * @brief The body of a task parsing a part of the digits of a number.
+ * @param pTask The ParseTask.
+ * @return NULL.
+ */
+static void * parseTask(void * pTask);
+
+/**
+ * @brief The body of a task writing a part of the digits of a number.
+ * @param pTask The WriteTask.
+ * @return NULL.
+ */
+static void * writeTask(void * pTask);
+
+/**
+ * @brief Returns the number of digits which is enough for writing the given big number.
+ * @param pTable The powers of the base of the digits.
+ * @param pNumber The number.
+ * @return The number of digits, it may exceed the actual number of digits by a few.
+ */
+static size_t digitsBound(RadixTable const * const pTable, BigNumber const * const pNumber);
+
+/**
+ * @brief Initializes the table of the powers of the given base.
+ * @param pTable The table to initialize.
+ * @param base The base.
+ */
+static void createRadixTable(RadixTable * const pTable, int const base);
+
+/**
+ * @brief Computes the powers of the table which split a number of the given number of digits.
+ * @param pTable The table of the powers.
+ * @param length The number of digits.
+ * @param reciprocals Non zero for computing the reciprocals of the powers as well.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the powers were computed, 1 if there is not enough memory.
+ */
+static int prepareRadixTable(RadixTable * const pTable, size_t const length, int const reciprocals,
+                             ConverterArena * const pArena);
+
+/**
+ * @brief Returns the level of the largest power of the table which has less digits than the
+ *        given number of digits.
+ * @param pTable The table of the powers.
+ * @param length The number of digits, it must be more than the digits of a single limb.
+ * @return The level of the power.
+ */
+static size_t splitLevel(RadixTable const * const pTable, size_t const length);
+
+/**
+ * @brief Releases the powers of the given table.
+ * @param pTable The table to release.
+ * @param pArena The Arena of the conversion, or NULL.
+ */
+static void freeRadixTable(RadixTable * const pTable, ConverterArena * const pArena);
+
+/**
+ * @brief Divides the given big number by a power of the table, using the reciprocal of the power
+ *        as in Barrett's reduction.
+ * @param pTable The table of the powers.
+ * @param level The level of the divisor power, it and its reciprocal must be computed.
+ * @param pNumber The number to divide, it must be less than the square of the power.
+ * @param pQuotient The path to store the quotient in.
+ * @param pRemainder The path to store the remainder in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was divided, 1 if there is not enough memory.
+ */
+static int dividePower(RadixTable const * const pTable, size_t const level,
+                       BigNumber const * const pNumber, BigNumber * const pQuotient,
+                       BigNumber * const pRemainder, ConverterArena * const pArena);
+
+/**
+ * @brief Computes the reciprocal of the given big number of m limbs, that is the quotient of
+ *        2^(2 * m * LIMB_BITS) by the number, using Newton's method.
+ * @param pDivisor The number.
+ * @param pResult The path to store the reciprocal in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the reciprocal was computed, 1 if there is not enough memory.
+ */
+static int computeReciprocal(BigNumber const * const pDivisor, BigNumber * const pResult,
+                             ConverterArena * const pArena);
+
+/**
+ * @brief Improves the given approximation of a reciprocal by a single step of Newton's method.
+ * @param pDivisor The number of m limbs whose reciprocal is approximated.
+ * @param pApproximation The approximation of the reciprocal.
+ * @param pResult The path to store the improved approximation in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the approximation was improved, 1 if there is not enough memory.
+ */
+static int newtonStep(BigNumber const * const pDivisor, BigNumber * const pApproximation,
+                      BigNumber * const pResult, ConverterArena * const pArena);
+
+/**
+ * @brief Corrects the given approximation of a reciprocal to the exact reciprocal.
+ * @param pDivisor The number of m limbs whose reciprocal is approximated.
+ * @param pReciprocal The approximation of the reciprocal, which is corrected in place.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the approximation was corrected, 1 if there is not enough memory.
+ */
+static int correctReciprocal(BigNumber const * const pDivisor, BigNumber * const pReciprocal,
+                             ConverterArena * const pArena);
+
+/**
+ * @brief Computes the reciprocal of a small big number bit by bit, as in long division.
+ * @param pDivisor The number.
+ * @param pResult The path to store the reciprocal in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the reciprocal was computed, 1 if there is not enough memory.
+ */
+static int computeSmallReciprocal(BigNumber const * const pDivisor, BigNumber * const pResult,
+                                  ConverterArena * const pArena);
+
+/**
+ * @brief Allocates the limbs of the given big number, all of them 0.
+ * @param pNumber The number.
+ * @param size The number of limbs.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the limbs were allocated, 1 if there is not enough memory.
+ */
+static int allocateNumber(BigNumber * const pNumber, size_t const size,
+                          ConverterArena * const pArena);
+
+/**
+ * @brief Releases the limbs of the given big number, and sets it to 0.
+ * @param pNumber The number.
+ * @param pArena The Arena of the conversion, or NULL.
+ */
+static void freeNumber(BigNumber * const pNumber, ConverterArena * const pArena);
+
+/**
+ * @brief Drops the most significant limbs of the given big number which are 0.
+ * @param pNumber The number.
+ */
+static void normalizeNumber(BigNumber * const pNumber);
+
+/**
+ * @brief Compares the given big numbers.
+ * @param pFirst The first number.
+ * @param pSecond The second number.
+ * @return A negative value if the first number is less than the second one, 0 if they are equal
+ *         and a positive value otherwise.
+ */
+static int compareNumbers(BigNumber const * const pFirst, BigNumber const * const pSecond);
+
+/**
+ * @brief Adds the given big numbers.
+ * @param pFirst The first number.
+ * @param pSecond The second number.
+ * @param pResult The path to store the sum in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the numbers were added, 1 if there is not enough memory.
+ */
+static int addNumbers(BigNumber const * const pFirst, BigNumber const * const pSecond,
+                      BigNumber * const pResult, ConverterArena * const pArena);
+
+/**
+ * @brief Subtracts the second big number from the first one, in place.
+ * @param pFirst The first number, it must not be less than the second one.
+ * @param pSecond The second number.
+ */
+static void subtractNumber(BigNumber * const pFirst, BigNumber const * const pSecond);
+
+/**
+ * @brief Multiplies the given big numbers.
+ * @param pFirst The first number.
+ * @param pSecond The second number.
+ * @param pResult The path to store the product in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the numbers were multiplied, 1 if there is not enough memory.
+ */
+static int multiplyNumbers(BigNumber const * const pFirst, BigNumber const * const pSecond,
+                           BigNumber * const pResult, ConverterArena * const pArena);
+
+/**
+ * @brief Shifts the given big number by whole limbs.
+ * @param pNumber The number.
+ * @param shift The number of limbs to shift by, a positive shift multiplies the number and a
+ *        negative shift divides it.
+ * @param pResult The path to store the shifted number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was shifted, 1 if there is not enough memory.
+ */
+static int shiftNumber(BigNumber const * const pNumber, long const shift,
+                       BigNumber * const pResult, ConverterArena * const pArena);
+
+/**
+ * @brief Adds the given limbs to the given limbs of at least the same length.
+ * @param result The path to store the sum in, it has as many limbs as the first operand and may
+ *        be the first operand.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand, at most firstSize.
+ * @return The carry out of the most significant limb.
+ */
+static Limb addLimbs(Limb * const result, Limb const * const first, size_t const firstSize,
+                     Limb const * const second, size_t const secondSize);
+
+/**
+ * @brief Subtracts the given limbs from the given limbs of at least the same length.
+ * @param result The path to store the difference in, it has as many limbs as the first operand
+ *        and may be the first operand.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand, at most firstSize.
+ * @return The borrow out of the most significant limb.
+ */
+static Limb subtractLimbs(Limb * const result, Limb const * const first, size_t const firstSize,
+                          Limb const * const second, size_t const secondSize);
+
+/**
+ * @brief Multiplies the given limbs, by Karatsuba's method if they are long enough.
+ * @param result The path to store the product in, of firstSize + secondSize limbs.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand, at least 1 and at most firstSize.
+ * @param scratch Scratch limbs, MULTIPLY_SCRATCH_FACTOR per limb of the operands.
+ */
+static void multiplyLimbs(Limb * const result, Limb const * const first, size_t const firstSize,
+                          Limb const * const second, size_t const secondSize, Limb * const scratch);
+
+/**
+ * @brief Multiplies the given limbs limb by limb.
+ * @param result The path to store the product in, of firstSize + secondSize limbs.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand.
+ */
+static void schoolbookMultiply(Limb * const result, Limb const * const first,
+                               size_t const firstSize, Limb const * const second,
+                               size_t const secondSize);
+
+/**
+ * @brief Multiplies the given limbs by a single limb and adds a single limb, in place.
+ * @param limbs The limbs.
+ * @param size The number of limbs.
+ * @param multiplier The limb to multiply by.
+ * @param addend The limb to add.
+ * @return The carry out of the most significant limb.
+ */
+static Limb multiplyAddLimb(Limb * const limbs, size_t const size, Limb const multiplier,
+                            Limb const addend);
+
+/**
+ * @brief Divides the given limbs by a single limb, in place.
+ * @param limbs The limbs.
+ * @param size The number of limbs.
+ * @param divisor The limb to divide by.
+ * @return The remainder.
+ */
+static Limb divideLimb(Limb * const limbs, size_t const size, Limb const divisor);
+
+/**
+ * @brief Multiplies the given limbs by number theoretic transforms modulo two primes.
+ * @param result The path to store the product in, of firstSize + secondSize limbs.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the limbs were multiplied, 1 if there is not enough memory.
+ */
+static int transformMultiply(Limb * const result, Limb const * const first, size_t const firstSize,
+                             Limb const * const second, size_t const secondSize,
+                             ConverterArena * const pArena);
+
+/**
+ * @brief The body of a task computing the product of two numbers modulo a single prime.
+ * @param pTask The PrimeTask.
+ * @return NULL.
+ */
+static void * transformPrime(void * pTask);
+
+/**
+ * @brief Recovers the product of two numbers from its pieces modulo the two primes.
+ * @param result The path to store the product in.
+ * @param size The number of limbs of the product.
+ * @param pFirst The product modulo the first prime.
+ * @param pSecond The product modulo the second prime.
+ */
+static void combineResidues(Limb * const result, size_t const size, PrimeTask const * const pFirst,
+                            PrimeTask const * const pSecond);
+
+/**
+ * @brief Splits the given limbs into pieces of PIECE_BITS bits, padded with zeros.
+ * @param values The path to store the pieces in.
+ * @param limbs The limbs.
+ * @param count The number of limbs.
+ * @param size The number of pieces to store.
+ */
+static void splitPieces(Limb * const values, Limb const * const limbs, size_t const count,
+                        size_t const size);
+
+/**
+ * @brief Transforms the given values in place, leaving them in bit reversed order.
+ * @param pField The arithmetic of the transform.
+ * @param values The values.
+ * @param size The number of values, a power of 2.
+ * @param roots The tables of the roots of unity of the whole transform.
+ * @param stride The distance between the roots of these values in the roots.
+ * @param pPool The pool transforming the values, or NULL for this thread.
+ */
+static void forwardTransform(TransformField const * const pField, Limb * const values,
+                             size_t const size, Limb const * const roots, size_t const stride,
+                             ThreadPool * const pPool);
+
+/**
+ * @brief Transforms back the given values in bit reversed order in place, without the scaling.
+ * @param pField The arithmetic of the transform.
+ * @param values The values.
+ * @param size The number of values, a power of 2.
+ * @param roots The tables of the roots of unity of the whole transform, read as the inverse
+ *              roots.
+ * @param stride The distance between the roots of these values in the roots.
+ * @param pPool The pool transforming the values, or NULL for this thread.
+ */
+static void inverseTransform(TransformField const * const pField, Limb * const values,
+                             size_t const size, Limb const * const roots, size_t const stride,
+                             ThreadPool * const pPool);
+
+/**
+ * @brief The body of a task of a forward transform.
+ * @param pTask The TransformTask.
+ * @return NULL.
+ */
+static void * forwardTask(void * pTask);
+
+/**
+ * @brief The body of a task of an inverse transform.
+ * @param pTask The TransformTask.
+ * @return NULL.
+ */
+static void * inverseTask(void * pTask);
+
+/**
+ * @brief The body of a task of a range of butterflies of a single layer.
+ * @param pTask The ButterflyTask.
+ * @return NULL.
+ */
+static void * butterflyTask(void * pTask);
+
+/**
+ * @brief Computes a range of the butterflies of a layer of the forward transform.
+ * @param pField The arithmetic of the transform.
+ * @param values The values of the layer.
+ * @param half Half the number of values of the layer.
+ * @param roots The tables of the roots of unity of the whole transform.
+ * @param stride The distance between the roots of this layer in the roots.
+ * @param begin The first butterfly of the range.
+ * @param end The butterfly after the last one of the range.
+ */
+static inline void forwardButterflies(TransformField const * const pField, Limb * const values,
+                                      size_t const half, Limb const * const roots,
+                                      size_t const stride, size_t const begin, size_t const end);
+
+/**
+ * @brief Computes a range of the butterflies of a layer of the inverse transform.
+ * @param pField The arithmetic of the transform.
+ * @param values The values of the layer.
+ * @param half Half the number of values of the layer.
+ * @param roots The tables of the roots of unity of the whole transform, read as the inverse
+ *              roots.
+ * @param stride The distance between the roots of this layer in the roots.
+ * @param begin The first butterfly of the range.
+ * @param end The butterfly after the last one of the range.
+ */
+static inline void inverseButterflies(TransformField const * const pField, Limb * const values,
+                                      size_t const half, Limb const * const roots,
+                                      size_t const stride, size_t const begin, size_t const end);
+
+/**
+ * @brief Initializes the arithmetic modulo the given prime.
+ * @param pField The arithmetic.
+ * @param modulus The prime, odd and less than 2^62.
+ */
+static void createField(TransformField * const pField, Limb const modulus);
+
+/**
+ * @brief Raises the given number to the given power.
+ * @param pField The arithmetic.
+ * @param base The number, in Montgomery's form.
+ * @param exponent The power.
+ * @return The result, in Montgomery's form.
+ */
+static Limb powerModulo(TransformField const * const pField, Limb base, Limb exponent);
+
+/**
+ * @brief Multiplies the given numbers and divides the product by 2^64, modulo the prime.
+ * @param pField The arithmetic.
+ * @param first The first number, less than the prime.
+ * @param second The second number, less than the prime.
+ * @return The result, less than the prime.
+ */
+static inline Limb montgomeryMultiply(TransformField const * const pField, Limb const first,
+                                      Limb const second);
+
+/**
+ * @brief Adds the given numbers modulo the given prime.
+ * @param modulus The prime.
+ * @param first The first number, less than the prime.
+ * @param second The second number, less than the prime.
+ * @return The sum, less than the prime.
+ */
+static inline Limb addModulo(Limb const modulus, Limb const first, Limb const second);
+
+/**
+ * @brief Subtracts the second number from the first one modulo the given prime.
+ * @param modulus The prime.
+ * @param first The first number, less than the prime.
+ * @param second The second number, less than the prime.
+ * @return The difference, less than the prime.
+ */
+static inline Limb subtractModulo(Limb const modulus, Limb const first, Limb const second);
+
+/**
+ * @brief Verify that the given number in the user input can be represented in the
+ *        given original base.
+ * @param originalBase The given original base in the user input.
+ * @param digits The digits of the given number in the user input.
+ * @param length The number of digits.
+ * @return 0 if the input is invalid, 1 otherwise.
+ */
+static int checkInput(int const originalBase, char const * const digits, size_t const length);
+
+#ifdef VECTOR_DIGITS
+
+/**
+ * @brief Checks the given digits 16 at a time using SSE2 instructions.
+ * @param originalBase The base of the digits.
+ * @param digits The digits.
+ * @param length The number of digits.
+ * @return The number of leading digits which are valid, a multiple of 16 which stops before the
+ *         first 16 digits which contain an invalid one.
+ */
+static size_t checkDigitsSse2(int const originalBase, char const * const digits,
+                              size_t const length);
+
+/**
+ * @brief Checks the given digits 32 at a time using AVX2 instructions.
+ * @param originalBase The base of the digits.
+ * @param digits The digits.
+ * @param length The number of digits.
+ * @return The number of leading digits which are valid, a multiple of 32 which stops before the
+ *         first 32 digits which contain an invalid one.
+ */
+static size_t checkDigitsAvx2(int const originalBase, char const * const digits,
+                              size_t const length);
+
+/**
+ * @brief Maps 16 characters to the values of their digits using SSE2 instructions.
+ * @param characters The characters.
+ * @return The values, INVALID_DIGIT for a character which is not a digit.
+ */
+static inline __m128i sse2DigitValues(__m128i const characters);
+
+/**
+ * @brief Maps 32 characters to the values of their digits using AVX2 instructions.
+ * @param characters The characters.
+ * @return The values, INVALID_DIGIT for a character which is not a digit.
+ */
+static inline __m256i avx2DigitValues(__m256i const characters);
+
+/**
+ * @brief Parses 16 digits into a single limb using SSE2 instructions.
+ * @param base The base of the digits, at most MAX_VECTOR_BASE.
+ * @param digits The digits, the most significant first, they must be valid.
+ * @return The value of the digits.
+ */
+static Limb parseDigitsSse2(int const base, char const * const digits);
+
+#endif
+
+
+/*----=  Digit Tables  =-----*/
+
+
+/**
+ * @brief The characters of the digits, indexed by their value.
+ */
+static char const DIGIT_CHARACTERS[CONVERTER_MAX_BASE + 1] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/**
+ * @brief The values of the digits, indexed by their character, INVALID_DIGIT (0xFF) for a
+ *        character which is not a digit.
+ */
+static unsigned char const DIGIT_VALUES[UCHAR_MAX + 1] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+/**
+ * @brief The number of digits which fit in a single limb, indexed by the base.
+ */
+static size_t const CHUNK_DIGITS[CONVERTER_MAX_BASE + 1] = {
+    0, 0, 63, 40, 31, 27, 24, 22, 21, 20, 19, 18,
+    17, 17, 16, 16, 15, 15, 15, 15, 14, 14, 14, 14,
+    13, 13, 13, 13, 13, 13, 13, 12, 12, 12, 12, 12,
+    12
+};
+
+/**
+ * @brief The base raised to the number of digits which fit in a single limb, indexed by the base.
+ */
+static Limb const CHUNK_POWERS[CONVERTER_MAX_BASE + 1] = {
+    0, 0, 0x8000000000000000, 0xa8b8b452291fe821,
+    0x4000000000000000, 0x6765c793fa10079d, 0x41c21cb8e1000000, 0x3642798750226111,
+    0x8000000000000000, 0xa8b8b452291fe821, 0x8ac7230489e80000, 0x4d28cb56c33fa539,
+    0x1eca170c00000000, 0x780c7372621bd74d, 0x1e39a5057d810000, 0x5b27ac993df97701,
+    0x1000000000000000, 0x27b95e997e21d9f1, 0x5da0e1e53c5c8000, 0xd2ae3299c1c4aedb,
+    0x16bcc41e90000000, 0x2d04b7fdd9c0ef49, 0x5658597bcaa24000, 0xa0e2073737609371,
+    0x0c29e98000000000, 0x14adf4b7320334b9, 0x226ed36478bfa000, 0x383d9170b85ff80b,
+    0x5a3c23e39c000000, 0x8e65137388122bcd, 0xdd41bb36d259e000, 0x0aee5720ee830681,
+    0x1000000000000000, 0x172588ad4f5f0981, 0x211e44f7d02c1000, 0x2ee56725f06e5c71,
+    0x41c21cb8e1000000
+};
+
+
+/*----=  Converter  =-----*/
+
+
+/**
+ * @brief Creates an Arena, with a pool of threads if more than a single thread converts.
+ *        If the threads cannot be started, the Arena converts in the calling thread.
+ * @param threads The number of threads converting a long number, including the thread which
+ *        calls 'converterConvert', 0 and 1 both mean that thread only.
+ * @return The new Arena, or NULL if there is not enough memory.
+ */
+ConverterArena * converterCreateArena(size_t const threads)
+{
+    ConverterArena * const pArena = calloc(1, sizeof(ConverterArena));
+    if (pArena == NULL)
+    {
+        return NULL;
+    }
+    pthread_mutex_init(&pArena->lock, NULL);
+    pArena->pooled = (threads > 1 && createThreadPool(&pArena->pool, threads - 1) == VALID_STATE);
+    return pArena;
+}
+
+/**
+ * @brief Releases the given Arena, its threads and all the memory it keeps.
+ * @param pArena The Arena to release, may be NULL.
+ */
+void converterDestroyArena(ConverterArena * const pArena)
+{
+    if (pArena == NULL)
+    {
+        return;
+    }
+    if (pArena->pooled)
+    {
+        destroyThreadPool(&pArena->pool);
+    }
+    for (size_t i = 0; i < ARENA_CLASSES; ++i)
+    {
+        while (pArena->blocks[i] != NULL)
+        {
+            ArenaBlock * const pBlock = pArena->blocks[i];
+            pArena->blocks[i] = pBlock->next;
+            free(pBlock);
+        }
+    }
+    pthread_mutex_destroy(&pArena->lock);
+    free(pArena);
+}
+
+/**
+ * @brief Returns the number of characters which is enough for any number of the given length
+ *        converted between the given bases, including its sign.
+ *        The number is less than the power of the original base of its chunks of digits, which
+ *        has at most as many bits as the powers of its chunks. A chunk of digits of the new base
+ *        holds at least as many bits as the power of 2 below its power.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param length The number of characters in the number.
+ * @return The number of characters, it may exceed the exact length by a chunk, or 1 if a base is
+ *         not between CONVERTER_MIN_BASE and CONVERTER_MAX_BASE, as only 0 is converted then.
+ */
+size_t converterBound(int const originalBase, int const newBase, size_t const length)
+{
+    if (originalBase < CONVERTER_MIN_BASE || originalBase > CONVERTER_MAX_BASE ||
+        newBase < CONVERTER_MIN_BASE || newBase > CONVERTER_MAX_BASE)
+    {
+        return 1;
+    }
+
+    size_t const chunks = (length + CHUNK_DIGITS[originalBase] - 1) / CHUNK_DIGITS[originalBase];
+    size_t const bits = chunks * (LIMB_BITS - (size_t) __builtin_clzll(CHUNK_POWERS[originalBase]));
+    size_t const chunkBits = LIMB_BITS - 1 - (size_t) __builtin_clzll(CHUNK_POWERS[newBase]);
+    return 1 + (bits + chunkBits - 1) / chunkBits * CHUNK_DIGITS[newBase];
+}
+
+/**
+ * @brief Converts the given number from the given original base to the given new base.
+ *        The sign and the leading zeros are separated, and the digits are converted within a
+ *        single limb if they fit in it, or as a big number otherwise. Either way, the digits are
+ *        written straight to their place in the buffer if the buffer holds any number of their
+ *        length, which it does if its capacity is given by 'converterBound'.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param result The buffer to write the converted number in, most significant digit first.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in, which
+ *        is also stored if they do not fit in the buffer.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was converted, 1 if the input is invalid, 2 if there is not enough
+ *         memory and 3 if the converted number does not fit in the buffer.
+ */
+int converterConvert(int const originalBase, int const newBase, char const * const number,
+                     size_t const length, char * const result, size_t const capacity,
+                     size_t * const pLength, ConverterArena * const pArena)
+{
+    char const * digits = NULL;
+    size_t digitsLength = 0;
+    int negative = FALSE;
+    int const empty = !separateNumber(number, length, &digits, &digitsLength, &negative);
+
+    // If the given number is 0, it does not matter what are the bases, the result will be 0.
+    if (!empty && digitsLength == 1 && *digits == '0')
+    {
+        return storeResult("0", 1, FALSE, result, capacity, pLength);
+    }
+    if (originalBase < CONVERTER_MIN_BASE || originalBase > CONVERTER_MAX_BASE ||
+        newBase < CONVERTER_MIN_BASE || newBase > CONVERTER_MAX_BASE || empty ||
+        !checkInput(originalBase, digits, digitsLength))
+    {
+        return CONVERTER_INVALID;
+    }
+
+    size_t const sign = negative ? 1 : 0;
+    size_t const space = (capacity > sign) ? capacity - sign : 0;
+    if (digitsLength <= CHUNK_DIGITS[originalBase])
+    {
+        // A short number is converted within a single limb, which has at most one digit more
+        // than a chunk of the new base.
+        char limbResult[MAX_RESULT_SIZE];
+        char * const written = (space > CHUNK_DIGITS[newBase]) ? result + sign : limbResult;
+        size_t const count = baseConverter(originalBase, newBase, digits, digitsLength, written);
+        return storeResult(written, count, negative, result, capacity, pLength);
+    }
+
+    size_t count = 0;
+    char * const written = (space > 0) ? result + sign : NULL;
+    if (bigBaseConverter(originalBase, newBase, digits, digitsLength, written, space, &count,
+                         pArena))
+    {
+        return CONVERTER_OUT_OF_MEMORY;
+    }
+    return storeResult(written, count, negative, result, capacity, pLength);
+}
+
+/**
+ * @brief Returns the number of limbs which is enough for any number of the given length in the
+ *        given base, by the same bound as 'converterBound' gives for base 2.
+ * @param originalBase The base the number is represented in.
+ * @param length The number of characters in the number.
+ * @return The number of limbs, or 0 if the base is not between CONVERTER_MIN_BASE and
+ *         CONVERTER_MAX_BASE.
+ */
+size_t converterLimbsBound(int const originalBase, size_t const length)
+{
+    if (originalBase < CONVERTER_MIN_BASE || originalBase > CONVERTER_MAX_BASE)
+    {
+        return 0;
+    }
+    return converterBound(originalBase, CONVERTER_MIN_BASE, length) / LIMB_BITS + 1;
+}
+
+/**
+ * @brief Parses the given number into its 64 bits limbs.
+ *        A number which fits in a single limb is parsed by the kernels of its base, and a
+ *        longer number is parsed into a big number which is copied to the limbs.
+ * @param originalBase The base the number is represented in.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param limbs The buffer to write the limbs of the absolute value of the number in, the least
+ *        significant first.
+ * @param capacity The number of limbs the buffer holds.
+ * @param pSize The path to store the number of limbs in, without leading zero limbs, so 0 is of
+ *        no limbs. It is also stored if they do not fit in the buffer.
+ * @param pNegative The path to store non zero in for a negative number.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was parsed, 1 if the input is invalid, 2 if there is not enough
+ *         memory and 3 if the limbs do not fit in the buffer.
+ */
+int converterParseLimbs(int const originalBase, char const * const number, size_t const length,
+                        uint64_t * const limbs, size_t const capacity, size_t * const pSize,
+                        int * const pNegative, ConverterArena * const pArena)
+{
+    char const * digits = NULL;
+    size_t digitsLength = 0;
+    int negative = FALSE;
+    if (!separateNumber(number, length, &digits, &digitsLength, &negative) ||
+        originalBase < CONVERTER_MIN_BASE || originalBase > CONVERTER_MAX_BASE ||
+        !checkInput(originalBase, digits, digitsLength))
+    {
+        return CONVERTER_INVALID;
+    }
+
+    Limb limb = 0;
+    BigNumber parsed = {&limb, 0};
+    int state = CONVERTER_VALID;
+    if (digitsLength <= CHUNK_DIGITS[originalBase])
+    {
+        limb = limbConverter(originalBase, digits, digitsLength);
+        parsed.size = (limb != 0) ? 1 : 0;
+    }
+    else if (parseNumber(originalBase, digits, digitsLength, &parsed, pArena))
+    {
+        state = CONVERTER_OUT_OF_MEMORY;
+    }
+
+    if (state == CONVERTER_VALID)
+    {
+        *pSize = parsed.size;
+        *pNegative = negative && parsed.size > 0;
+        if (parsed.size > capacity)
+        {
+            state = CONVERTER_BUFFER_TOO_SMALL;
+        }
+        else if (parsed.size > 0)
+        {
+            memcpy(limbs, parsed.limbs, parsed.size * sizeof(Limb));
+        }
+    }
+    if (parsed.limbs != &limb)
+    {
+        freeNumber(&parsed, pArena);
+    }
+    return state;
+}
+
+/**
+ * @brief Converts the given number, given as its 64 bits limbs, to the given new base.
+ *        The limbs are read in place, as the big number which the conversion of digits parses.
+ * @param newBase The base to convert the number to.
+ * @param limbs The limbs of the absolute value of the number, the least significant first.
+ * @param size The number of limbs, which may include leading zero limbs.
+ * @param negative Non zero for a negative number.
+ * @param result The buffer to write the converted number in, most significant digit first.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in, which
+ *        is also stored if they do not fit in the buffer.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was converted, 1 if the base is invalid, 2 if there is not enough
+ *         memory and 3 if the converted number does not fit in the buffer.
+ */
+int converterConvertLimbs(int const newBase, uint64_t const * const limbs, size_t const size,
+                          int const negative, char * const result, size_t const capacity,
+                          size_t * const pLength, ConverterArena * const pArena)
+{
+    size_t numberSize = size;
+    while (numberSize > 0 && limbs[numberSize - 1] == 0)
+    {
+        numberSize--;
+    }
+
+    // As for digits, 0 is converted whatever the base is.
+    if (numberSize == 0)
+    {
+        return storeResult("0", 1, FALSE, result, capacity, pLength);
+    }
+    if (newBase < CONVERTER_MIN_BASE || newBase > CONVERTER_MAX_BASE)
+    {
+        return CONVERTER_INVALID;
+    }
+
+    size_t const sign = negative ? 1 : 0;
+    size_t const space = (capacity > sign) ? capacity - sign : 0;
+    if (numberSize == 1)
+    {
+        char limbResult[MAX_RESULT_SIZE];
+        char * const written = (space >= MAX_RESULT_SIZE) ? result + sign : limbResult;
+        size_t const count = baseConverterHelper(newBase, limbs[0], written);
+        return storeResult(written, count, negative, result, capacity, pLength);
+    }
+
+    // The big number only reads its limbs, so the limbs of the caller serve it as they are.
+    BigNumber const number = {(Limb *) limbs, numberSize};
+    size_t count = 0;
+    char * const written = (space > 0) ? result + sign : NULL;
+    if (writeNumber(newBase, &number, written, space, &count, pArena))
+    {
+        return CONVERTER_OUT_OF_MEMORY;
+    }
+    return storeResult(written, count, negative, result, capacity, pLength);
+}
+
+/**
+ * @brief Separates the sign and the leading zeros of the given number from its digits, the
+ *        leading zeros do not change the number but a single zero is kept.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param pDigits The path to store the start of the digits in.
+ * @param pDigitsLength The path to store the number of digits in.
+ * @param pNegative The path to store non zero in for a negative number.
+ * @return 1 if the number has any digits, 0 otherwise.
+ */
+static int separateNumber(char const * const number, size_t const length,
+                          char const ** const pDigits, size_t * const pDigitsLength,
+                          int * const pNegative)
+{
+    char const * digits = number;
+    size_t digitsLength = length;
+    *pNegative = (digitsLength > 0 && *digits == NEGATIVE_SIGN);
+    if (digitsLength > 0 && (*digits == NEGATIVE_SIGN || *digits == POSITIVE_SIGN))
+    {
+        digits++;
+        digitsLength--;
+    }
+    int const hasDigits = (digitsLength > 0);
+    while (digitsLength > 1 && *digits == '0')
+    {
+        digits++;
+        digitsLength--;
+    }
+    *pDigits = digits;
+    *pDigitsLength = digitsLength;
+    return hasDigits;
+}
+
+/**
+ * @brief Stores the given digits, after the sign of the number, in the given buffer.
+ * @param digits The digits, which may already be in their place in the buffer.
+ * @param count The number of digits.
+ * @param negative Non zero for a negative number.
+ * @param result The buffer.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the number in.
+ * @return 0 if the number was stored, 3 if it does not fit in the buffer.
+ */
+static int storeResult(char const * const digits, size_t const count, int const negative,
+                       char * const result, size_t const capacity, size_t * const pLength)
+{
+    size_t const sign = negative ? 1 : 0;
+    *pLength = sign + count;
+    if (sign + count > capacity)
+    {
+        return CONVERTER_BUFFER_TOO_SMALL;
+    }
+    if (digits != result + sign)
+    {
+        memmove(result + sign, digits, count);
+    }
+    if (negative)
+    {
+        result[0] = NEGATIVE_SIGN;
+    }
+    return CONVERTER_VALID;
+}
+
+
+/*----=  Arena  =-----*/
+
+
+/**
+ * @brief Allocates a block of the given number of bytes from the given Arena.
+ *        The sizes of the blocks, along with their headers, are powers of 2, so a block wastes
+ *        less than half of itself. A released block is kept in the free blocks of its size
+ *        class, and a block is allocated from the heap only if there is no free block of its
+ *        size class. So the blocks of a conversion serve the next ones, and an Arena which has
+ *        converted numbers of some length allocates no more memory for numbers of that length.
+ * @param pArena The Arena, or NULL for the heap.
+ * @param size The number of bytes.
+ * @return The block, or NULL if there is not enough memory.
+ */
+static void * arenaAllocate(ConverterArena * const pArena, size_t const size)
+{
+    if (pArena == NULL)
+    {
+        return malloc(size);
+    }
+
+    size_t sizeClass = ARENA_MIN_CLASS;
+    while (sizeClass < ARENA_CLASSES && ((size_t) 1 << sizeClass) - sizeof(ArenaBlock) < size)
+    {
+        sizeClass++;
+    }
+    if (sizeClass == ARENA_CLASSES)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pArena->lock);
+    ArenaBlock * pBlock = pArena->blocks[sizeClass];
+    if (pBlock != NULL)
+    {
+        pArena->blocks[sizeClass] = pBlock->next;
+    }
+    pthread_mutex_unlock(&pArena->lock);
+
+    if (pBlock == NULL)
+    {
+        pBlock = malloc((size_t) 1 << sizeClass);
+        if (pBlock == NULL)
+        {
+            return NULL;
+        }
+        pBlock->sizeClass = sizeClass;
+    }
+    return pBlock + 1;
+}
+
+/**
+ * @brief Gives the given block back to the given Arena, which keeps it for the next blocks of
+ *        its size class.
+ * @param pArena The Arena the block was allocated from, or NULL for the heap.
+ * @param block The block, may be NULL.
+ */
+static void arenaRelease(ConverterArena * const pArena, void * const block)
+{
+    if (pArena == NULL || block == NULL)
+    {
+        free(block);
+        return;
+    }
+
+    ArenaBlock * const pBlock = (ArenaBlock *) block - 1;
+    pthread_mutex_lock(&pArena->lock);
+    pBlock->next = pArena->blocks[pBlock->sizeClass];
+    pArena->blocks[pBlock->sizeClass] = pBlock;
+    pthread_mutex_unlock(&pArena->lock);
+}
+
+/**
+ * @brief Returns the pool of the given Arena.
+ * @param pArena The Arena, or NULL.
+ * @return The pool, or NULL if there are no threads other than this thread.
+ */
+static ThreadPool * arenaPool(ConverterArena * const pArena)
+{
+    return (pArena != NULL && pArena->pooled) ? &pArena->pool : NULL;
+}
+
+
+/*----=  Cache  =-----*/
+
+
+/**
+ * @brief Creates an empty Cache, of as many entries as the given memory budget holds.
+ *        The number of buckets is a power of 2, so a bucket is chosen by the low bits of a hash.
+ * @param budget The number of bytes the Cache may use.
+ * @return The new Cache, or NULL if the budget does not hold a single bucket of entries or there
+ *         is not enough memory.
+ */
+ConverterCache * converterCreateCache(size_t const budget)
+{
+    // The entries are aligned to their size, so an entry never shares a cache line with another.
+    size_t const bucketSize = CACHE_WAYS * sizeof(CacheEntry) + sizeof(CacheBucket) +
+                              sizeof(uint32_t);
+    size_t const fixedSize = sizeof(ConverterCache) + sizeof(CacheEntry) +
+                             CACHE_COUNTER_SHARDS * sizeof(CacheCounters);
+    if (budget < fixedSize + bucketSize)
+    {
+        return NULL;
+    }
+    size_t bucketsNumber = 1;
+    while (bucketsNumber <= (budget - fixedSize) / bucketSize / 2)
+    {
+        bucketsNumber *= 2;
+    }
+
+    ConverterCache * const pCache = calloc(1, sizeof(ConverterCache));
+    if (pCache == NULL)
+    {
+        return NULL;
+    }
+    pCache->memory = calloc(1, fixedSize - sizeof(ConverterCache) + bucketsNumber * bucketSize);
+    if (pCache->memory == NULL)
+    {
+        free(pCache);
+        return NULL;
+    }
+    uintptr_t const address = (uintptr_t) pCache->memory;
+    pCache->entries = (CacheEntry *) ((address + sizeof(CacheEntry) - 1) &
+                                      ~(uintptr_t) (sizeof(CacheEntry) - 1));
+    pCache->counters = (CacheCounters *) (pCache->entries + bucketsNumber * CACHE_WAYS);
+    pCache->buckets = (CacheBucket *) (pCache->counters + CACHE_COUNTER_SHARDS);
+    pCache->clocks = (uint32_t *) (pCache->buckets + bucketsNumber);
+    pCache->bucketsNumber = bucketsNumber;
+    return pCache;
+}
+
+/**
+ * @brief Releases the given Cache.
+ * @param pCache The Cache to release, may be NULL.
+ */
+void converterDestroyCache(ConverterCache * const pCache)
+{
+    if (pCache == NULL)
+    {
+        return;
+    }
+    free(pCache->memory);
+    free(pCache);
+}
+
+/**
+ * @brief Converts the given number from the given original base to the given new base, like
+ *        'converterConvert', by copying the converted number from the given Cache if it is
+ *        there. Otherwise the number is converted, and stored in the Cache if the number and
+ *        the converted number together have at most CONVERTER_CACHE_ENTRY_SIZE characters.
+ *        The key is the bases and the number as given, so only valid numbers are stored and an
+ *        invalid number is checked again every time.
+ * @param pCache The Cache, or NULL for converting the number.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param result The buffer to write the converted number in, most significant digit first.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in, which
+ *        is also stored if they do not fit in the buffer.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was converted, 1 if the input is invalid, 2 if there is not enough
+ *         memory and 3 if the converted number does not fit in the buffer.
+ */
+int converterCacheConvert(ConverterCache * const pCache, int const originalBase,
+                          int const newBase, char const * const number, size_t const length,
+                          char * const result, size_t const capacity, size_t * const pLength,
+                          ConverterArena * const pArena)
+{
+    if (pCache == NULL || originalBase < CONVERTER_MIN_BASE || originalBase > CONVERTER_MAX_BASE ||
+        newBase < CONVERTER_MIN_BASE || newBase > CONVERTER_MAX_BASE ||
+        length > CONVERTER_CACHE_ENTRY_SIZE)
+    {
+        if (pCache != NULL)
+        {
+            __atomic_fetch_add(&pCache->counters[0].misses, 1, __ATOMIC_RELAXED);
+        }
+        return converterConvert(originalBase, newBase, number, length, result, capacity,
+                                pLength, pArena);
+    }
+
+    uint64_t const hash = hashKey(originalBase, newBase, number, length);
+    CacheCounters * const pCounters = &pCache->counters[hash % CACHE_COUNTER_SHARDS];
+    uint64_t const key = (uint64_t) originalBase | (uint64_t) newBase << CHAR_BIT |
+                         (uint64_t) length << (2 * CHAR_BIT);
+    uint64_t words[CACHE_ENTRY_WORDS];
+    uint64_t shape = 0;
+    if (findEntry(pCache, hash, key, number, words, &shape))
+    {
+        __atomic_fetch_add(&pCounters->hits, 1, __ATOMIC_RELAXED);
+        *pLength = (size_t) (shape >> (3 * CHAR_BIT));
+        if (*pLength > capacity)
+        {
+            return CONVERTER_BUFFER_TOO_SMALL;
+        }
+        memcpy(result, (char const *) words + length, *pLength);
+        return CONVERTER_VALID;
+    }
+
+    __atomic_fetch_add(&pCounters->misses, 1, __ATOMIC_RELAXED);
+    int const state = converterConvert(originalBase, newBase, number, length, result, capacity,
+                                       pLength, pArena);
+    if (state == CONVERTER_VALID && length + *pLength <= CONVERTER_CACHE_ENTRY_SIZE)
+    {
+        insertEntry(pCache, hash, key | (uint64_t) *pLength << (3 * CHAR_BIT), number, result);
+    }
+    return state;
+}
+
+/**
+ * @brief Reads the counters of the given Cache, which its threads may still be changing.
+ * @param pCache The Cache.
+ * @param pStatistics The address to store the counters in.
+ */
+void converterCacheStatistics(ConverterCache const * const pCache,
+                              ConverterCacheStatistics * const pStatistics)
+{
+    memset(pStatistics, 0, sizeof(ConverterCacheStatistics));
+    for (size_t i = 0; i < CACHE_COUNTER_SHARDS; ++i)
+    {
+        CacheCounters * const pCounters = &pCache->counters[i];
+        pStatistics->hits += __atomic_load_n(&pCounters->hits, __ATOMIC_RELAXED);
+        pStatistics->misses += __atomic_load_n(&pCounters->misses, __ATOMIC_RELAXED);
+        pStatistics->insertions += __atomic_load_n(&pCounters->insertions, __ATOMIC_RELAXED);
+        pStatistics->evictions += __atomic_load_n(&pCounters->evictions, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Hashes the key of a Cache made of the given bases and number.
+ *        The number is mixed a word at a time, and the low bits of the hash, which choose the
+ *        bucket, depend on all of its bits.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number.
+ * @param length The number of characters in the number.
+ * @return The hash.
+ */
+static uint64_t hashKey(int const originalBase, int const newBase, char const * const number,
+                        size_t const length)
+{
+    uint64_t hash = ((uint64_t) originalBase << (2 * CHAR_BIT) |
+                     (uint64_t) newBase << CHAR_BIT | length) * CACHE_HASH_MULTIPLIER;
+    for (size_t i = 0; i < length; i += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, number + i, (length - i < sizeof(uint64_t)) ? length - i : sizeof(uint64_t));
+        hash = (hash ^ word) * CACHE_HASH_MULTIPLIER;
+        hash ^= hash >> (LIMB_BITS / 2);
+    }
+    return hash;
+}
+
+/**
+ * @brief Looks the given key up in the given Cache.
+ *        The fingerprints of the bucket of the key are compared at first, and only an entry of
+ *        the same fingerprint is read and compared to the key. A found entry is marked as used,
+ *        unless it already is, so a popular entry is not written by its readers.
+ * @param pCache The Cache.
+ * @param hash The hash of the key.
+ * @param key The bases and the length of the number of the key.
+ * @param number The number of the key.
+ * @param words The words to copy the characters of the entry of the key in.
+ * @param pShape The path to store the shape of the entry in.
+ * @return 1 if the key was found, 0 otherwise.
+ */
+static int findEntry(ConverterCache * const pCache, uint64_t const hash, uint64_t const key,
+                     char const * const number, uint64_t * const words, uint64_t * const pShape)
+{
+    size_t const bucket = (size_t) hash & (pCache->bucketsNumber - 1);
+    uint32_t const fingerprint = (uint32_t) (hash >> (LIMB_BITS / 2)) | 1;
+    uint32_t * const fingerprints = pCache->buckets[bucket].fingerprints;
+    for (size_t way = 0; way < CACHE_WAYS; ++way)
+    {
+        if (__atomic_load_n(&fingerprints[way], __ATOMIC_RELAXED) != fingerprint ||
+            !readEntry(&pCache->entries[bucket * CACHE_WAYS + way], fingerprint, words, pShape) ||
+            (*pShape & CACHE_KEY_MASK) != key ||
+            memcmp(words, number, (size_t) (key >> (2 * CHAR_BIT))) != 0)
+        {
+            continue;
+        }
+
+        uint32_t const used = (uint32_t) 1 << way;
+        if (!(__atomic_load_n(&pCache->clocks[bucket], __ATOMIC_RELAXED) & used))
+        {
+            __atomic_fetch_or(&pCache->clocks[bucket], used, __ATOMIC_RELAXED);
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Reads the given entry of a Cache, if it has the given fingerprint and no thread writes
+ *        it meanwhile. Every field is read atomically, so a reader which races a writer reads
+ *        some mix of the two versions, and throws it away as the version has changed.
+ * @param pEntry The entry.
+ * @param fingerprint The fingerprint.
+ * @param words The words to copy the characters of the entry in.
+ * @param pShape The path to store the shape of the entry in.
+ * @return 1 if the entry was read, 0 otherwise.
+ */
+static int readEntry(CacheEntry * const pEntry, uint32_t const fingerprint,
+                     uint64_t * const words, uint64_t * const pShape)
+{
+    uint32_t const version = __atomic_load_n(&pEntry->version, __ATOMIC_ACQUIRE);
+    if ((version & 1) || __atomic_load_n(&pEntry->fingerprint, __ATOMIC_RELAXED) != fingerprint)
+    {
+        return FALSE;
+    }
+    uint64_t const shape = __atomic_load_n(&pEntry->shape, __ATOMIC_RELAXED);
+    size_t const size = (size_t) ((shape >> (2 * CHAR_BIT) & UCHAR_MAX) +
+                                  (shape >> (3 * CHAR_BIT)));
+    for (size_t i = 0; i * sizeof(uint64_t) < size; ++i)
+    {
+        words[i] = __atomic_load_n(&pEntry->words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&pEntry->version, __ATOMIC_RELAXED) != version)
+    {
+        return FALSE;
+    }
+    *pShape = shape;
+    return TRUE;
+}
+
+/**
+ * @brief Stores the given number and converted number in the given Cache.
+ *        An empty entry of the bucket of the key is taken if there is one. Otherwise the hand of
+ *        the clock of the bucket sweeps its entries, clearing the marks of the used entries,
+ *        until it finds an entry which was not used since the hand last passed it, and that
+ *        entry is replaced. If another thread writes the chosen entry meanwhile, the number is
+ *        not stored, as it is only a cache.
+ * @param pCache The Cache.
+ * @param hash The hash of the key.
+ * @param shape The bases and the lengths of the number and of the converted number.
+ * @param number The number.
+ * @param converted The converted number.
+ */
+static void insertEntry(ConverterCache * const pCache, uint64_t const hash, uint64_t const shape,
+                        char const * const number, char const * const converted)
+{
+    size_t const bucket = (size_t) hash & (pCache->bucketsNumber - 1);
+    uint32_t const fingerprint = (uint32_t) (hash >> (LIMB_BITS / 2)) | 1;
+    uint32_t * const fingerprints = pCache->buckets[bucket].fingerprints;
+    size_t empty = 0;
+    while (empty < CACHE_WAYS && __atomic_load_n(&fingerprints[empty], __ATOMIC_RELAXED) != 0)
+    {
+        empty++;
+    }
+
+    uint32_t const usedMask = ((uint32_t) 1 << CACHE_WAYS) - 1;
+    uint32_t clock = __atomic_load_n(&pCache->clocks[bucket], __ATOMIC_RELAXED);
+    uint32_t swept = 0;
+    size_t way = empty;
+    do
+    {
+        uint32_t used = clock & usedMask;
+        size_t hand = clock >> CACHE_WAYS;
+        way = empty;
+        if (way == CACHE_WAYS)
+        {
+            while (used & (uint32_t) 1 << hand)
+            {
+                used &= ~((uint32_t) 1 << hand);
+                hand = (hand + 1) % CACHE_WAYS;
+            }
+            way = hand;
+            hand = (hand + 1) % CACHE_WAYS;
+        }
+        swept = (uint32_t) hand << CACHE_WAYS | used | (uint32_t) 1 << way;
+    } while (!__atomic_compare_exchange_n(&pCache->clocks[bucket], &clock, swept, FALSE,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    CacheEntry * const pEntry = &pCache->entries[bucket * CACHE_WAYS + way];
+    uint32_t version = __atomic_load_n(&pEntry->version, __ATOMIC_RELAXED);
+    if ((version & 1) ||
+        !__atomic_compare_exchange_n(&pEntry->version, &version, version + 1, FALSE,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    size_t const length = (size_t) (shape >> (2 * CHAR_BIT) & UCHAR_MAX);
+    size_t const convertedLength = (size_t) (shape >> (3 * CHAR_BIT));
+    uint64_t words[CACHE_ENTRY_WORDS] = {0};
+    memcpy(words, number, length);
+    memcpy((char *) words + length, converted, convertedLength);
+    int const evicted = (__atomic_load_n(&pEntry->fingerprint, __ATOMIC_RELAXED) != 0);
+    __atomic_store_n(&pEntry->fingerprint, fingerprint, __ATOMIC_RELAXED);
+    __atomic_store_n(&pEntry->shape, shape, __ATOMIC_RELAXED);
+    for (size_t i = 0; i * sizeof(uint64_t) < length + convertedLength; ++i)
+    {
+        __atomic_store_n(&pEntry->words[i], words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&pEntry->version, version + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&fingerprints[way], fingerprint, __ATOMIC_RELAXED);
+
+    CacheCounters * const pCounters = &pCache->counters[hash % CACHE_COUNTER_SHARDS];
+    __atomic_fetch_add(&pCounters->insertions, 1, __ATOMIC_RELAXED);
+    if (evicted)
+    {
+        __atomic_fetch_add(&pCounters->evictions, 1, __ATOMIC_RELAXED);
+    }
+}
+
+
+/*----=  Thread Pool  =-----*/
+
+
+/**
+ * @brief Starts the given number of threads of the given pool.
+ *        The tasks form a tree of splits, where every task waits only for the tasks it has
+ *        started. A thread which waits runs the pending tasks meanwhile, so no thread is idle
+ *        while there is a pending task, and a task nobody has taken yet is run by the thread
+ *        which started it, at no more cost than a function call.
+ * @param pPool The pool.
+ * @param threadsNumber The number of threads.
+ * @return 0 if any thread was started, 1 otherwise.
+ */
+static int createThreadPool(ThreadPool * const pPool, size_t const threadsNumber)
+{
+    pthread_mutex_init(&pPool->lock, NULL);
+    pthread_cond_init(&pPool->wake, NULL);
+    pthread_cond_init(&pPool->finished, NULL);
+    pPool->pending = NULL;
+    pPool->stopping = FALSE;
+    pPool->threadsNumber = 0;
+    while (pPool->threadsNumber < threadsNumber && pPool->threadsNumber < CONVERTER_MAX_THREADS &&
+           pthread_create(&pPool->threads[pPool->threadsNumber], NULL, runPool, pPool) == 0)
+    {
+        pPool->threadsNumber++;
+    }
+
+    if (pPool->threadsNumber == 0)
+    {
+        destroyThreadPool(pPool);
+        return INVALID_STATE;
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief Stops the threads of the given pool, once they have no task left.
+ * @param pPool The pool.
+ */
+static void destroyThreadPool(ThreadPool * const pPool)
+{
+    pthread_mutex_lock(&pPool->lock);
+    pPool->stopping = TRUE;
+    pthread_cond_broadcast(&pPool->wake);
+    pthread_mutex_unlock(&pPool->lock);
+    for (size_t i = 0; i < pPool->threadsNumber; ++i)
+    {
+        pthread_join(pPool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pPool->finished);
+    pthread_cond_destroy(&pPool->wake);
+    pthread_mutex_destroy(&pPool->lock);
+}
+
+/**
+ * @brief The body of a thread of the pool, runs the pending tasks until the pool stops.
+ * @param pPool The pool.
+ * @return NULL.
+ */
+static void * runPool(void * pPool)
+{
+    ThreadPool * const pThis = pPool;
+    pthread_mutex_lock(&pThis->lock);
+    while (!pThis->stopping)
+    {
+        if (pThis->pending != NULL)
+        {
+            runPending(pThis);
+        }
+        else
+        {
+            pthread_cond_wait(&pThis->wake, &pThis->lock);
+        }
+    }
+    pthread_mutex_unlock(&pThis->lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts the given task, which some thread of the given pool runs.
+ * @param pPool The pool, or NULL for running the task once it is finished.
+ * @param pTask The task.
+ * @param body The body of the task.
+ * @param argument The argument of the body.
+ */
+static void startTask(ThreadPool * const pPool, ParallelTask * const pTask, void * (* body)(void *),
+                      void * const argument)
+{
+    pTask->body = body;
+    pTask->argument = argument;
+    pTask->status = TASK_PENDING;
+    pTask->next = NULL;
+    if (pPool == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pPool->lock);
+    pTask->next = pPool->pending;
+    pPool->pending = pTask;
+    pthread_cond_signal(&pPool->wake);
+    pthread_mutex_unlock(&pPool->lock);
+}
+
+/**
+ * @brief Waits for the given task to finish, running it or other pending tasks meanwhile.
+ * @param pPool The pool the task was started in, or NULL.
+ * @param pTask The task.
+ */
+static void finishTask(ThreadPool * const pPool, ParallelTask * const pTask)
+{
+    if (pPool == NULL)
+    {
+        pTask->body(pTask->argument);
+        return;
+    }
+
+    pthread_mutex_lock(&pPool->lock);
+    ParallelTask ** pLink = &pPool->pending;
+    while (*pLink != NULL && *pLink != pTask)
+    {
+        pLink = &(*pLink)->next;
+    }
+    if (*pLink == pTask)
+    {
+        // No thread has taken the task, so this thread runs it.
+        *pLink = pTask->next;
+        pTask->status = TASK_RUNNING;
+        pthread_mutex_unlock(&pPool->lock);
+        pTask->body(pTask->argument);
+        return;
+    }
+
+    while (pTask->status != TASK_FINISHED)
+    {
+        if (pPool->pending != NULL)
+        {
+            runPending(pPool);
+        }
+        else
+        {
+            pthread_cond_wait(&pPool->finished, &pPool->lock);
+        }
+    }
+    pthread_mutex_unlock(&pPool->lock);
+}
+
+/**
+ * @brief Runs the last started pending task of the given pool, the lock of the pool is held.
+ * @param pPool The pool.
+ */
+static void runPending(ThreadPool * const pPool)
+{
+    ParallelTask * const pTask = pPool->pending;
+    pPool->pending = pTask->next;
+    pTask->status = TASK_RUNNING;
+    pthread_mutex_unlock(&pPool->lock);
+    pTask->body(pTask->argument);
+    pthread_mutex_lock(&pPool->lock);
+
+    // The task may be released once its status is seen, so it is not used afterwards.
+    pTask->status = TASK_FINISHED;
+    pthread_cond_broadcast(&pPool->finished);
+}
+
+
+/*----=  Base Conversion  =-----*/
+
+
+/**
+ * @brief Performs the base conversion from a given bases for the desired given number to convert.
+ *        The function first parses the digits into a single limb, and then writes the limb in
+ *        the desired new base.
+ *        Explanation of the Algorithm:
+ *        The digits are parsed by Horner's method, starting from the highest one: the value so
+ *        far is multiplied by the original base and the next digit is added, so every digit
+ *        costs a single multiplication rather than a power of the base.
+ *        The value is written by Euclidean Division by the new base: the remainder is the
+ *        lowest digit, and the quotient is written the same way until it is equals to 0.
+ *        The digits are mapped to and from characters by lookup tables. The digits of the value
+ *        are counted first, so they are written from the lowest one straight to their place,
+ *        and need not be reversed.
+ *        Pairs of the common bases 2, 8, 10 and 16 are converted by kernels in which both bases
+ *        are constants, so the multiplications and divisions of powers of 2 are shifts and the
+ *        divisions by 10 are multiplications.
+ *        The running time complexity of this algorithm is O(n) where n is the number of digits
+ *        in the given number to convert.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param digits The digits of the given number, at most CHUNK_DIGITS[originalBase] of them.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+static size_t baseConverter(int const originalBase, int const newBase,
+                            char const * const digits, size_t const length,
+                            char * const result)
+{
+    LimbKernel const kernel = selectLimbKernel(originalBase, newBase);
+    if (kernel != NULL)
+    {
+        return kernel(digits, length, result);
+    }
+
+    Limb const number = limbConverter(originalBase, digits, length);
+    return baseConverterHelper(newBase, number, result);
+}
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function parses the digits of the given number into a single limb.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param digits The digits of the given number.
+ * @param length The number of digits.
+ * @return The value of the number.
+ */
+static Limb limbConverter(int const originalBase, char const * const digits, size_t const length)
+{
+    Limb result = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        result = result * (Limb) originalBase + DIGIT_VALUES[(unsigned char) digits[i]];
+    }
+    return result;
+}
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function writes the given limb in the new base, from its lowest digit.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The value of the number.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+static size_t baseConverterHelper(int const newBase, Limb number, char * const result)
+{
+    size_t const count = limbDigits(newBase, number);
+    size_t index = count;
+    while (number > UINT32_MAX)
+    {
+        result[--index] = DIGIT_CHARACTERS[number % (Limb) newBase];
+        number /= (Limb) newBase;
+    }
+
+    // Below 2^32, the quotient is the high limb of the product by the rounded up reciprocal of
+    // the base, which is exact for such numbers and much cheaper than a division.
+    Limb const reciprocal = UINT64_MAX / (Limb) newBase + 1;
+    while (index > 0)
+    {
+        Limb const quotient = (Limb) (((DoubleLimb) number * reciprocal) >> LIMB_BITS);
+        result[--index] = DIGIT_CHARACTERS[number - quotient * (Limb) newBase];
+        number = quotient;
+    }
+    return count;
+}
+
+
+/*----=  Base Kernels  =-----*/
+
+
+/**
+ * @brief Converts a number of a single limb from the original base to the new base, it is
+ *        inlined into the kernel of every pair of common bases.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param digits The digits of the given number.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, the most significant first.
+ * @return The number of digits written.
+ */
+__attribute__((always_inline))
+static inline size_t convertLimb(int const originalBase, int const newBase,
+                                 char const * const digits, size_t const length,
+                                 char * const result)
+{
+    Limb number = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        number = number * (Limb) originalBase + DIGIT_VALUES[(unsigned char) digits[i]];
+    }
+
+    size_t const count = limbDigits(newBase, number);
+    emitChunk(newBase, number, result, count);
+    return count;
+}
+
+/**
+ * @brief Returns the number of digits of the given limb in the given base, it is inlined into
+ *        the kernel of every pair of common bases.
+ *        The digits of a power of 2 hold whole bits, so they are counted by the bits of the
+ *        limb. Otherwise the powers of the base are compared to the limb, up to the largest
+ *        power which fits in a limb.
+ * @param base The base.
+ * @param number The limb.
+ * @return The number of digits, 1 for 0.
+ */
+__attribute__((always_inline))
+static inline size_t limbDigits(int const base, Limb const number)
+{
+    if ((base & (base - 1)) == 0)
+    {
+        size_t const digitBits = (size_t) __builtin_ctz((unsigned int) base);
+        size_t const bits = LIMB_BITS - (size_t) __builtin_clzll(number | 1);
+        return (bits + digitBits - 1) / digitBits;
+    }
+
+    size_t count = 1;
+    Limb const limit = UINT64_MAX / (Limb) base;
+    for (Limb power = (Limb) base; power <= number; power *= (Limb) base)
+    {
+        count++;
+        if (power > limit)
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+/*
+ * The kernels of the pairs of common bases.
+ */
+LIMB_KERNEL(2, 2)
+LIMB_KERNEL(2, 8)
+LIMB_KERNEL(2, 10)
+LIMB_KERNEL(2, 16)
+LIMB_KERNEL(8, 2)
+LIMB_KERNEL(8, 8)
+LIMB_KERNEL(8, 10)
+LIMB_KERNEL(8, 16)
+LIMB_KERNEL(10, 2)
+LIMB_KERNEL(10, 8)
+LIMB_KERNEL(10, 10)
+LIMB_KERNEL(10, 16)
+LIMB_KERNEL(16, 2)
+LIMB_KERNEL(16, 8)
+LIMB_KERNEL(16, 10)
+LIMB_KERNEL(16, 16)
+
+/**
+ * @brief Selects the kernel specialized for the given pair of bases.
+ * @param originalBase The base in which the number is currently represented.
+ * @param newBase The base to convert the number representation to.
+ * @return The kernel, or NULL if one of the bases is not a common base.
+ */
+static LimbKernel selectLimbKernel(int const originalBase, int const newBase)
+{
+    // The kernels, indexed by the indices of the original base and of the new base.
+    static LimbKernel const kernels[COMMON_BASES_NUMBER][COMMON_BASES_NUMBER] = {
+        {convertLimb2To2, convertLimb2To8, convertLimb2To10, convertLimb2To16},
+        {convertLimb8To2, convertLimb8To8, convertLimb8To10, convertLimb8To16},
+        {convertLimb10To2, convertLimb10To8, convertLimb10To10, convertLimb10To16},
+        {convertLimb16To2, convertLimb16To8, convertLimb16To10, convertLimb16To16}
+    };
+
+    int const originalIndex = commonBaseIndex(originalBase);
+    int const newIndex = commonBaseIndex(newBase);
+    if (originalIndex < 0 || newIndex < 0)
+    {
+        return NULL;
+    }
+    return kernels[originalIndex][newIndex];
+}
+
+/**
+ * @brief Returns the index of the given base among the common bases.
+ * @param base The base.
+ * @return The index, or -1 if the base is not a common base.
+ */
+static int commonBaseIndex(int const base)
+{
+    switch (base)
+    {
+        case 2:
+            return 0;
+        case 8:
+            return 1;
+        case STANDARD_BASE:
+            return 2;
+        case 16:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Parses the given digits of a base which is a power of 2 into a big number, by placing
+ *        the bits of every digit. No multiplication is needed, so it takes O(n) time.
+ * @param base The base of the digits, a power of 2.
+ * @param digits The digits, the most significant first.
+ * @param length The number of digits.
+ * @param pResult The path to store the number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the digits were parsed, 1 if there is not enough memory.
+ */
+static int packDigits(int const base, char const * const digits, size_t const length,
+                      BigNumber * const pResult, ConverterArena * const pArena)
+{
+    size_t const digitBits = (size_t) __builtin_ctz((unsigned int) base);
+    if (allocateNumber(pResult, (length * digitBits + LIMB_BITS - 1) / LIMB_BITS, pArena))
+    {
+        return INVALID_STATE;
+    }
+
+    size_t bit = 0;
+    for (size_t i = length; i > 0; --i)
+    {
+        Limb const value = DIGIT_VALUES[(unsigned char) digits[i - 1]];
+        size_t const index = bit / LIMB_BITS;
+        size_t const offset = bit % LIMB_BITS;
+        pResult->limbs[index] |= value << offset;
+        if (offset + digitBits > LIMB_BITS)
+        {
+            // The digit crosses the border of two limbs.
+            pResult->limbs[index + 1] |= value >> (LIMB_BITS - offset);
+        }
+        bit += digitBits;
+    }
+    normalizeNumber(pResult);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Writes the given big number in a base which is a power of 2 as exactly the given
+ *        number of digits, by extracting the bits of every digit. No division is needed, so it
+ *        takes O(n) time.
+ * @param base The base of the digits, a power of 2.
+ * @param pNumber The number, it must be less than the base raised to the number of digits.
+ * @param digits The path to write the digits in, the most significant first.
+ * @param length The number of digits to write.
+ */
+static void unpackDigits(int const base, BigNumber const * const pNumber, char * const digits,
+                         size_t const length)
+{
+    size_t const digitBits = (size_t) __builtin_ctz((unsigned int) base);
+    Limb const mask = (Limb) base - 1;
+
+    size_t bit = 0;
+    for (size_t i = length; i > 0; --i)
+    {
+        size_t const index = bit / LIMB_BITS;
+        size_t const offset = bit % LIMB_BITS;
+        Limb value = 0;
+        if (index < pNumber->size)
+        {
+            value = pNumber->limbs[index] >> offset;
+            if (offset + digitBits > LIMB_BITS && index + 1 < pNumber->size)
+            {
+                // The digit crosses the border of two limbs.
+                value |= pNumber->limbs[index + 1] << (LIMB_BITS - offset);
+            }
+        }
+        digits[i - 1] = DIGIT_CHARACTERS[value & mask];
+        bit += digitBits;
+    }
+}
+
+/**
+ * @brief Parses the given digits into a single limb, it is inlined with a constant base for the
+ *        standard base.
+ * @param base The base of the digits.
+ * @param digits The digits, the most significant first.
+ * @param count The number of digits, at most the digits which fit in a single limb.
+ * @return The value of the digits.
+ */
+__attribute__((always_inline))
+static inline Limb parseChunk(int const base, char const * const digits, size_t const count)
+{
+    size_t scalarCount = count;
+#ifdef VECTOR_DIGITS
+    // The last digits of a small base are parsed 16 at a time, after the first ones.
+    int const vectorParse = (base <= MAX_VECTOR_BASE && count >= VECTOR_CHUNK_DIGITS && HAS_SSE2);
+    if (vectorParse)
+    {
+        scalarCount = count - VECTOR_CHUNK_DIGITS;
+    }
+#endif
+
+    Limb chunk = 0;
+    for (size_t i = 0; i < scalarCount; ++i)
+    {
+        chunk = chunk * (Limb) base + DIGIT_VALUES[(unsigned char) digits[i]];
+    }
+
+#ifdef VECTOR_DIGITS
+    if (vectorParse)
+    {
+        Limb const square = (Limb) base * (Limb) base;
+        Limb const fourth = square * square;
+        chunk = chunk * (fourth * fourth) * (fourth * fourth) +
+                parseDigitsSse2(base, digits + scalarCount);
+    }
+#endif
+    return chunk;
+}
+
+/**
+ * @brief Writes the given limb as exactly the given number of digits, it is inlined with a
+ *        constant base for the standard base.
+ * @param base The base of the digits.
+ * @param chunk The limb, it must be less than the base raised to the number of digits.
+ * @param digits The path to write the digits in, the most significant first.
+ * @param count The number of digits to write.
+ */
+__attribute__((always_inline))
+static inline void emitChunk(int const base, Limb chunk, char * const digits, size_t const count)
+{
+    for (size_t i = count; i > 0; --i)
+    {
+        digits[i - 1] = DIGIT_CHARACTERS[chunk % (Limb) base];
+        chunk /= (Limb) base;
+    }
+}
+
+
+/*----=  Big Base Conversion  =-----*/
+
+
+/**
+ * @brief Performs the base conversion of a number of any number of digits.
+ *        The digits are parsed into a big number, and the big number is written in the new base.
+ *        Explanation of the Algorithm:
+ *        Both directions split the number by a power of the base, B^(k * 2^i), where k is the
+ *        number of digits which fit in a single limb. Parsing splits the digits into a high part
+ *        and a low part of k * 2^i digits, parses both recursively and combines them as
+ *        high * B^(k * 2^i) + low. Writing divides the number by B^(k * 2^i) and writes the
+ *        quotient and the remainder recursively. The powers are squared from level to level, so
+ *        a table of about log(n) powers serves the whole number.
+ *        With Karatsuba's multiplication, and with divisions by the precomputed reciprocals of
+ *        the powers, every level of the recursion costs O(n^1.58), so the running time
+ *        complexity is O(n^1.58 log(n)) rather than the O(n^2) of converting digit by digit.
+ *        The largest products are computed by number theoretic transforms instead, which
+ *        brings every level of the recursion near O(n log(n)).
+ *        The two parts of every split are independent, so with a pool the high part of a long
+ *        number is converted by another thread, as are the transforms of the products. The
+ *        tables of the powers are computed in advance, so the threads only read them.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param digits The digits of the given number, the most significant first.
+ * @param length The number of digits.
+ * @param result The path to write the converted digits in, without leading zeros, if they fit.
+ * @param capacity The number of characters the result holds.
+ * @param pCount The path to store the number of converted digits in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was converted, 1 if there is not enough memory.
+ */
+static int bigBaseConverter(int const originalBase, int const newBase, char const * const digits,
+                            size_t const length, char * const result, size_t const capacity,
+                            size_t * const pCount, ConverterArena * const pArena)
+{
+    BigNumber number = {NULL, 0};
+    int state = parseNumber(originalBase, digits, length, &number, pArena);
+    if (state == VALID_STATE)
+    {
+        state = writeNumber(newBase, &number, result, capacity, pCount, pArena);
+    }
+    freeNumber(&number, pArena);
+    return state;
+}
+
+/**
+ * @brief Parses the given digits of any number of digits into a big number, by the powers of
+ *        the base which are computed for the digits.
+ * @param originalBase The base of the digits.
+ * @param digits The digits, the most significant first.
+ * @param length The number of digits.
+ * @param pNumber The path to store the number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the digits were parsed, 1 if there is not enough memory.
+ */
+static int parseNumber(int const originalBase, char const * const digits, size_t const length,
+                       BigNumber * const pNumber, ConverterArena * const pArena)
+{
+    RadixTable table;
+    createRadixTable(&table, originalBase);
+    int state = INVALID_STATE;
+    if (prepareRadixTable(&table, length, FALSE, pArena) == VALID_STATE)
+    {
+        state = digitsToNumber(&table, digits, length, pNumber, pArena);
+    }
+    freeRadixTable(&table, pArena);
+    return state;
+}
+
+/**
+ * @brief Writes the given big number in the given base, without leading zeros.
+ *        The number is written with a few leading zeros, which are dropped. It is written
+ *        straight to the result if the result holds them too.
+ * @param newBase The base to write the number in.
+ * @param pNumber The number.
+ * @param result The path to write the digits in, if they fit.
+ * @param capacity The number of characters the result holds.
+ * @param pCount The path to store the number of digits in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was written, 1 if there is not enough memory.
+ */
+static int writeNumber(int const newBase, BigNumber const * const pNumber, char * const result,
+                       size_t const capacity, size_t * const pCount,
+                       ConverterArena * const pArena)
+{
+    RadixTable newTable;
+    createRadixTable(&newTable, newBase);
+    int state = VALID_STATE;
+    size_t const resultLength = digitsBound(&newTable, pNumber);
+    char * const written = (capacity >= resultLength) ? result :
+                           arenaAllocate(pArena, resultLength);
+    if (written != NULL &&
+        prepareRadixTable(&newTable, resultLength, TRUE, pArena) == VALID_STATE &&
+        numberToDigits(&newTable, pNumber, written, resultLength, pArena) == VALID_STATE)
+    {
+        size_t zeros = 0;
+        while (zeros < resultLength - 1 && written[zeros] == '0')
+        {
+            zeros++;
+        }
+        *pCount = resultLength - zeros;
+        if (*pCount <= capacity)
+        {
+            memmove(result, written + zeros, *pCount);
+        }
+    }
+    else
+    {
+        state = INVALID_STATE;
+    }
+    if (written != result)
+    {
+        arenaRelease(pArena, written);
+    }
+    freeRadixTable(&newTable, pArena);
+    return state;
+}
+
+/**
+ * @brief Parses the given digits into a big number, by splitting them by a power of the base.
+ * @param pTable The powers of the base of the digits, prepared for the digits.
+ * @param digits The digits, the most significant first.
+ * @param length The number of digits.
+ * @param pResult The path to store the number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the digits were parsed, 1 if there is not enough memory.
+ */
+static int digitsToNumber(RadixTable const * const pTable, char const * const digits,
+                          size_t const length, BigNumber * const pResult,
+                          ConverterArena * const pArena)
+{
+    // The digits of a power of 2 hold whole bits, which are placed without multiplications.
+    if ((pTable->base & (pTable->base - 1)) == 0)
+    {
+        return packDigits(pTable->base, digits, length, pResult, pArena);
+    }
+
+    size_t const chunkDigits = pTable->chunkDigits;
+    size_t const chunks = (length + chunkDigits - 1) / chunkDigits;
+
+    // A short number is accumulated a chunk of digits at a time, as in Horner's method.
+    if (chunks <= HORNER_THRESHOLD)
+    {
+        if (allocateNumber(pResult, chunks, pArena))
+        {
+            return INVALID_STATE;
+        }
+        size_t index = 0;
+        size_t size = 0;
+        while (index < length)
+        {
+            size_t const count = (index == 0) ? length - (chunks - 1) * chunkDigits : chunkDigits;
+            Limb const chunk = (pTable->base == STANDARD_BASE) ?
+                               parseChunk(STANDARD_BASE, digits + index, count) :
+                               parseChunk(pTable->base, digits + index, count);
+            index += count;
+            Limb const carry = multiplyAddLimb(pResult->limbs, size, pTable->chunkPower, chunk);
+            if (carry != 0)
+            {
+                pResult->limbs[size++] = carry;
+            }
+        }
+        pResult->size = size;
+        normalizeNumber(pResult);
+        return VALID_STATE;
+    }
+
+    // A long number is split into a high part and a low part of k * 2^i digits, the high part
+    // of a long enough number is parsed by another thread.
+    size_t const level = splitLevel(pTable, length);
+    size_t const lowLength = chunkDigits << level;
+    ThreadPool * const pSplitPool = (chunks >= PARALLEL_THRESHOLD) ? arenaPool(pArena) : NULL;
+    ParseTask high = {pTable, digits, length - lowLength, {NULL, 0}, pArena, INVALID_STATE};
+    ParallelTask task;
+    startTask(pSplitPool, &task, parseTask, &high);
+    BigNumber low = {NULL, 0};
+    BigNumber product = {NULL, 0};
+    int state = digitsToNumber(pTable, digits + length - lowLength, lowLength, &low, pArena);
+    finishTask(pSplitPool, &task);
+
+    if (state == VALID_STATE && high.state == VALID_STATE &&
+        multiplyNumbers(&high.number, &pTable->powers[level], &product, pArena) == VALID_STATE)
+    {
+        state = addNumbers(&product, &low, pResult, pArena);
+    }
+    else
+    {
+        state = INVALID_STATE;
+    }
+
+    freeNumber(&high.number, pArena);
+    freeNumber(&low, pArena);
+    freeNumber(&product, pArena);
+    return state;
+}
+
+/**
+ * @brief Writes the given big number as exactly the given number of digits, padded with zeros,
+ *        by splitting it by a power of the base.
+ * @param pTable The powers of the base of the digits, prepared for the digits.
+ * @param pNumber The number, it must be less than the base raised to the number of digits.
+ * @param digits The path to write the digits in, the most significant first.
+ * @param length The number of digits to write.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was written, 1 if there is not enough memory.
+ */
+static int numberToDigits(RadixTable const * const pTable, BigNumber const * const pNumber,
+                          char * const digits, size_t const length,
+                          ConverterArena * const pArena)
+{
+    // The digits of a power of 2 hold whole bits, which are extracted without divisions.
+    if ((pTable->base & (pTable->base - 1)) == 0)
+    {
+        unpackDigits(pTable->base, pNumber, digits, length);
+        return VALID_STATE;
+    }
+
+    // A short number is divided by a single limb, emitting a chunk of digits at a time.
+    if (pNumber->size <= DIVISION_THRESHOLD)
+    {
+        Limb remaining[DIVISION_THRESHOLD];
+        size_t size = pNumber->size;
+        memcpy(remaining, pNumber->limbs, size * sizeof(Limb));
+
+        size_t index = length;
+        while (size > 0)
+        {
+            Limb const chunk = divideLimb(remaining, size, pTable->chunkPower);
+            while (size > 0 && remaining[size - 1] == 0)
+            {
+                size--;
+            }
+            size_t const count = (index < pTable->chunkDigits) ? index : pTable->chunkDigits;
+            index -= count;
+            if (pTable->base == STANDARD_BASE)
+            {
+                emitChunk(STANDARD_BASE, chunk, digits + index, count);
+            }
+            else
+            {
+                emitChunk(pTable->base, chunk, digits + index, count);
+            }
+        }
+        memset(digits, '0', index);
+        return VALID_STATE;
+    }
+
+    // A long number is split into a quotient and a remainder of k * 2^i digits, the quotient
+    // of a long enough number is written by another thread.
+    size_t const level = splitLevel(pTable, length);
+    size_t const lowLength = pTable->chunkDigits << level;
+    BigNumber quotient = {NULL, 0};
+    BigNumber remainder = {NULL, 0};
+    int state = dividePower(pTable, level, pNumber, &quotient, &remainder, pArena);
+    if (state == VALID_STATE)
+    {
+        ThreadPool * const pSplitPool = (pNumber->size >= PARALLEL_THRESHOLD) ?
+                                        arenaPool(pArena) : NULL;
+        WriteTask high = {pTable, &quotient, digits, length - lowLength, pArena, INVALID_STATE};
+        ParallelTask task;
+        startTask(pSplitPool, &task, writeTask, &high);
+        state = numberToDigits(pTable, &remainder, digits + length - lowLength, lowLength,
+                               pArena);
+        finishTask(pSplitPool, &task);
+        if (high.state != VALID_STATE)
+        {
+            state = INVALID_STATE;
+        }
+    }
+
+    freeNumber(&quotient, pArena);
+    freeNumber(&remainder, pArena);
+    return state;
+}
+
+/**
+ * @brief The body of a task parsing a part of the digits of a number.
+ * @param pTask The ParseTask.
+ * @return NULL.
+ */
+static void * parseTask(void * pTask)
+{
+    ParseTask * const pThis = pTask;
+    pThis->state = digitsToNumber(pThis->pTable, pThis->digits, pThis->length, &pThis->number,
+                                  pThis->pArena);
+    return NULL;
+}
+
+/**
+ * @brief The body of a task writing a part of the digits of a number.
+ * @param pTask The WriteTask.
+ * @return NULL.
+ */
+static void * writeTask(void * pTask)
+{
+    WriteTask * const pThis = pTask;
+    pThis->state = numberToDigits(pThis->pTable, pThis->pNumber, pThis->digits, pThis->length,
+                                  pThis->pArena);
+    return NULL;
+}
+
+/**
+ * @brief Returns the number of digits which is enough for writing the given big number.
+ * @param pTable The powers of the base of the digits.
+ * @param pNumber The number.
+ * @return The number of digits, it may exceed the actual number of digits by a few.
+ */
+static size_t digitsBound(RadixTable const * const pTable, BigNumber const * const pNumber)
+{
+    if (pNumber->size == 0)
+    {
+        return 1;
+    }
+
+    // A chunk of digits holds at least as many bits as the power of 2 below its power.
+    size_t const bits = pNumber->size * LIMB_BITS -
+                        (size_t) __builtin_clzll(pNumber->limbs[pNumber->size - 1]);
+    size_t const chunkBits = LIMB_BITS - 1 - (size_t) __builtin_clzll(pTable->chunkPower);
+    return (bits + chunkBits - 1) / chunkBits * pTable->chunkDigits;
+}
+
+
+/*----=  Radix Tables  =-----*/
+
+
+/**
+ * @brief Initializes the table of the powers of the given base.
+ * @param pTable The table to initialize.
+ * @param base The base.
+ */
+static void createRadixTable(RadixTable * const pTable, int const base)
+{
+    memset(pTable, 0, sizeof(RadixTable));
+    pTable->base = base;
+    pTable->chunkDigits = CHUNK_DIGITS[base];
+    pTable->chunkPower = CHUNK_POWERS[base];
+}
+
+/**
+ * @brief Computes the powers of the table which split a number of the given number of digits,
+ *        and their reciprocals if needed. The digits of a power of 2 need no powers.
+ * @param pTable The table of the powers.
+ * @param length The number of digits.
+ * @param reciprocals Non zero for computing the reciprocals of the powers as well.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the powers were computed, 1 if there is not enough memory.
+ */
+static int prepareRadixTable(RadixTable * const pTable, size_t const length, int const reciprocals,
+                             ConverterArena * const pArena)
+{
+    if ((pTable->base & (pTable->base - 1)) == 0 || length <= pTable->chunkDigits)
+    {
+        return VALID_STATE;
+    }
+
+    size_t const level = splitLevel(pTable, length);
+    if (pTable->levels == 0)
+    {
+        if (allocateNumber(&pTable->powers[0], 1, pArena))
+        {
+            return INVALID_STATE;
+        }
+        pTable->powers[0].limbs[0] = pTable->chunkPower;
+        pTable->levels = 1;
+    }
+
+    // Every power is the square of the previous one.
+    while (pTable->levels <= level)
+    {
+        BigNumber const * const pPrevious = &pTable->powers[pTable->levels - 1];
+        if (multiplyNumbers(pPrevious, pPrevious, &pTable->powers[pTable->levels], pArena))
+        {
+            return INVALID_STATE;
+        }
+        pTable->levels++;
+    }
+
+    for (size_t i = 0; reciprocals && i <= level; ++i)
+    {
+        if (pTable->reciprocals[i].size == 0 &&
+            computeReciprocal(&pTable->powers[i], &pTable->reciprocals[i], pArena))
+        {
+            return INVALID_STATE;
+        }
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief Returns the level of the largest power of the table which has less digits than the
+ *        given number of digits.
+ * @param pTable The table of the powers.
+ * @param length The number of digits, it must be more than the digits of a single limb.
+ * @return The level of the power.
+ */
+static size_t splitLevel(RadixTable const * const pTable, size_t const length)
+{
+    size_t level = 0;
+    while ((pTable->chunkDigits << (level + 1)) < length)
+    {
+        level++;
+    }
+    return level;
+}
+
+/**
+ * @brief Releases the powers of the given table.
+ * @param pTable The table to release.
+ * @param pArena The Arena of the conversion, or NULL.
+ */
+static void freeRadixTable(RadixTable * const pTable, ConverterArena * const pArena)
+{
+    for (size_t i = 0; i < MAX_POWER_LEVELS; ++i)
+    {
+        freeNumber(&pTable->powers[i], pArena);
+        freeNumber(&pTable->reciprocals[i], pArena);
+    }
+    pTable->levels = 0;
+}
+
+
+/*----=  Division  =-----*/
+
+
+/**
+ * @brief Divides the given big number by a power of the table, using the reciprocal of the power
+ *        as in Barrett's reduction.
+ *        For a divisor d of m limbs and its reciprocal mu = floor(2^(2 * m * 64) / d), the
+ *        estimate q = ((n >> (m - 1) limbs) * mu) >> (m + 1) limbs is at most 2 less than the
+ *        quotient of any n < d^2, so the remainder n - q * d is corrected by at most 2
+ *        subtractions.
+ * @param pTable The table of the powers.
+ * @param level The level of the divisor power, it and its reciprocal must be computed.
+ * @param pNumber The number to divide, it must be less than the square of the power.
+ * @param pQuotient The path to store the quotient in.
+ * @param pRemainder The path to store the remainder in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was divided, 1 if there is not enough memory.
+ */
+static int dividePower(RadixTable const * const pTable, size_t const level,
+                       BigNumber const * const pNumber, BigNumber * const pQuotient,
+                       BigNumber * const pRemainder, ConverterArena * const pArena)
+{
+    BigNumber const * const pDivisor = &pTable->powers[level];
+    BigNumber const * const pReciprocal = &pTable->reciprocals[level];
+
+    long const divisorSize = (long) pDivisor->size;
+    BigNumber high = {NULL, 0};
+    BigNumber estimate = {NULL, 0};
+    BigNumber product = {NULL, 0};
+    int state = INVALID_STATE;
+    if (shiftNumber(pNumber, 1 - divisorSize, &high, pArena) == VALID_STATE &&
+        multiplyNumbers(&high, pReciprocal, &estimate, pArena) == VALID_STATE &&
+        shiftNumber(&estimate, -divisorSize - 1, pQuotient, pArena) == VALID_STATE &&
+        multiplyNumbers(pQuotient, pDivisor, &product, pArena) == VALID_STATE &&
+        shiftNumber(pNumber, 0, pRemainder, pArena) == VALID_STATE)
+    {
+        subtractNumber(pRemainder, &product);
+        Limb one = 1;
+        BigNumber const unit = {&one, 1};
+        state = VALID_STATE;
+        while (state == VALID_STATE && compareNumbers(pRemainder, pDivisor) >= 0)
+        {
+            subtractNumber(pRemainder, pDivisor);
+            BigNumber const previous = *pQuotient;
+            state = addNumbers(&previous, &unit, pQuotient, pArena);
+            arenaRelease(pArena, previous.limbs);
+        }
+    }
+
+    freeNumber(&high, pArena);
+    freeNumber(&estimate, pArena);
+    freeNumber(&product, pArena);
+    return state;
+}
+
+/**
+ * @brief Computes the reciprocal of the given big number of m limbs, that is the quotient of
+ *        2^(2 * m * LIMB_BITS) by the number, using Newton's method.
+ *        The reciprocal of the h most significant limbs of the number, computed recursively for
+ *        h a little more than m / 2, approximates the reciprocal to about h limbs. A single
+ *        Newton step doubles the precision, and the few units it is off by are corrected at the
+ *        end.
+ * @param pDivisor The number.
+ * @param pResult The path to store the reciprocal in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the reciprocal was computed, 1 if there is not enough memory.
+ */
+static int computeReciprocal(BigNumber const * const pDivisor, BigNumber * const pResult,
+                             ConverterArena * const pArena)
+{
+    size_t const size = pDivisor->size;
+    if (size <= RECIPROCAL_THRESHOLD)
+    {
+        return computeSmallReciprocal(pDivisor, pResult, pArena);
+    }
+
+    // The two extra limbs keep the error of the approximation below a unit.
+    size_t const highSize = (size + 5) / 2;
+    BigNumber const high = {pDivisor->limbs + size - highSize, highSize};
+    BigNumber highReciprocal = {NULL, 0};
+    BigNumber approximation = {NULL, 0};
+    int state = INVALID_STATE;
+    if (computeReciprocal(&high, &highReciprocal, pArena) == VALID_STATE &&
+        shiftNumber(&highReciprocal, (long) (size - highSize), &approximation,
+                    pArena) == VALID_STATE &&
+        newtonStep(pDivisor, &approximation, pResult, pArena) == VALID_STATE)
+    {
+        state = correctReciprocal(pDivisor, pResult, pArena);
+    }
+
+    freeNumber(&highReciprocal, pArena);
+    freeNumber(&approximation, pArena);
+    if (state != VALID_STATE)
+    {
+        freeNumber(pResult, pArena);
+    }
+    return state;
+}
+
+/**
+ * @brief Improves the given approximation of a reciprocal by a single step of Newton's method,
+ *        x + x * (2^(2 * m * 64) - d * x) / 2^(2 * m * 64), where the error d * x - 2^(2 * m * 64)
+ *        may be of either sign.
+ * @param pDivisor The number of m limbs whose reciprocal is approximated.
+ * @param pApproximation The approximation of the reciprocal.
+ * @param pResult The path to store the improved approximation in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the approximation was improved, 1 if there is not enough memory.
+ */
+static int newtonStep(BigNumber const * const pDivisor, BigNumber * const pApproximation,
+                      BigNumber * const pResult, ConverterArena * const pArena)
+{
+    long const numeratorShift = (long) (2 * pDivisor->size);
+    Limb one = 1;
+    BigNumber const unit = {&one, 1};
+    BigNumber numerator = {NULL, 0};
+    BigNumber product = {NULL, 0};
+    BigNumber error = {NULL, 0};
+    BigNumber scaledError = {NULL, 0};
+    BigNumber correction = {NULL, 0};
+    int state = INVALID_STATE;
+    if (shiftNumber(&unit, numeratorShift, &numerator, pArena) != VALID_STATE ||
+        multiplyNumbers(pDivisor, pApproximation, &product, pArena) != VALID_STATE)
+    {
+        freeNumber(&numerator, pArena);
+        freeNumber(&product, pArena);
+        return state;
+    }
+
+    int const excess = compareNumbers(&product, &numerator) > 0;
+    if (shiftNumber(excess ? &product : &numerator, 0, &error, pArena) == VALID_STATE)
+    {
+        subtractNumber(&error, excess ? &numerator : &product);
+        if (multiplyNumbers(pApproximation, &error, &scaledError, pArena) == VALID_STATE &&
+            shiftNumber(&scaledError, -numeratorShift, &correction, pArena) == VALID_STATE)
+        {
+            if (excess)
+            {
+                subtractNumber(pApproximation, &correction);
+                state = shiftNumber(pApproximation, 0, pResult, pArena);
+            }
+            else
+            {
+                state = addNumbers(pApproximation, &correction, pResult, pArena);
+            }
+        }
+    }
+
+    freeNumber(&numerator, pArena);
+    freeNumber(&product, pArena);
+    freeNumber(&error, pArena);
+    freeNumber(&scaledError, pArena);
+    freeNumber(&correction, pArena);
+    return state;
+}
+
+/**
+ * @brief Corrects the given approximation of a reciprocal to the exact reciprocal, so the
+ *        remainder 2^(2 * m * 64) - d * x is in [0, d).
+ * @param pDivisor The number of m limbs whose reciprocal is approximated.
+ * @param pReciprocal The approximation of the reciprocal, which is corrected in place.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the approximation was corrected, 1 if there is not enough memory.
+ */
+static int correctReciprocal(BigNumber const * const pDivisor, BigNumber * const pReciprocal,
+                             ConverterArena * const pArena)
+{
+    Limb one = 1;
+    BigNumber const unit = {&one, 1};
+    BigNumber numerator = {NULL, 0};
+    BigNumber product = {NULL, 0};
+    if (shiftNumber(&unit, (long) (2 * pDivisor->size), &numerator, pArena) != VALID_STATE ||
+        multiplyNumbers(pDivisor, pReciprocal, &product, pArena) != VALID_STATE)
+    {
+        freeNumber(&numerator, pArena);
+        freeNumber(&product, pArena);
+        return INVALID_STATE;
+    }
+
+    while (compareNumbers(&product, &numerator) > 0)
+    {
+        subtractNumber(pReciprocal, &unit);
+        subtractNumber(&product, pDivisor);
+    }
+    subtractNumber(&numerator, &product);
+
+    int state = VALID_STATE;
+    while (state == VALID_STATE && compareNumbers(&numerator, pDivisor) >= 0)
+    {
+        subtractNumber(&numerator, pDivisor);
+        BigNumber const previous = *pReciprocal;
+        state = addNumbers(&previous, &unit, pReciprocal, pArena);
+        arenaRelease(pArena, previous.limbs);
+    }
+
+    freeNumber(&numerator, pArena);
+    freeNumber(&product, pArena);
+    return state;
+}
+
+/**
+ * @brief Computes the reciprocal of a small big number bit by bit, as in long division.
+ * @param pDivisor The number.
+ * @param pResult The path to store the reciprocal in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the reciprocal was computed, 1 if there is not enough memory.
+ */
+static int computeSmallReciprocal(BigNumber const * const pDivisor, BigNumber * const pResult,
+                                  ConverterArena * const pArena)
+{
+    size_t const size = pDivisor->size;
+    Limb remainder[RECIPROCAL_THRESHOLD + 1] = {0};
+    if (allocateNumber(pResult, size + 2, pArena))
+    {
+        return INVALID_STATE;
+    }
+
+    // The numerator is a single bit followed by 2 * m * 64 zeros, which is where its quotient
+    // starts. The remainder is less than twice the divisor, so it has m + 1 limbs.
+    for (size_t bit = 2 * size * LIMB_BITS + 1; bit-- > 0; )
+    {
+        Limb carry = (bit == 2 * size * LIMB_BITS);
+        for (size_t i = 0; i <= size; ++i)
+        {
+            Limb const next = remainder[i] >> (LIMB_BITS - 1);
+            remainder[i] = (remainder[i] << 1) | carry;
+            carry = next;
+        }
+
+        BigNumber const current = {remainder, size + 1};
+        BigNumber normalized = current;
+        normalizeNumber(&normalized);
+        if (compareNumbers(&normalized, pDivisor) >= 0)
+        {
+            subtractLimbs(remainder, remainder, size + 1, pDivisor->limbs, size);
+            pResult->limbs[bit / LIMB_BITS] |= (Limb) 1 << (bit % LIMB_BITS);
+        }
+    }
+    normalizeNumber(pResult);
+    return VALID_STATE;
+}
+
+
+/*----=  Big Numbers  =-----*/
+
+
+/**
+ * @brief Allocates the limbs of the given big number, all of them 0.
+ * @param pNumber The number.
+ * @param size The number of limbs.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the limbs were allocated, 1 if there is not enough memory.
+ */
+static int allocateNumber(BigNumber * const pNumber, size_t const size,
+                          ConverterArena * const pArena)
+{
+    size_t const bytes = (size > 0 ? size : 1) * sizeof(Limb);
+    pNumber->limbs = arenaAllocate(pArena, bytes);
+    pNumber->size = size;
+    if (pNumber->limbs == NULL)
+    {
+        return INVALID_STATE;
+    }
+    memset(pNumber->limbs, 0, bytes);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Releases the limbs of the given big number, and sets it to 0.
+ * @param pNumber The number.
+ * @param pArena The Arena of the conversion, or NULL.
+ */
+static void freeNumber(BigNumber * const pNumber, ConverterArena * const pArena)
+{
+    arenaRelease(pArena, pNumber->limbs);
+    pNumber->limbs = NULL;
+    pNumber->size = 0;
+}
+
+/**
+ * @brief Drops the most significant limbs of the given big number which are 0.
+ * @param pNumber The number.
+ */
+static void normalizeNumber(BigNumber * const pNumber)
+{
+    while (pNumber->size > 0 && pNumber->limbs[pNumber->size - 1] == 0)
+    {
+        pNumber->size--;
+    }
+}
+
+/**
+ * @brief Compares the given big numbers.
+ * @param pFirst The first number.
+ * @param pSecond The second number.
+ * @return A negative value if the first number is less than the second one, 0 if they are equal
+ *         and a positive value otherwise.
+ */
+static int compareNumbers(BigNumber const * const pFirst, BigNumber const * const pSecond)
+{
+    if (pFirst->size != pSecond->size)
+    {
+        return (pFirst->size < pSecond->size) ? -1 : 1;
+    }
+    for (size_t i = pFirst->size; i-- > 0; )
+    {
+        if (pFirst->limbs[i] != pSecond->limbs[i])
+        {
+            return (pFirst->limbs[i] < pSecond->limbs[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Adds the given big numbers.
+ * @param pFirst The first number.
+ * @param pSecond The second number.
+ * @param pResult The path to store the sum in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the numbers were added, 1 if there is not enough memory.
+ */
+static int addNumbers(BigNumber const * const pFirst, BigNumber const * const pSecond,
+                      BigNumber * const pResult, ConverterArena * const pArena)
+{
+    BigNumber const * const pLong = (pFirst->size >= pSecond->size) ? pFirst : pSecond;
+    BigNumber const * const pShort = (pFirst->size >= pSecond->size) ? pSecond : pFirst;
+    if (allocateNumber(pResult, pLong->size + 1, pArena))
+    {
+        return INVALID_STATE;
+    }
+    pResult->limbs[pLong->size] = addLimbs(pResult->limbs, pLong->limbs, pLong->size,
+                                           pShort->limbs, pShort->size);
+    normalizeNumber(pResult);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Subtracts the second big number from the first one, in place.
+ * @param pFirst The first number, it must not be less than the second one.
+ * @param pSecond The second number.
+ */
+static void subtractNumber(BigNumber * const pFirst, BigNumber const * const pSecond)
+{
+    subtractLimbs(pFirst->limbs, pFirst->limbs, pFirst->size, pSecond->limbs, pSecond->size);
+    normalizeNumber(pFirst);
+}
+
+/**
+ * @brief Multiplies the given big numbers, long numbers by number theoretic transforms.
+ * @param pFirst The first number.
+ * @param pSecond The second number.
+ * @param pResult The path to store the product in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the numbers were multiplied, 1 if there is not enough memory.
+ */
+static int multiplyNumbers(BigNumber const * const pFirst, BigNumber const * const pSecond,
+                           BigNumber * const pResult, ConverterArena * const pArena)
+{
+    BigNumber const * const pLong = (pFirst->size >= pSecond->size) ? pFirst : pSecond;
+    BigNumber const * const pShort = (pFirst->size >= pSecond->size) ? pSecond : pFirst;
+    if (allocateNumber(pResult, pLong->size + pShort->size, pArena))
+    {
+        return INVALID_STATE;
+    }
+    if (pShort->size == 0)
+    {
+        pResult->size = 0;
+        return VALID_STATE;
+    }
+
+    if (pShort->size >= TRANSFORM_THRESHOLD)
+    {
+        if (transformMultiply(pResult->limbs, pLong->limbs, pLong->size, pShort->limbs,
+                              pShort->size, pArena))
+        {
+            freeNumber(pResult, pArena);
+            return INVALID_STATE;
+        }
+        normalizeNumber(pResult);
+        return VALID_STATE;
+    }
+
+    Limb * scratch = NULL;
+    if (pShort->size >= KARATSUBA_THRESHOLD)
+    {
+        scratch = arenaAllocate(pArena, MULTIPLY_SCRATCH_FACTOR * (pLong->size + pShort->size) *
+                                        sizeof(Limb));
+        if (scratch == NULL)
+        {
+            freeNumber(pResult, pArena);
+            return INVALID_STATE;
+        }
+    }
+    multiplyLimbs(pResult->limbs, pLong->limbs, pLong->size, pShort->limbs, pShort->size,
+                  scratch);
+    arenaRelease(pArena, scratch);
+    normalizeNumber(pResult);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Shifts the given big number by whole limbs.
+ * @param pNumber The number.
+ * @param shift The number of limbs to shift by, a positive shift multiplies the number and a
+ *        negative shift divides it.
+ * @param pResult The path to store the shifted number in.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the number was shifted, 1 if there is not enough memory.
+ */
+static int shiftNumber(BigNumber const * const pNumber, long const shift,
+                       BigNumber * const pResult, ConverterArena * const pArena)
+{
+    if (shift < 0 && (size_t) -shift >= pNumber->size)
+    {
+        return allocateNumber(pResult, 0, pArena);
+    }
+
+    size_t const size = (size_t) ((long) pNumber->size + shift);
+    if (allocateNumber(pResult, size, pArena))
+    {
+        return INVALID_STATE;
+    }
+    if (shift >= 0)
+    {
+        memcpy(pResult->limbs + shift, pNumber->limbs, pNumber->size * sizeof(Limb));
+    }
+    else
+    {
+        memcpy(pResult->limbs, pNumber->limbs - shift, size * sizeof(Limb));
+    }
+    return VALID_STATE;
+}
+
+
+/*----=  Limbs  =-----*/
+
+
+/**
+ * @brief Adds the given limbs to the given limbs of at least the same length.
+ * @param result The path to store the sum in, it has as many limbs as the first operand and may
+ *        be the first operand.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand, at most firstSize.
+ * @return The carry out of the most significant limb.
+ */
+static Limb addLimbs(Limb * const result, Limb const * const first, size_t const firstSize,
+                     Limb const * const second, size_t const secondSize)
+{
+    Limb carry = 0;
+    size_t i = 0;
+    for ( ; i < secondSize; ++i)
+    {
+        Limb const sum = first[i] + carry;
+        carry = (sum < carry);
+        result[i] = sum + second[i];
+        carry += (result[i] < sum);
+    }
+    for ( ; i < firstSize; ++i)
+    {
+        result[i] = first[i] + carry;
+        carry = (result[i] < carry);
+    }
+    return carry;
+}
+
+/**
+ * @brief Subtracts the given limbs from the given limbs of at least the same length.
+ * @param result The path to store the difference in, it has as many limbs as the first operand
+ *        and may be the first operand.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand, at most firstSize.
+ * @return The borrow out of the most significant limb.
+ */
+static Limb subtractLimbs(Limb * const result, Limb const * const first, size_t const firstSize,
+                          Limb const * const second, size_t const secondSize)
+{
+    Limb borrow = 0;
+    size_t i = 0;
+    for ( ; i < secondSize; ++i)
+    {
+        Limb const subtrahend = second[i] + borrow;
+        borrow = (subtrahend < borrow) || (first[i] < subtrahend);
+        result[i] = first[i] - subtrahend;
+    }
+    for ( ; i < firstSize; ++i)
+    {
+        Limb const difference = first[i] - borrow;
+        borrow = (first[i] < borrow);
+        result[i] = difference;
+    }
+    return borrow;
+}
+
+/**
+ * @brief Multiplies the given limbs, by Karatsuba's method if they are long enough.
+ *        Karatsuba's method splits both operands at h limbs, a = a1 * B^h + a0 and
+ *        b = b1 * B^h + b0, and computes the product with three products of half the length:
+ *        a0 * b0, a1 * b1 and (a0 + a1) * (b0 + b1), which adds the middle terms to both.
+ *        An operand much shorter than the other is multiplied by slices of the other instead.
+ * @param result The path to store the product in, of firstSize + secondSize limbs.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand, at least 1 and at most firstSize.
+ * @param scratch Scratch limbs, MULTIPLY_SCRATCH_FACTOR per limb of the operands.
+ */
+static void multiplyLimbs(Limb * const result, Limb const * const first, size_t const firstSize,
+                          Limb const * const second, size_t const secondSize, Limb * const scratch)
+{
+    if (secondSize < KARATSUBA_THRESHOLD)
+    {
+        schoolbookMultiply(result, first, firstSize, second, secondSize);
+        return;
+    }
+
+    size_t const half = (firstSize + 1) / 2;
+    if (secondSize <= half)
+    {
+        // Multiply slices of the longer operand and add them in place.
+        memset(result, 0, (firstSize + secondSize) * sizeof(Limb));
+        for (size_t offset = 0; offset < firstSize; offset += secondSize)
+        {
+            size_t const slice = (firstSize - offset < secondSize) ? firstSize - offset :
+                                                                     secondSize;
+            Limb * const product = scratch;
+            if (slice >= secondSize)
+            {
+                multiplyLimbs(product, first + offset, slice, second, secondSize,
+                              scratch + slice + secondSize);
+            }
+            else
+            {
+                multiplyLimbs(product, second, secondSize, first + offset, slice,
+                              scratch + slice + secondSize);
+            }
+            addLimbs(result + offset, result + offset, firstSize + secondSize - offset, product,
+                     slice + secondSize);
+        }
+        return;
+    }
+
+    // The low and high products are stored in place, the middle one in the scratch.
+    Limb * const firstSum = scratch;
+    Limb * const secondSum = scratch + half + 1;
+    Limb * const middle = scratch + 2 * (half + 1);
+    size_t const middleSize = 2 * (half + 1);
+    multiplyLimbs(result, first, half, second, half, scratch);
+    multiplyLimbs(result + 2 * half, first + half, firstSize - half, second + half,
+                  secondSize - half, scratch);
+    firstSum[half] = addLimbs(firstSum, first, half, first + half, firstSize - half);
+    secondSum[half] = addLimbs(secondSum, second, half, second + half, secondSize - half);
+    multiplyLimbs(middle, firstSum, half + 1, secondSum, half + 1, middle + middleSize);
+    subtractLimbs(middle, middle, middleSize, result, 2 * half);
+    subtractLimbs(middle, middle, middleSize, result + 2 * half,
+                  firstSize + secondSize - 2 * half);
+
+    // The middle product fits in the limbs above the low half.
+    size_t significant = middleSize;
+    while (significant > 0 && middle[significant - 1] == 0)
+    {
+        significant--;
+    }
+    addLimbs(result + half, result + half, firstSize + secondSize - half, middle, significant);
+}
+
+/**
+ * @brief Multiplies the given limbs limb by limb.
+ * @param result The path to store the product in, of firstSize + secondSize limbs.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand.
+ */
+static void schoolbookMultiply(Limb * const result, Limb const * const first,
+                               size_t const firstSize, Limb const * const second,
+                               size_t const secondSize)
+{
+    memset(result, 0, (firstSize + secondSize) * sizeof(Limb));
+    for (size_t i = 0; i < secondSize; ++i)
+    {
+        Limb carry = 0;
+        for (size_t j = 0; j < firstSize; ++j)
+        {
+            DoubleLimb const product = (DoubleLimb) first[j] * second[i] + result[i + j] + carry;
+            result[i + j] = (Limb) product;
+            carry = (Limb) (product >> LIMB_BITS);
+        }
+        result[i + firstSize] = carry;
+    }
+}
+
+/**
+ * @brief Multiplies the given limbs by a single limb and adds a single limb, in place.
+ * @param limbs The limbs.
+ * @param size The number of limbs.
+ * @param multiplier The limb to multiply by.
+ * @param addend The limb to add.
+ * @return The carry out of the most significant limb.
+ */
+static Limb multiplyAddLimb(Limb * const limbs, size_t const size, Limb const multiplier,
+                            Limb const addend)
+{
+    Limb carry = addend;
+    for (size_t i = 0; i < size; ++i)
+    {
+        DoubleLimb const product = (DoubleLimb) limbs[i] * multiplier + carry;
+        limbs[i] = (Limb) product;
+        carry = (Limb) (product >> LIMB_BITS);
+    }
+    return carry;
+}
+
+/**
+ * @brief Divides the given limbs by a single limb, in place.
+ * @param limbs The limbs.
+ * @param size The number of limbs.
+ * @param divisor The limb to divide by.
+ * @return The remainder.
+ */
+static Limb divideLimb(Limb * const limbs, size_t const size, Limb const divisor)
+{
+    Limb remainder = 0;
+    for (size_t i = size; i-- > 0; )
+    {
+        DoubleLimb const dividend = ((DoubleLimb) remainder << LIMB_BITS) | limbs[i];
+        limbs[i] = (Limb) (dividend / divisor);
+        remainder = (Limb) (dividend % divisor);
+    }
+    return remainder;
+}
+
+
+/*----=  Transform Multiplication  =-----*/
+
+
+/**
+ * @brief The primes the number theoretic transforms are taken modulo, both are c * 2^k + 1 for
+ *        a large k, so they have roots of unity of every power of 2 size up to 2^55.
+ */
+static Limb const TRANSFORM_MODULI[TRANSFORM_PRIMES] = {
+    4179340454199820289ULL, 2485986994308513793ULL
+};
+
+/**
+ * @brief Generators of the multiplicative groups modulo the primes.
+ */
+static Limb const TRANSFORM_GENERATORS[TRANSFORM_PRIMES] = {3, 5};
+
+/**
+ * @brief Multiplies the given limbs by number theoretic transforms modulo two primes.
+ *        Every limb is split into two pieces of 32 bits, so every coefficient of the product
+ *        of the pieces is less than 2^95, below the product of the primes. The coefficients are
+ *        computed modulo each prime by transforms of a power of 2 size, in O(n log(n)), and are
+ *        recovered from both residues by the Chinese remainder theorem.
+ *        The two primes, the transforms of the two operands and the halves of every transform
+ *        are tasks of the pool.
+ * @param result The path to store the product in, of firstSize + secondSize limbs.
+ * @param first The first operand.
+ * @param firstSize The number of limbs in the first operand.
+ * @param second The second operand.
+ * @param secondSize The number of limbs in the second operand.
+ * @param pArena The Arena of the conversion, or NULL.
+ * @return 0 if the limbs were multiplied, 1 if there is not enough memory.
+ */
+static int transformMultiply(Limb * const result, Limb const * const first, size_t const firstSize,
+                             Limb const * const second, size_t const secondSize,
+                             ConverterArena * const pArena)
+{
+    ThreadPool * const pPool = arenaPool(pArena);
+    size_t const pieces = (firstSize + secondSize) * (LIMB_BITS / PIECE_BITS);
+    size_t size = 1;
+    while (size < pieces)
+    {
+        size <<= 1;
+    }
+
+    PrimeTask primes[TRANSFORM_PRIMES];
+    ParallelTask tasks[TRANSFORM_PRIMES];
+    for (size_t i = 0; i < TRANSFORM_PRIMES; ++i)
+    {
+        createField(&primes[i].field, TRANSFORM_MODULI[i]);
+        primes[i].generator = TRANSFORM_GENERATORS[i];
+        primes[i].first = first;
+        primes[i].firstSize = firstSize;
+        primes[i].second = second;
+        primes[i].secondSize = secondSize;
+        primes[i].residues = NULL;
+        primes[i].size = size;
+        primes[i].pArena = pArena;
+        primes[i].state = INVALID_STATE;
+        startTask(pPool, &tasks[i], transformPrime, &primes[i]);
+    }
+
+    int state = VALID_STATE;
+    for (size_t i = TRANSFORM_PRIMES; i > 0; --i)
+    {
+        finishTask(pPool, &tasks[i - 1]);
+        if (primes[i - 1].state != VALID_STATE)
+        {
+            state = INVALID_STATE;
+        }
+    }
+    if (state == VALID_STATE)
+    {
+        combineResidues(result, firstSize + secondSize, &primes[0], &primes[1]);
+    }
+
+    for (size_t i = 0; i < TRANSFORM_PRIMES; ++i)
+    {
+        arenaRelease(pArena, primes[i].residues);
+    }
+    return state;
+}
+
+/**
+ * @brief The body of a task computing the product of two numbers modulo a single prime.
+ *        Both operands are transformed, their transforms are multiplied value by value and
+ *        the products are transformed back. The forward transform leaves its values in bit
+ *        reversed order and the inverse transform takes them in that order, so the values are
+ *        never reordered.
+ * @param pTask The PrimeTask.
+ * @return NULL.
+ */
+static void * transformPrime(void * pTask)
+{
+    PrimeTask * const pThis = pTask;
+    TransformField const * const pField = &pThis->field;
+    Limb const modulus = pField->modulus;
+    size_t const size = pThis->size;
+    size_t const half = size / 2;
+    ThreadPool * const pPool = arenaPool(pThis->pArena);
+
+    // The values of both operands and the roots share a single block.
+    Limb * const values = arenaAllocate(pThis->pArena, 3 * size * sizeof(Limb));
+    pThis->residues = values;
+    if (values == NULL)
+    {
+        pThis->state = INVALID_STATE;
+        return NULL;
+    }
+    Limb * const other = values + size;
+    Limb * const roots = other + size;
+    splitPieces(values, pThis->first, pThis->firstSize, size);
+    splitPieces(other, pThis->second, pThis->secondSize, size);
+
+    // The powers w^i of a root of unity w of the size, for i < size / 2, followed by a table
+    // for every stride s of the layers further down, of the powers w^(s * i), so every layer
+    // reads its roots in order rather than one in every s. The table of s starts at
+    // size - size / s, and the inverse roots are read from the same tables.
+    Limb const generator = montgomeryMultiply(pField, pThis->generator, pField->square);
+    Limb const root = powerModulo(pField, generator, (modulus - 1) / size);
+    roots[0] = montgomeryMultiply(pField, 1, pField->square);
+    for (size_t i = 1; i < half; ++i)
+    {
+        roots[i] = montgomeryMultiply(pField, roots[i - 1], root);
+    }
+    for (size_t start = 0, count = half; count > 1; start += count, count /= 2)
+    {
+        for (size_t i = 0; i < count / 2; ++i)
+        {
+            roots[start + count + i] = roots[start + 2 * i];
+        }
+    }
+
+    TransformTask otherTransform = {pField, other, size, roots, 1, pPool};
+    ParallelTask task;
+    startTask(pPool, &task, forwardTask, &otherTransform);
+    forwardTransform(pField, values, size, roots, 1, pPool);
+    finishTask(pPool, &task);
+
+    // The products lack a factor of 2^64 and the inverse transform multiplies by the size, so
+    // both are made up for by the scale, 2^128 / size.
+    Limb const inverseSize = modulus - (modulus - 1) / size;
+    Limb const scale = montgomeryMultiply(pField, montgomeryMultiply(pField, inverseSize,
+                                                                     pField->square),
+                                          pField->square);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = montgomeryMultiply(pField, montgomeryMultiply(pField, values[i], other[i]),
+                                       scale);
+    }
+    inverseTransform(pField, values, size, roots, 1, pPool);
+    pThis->state = VALID_STATE;
+    return NULL;
+}
+
+/**
+ * @brief Recovers the product of two numbers from its pieces modulo the two primes, as
+ *        x = r1 + p1 * ((r2 - r1) / p1 mod p2) for the residues r1 and r2 modulo p1 and p2,
+ *        and carries the pieces into limbs.
+ * @param result The path to store the product in.
+ * @param size The number of limbs of the product.
+ * @param pFirst The product modulo the first prime.
+ * @param pSecond The product modulo the second prime.
+ */
+static void combineResidues(Limb * const result, size_t const size, PrimeTask const * const pFirst,
+                            PrimeTask const * const pSecond)
+{
+    TransformField const * const pField = &pSecond->field;
+    Limb const firstModulus = pFirst->field.modulus;
+    Limb const reducedModulus = montgomeryMultiply(pField, firstModulus % pField->modulus,
+                                                   pField->square);
+    Limb const inverse = powerModulo(pField, reducedModulus, pField->modulus - 2);
+    Limb const pieceMask = ((Limb) 1 << PIECE_BITS) - 1;
+
+    DoubleLimb carry = 0;
+    size_t piece = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        Limb limb = 0;
+        for (size_t shift = 0; shift < LIMB_BITS; shift += PIECE_BITS)
+        {
+            Limb const residue = pFirst->residues[piece];
+            Limb const difference = subtractModulo(pField->modulus, pSecond->residues[piece],
+                                                   residue % pField->modulus);
+            carry += (DoubleLimb) montgomeryMultiply(pField, difference, inverse) *
+                     firstModulus + residue;
+            limb |= ((Limb) carry & pieceMask) << shift;
+            carry >>= PIECE_BITS;
+            piece++;
+        }
+        result[i] = limb;
+    }
+}
+
+/**
+ * @brief Splits the given limbs into pieces of PIECE_BITS bits, padded with zeros.
+ * @param values The path to store the pieces in.
+ * @param limbs The limbs.
+ * @param count The number of limbs.
+ * @param size The number of pieces to store.
+ */
+static void splitPieces(Limb * const values, Limb const * const limbs, size_t const count,
+                        size_t const size)
+{
+    Limb const pieceMask = ((Limb) 1 << PIECE_BITS) - 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[2 * i] = limbs[i] & pieceMask;
+        values[2 * i + 1] = limbs[i] >> PIECE_BITS;
+    }
+    memset(values + 2 * count, 0, (size - 2 * count) * sizeof(Limb));
+}
+
+/**
+ * @brief Transforms the given values in place, leaving them in bit reversed order.
+ *        This is the decimation in frequency form: a layer of butterflies pairs the two halves
+ *        of the values, and each half is then transformed separately, by another thread if it
+ *        is long enough.
+ * @param pField The arithmetic of the transform.
+ * @param values The values.
+ * @param size The number of values, a power of 2.
+ * @param roots The tables of the roots of unity of the whole transform.
+ * @param stride The distance between the roots of these values in the roots.
+ * @param pPool The pool transforming the values, or NULL for this thread.
+ */
+static void forwardTransform(TransformField const * const pField, Limb * const values,
+                             size_t const size, Limb const * const roots, size_t const stride,
+                             ThreadPool * const pPool)
+{
+    if (size <= TRANSFORM_BLOCK_SIZE)
+    {
+        for (size_t length = size; length >= 2; length /= 2)
+        {
+            for (size_t start = 0; start < size; start += length)
+            {
+                forwardButterflies(pField, values + start, length / 2, roots,
+                                   stride * (size / length), 0, length / 2);
+            }
+        }
+        return;
+    }
+
+    size_t const half = size / 2;
+    ThreadPool * const pSplitPool = (half >= PARALLEL_THRESHOLD) ? pPool : NULL;
+    ButterflyTask layer = {pField, values, half, roots, stride, 0, half, FALSE, pSplitPool};
+    butterflyTask(&layer);
+
+    TransformTask high = {pField, values + half, half, roots, 2 * stride, pPool};
+    ParallelTask task;
+    startTask(pSplitPool, &task, forwardTask, &high);
+    forwardTransform(pField, values, half, roots, 2 * stride, pPool);
+    finishTask(pSplitPool, &task);
+}
+
+/**
+ * @brief Transforms back the given values in bit reversed order in place, without the scaling.
+ *        This is the decimation in time form: each half of the values is transformed
+ *        separately, by another thread if it is long enough, and a layer of butterflies then
+ *        pairs the two halves.
+ * @param pField The arithmetic of the transform.
+ * @param values The values.
+ * @param size The number of values, a power of 2.
+ * @param roots The tables of the roots of unity of the whole transform, read as the inverse
+ *              roots.
+ * @param stride The distance between the roots of these values in the roots.
+ * @param pPool The pool transforming the values, or NULL for this thread.
+ */
+static void inverseTransform(TransformField const * const pField, Limb * const values,
+                             size_t const size, Limb const * const roots, size_t const stride,
+                             ThreadPool * const pPool)
+{
+    if (size <= TRANSFORM_BLOCK_SIZE)
+    {
+        for (size_t length = 2; length <= size; length *= 2)
+        {
+            for (size_t start = 0; start < size; start += length)
+            {
+                inverseButterflies(pField, values + start, length / 2, roots,
+                                   stride * (size / length), 0, length / 2);
+            }
+        }
+        return;
+    }
+
+    size_t const half = size / 2;
+    ThreadPool * const pSplitPool = (half >= PARALLEL_THRESHOLD) ? pPool : NULL;
+    TransformTask high = {pField, values + half, half, roots, 2 * stride, pPool};
+    ParallelTask task;
+    startTask(pSplitPool, &task, inverseTask, &high);
+    inverseTransform(pField, values, half, roots, 2 * stride, pPool);
+    finishTask(pSplitPool, &task);
+
+    ButterflyTask layer = {pField, values, half, roots, stride, 0, half, TRUE, pSplitPool};
+    butterflyTask(&layer);
+}
+
+/**
+ * @brief The body of a task of a forward transform.
+ * @param pTask The TransformTask.
+ * @return NULL.
+ */
+static void * forwardTask(void * pTask)
+{
+    TransformTask const * const pThis = pTask;
+    forwardTransform(pThis->pField, pThis->values, pThis->size, pThis->roots, pThis->stride,
+                     pThis->pPool);
+    return NULL;
+}
+
+/**
+ * @brief The body of a task of an inverse transform.
+ * @param pTask The TransformTask.
+ * @return NULL.
+ */
+static void * inverseTask(void * pTask)
+{
+    TransformTask const * const pThis = pTask;
+    inverseTransform(pThis->pField, pThis->values, pThis->size, pThis->roots, pThis->stride,
+                     pThis->pPool);
+    return NULL;
+}
+
+/**
+ * @brief The body of a task of a range of butterflies of a single layer, a long range is split
+ *        in two ranges, one of them for another thread.
+ * @param pTask The ButterflyTask.
+ * @return NULL.
+ */
+static void * butterflyTask(void * pTask)
+{
+    ButterflyTask * const pThis = pTask;
+    size_t const count = pThis->end - pThis->begin;
+    if (pThis->pPool != NULL && count >= 2 * PARALLEL_THRESHOLD)
+    {
+        ButterflyTask high = *pThis;
+        high.begin = pThis->begin + count / 2;
+        ButterflyTask low = *pThis;
+        low.end = high.begin;
+        ParallelTask task;
+        startTask(pThis->pPool, &task, butterflyTask, &high);
+        butterflyTask(&low);
+        finishTask(pThis->pPool, &task);
+        return NULL;
+    }
+
+    if (pThis->inverse)
+    {
+        inverseButterflies(pThis->pField, pThis->values, pThis->half, pThis->roots,
+                           pThis->stride, pThis->begin, pThis->end);
+    }
+    else
+    {
+        forwardButterflies(pThis->pField, pThis->values, pThis->half, pThis->roots,
+                           pThis->stride, pThis->begin, pThis->end);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Computes a range of the butterflies of a layer of the forward transform, each maps
+ *        (x, y) to (x + y, (x - y) * w^i).
+ * @param pField The arithmetic of the transform.
+ * @param values The values of the layer.
+ * @param half Half the number of values of the layer.
+ * @param roots The tables of the roots of unity of the whole transform.
+ * @param stride The distance between the roots of this layer in the roots.
+ * @param begin The first butterfly of the range.
+ * @param end The butterfly after the last one of the range.
+ */
+__attribute__((always_inline))
+static inline void forwardButterflies(TransformField const * const pField, Limb * const values,
+                                      size_t const half, Limb const * const roots,
+                                      size_t const stride, size_t const begin, size_t const end)
+{
+    Limb const modulus = pField->modulus;
+    Limb const * const layerRoots = roots + 2 * half * (stride - 1);
+    Limb * const high = values + half;
+    for (size_t i = begin; i < end; ++i)
+    {
+        Limb const x = values[i];
+        Limb const y = high[i];
+        values[i] = addModulo(modulus, x, y);
+        high[i] = montgomeryMultiply(pField, subtractModulo(modulus, x, y), layerRoots[i]);
+    }
+}
+
+/**
+ * @brief Computes a range of the butterflies of a layer of the inverse transform, each maps
+ *        (x, y) to (x + y * w^-i, x - y * w^-i).
+ * @param pField The arithmetic of the transform.
+ * @param values The values of the layer.
+ * @param half Half the number of values of the layer.
+ * @param roots The tables of the roots of unity of the whole transform, read as the inverse
+ *              roots.
+ * @param stride The distance between the roots of this layer in the roots.
+ * @param begin The first butterfly of the range.
+ * @param end The butterfly after the last one of the range.
+ */
+__attribute__((always_inline))
+static inline void inverseButterflies(TransformField const * const pField, Limb * const values,
+                                      size_t const half, Limb const * const roots,
+                                      size_t const stride, size_t const begin, size_t const end)
+{
+    Limb const modulus = pField->modulus;
+    Limb const * const layerRoots = roots + 2 * half * (stride - 1);
+    Limb * const high = values + half;
+    size_t first = begin;
+    if (first == 0)
+    {
+        Limb const x = values[0];
+        Limb const y = high[0];
+        values[0] = addModulo(modulus, x, y);
+        high[0] = subtractModulo(modulus, x, y);
+        first = 1;
+    }
+
+    // Since w^half is -1, w^-i is -w^(half - i), so the roots of the layer are read backwards
+    // and the sum and the difference trade places.
+    for (size_t i = first; i < end; ++i)
+    {
+        Limb const x = values[i];
+        Limb const y = montgomeryMultiply(pField, high[i], layerRoots[half - i]);
+        values[i] = subtractModulo(modulus, x, y);
+        high[i] = addModulo(modulus, x, y);
+    }
+}
+
+/**
+ * @brief Initializes the arithmetic modulo the given prime.
+ * @param pField The arithmetic.
+ * @param modulus The prime, odd and less than 2^62.
+ */
+static void createField(TransformField * const pField, Limb const modulus)
+{
+    // Every step of Newton's method doubles the bits of the inverse, the prime is its own
+    // inverse modulo 2^3.
+    Limb inverse = modulus;
+    for (int i = 0; i < 5; ++i)
+    {
+        inverse *= 2 - modulus * inverse;
+    }
+    Limb const unit = (Limb) (((DoubleLimb) 1 << LIMB_BITS) % modulus);
+    pField->modulus = modulus;
+    pField->inverse = 0 - inverse;
+    pField->square = (Limb) ((DoubleLimb) unit * unit % modulus);
+}
+
+/**
+ * @brief Raises the given number to the given power, by repeated squaring.
+ * @param pField The arithmetic.
+ * @param base The number, in Montgomery's form.
+ * @param exponent The power.
+ * @return The result, in Montgomery's form.
+ */
+static Limb powerModulo(TransformField const * const pField, Limb base, Limb exponent)
+{
+    Limb result = montgomeryMultiply(pField, 1, pField->square);
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+        {
+            result = montgomeryMultiply(pField, result, base);
+        }
+        base = montgomeryMultiply(pField, base, base);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Multiplies the given numbers and divides the product by 2^64, modulo the prime, as in
+ *        Montgomery's reduction: adding a multiple of the prime clears the low limb of the
+ *        product, which is then dropped.
+ * @param pField The arithmetic.
+ * @param first The first number, less than the prime.
+ * @param second The second number, less than the prime.
+ * @return The result, less than the prime.
+ */
+__attribute__((always_inline))
+static inline Limb montgomeryMultiply(TransformField const * const pField, Limb const first,
+                                      Limb const second)
+{
+    DoubleLimb const product = (DoubleLimb) first * second;
+    Limb const factor = (Limb) product * pField->inverse;
+    Limb const reduced = (Limb) ((product + (DoubleLimb) factor * pField->modulus) >> LIMB_BITS);
+    return (reduced >= pField->modulus) ? reduced - pField->modulus : reduced;
+}
+
+/**
+ * @brief Adds the given numbers modulo the given prime.
+ * @param modulus The prime.
+ * @param first The first number, less than the prime.
+ * @param second The second number, less than the prime.
+ * @return The sum, less than the prime.
+ */
+__attribute__((always_inline))
+static inline Limb addModulo(Limb const modulus, Limb const first, Limb const second)
+{
+    Limb const sum = first + second;
+    return (sum >= modulus) ? sum - modulus : sum;
+}
+
+/**
+ * @brief Subtracts the second number from the first one modulo the given prime.
+ * @param modulus The prime.
+ * @param first The first number, less than the prime.
+ * @param second The second number, less than the prime.
+ * @return The difference, less than the prime.
+ */
+__attribute__((always_inline))
+static inline Limb subtractModulo(Limb const modulus, Limb const first, Limb const second)
+{
+    return (first >= second) ? first - second : first + modulus - second;
+}
+
+
+/*----=  Digit Validation  =-----*/
+
+
+/**
+ * @brief Verify that the given number in the user input can be represented in the
+ *        given original base.
+ * @param originalBase The given original base in the user input.
+ * @param digits The digits of the given number in the user input.
+ * @param length The number of digits.
+ * @return 0 if the input is invalid, 1 otherwise.
+ */
+static int checkInput(int const originalBase, char const * const digits, size_t const length)
+{
+    size_t checked = 0;
+#ifdef VECTOR_DIGITS
+    // Long numbers are checked by vectors, the digits which are left are checked one by one.
+    __builtin_cpu_init();
+    if (length >= AVX2_WIDTH && __builtin_cpu_supports("avx2"))
+    {
+        checked = checkDigitsAvx2(originalBase, digits, length);
+    }
+    else if (length >= SSE2_WIDTH && HAS_SSE2)
+    {
+        checked = checkDigitsSse2(originalBase, digits, length);
+    }
+#endif
+
+    for (size_t i = checked; i < length; ++i)
+    {
+        if (DIGIT_VALUES[(unsigned char) digits[i]] >= originalBase)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/*----=  Vector Digits  =-----*/
+
+
+#ifdef VECTOR_DIGITS
+
+/**
+ * @brief Checks the given digits 16 at a time using SSE2 instructions.
+ * @param originalBase The base of the digits.
+ * @param digits The digits.
+ * @param length The number of digits.
+ * @return The number of leading digits which are valid, a multiple of 16 which stops before the
+ *         first 16 digits which contain an invalid one.
+ */
+__attribute__((target("sse2")))
+static size_t checkDigitsSse2(int const originalBase, char const * const digits,
+                              size_t const length)
+{
+    __m128i const maxDigit = _mm_set1_epi8((char) (originalBase - 1));
+    size_t checked = 0;
+    for ( ; checked + SSE2_WIDTH <= length; checked += SSE2_WIDTH)
+    {
+        __m128i const block = _mm_loadu_si128((__m128i const *) (digits + checked));
+        __m128i const values = sse2DigitValues(block);
+        __m128i const valid = _mm_cmpeq_epi8(_mm_min_epu8(values, maxDigit), values);
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+        {
+            break;
+        }
+    }
+    return checked;
+}
+
+/**
+ * @brief Checks the given digits 32 at a time using AVX2 instructions.
+ * @param originalBase The base of the digits.
+ * @param digits The digits.
+ * @param length The number of digits.
+ * @return The number of leading digits which are valid, a multiple of 32 which stops before the
+ *         first 32 digits which contain an invalid one.
+ */
+__attribute__((target("avx2")))
+static size_t checkDigitsAvx2(int const originalBase, char const * const digits,
+                              size_t const length)
+{
+    __m256i const maxDigit = _mm256_set1_epi8((char) (originalBase - 1));
+    size_t checked = 0;
+    for ( ; checked + AVX2_WIDTH <= length; checked += AVX2_WIDTH)
+    {
+        __m256i const block = _mm256_loadu_si256((__m256i const *) (digits + checked));
+        __m256i const values = avx2DigitValues(block);
+        __m256i const valid = _mm256_cmpeq_epi8(_mm256_min_epu8(values, maxDigit), values);
+        if (_mm256_movemask_epi8(valid) != -1)
+        {
+            break;
+        }
+    }
+    return checked;
+}
+
+/**
+ * @brief Maps 16 characters to the values of their digits using SSE2 instructions.
+ *        A character is a decimal digit if it is at most 9 above '0', and a letter if, once it is
+ *        lowercase, it is less than 26 above 'a'. Both are unsigned comparisons by a minimum.
+ * @param characters The characters.
+ * @return The values, INVALID_DIGIT for a character which is not a digit.
+ */
+__attribute__((target("sse2")))
+static inline __m128i sse2DigitValues(__m128i const characters)
+{
+    __m128i const maxDecimal = _mm_set1_epi8(STANDARD_BASE - 1);
+    __m128i const maxLetter = _mm_set1_epi8(LETTERS_NUMBER - 1);
+    __m128i const decimals = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+    __m128i const lowercase = _mm_or_si128(characters, _mm_set1_epi8(LETTER_CASE_BIT));
+    __m128i const letters = _mm_sub_epi8(lowercase, _mm_set1_epi8('a'));
+    __m128i const isDecimal = _mm_cmpeq_epi8(_mm_min_epu8(decimals, maxDecimal), decimals);
+    __m128i const isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, maxLetter), letters);
+    __m128i const letterValues = _mm_add_epi8(letters, _mm_set1_epi8(STANDARD_BASE));
+    __m128i const invalid = _mm_andnot_si128(_mm_or_si128(isDecimal, isLetter),
+                                             _mm_set1_epi8((char) INVALID_DIGIT));
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(isDecimal, decimals),
+                                     _mm_and_si128(isLetter, letterValues)), invalid);
+}
+
+/**
+ * @brief Maps 32 characters to the values of their digits using AVX2 instructions, as
+ *        sse2DigitValues does.
+ * @param characters The characters.
+ * @return The values, INVALID_DIGIT for a character which is not a digit.
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2DigitValues(__m256i const characters)
+{
+    __m256i const maxDecimal = _mm256_set1_epi8(STANDARD_BASE - 1);
+    __m256i const maxLetter = _mm256_set1_epi8(LETTERS_NUMBER - 1);
+    __m256i const decimals = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+    __m256i const lowercase = _mm256_or_si256(characters, _mm256_set1_epi8(LETTER_CASE_BIT));
+    __m256i const letters = _mm256_sub_epi8(lowercase, _mm256_set1_epi8('a'));
+    __m256i const isDecimal = _mm256_cmpeq_epi8(_mm256_min_epu8(decimals, maxDecimal), decimals);
+    __m256i const isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, maxLetter), letters);
+    __m256i const letterValues = _mm256_add_epi8(letters, _mm256_set1_epi8(STANDARD_BASE));
+    __m256i const invalid = _mm256_andnot_si256(_mm256_or_si256(isDecimal, isLetter),
+                                                _mm256_set1_epi8((char) INVALID_DIGIT));
+    return _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(isDecimal, decimals),
+                                           _mm256_and_si256(isLetter, letterValues)), invalid);
+}
+
+/**
+ * @brief Parses 16 digits into a single limb using SSE2 instructions.
+ *        The digits are widened to 16 bits, and every pair of neighbours is reduced to
+ *        d0 * B + d1 by a single multiply-add, then every pair of pairs is reduced to
+ *        p0 * B^2 + p1 the same way and every pair of groups of 4 digits to g0 * B^4 + g1 by a
+ *        single 32 bits multiplication. The two halves are combined as h0 * B^8 + h1.
+ * @param base The base of the digits, at most MAX_VECTOR_BASE.
+ * @param digits The digits, the most significant first, they must be valid.
+ * @return The value of the digits.
+ */
+__attribute__((target("sse2")))
+static Limb parseDigitsSse2(int const base, char const * const digits)
+{
+    __m128i const values = sse2DigitValues(_mm_loadu_si128((__m128i const *) digits));
+    __m128i const zero = _mm_setzero_si128();
+
+    // Every 32 bits lane multiplies its lower 16 bits by its first factor, and the higher ones
+    // by 1, which suits the most significant digit first.
+    __m128i const pairFactors = _mm_set1_epi32((1 << 16) | base);
+    __m128i const groupFactors = _mm_set1_epi32((1 << 16) | (base * base));
+    __m128i const pairs = _mm_packs_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(values, zero),
+                                                         pairFactors),
+                                          _mm_madd_epi16(_mm_unpackhi_epi8(values, zero),
+                                                         pairFactors));
+    __m128i const groups = _mm_madd_epi16(pairs, groupFactors);
+
+    // Every 64 bits lane reduces its two groups of 4 digits to g0 * B^4 + g1.
+    __m128i const fourth = _mm_set1_epi32(base * base * base * base);
+    __m128i const halves = _mm_add_epi64(_mm_mul_epu32(groups, fourth), _mm_srli_epi64(groups, 32));
+    uint64_t high = 0;
+    uint64_t low = 0;
+    _mm_storel_epi64((__m128i *) &high, halves);
+    _mm_storel_epi64((__m128i *) &low, _mm_unpackhi_epi64(halves, halves));
+
+    Limb const eighth = (Limb) (base * base * base * base) * (Limb) (base * base * base * base);
+    return high * eighth + low;
+}
+
+#endif
@@ -0,0 +1,283 @@
+/**
+ * @file BaseConverter.h
+ * @author Itai Tagar <itagar>
+ * @version 1.2
+ * @date 09 Aug 2016
+ *
+ * @brief A library that convert a given number from one base representation to another.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A library that convert a given number from one base representation to another.
+ * The number may have any number of digits, and may start with a sign. The digits of bases
+ * above 10 are the letters, in any case, and the converted digits are lowercase.
+ * The converted number is written in its final order to a buffer of the caller, whose size is
+ * given by 'converterBound', and its exact length is returned. Nothing is null terminated.
+ * Long numbers need scratch memory. With an Arena, the scratch memory is kept for the next
+ * conversions, so once an Arena has served a few conversions it allocates no more memory. An
+ * Arena may also hold a pool of threads which convert the parts of a long number.
+ * An Arena serves a single conversion at a time, and any number of Arenas may be used at the
+ * same time.
+ * A number may also be given as its 64 bits limbs, the least significant first, or parsed into
+ * them, for callers which keep numbers in binary.
+ * Optionally, a Cache of a bounded memory budget keeps short numbers along with their converted
+ * numbers, so a number converted again between the same bases is copied from the Cache. A Cache
+ * is shared by any number of threads at the same time.
+ * Usage:       ConverterArena * pArena = converterCreateArena(threads);
+ *              size_t capacity = converterBound(originalBase, newBase, length);
+ *              int result = converterConvert(originalBase, newBase, number, length, buffer,
+ *                                            capacity, &resultLength, pArena);
+ *              converterDestroyArena(pArena);
+ *              ConverterCache * pCache = converterCreateCache(budget);
+ *              int result = converterCacheConvert(pCache, originalBase, newBase, number, length,
+ *                                                 buffer, capacity, &resultLength, pArena);
+ *              converterDestroyCache(pCache);
+ */
+
+#ifndef BASE_CONVERTER_H
+#define BASE_CONVERTER_H
+
+
+/*----=  Includes  =-----*/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def CONVERTER_VALID 0
+ * @brief A Flag for a number which was converted.
+ */
+#define CONVERTER_VALID 0
+
+/**
+ * @def CONVERTER_INVALID 1
+ * @brief A Flag for a number which cannot be represented in its base, or for a base which is not
+ *        between CONVERTER_MIN_BASE and CONVERTER_MAX_BASE.
+ */
+#define CONVERTER_INVALID 1
+
+/**
+ * @def CONVERTER_OUT_OF_MEMORY 2
+ * @brief A Flag for a number which does not fit in the memory.
+ */
+#define CONVERTER_OUT_OF_MEMORY 2
+
+/**
+ * @def CONVERTER_BUFFER_TOO_SMALL 3
+ * @brief A Flag for a converted number which does not fit in the buffer of the caller.
+ */
+#define CONVERTER_BUFFER_TOO_SMALL 3
+
+/**
+ * @def CONVERTER_MIN_BASE 2
+ * @brief A Macro that sets the smallest base a number can be represented in.
+ */
+#define CONVERTER_MIN_BASE 2
+
+/**
+ * @def CONVERTER_MAX_BASE 36
+ * @brief A Macro that sets the largest base a number can be represented in, the digits of a
+ *        number are the decimal digits followed by the letters.
+ */
+#define CONVERTER_MAX_BASE 36
+
+/**
+ * @def CONVERTER_MAX_THREADS 256
+ * @brief A Macro that sets the maximal number of threads of an Arena.
+ */
+#define CONVERTER_MAX_THREADS 256
+
+/**
+ * @def CONVERTER_CACHE_ENTRY_SIZE 112
+ * @brief A Macro that sets the maximal number of characters of a number and of its converted
+ *        number together, which a Cache keeps.
+ */
+#define CONVERTER_CACHE_ENTRY_SIZE 112
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The scratch memory, and the threads, of the conversions of a single caller.
+ */
+typedef struct ConverterArena ConverterArena;
+
+/**
+ * @brief A bounded memory of converted numbers, shared by the conversions of any number of
+ *        threads.
+ */
+typedef struct ConverterCache ConverterCache;
+
+/**
+ * @brief The counters of a Cache.
+ */
+typedef struct ConverterCacheStatistics
+{
+    /** The number of conversions copied from the Cache. */
+    unsigned long long hits;
+    /** The number of conversions which were not found in the Cache. */
+    unsigned long long misses;
+    /** The number of converted numbers stored in the Cache. */
+    unsigned long long insertions;
+    /** The number of converted numbers which were replaced by others. */
+    unsigned long long evictions;
+} ConverterCacheStatistics;
+
+
+/*----=  Converter  =-----*/
+
+
+/**
+ * @brief Creates an Arena, with a pool of threads if more than a single thread converts.
+ * @param threads The number of threads converting a long number, including the thread which
+ *        calls 'converterConvert', 0 and 1 both mean that thread only.
+ * @return The new Arena, or NULL if there is not enough memory.
+ */
+ConverterArena * converterCreateArena(size_t const threads);
+
+/**
+ * @brief Releases the given Arena, its threads and all the memory it keeps.
+ * @param pArena The Arena to release, may be NULL.
+ */
+void converterDestroyArena(ConverterArena * const pArena);
+
+/**
+ * @brief Returns the number of characters which is enough for any number of the given length
+ *        converted between the given bases, including its sign.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param length The number of characters in the number.
+ * @return The number of characters, it may exceed the exact length by a chunk, or 1 if a base is
+ *         not between CONVERTER_MIN_BASE and CONVERTER_MAX_BASE, as only 0 is converted then.
+ */
+size_t converterBound(int const originalBase, int const newBase, size_t const length);
+
+/**
+ * @brief Converts the given number from the given original base to the given new base.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param result The buffer to write the converted number in, most significant digit first.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in, which
+ *        is also stored if they do not fit in the buffer.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was converted, 1 if the input is invalid, 2 if there is not enough
+ *         memory and 3 if the converted number does not fit in the buffer.
+ */
+int converterConvert(int const originalBase, int const newBase, char const * const number,
+                     size_t const length, char * const result, size_t const capacity,
+                     size_t * const pLength, ConverterArena * const pArena);
+
+/**
+ * @brief Returns the number of limbs which is enough for any number of the given length in the
+ *        given base. The number of characters which is enough for a number of a given number of
+ *        limbs converted to a base is 'converterBound(2, newBase, 64 * size)'.
+ * @param originalBase The base the number is represented in.
+ * @param length The number of characters in the number.
+ * @return The number of limbs, or 0 if the base is not between CONVERTER_MIN_BASE and
+ *         CONVERTER_MAX_BASE.
+ */
+size_t converterLimbsBound(int const originalBase, size_t const length);
+
+/**
+ * @brief Parses the given number into its 64 bits limbs.
+ * @param originalBase The base the number is represented in.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param limbs The buffer to write the limbs of the absolute value of the number in, the least
+ *        significant first.
+ * @param capacity The number of limbs the buffer holds.
+ * @param pSize The path to store the number of limbs in, without leading zero limbs, so 0 is of
+ *        no limbs. It is also stored if they do not fit in the buffer.
+ * @param pNegative The path to store non zero in for a negative number.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was parsed, 1 if the input is invalid, 2 if there is not enough
+ *         memory and 3 if the limbs do not fit in the buffer.
+ */
+int converterParseLimbs(int const originalBase, char const * const number, size_t const length,
+                        uint64_t * const limbs, size_t const capacity, size_t * const pSize,
+                        int * const pNegative, ConverterArena * const pArena);
+
+/**
+ * @brief Converts the given number, given as its 64 bits limbs, to the given new base.
+ * @param newBase The base to convert the number to.
+ * @param limbs The limbs of the absolute value of the number, the least significant first.
+ * @param size The number of limbs, which may include leading zero limbs.
+ * @param negative Non zero for a negative number.
+ * @param result The buffer to write the converted number in, most significant digit first.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in, which
+ *        is also stored if they do not fit in the buffer.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was converted, 1 if the base is invalid, 2 if there is not enough
+ *         memory and 3 if the converted number does not fit in the buffer.
+ */
+int converterConvertLimbs(int const newBase, uint64_t const * const limbs, size_t const size,
+                          int const negative, char * const result, size_t const capacity,
+                          size_t * const pLength, ConverterArena * const pArena);
+
+
+/*----=  Cache  =-----*/
+
+
+/**
+ * @brief Creates an empty Cache, of as many entries as the given memory budget holds.
+ * @param budget The number of bytes the Cache may use.
+ * @return The new Cache, or NULL if the budget does not hold a single bucket of entries or there
+ *         is not enough memory.
+ */
+ConverterCache * converterCreateCache(size_t const budget);
+
+/**
+ * @brief Releases the given Cache.
+ * @param pCache The Cache to release, may be NULL.
+ */
+void converterDestroyCache(ConverterCache * const pCache);
+
+/**
+ * @brief Converts the given number from the given original base to the given new base, like
+ *        'converterConvert', by copying the converted number from the given Cache if it is
+ *        there. Otherwise the number is converted, and stored in the Cache if the number and
+ *        the converted number together have at most CONVERTER_CACHE_ENTRY_SIZE characters.
+ * @param pCache The Cache, or NULL for converting the number.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param result The buffer to write the converted number in, most significant digit first.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in, which
+ *        is also stored if they do not fit in the buffer.
+ * @param pArena The Arena providing the scratch memory and the threads, or NULL for the heap
+ *        and this thread.
+ * @return 0 if the number was converted, 1 if the input is invalid, 2 if there is not enough
+ *         memory and 3 if the converted number does not fit in the buffer.
+ */
+int converterCacheConvert(ConverterCache * const pCache, int const originalBase,
+                          int const newBase, char const * const number, size_t const length,
+                          char * const result, size_t const capacity, size_t * const pLength,
+                          ConverterArena * const pArena);
+
+/**
+ * @brief Reads the counters of the given Cache, which its threads may still be changing.
+ * @param pCache The Cache.
+ * @param pStatistics The address to store the counters in.
+ */
+void converterCacheStatistics(ConverterCache const * const pCache,
+                              ConverterCacheStatistics * const pStatistics);
+
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file ChangeBase.c
  * @author Itai Tagar <itagar>
- * @version 2.0
+ * @version 2.3
  * @date 09 Aug 2016
  *
  * @brief A program that convert a given number from one base representation to another.
@@ -14,325 +14,2738 @@
  * Input:       One input that holds the given number, it's current base representation and the
  *              new base we want to convert to. The input comes from the user in the format of -
  *              <original base>^<new base>^<the number in original base>^
+ *              The number may have any number of digits, and may start with a sign.
+ *              With '--batch', any number of such inputs are read one per line from the given
+ *              file or from the standard input.
+ *              With '--binary', the inputs are read as binary records from the given file, which
+ *              is mapped to the memory, so their digits are converted where they are.
  * Process:     The program analyze if the input is valid, an invalid state is where the given
- *              number cannot be represented with the given original base.
+ *              number cannot be represented with the given original base, or where a base is
+ *              not between 2 and 36. The digits of bases above 10 are the letters, in any case.
  *              After validating the input, the program convert the number to the new base
  *              representation and prints it out to the screen.
+ *              Numbers which fit in 64 bits are converted within a single limb, a digit at a time.
+ *              Longer numbers are stored as arrays of 64 bits limbs, and are converted by
+ *              splitting them by powers of the base, which takes O(n^1.58 log(n)) time rather
+ *              than O(n^2). The largest products are computed by number theoretic transforms.
+ *              With '--threads', the parts of a long number are converted by a pool of threads.
+ *              The conversion itself is done by the Base Converter library, which writes the
+ *              converted number straight to the output buffer.
+ *              With '--batch' and '--cache', short numbers which repeat are copied from a Cache
+ *              of the given number of megabytes, which the threads share.
  * Output:      The converted number is printed to the screen if the input was valid.
  *              An error message in case of bad input.
+ *              With '--batch', every input line gets one output line, its converted number or
+ *              its error message, so a bad input does not stop the inputs which follow it.
+ *              With '--batch' and '--threads', blocks of lines are converted by a pool of threads
+ *              between a reading thread and a writing thread, and the output keeps the order of
+ *              the input.
+ *              With '--cache', the counters of the Cache are printed to the standard error once
+ *              the input ends.
+ *              With '--binary', every input record gets one output record, written straight to
+ *              the output file, which is mapped to the memory at the size which fits any output
+ *              and is cut to the size of the output at the end.
+ *              '--pack' writes the lines of the text format as binary input records, of digits or
+ *              with '--limbs' of limbs, and '--unpack' writes binary records of either kind back
+ *              in the text format, the input records as input lines and the output records as
+ *              the output lines of '--batch'. A line which does not have the input format is
+ *              packed as a record of invalid bases whose digits are the line.
+ * Records:     A file of records starts with a header of 8 bytes, "CBR1" and a byte of 'I' for
+ *              input records or 'O' for output records, padded with zeros. Every record has a
+ *              header of 8 bytes: the original base, the new base, the format of the payload,
+ *              the flags of the record and the number of bytes of the payload as a 32 bits
+ *              integer, all in the byte order of the machine. The payload follows, padded with
+ *              zeros to a multiple of 8 bytes. A payload of digits holds the characters of the
+ *              number, which may start with a sign. A payload of limbs holds the 64 bits limbs
+ *              of the absolute value of the number, the least significant first, and a flag
+ *              marks a negative number. Output records hold digits, or no payload and a flag of
+ *              an invalid input or of lack of memory.
+ * Usage:       ChangeBase [--threads <number>]
+ *              ChangeBase --batch [--threads <number>] [--cache <megabytes>] [<filename>]
+ *              ChangeBase --binary [--threads <number>] <input> <output>
+ *              ChangeBase --pack [--limbs] <input> <output>
+ *              ChangeBase --unpack <input> <output>
+ *              A statistics build also accepts [--stats] [--progress <seconds>] after the other
+ *              options of '--batch' and '--binary'. With '--stats', the records, the records per
+ *              second, the time spent parsing, converting and emitting them, summed over the
+ *              threads, and the hit rate of the Cache are printed to the standard error once
+ *              the input ends. With '--progress', the records converted so far are printed to
+ *              the standard error every given number of seconds.
+ * Build:       gcc -std=c99 -O2 -pthread ChangeBase.c BaseConverter.c -o ChangeBase
+ *              The statistics build adds -DCHANGE_BASE_STATISTICS, otherwise the counters and
+ *              the timers are not compiled at all.
  */
 
 
+
 /*----=  Includes  =-----*/
 
 
-#include <stdio.h>
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "BaseConverter.h"
+
+#ifdef CHANGE_BASE_STATISTICS
+#include <errno.h>
+#include <time.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+/**
+ * @def TIME_STAMP_COUNTER
+ * @brief A Flag which states that the timer reads the time stamp counter of the CPU.
+ */
+#define TIME_STAMP_COUNTER
+#endif
+#endif
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def VALID_STATE 0
+ * @brief A Flag for valid state during the program run.
+ */
+#define VALID_STATE 0
+
+/**
+ * @def INVALID_STATE 1
+ * @brief A Flag for invalid state during the program run.
+ */
+#define INVALID_STATE 1
+
+/**
+ * @def OUT_OF_MEMORY_STATE 2
+ * @brief A Flag for a number which does not fit in the memory.
+ */
+#define OUT_OF_MEMORY_STATE 2
+
+/**
+ * @def STANDARD_BASE 10
+ * @brief A Macro that sets the standard base which we usually use.
+ */
+#define STANDARD_BASE 10
+
+/**
+ * @def TRUE 1
+ * @brief A Flag for true statement.
+ */
+#define TRUE 1
+
+/**
+ * @def FALSE 0
+ * @brief A Flag for false statement.
+ */
+#define FALSE 0
+
+/**
+ * @def INVALID_INPUT_MESSAGE "invalid!!\n"
+ * @brief A Macro that sets the output message for invalid user input.
+ */
+#define INVALID_INPUT_MESSAGE "invalid!!\n"
+
+/**
+ * @def OUT_OF_MEMORY_MESSAGE "Error! not enough memory to convert the number\n"
+ * @brief A Macro that sets the output message for a number which does not fit in the memory.
+ */
+#define OUT_OF_MEMORY_MESSAGE "Error! not enough memory to convert the number\n"
+
+#ifdef CHANGE_BASE_STATISTICS
+/**
+ * @def STATISTICS_USAGE "[--stats] [--progress <seconds>] "
+ * @brief A Macro that sets the usage of the statistics options, which exist only if they are
+ *        compiled in.
+ */
+#define STATISTICS_USAGE "[--stats] [--progress <seconds>] "
+#else
+#define STATISTICS_USAGE ""
+#endif
+
+/**
+ * @def INVALID_ARGUMENTS_MESSAGE "usage: ChangeBase [--threads <number>]\n..."
+ * @brief A Macro that sets the output message for invalid arguments to the program.
+ */
+#define INVALID_ARGUMENTS_MESSAGE "usage: ChangeBase [--threads <number>]\n" \
+                                  "       ChangeBase --batch [--threads <number>] " \
+                                  "[--cache <megabytes>] " STATISTICS_USAGE "[<filename>]\n" \
+                                  "       ChangeBase --binary [--threads <number>] " \
+                                  STATISTICS_USAGE "<input> <output>\n" \
+                                  "       ChangeBase --pack [--limbs] <input> <output>\n" \
+                                  "       ChangeBase --unpack <input> <output>\n"
+
+/**
+ * @def INVALID_FILE_MESSAGE "Error! trying to open the file %s\n"
+ * @brief A Macro that sets the output message for a file which cannot be opened.
+ */
+#define INVALID_FILE_MESSAGE "Error! trying to open the file %s\n"
+
+/**
+ * @def READ_ERROR_MESSAGE "Error! trying to read the input\n"
+ * @brief A Macro that sets the output message for input which cannot be read.
+ */
+#define READ_ERROR_MESSAGE "Error! trying to read the input\n"
+
+/**
+ * @def WRITE_ERROR_MESSAGE "Error! trying to write the file %s\n"
+ * @brief A Macro that sets the output message for an output file which cannot be written.
+ */
+#define WRITE_ERROR_MESSAGE "Error! trying to write the file %s\n"
+
+/**
+ * @def INVALID_RECORDS_MESSAGE "Error! the file %s does not hold valid records\n"
+ * @brief A Macro that sets the output message for a file of records which is not valid.
+ */
+#define INVALID_RECORDS_MESSAGE "Error! the file %s does not hold valid records\n"
+
+/**
+ * @def CACHE_STATISTICS_MESSAGE "Cache: %llu hits, %llu misses, %llu evictions\n"
+ * @brief A Macro that sets the output message for the counters of the Cache.
+ */
+#define CACHE_STATISTICS_MESSAGE "Cache: %llu hits, %llu misses, %llu evictions\n"
+
+/**
+ * @def BATCH_OPTION "--batch"
+ * @brief A Macro that sets the argument which reads any number of inputs, one per line.
+ */
+#define BATCH_OPTION "--batch"
+
+/**
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the argument which sets the number of threads converting.
+ */
+#define THREADS_OPTION "--threads"
+
+/**
+ * @def CACHE_OPTION "--cache"
+ * @brief A Macro that sets the argument which sets the number of megabytes of the Cache.
+ */
+#define CACHE_OPTION "--cache"
+
+/**
+ * @def BINARY_OPTION "--binary"
+ * @brief A Macro that sets the argument which converts a file of binary records.
+ */
+#define BINARY_OPTION "--binary"
+
+/**
+ * @def PACK_OPTION "--pack"
+ * @brief A Macro that sets the argument which writes the lines of a text file as records.
+ */
+#define PACK_OPTION "--pack"
+
+/**
+ * @def UNPACK_OPTION "--unpack"
+ * @brief A Macro that sets the argument which writes a file of records as text lines.
+ */
+#define UNPACK_OPTION "--unpack"
+
+/**
+ * @def LIMBS_OPTION "--limbs"
+ * @brief A Macro that sets the argument which packs the numbers as limbs rather than digits.
+ */
+#define LIMBS_OPTION "--limbs"
+
+/**
+ * @def MAX_CACHE_SIZE 65536
+ * @brief A Macro that sets the maximal number of megabytes of the Cache.
+ */
+#define MAX_CACHE_SIZE 65536
+
+/**
+ * @def MEGABYTE_SHIFT 20
+ * @brief A Macro that sets the power of 2 of the number of bytes of a megabyte.
+ */
+#define MEGABYTE_SHIFT 20
+
+/**
+ * @def STANDARD_INPUT_NAME "-"
+ * @brief A Macro that sets the file name which stands for the standard input.
+ */
+#define STANDARD_INPUT_NAME "-"
+
+/**
+ * @def STANDARD_OUTPUT_NAME "-"
+ * @brief A Macro that sets the file name which stands for the standard output.
+ */
+#define STANDARD_OUTPUT_NAME "-"
+
+/**
+ * @def OUTPUT_FILE_MODE 0644
+ * @brief A Macro that sets the permissions of a created output file.
+ */
+#define OUTPUT_FILE_MODE 0644
+
+/**
+ * @def INPUT_SEPARATOR '^'
+ * @brief A Macro that sets the character which ends every part of the input.
+ */
+#define INPUT_SEPARATOR '^'
+
+/**
+ * @def LINE_SEPARATOR '\n'
+ * @brief A Macro that sets the character which ends every input in batch mode.
+ */
+#define LINE_SEPARATOR '\n'
+
+/**
+ * @def CARRIAGE_RETURN '\r'
+ * @brief A Macro that sets the character which may precede the end of an input line.
+ */
+#define CARRIAGE_RETURN '\r'
+
+/**
+ * @def INITIAL_DIGITS_CAPACITY 64
+ * @brief A Macro that sets the number of digits the input buffer holds before it grows.
+ */
+#define INITIAL_DIGITS_CAPACITY 64
+
+/**
+ * @def READ_BUFFER_SIZE (1 << 20)
+ * @brief A Macro that sets the number of bytes read from the input at once in batch mode, the
+ *        buffer grows for longer lines.
+ */
+#define READ_BUFFER_SIZE (1 << 20)
+
+/**
+ * @def OUTPUT_BUFFER_SIZE (1 << 16)
+ * @brief A Macro that sets the number of bytes of output gathered before they are written.
+ */
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+
+/**
+ * @def NO_FILE -1
+ * @brief A Macro that sets the file descriptor of a buffer which stays in the memory.
+ */
+#define NO_FILE -1
+
+/**
+ * @def BLOCK_SIZE (1 << 20)
+ * @brief A Macro that sets the number of bytes of lines a thread converts at once.
+ */
+#define BLOCK_SIZE (1 << 20)
+
+/**
+ * @def RING_CAPACITY 4
+ * @brief A Macro that sets the number of blocks a ring between two threads holds.
+ */
+#define RING_CAPACITY 4
+
+/**
+ * @def RING_SPINS 64
+ * @brief A Macro that sets the number of times a thread yields on a full or an empty ring before
+ *        it sleeps until the other thread of the ring wakes it.
+ */
+#define RING_SPINS 64
+
+/**
+ * @def CACHE_LINE_SIZE 64
+ * @brief A Macro that sets the number of bytes of a cache line.
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @def RECORDS_MAGIC "CBR1"
+ * @brief A Macro that sets the bytes which start a file of records.
+ */
+#define RECORDS_MAGIC "CBR1"
+
+/**
+ * @def MAGIC_LENGTH 4
+ * @brief A Macro that sets the number of bytes of RECORDS_MAGIC.
+ */
+#define MAGIC_LENGTH 4
+
+/**
+ * @def INPUT_RECORDS 'I'
+ * @brief A Flag for a file of input records.
+ */
+#define INPUT_RECORDS 'I'
+
+/**
+ * @def OUTPUT_RECORDS 'O'
+ * @brief A Flag for a file of output records.
+ */
+#define OUTPUT_RECORDS 'O'
+
+/**
+ * @def RECORD_DIGITS 0
+ * @brief A Flag for a record whose payload is the characters of the number.
+ */
+#define RECORD_DIGITS 0
+
+/**
+ * @def RECORD_LIMBS 1
+ * @brief A Flag for a record whose payload is the 64 bits limbs of the number.
+ */
+#define RECORD_LIMBS 1
+
+/**
+ * @def RECORD_NEGATIVE 1
+ * @brief A Flag of a record of limbs whose number is negative.
+ */
+#define RECORD_NEGATIVE 1
+
+/**
+ * @def RECORD_INVALID 2
+ * @brief A Flag of an output record whose input is invalid.
+ */
+#define RECORD_INVALID 2
+
+/**
+ * @def RECORD_OUT_OF_MEMORY 4
+ * @brief A Flag of an output record whose input could not be converted for lack of memory.
+ */
+#define RECORD_OUT_OF_MEMORY 4
+
+/**
+ * @def RECORD_ALIGNMENT 8
+ * @brief A Macro that sets the alignment of the records in a file, which is the size of a limb.
+ */
+#define RECORD_ALIGNMENT 8
+
+/**
+ * @def BASES_TEXT_SIZE 16
+ * @brief A Macro that sets the number of characters which holds the two bases of a record, with
+ *        their input separators, as text.
+ */
+#define BASES_TEXT_SIZE 16
+
+#ifdef CHANGE_BASE_STATISTICS
+
+/**
+ * @def STATS_OPTION "--stats"
+ * @brief A Macro that sets the option which prints the counters of the run once it ends.
+ */
+#define STATS_OPTION "--stats"
+
+/**
+ * @def PROGRESS_OPTION "--progress"
+ * @brief A Macro that sets the option which prints the progress of the run periodically.
+ */
+#define PROGRESS_OPTION "--progress"
+
+/**
+ * @def PARSE_TIME 0
+ * @brief A Flag for the time spent reading the input and parsing the records.
+ */
+#define PARSE_TIME 0
+
+/**
+ * @def CONVERT_TIME 1
+ * @brief A Flag for the time spent converting the numbers.
+ */
+#define CONVERT_TIME 1
+
+/**
+ * @def EMIT_TIME 2
+ * @brief A Flag for the time spent gathering and writing the output.
+ */
+#define EMIT_TIME 2
+
+/**
+ * @def PHASES_NUMBER 3
+ * @brief A Macro that sets the number of phases the time of a record is split into.
+ */
+#define PHASES_NUMBER 3
+
+/**
+ * @def FLUSH_RECORDS 1024
+ * @brief A Macro that sets the number of records a thread counts before it adds its counters
+ *        to the counters of the run.
+ */
+#define FLUSH_RECORDS 1024
+
+/**
+ * @def NANOSECONDS_PER_SECOND 1000000000
+ * @brief A Macro that sets the number of nanoseconds in a second.
+ */
+#define NANOSECONDS_PER_SECOND 1000000000
+
+/**
+ * @def PERCENT 100.0
+ * @brief A Macro that sets the scale of a percentage.
+ */
+#define PERCENT 100.0
+
+/**
+ * @def PROGRESS_MESSAGE "Progress: %.1f seconds, %llu records, %.0f records per second\n"
+ * @brief A Macro that sets the output message of the periodic progress.
+ */
+#define PROGRESS_MESSAGE "Progress: %.1f seconds, %llu records, %.0f records per second\n"
+
+/**
+ * @def STATISTICS_MESSAGE "Statistics: %llu records in %.3f seconds, %.0f records per second\n"
+ * @brief A Macro that sets the output message of the counters of the run.
+ */
+#define STATISTICS_MESSAGE "Statistics: %llu records in %.3f seconds, %.0f records per second\n"
+
+/**
+ * @def TIME_MESSAGE "Time: %.3f parsing, %.3f converting, %.3f emitting\n"
+ * @brief A Macro that sets the output message of the time of the run, which is summed over the
+ *        threads.
+ */
+#define TIME_MESSAGE "Time: %.3f parsing, %.3f converting, %.3f emitting\n"
+
+/**
+ * @def HIT_RATE_MESSAGE "Cache: %.1f%% hit rate\n"
+ * @brief A Macro that sets the output message of the hit rate of the Cache.
+ */
+#define HIT_RATE_MESSAGE "Cache: %.1f%% hit rate\n"
+
+/**
+ * @def START_TIMER()
+ * @brief A Macro that starts the timer of this thread.
+ */
+#define START_TIMER() startTimer()
+
+/**
+ * @def COUNT_TIME(phase)
+ * @brief A Macro that adds the time since the timer of this thread started to the given phase,
+ *        and restarts the timer.
+ */
+#define COUNT_TIME(phase) countTime(phase)
+
+/**
+ * @def COUNT_RECORD()
+ * @brief A Macro that counts a record of this thread.
+ */
+#define COUNT_RECORD() countRecord()
+
+/**
+ * @def FLUSH_STATISTICS()
+ * @brief A Macro that adds the counters of this thread to the counters of the run.
+ */
+#define FLUSH_STATISTICS() flushStatistics()
+
+#else
+
+#define START_TIMER() ((void) 0)
+#define COUNT_TIME(phase) ((void) 0)
+#define COUNT_RECORD() ((void) 0)
+#define FLUSH_STATISTICS() ((void) 0)
+
+#endif
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The output gathered before it is written at once.
+ */
+typedef struct OutputBuffer
+{
+    /** The file descriptor the output is written to, or NO_FILE for an output which grows in
+     *  the memory. */
+    int fileDescriptor;
+    /** Non zero if writing the output, or growing it, failed. */
+    int failed;
+    /** The number of bytes gathered so far. */
+    size_t size;
+    /** The number of bytes the data can hold. */
+    size_t capacity;
+    /** The bytes gathered so far, allocated for an output of NO_FILE. */
+    char * data;
+} OutputBuffer;
+
+/**
+ * @brief The input of batch mode, read in large blocks and split into lines.
+ */
+typedef struct LineReader
+{
+    /** The file descriptor the input is read from. */
+    int fileDescriptor;
+    /** Non zero once the input has ended. */
+    int ended;
+    /** The bytes read so far and not yet split, or NULL before the first read. */
+    char * data;
+    /** The index of the first byte which is not yet split. */
+    size_t start;
+    /** The index after the last byte read. */
+    size_t end;
+    /** The number of bytes the data can hold. */
+    size_t capacity;
+} LineReader;
+
+/**
+ * @brief A block of whole input lines, and their output once they are converted.
+ */
+typedef struct RecordBlock
+{
+    /** The lines, each ends with a line separator. */
+    OutputBuffer lines;
+    /** The output of the lines. */
+    OutputBuffer output;
+    /** INVALID_STATE if any of the lines is invalid. */
+    int state;
+} RecordBlock;
+
+/**
+ * @brief A ring of blocks passed from a single thread to another single thread. A NULL block
+ *        ends the stream of blocks. A thread which waits too long for the ring sleeps on its
+ *        condition, the ring cannot be full and empty at once so only one thread sleeps on it.
+ */
+typedef struct BlockRing
+{
+    /** The blocks in the ring. */
+    RecordBlock * blocks[RING_CAPACITY];
+    /** The number of blocks taken so far, written by the consumer only. */
+    size_t head;
+    /** Keeps the indices of the two threads in different cache lines. */
+    char padding[CACHE_LINE_SIZE];
+    /** The number of blocks put so far, written by the producer only. */
+    size_t tail;
+    /** TRUE while a thread sleeps on the ring, written under the lock only. */
+    int waiting;
+    /** The lock of the condition. */
+    pthread_mutex_t lock;
+    /** Signaled when a block is put in or taken from the ring while a thread sleeps on it. */
+    pthread_cond_t changed;
+} BlockRing;
+
+/**
+ * @brief A thread of the batch pipeline converting blocks.
+ */
+typedef struct BatchWorker
+{
+    /** The thread. */
+    pthread_t thread;
+    /** The Cache the threads share, or NULL. */
+    ConverterCache * pCache;
+    /** The blocks to convert, from the reading thread. */
+    BlockRing input;
+    /** The converted blocks, to the writing thread. */
+    BlockRing output;
+} BatchWorker;
+
+/**
+ * @brief The thread of the batch pipeline writing the converted blocks in the input order.
+ */
+typedef struct BatchWriter
+{
+    /** The thread. */
+    pthread_t thread;
+    /** The converting threads, the blocks are dealt to them in turn. */
+    BatchWorker * workers;
+    /** The number of converting threads. */
+    size_t workersNumber;
+    /** INVALID_STATE if any block is invalid or cannot be written. */
+    int state;
+} BatchWriter;
+
+/**
+ * @brief The header of a file of records.
+ */
+typedef struct RecordsHeader
+{
+    /** The bytes of RECORDS_MAGIC. */
+    char magic[MAGIC_LENGTH];
+    /** INPUT_RECORDS or OUTPUT_RECORDS. */
+    uint8_t kind;
+    /** Zeros. */
+    uint8_t reserved[3];
+} RecordsHeader;
+
+/**
+ * @brief The header of a record, which its payload follows.
+ */
+typedef struct RecordHeader
+{
+    /** The base the number is represented in, or 0 for an invalid base. */
+    uint8_t originalBase;
+    /** The base to convert the number to, or 0 for an invalid base. */
+    uint8_t newBase;
+    /** RECORD_DIGITS or RECORD_LIMBS. */
+    uint8_t format;
+    /** RECORD_NEGATIVE, RECORD_INVALID and RECORD_OUT_OF_MEMORY. */
+    uint8_t flags;
+    /** The number of bytes of the payload, without its padding. */
+    uint32_t length;
+} RecordHeader;
+
+/**
+ * @brief A file mapped to the memory.
+ */
+typedef struct MappedFile
+{
+    /** The bytes of the file. */
+    unsigned char * data;
+    /** The number of bytes of the file. */
+    size_t size;
+} MappedFile;
+
+#ifdef CHANGE_BASE_STATISTICS
+
+/**
+ * @brief The counters of a single thread, which it adds to the counters of the run now and
+ *        then, so the threads do not share them while they convert.
+ */
+typedef struct ThreadStatistics
+{
+    /** The number of records counted since the last flush. */
+    unsigned long long records;
+    /** The timer ticks of every phase since the last flush. */
+    unsigned long long ticks[PHASES_NUMBER];
+    /** The timer when the current phase started. */
+    unsigned long long timer;
+} ThreadStatistics;
+
+/**
+ * @brief The counters of a run, which every thread adds to, and the thread printing its
+ *        progress.
+ */
+typedef struct RunStatistics
+{
+    /** Non zero if the run is counted. */
+    int counting;
+    /** The number of records converted. */
+    unsigned long long records;
+    /** The timer ticks of every phase, summed over the threads. */
+    unsigned long long ticks[PHASES_NUMBER];
+    /** The counters of the Cache, if there is one. */
+    ConverterCacheStatistics cache;
+    /** Non zero if there is a Cache. */
+    int cached;
+    /** The timer when the run started. */
+    unsigned long long startTicks;
+    /** The time when the run started. */
+    struct timespec start;
+    /** The number of seconds between two progress messages, or 0 for none. */
+    double progressInterval;
+    /** The thread printing the progress. */
+    pthread_t progressThread;
+    /** Non zero once the run ended. */
+    int stopped;
+    /** The lock of 'stopped'. */
+    pthread_mutex_t lock;
+    /** Signaled when the run ends. */
+    pthread_cond_t stop;
+} RunStatistics;
+
+/**
+ * @brief The counters of the run.
+ */
+static RunStatistics runStatistics;
+
+/**
+ * @brief The counters of this thread.
+ */
+static __thread ThreadStatistics threadStatistics;
+
+#endif
+
+
+/*----=  Forward Declarations  =-----*/
+
+
+/**
+ * @brief Converts a single input from the standard input and prints the result.
+ * @param threads The number of threads converting the input.
+ * @return 0 if the input was converted, 1 otherwise.
+ */
+int convertInput(size_t const threads);
+
+/**
+ * @brief Converts every input line of the given file and prints a line for each of them.
+ * @param fileName The name of the file, or NULL for the standard input.
+ * @param threads The number of threads converting the lines.
+ * @param cacheSize The number of megabytes of the Cache, 0 for none.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertBatch(char const * const fileName, size_t const threads, size_t const cacheSize);
+
+/**
+ * @brief Converts every input line of the given file in this thread.
+ * @param fileDescriptor The file.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertLines(int const fileDescriptor, ConverterCache * const pCache);
+
+/**
+ * @brief Converts a single input line and appends its output line to the given output.
+ * @param line The line.
+ * @param length The number of characters of the line.
+ * @param pOutput The output.
+ * @param pArena The Arena converting the number, or NULL.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if the line was converted, 1 otherwise.
+ */
+int convertLine(char const * const line, size_t const length, OutputBuffer * const pOutput,
+                ConverterArena * const pArena, ConverterCache * const pCache);
+
+/**
+ * @brief Converts every input line of the given file by a pipeline of threads.
+ * @param fileDescriptor The file.
+ * @param threads The number of threads converting the lines.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertPipeline(int const fileDescriptor, size_t const threads,
+                    ConverterCache * const pCache);
+
+/**
+ * @brief Reads the next block of whole lines of the given input.
+ * @param pReader The input.
+ * @param ppBlock The path to store the block in.
+ * @return 1 if a block was read, 0 if the input has ended and -1 if the input cannot be read or
+ *         there is not enough memory.
+ */
+int readBlock(LineReader * const pReader, RecordBlock ** const ppBlock);
+
+/**
+ * @brief The body of a converting thread, converts the blocks of its input ring and passes them
+ *        to its output ring. The thread converts from an Arena of its own.
+ * @param pWorker The BatchWorker of the thread.
+ * @return NULL.
+ */
+void * convertBlocks(void * pWorker);
+
+/**
+ * @brief The body of the writing thread, writes the converted blocks in the input order.
+ * @param pWriter The BatchWriter of the thread.
+ * @return NULL.
+ */
+void * writeBlocks(void * pWriter);
+
+/**
+ * @brief Releases the given block.
+ * @param pBlock The block.
+ */
+void freeBlock(RecordBlock * const pBlock);
+
+/**
+ * @brief Puts the given block in the given ring, waiting while the ring is full.
+ * @param pRing The ring, only this thread puts blocks in it.
+ * @param pBlock The block, or NULL to end the stream of blocks.
+ */
+void pushBlock(BlockRing * const pRing, RecordBlock * const pBlock);
+
+/**
+ * @brief Takes the next block of the given ring, waiting while the ring is empty.
+ * @param pRing The ring, only this thread takes blocks from it.
+ * @return The block, or NULL once the stream of blocks has ended.
+ */
+RecordBlock * popBlock(BlockRing * const pRing);
+
+/**
+ * @brief Wakes the thread sleeping on the given ring, if there is one.
+ * @param pRing The ring.
+ */
+void wakeRing(BlockRing * const pRing);
+
+/**
+ * @brief Converts every record of the given file of input records, and writes a record for each
+ *        of them to the given output file.
+ * @param inputName The name of the file of input records.
+ * @param outputName The name of the output file.
+ * @param threads The number of threads converting a long number.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertRecords(char const * const inputName, char const * const outputName,
+                   size_t const threads);
+
+/**
+ * @brief Writes every input line of the given text file as an input record of the given output
+ *        file.
+ * @param inputName The name of the text file.
+ * @param outputName The name of the output file.
+ * @param limbs Non zero for writing the valid numbers as limbs rather than digits.
+ * @return 0 if every line was written, 1 otherwise.
+ */
+int packRecords(char const * const inputName, char const * const outputName, int const limbs);
+
+/**
+ * @brief Writes every record of the given file of records as a text line of the given output
+ *        file.
+ * @param inputName The name of the file of records.
+ * @param outputName The name of the output file.
+ * @return 0 if every record was written, 1 otherwise.
+ */
+int unpackRecords(char const * const inputName, char const * const outputName);
+
+/**
+ * @brief Writes a single input line as an input record to the given output.
+ * @param line The line.
+ * @param length The number of characters of the line.
+ * @param pOutput The output.
+ * @param limbs Non zero for writing a valid number as limbs rather than digits.
+ * @param ppLimbs The path of the buffer of the limbs, which grows as needed.
+ * @param pCapacity The path of the number of limbs the buffer holds.
+ * @return 0 if the record was written, 1 otherwise.
+ */
+int packLine(char const * const line, size_t const length, OutputBuffer * const pOutput,
+             int const limbs, uint64_t ** const ppLimbs, size_t * const pCapacity);
+
+/**
+ * @brief Converts the number of the given input record to the given buffer.
+ * @param pRecord The record.
+ * @param newBase The base to convert the number to.
+ * @param result The buffer.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in.
+ * @param pArena The Arena converting the number, or NULL.
+ * @return The state of the Base Converter library.
+ */
+int convertPayload(RecordHeader const * const pRecord, int const newBase, char * const result,
+                   size_t const capacity, size_t * const pLength, ConverterArena * const pArena);
+
+/**
+ * @brief Returns the number of characters which is enough for the converted number of the given
+ *        input record.
+ * @param pRecord The record.
+ * @param newBase The base to convert the number to.
+ * @return The number of characters, or 0 if they may not fit in a record.
+ */
+size_t payloadBound(RecordHeader const * const pRecord, int const newBase);
+
+/**
+ * @brief Returns the number of bytes of a record of the given payload length, with its header
+ *        and its padding.
+ * @param length The number of bytes of the payload.
+ * @return The number of bytes of the record.
+ */
+size_t recordSize(size_t const length);
+
+/**
+ * @brief Returns the header of a file of records of the given kind.
+ * @param kind INPUT_RECORDS or OUTPUT_RECORDS.
+ * @return The header.
+ */
+RecordsHeader recordsHeader(uint8_t const kind);
+
+/**
+ * @brief Finds the next record of the given file of records.
+ * @param pFile The file.
+ * @param pOffset The path of the offset of the next record, which is advanced past it.
+ * @param ppRecord The path to store the record in.
+ * @return 1 if a record was found, 0 if the file has ended and -1 if the record is not valid.
+ */
+int nextRecord(MappedFile const * const pFile, size_t * const pOffset,
+               RecordHeader const ** const ppRecord);
+
+/**
+ * @brief Maps the given file of records to the memory and checks its header.
+ * @param fileName The name of the file.
+ * @param pFile The path to store the mapped file in.
+ * @return 0 if the file was mapped, 1 otherwise.
+ */
+int mapRecords(char const * const fileName, MappedFile * const pFile);
+
+/**
+ * @brief Opens the given file.
+ * @param fileName The name of the file, STANDARD_INPUT_NAME or STANDARD_OUTPUT_NAME.
+ * @param output Non zero for a file to write, which is created and truncated.
+ * @return The file descriptor, or -1 if the file cannot be opened.
+ */
+int openFile(char const * const fileName, int const output);
+
+/**
+ * @brief Closes the given file, unless it is the standard input or output.
+ * @param fileDescriptor The file descriptor.
+ */
+void closeFile(int const fileDescriptor);
+
+/**
+ * @brief Converts the given number from the given original base to the given new base and
+ *        appends the result to the given output.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param pOutput The output to append the result to.
+ * @param pArena The Arena converting the number, or NULL.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if the number was converted, 1 if the input is invalid and 2 if there is not
+ *         enough memory.
+ */
+int convertRecord(int const originalBase, int const newBase, char const * const number,
+                  size_t const length, OutputBuffer * const pOutput,
+                  ConverterArena * const pArena, ConverterCache * const pCache);
+
+/**
+ * @brief Reads the number of the user input, up to the character which ends it.
+ * @param pDigits The path to store the characters of the number in, as a string the caller
+ *        releases.
+ * @param pLength The path to store the number of characters in.
+ * @return 0 if the number was read, 1 if there is not enough memory.
+ */
+int readNumber(char ** const pDigits, size_t * const pLength);
+
+/**
+ * @brief Reads the next line of the given input, without its line separator.
+ * @param pReader The input.
+ * @param pLine The path to store the start of the line in, valid up to the next read.
+ * @param pLength The path to store the number of characters of the line in.
+ * @return 1 if a line was read, 0 if the input has ended and -1 if the input cannot be read or
+ *         there is not enough memory.
+ */
+int readLine(LineReader * const pReader, char const ** const pLine, size_t * const pLength);
+
+/**
+ * @brief Parses a single input line of the format <original base>^<new base>^<number>^.
+ * @param line The line.
+ * @param length The number of characters of the line.
+ * @param pOriginalBase The path to store the original base in.
+ * @param pNewBase The path to store the new base in.
+ * @param pNumber The path to store the start of the number in.
+ * @param pNumberLength The path to store the number of characters of the number in.
+ * @return 0 if the line has the required format, 1 otherwise.
+ */
+int parseLine(char const * const line, size_t const length, int * const pOriginalBase,
+              int * const pNewBase, char const ** const pNumber, size_t * const pNumberLength);
+
+/**
+ * @brief Parses a single base of an input line, which ends with the input separator.
+ * @param cursor The first character of the base.
+ * @param end The end of the line.
+ * @param pBase The path to store the base in, a base of too many digits is stored as 0.
+ * @return The character after the input separator, or NULL if the base is not a number which
+ *         ends with the input separator.
+ */
+char const * parseBase(char const * cursor, char const * const end, int * const pBase);
+
+/**
+ * @brief Makes room for the given number of bytes at the end of the given output.
+ * @param pOutput The output.
+ * @param length The number of bytes.
+ * @return The room, which the caller fills and adds to the size of the output, or NULL if the
+ *         bytes do not fit in an empty output or there is not enough memory.
+ */
+char * reserveOutput(OutputBuffer * const pOutput, size_t const length);
+
+/**
+ * @brief Appends the given bytes to the given output, and writes the output once it is full.
+ * @param pOutput The output.
+ * @param data The bytes to append.
+ * @param length The number of bytes.
+ */
+void appendOutput(OutputBuffer * const pOutput, char const * const data, size_t const length);
+
+/**
+ * @brief Writes the bytes gathered in the given output.
+ * @param pOutput The output.
+ */
+void flushOutput(OutputBuffer * const pOutput);
+
+/**
+ * @brief Grows the data of the given output of NO_FILE, so it holds the given number of bytes.
+ * @param pOutput The output.
+ * @param capacity The number of bytes.
+ * @return 0 if the output has grown, 1 if there is not enough memory.
+ */
+int growOutput(OutputBuffer * const pOutput, size_t const capacity);
+
+/**
+ * @brief Writes the given bytes to the file of the given output, unless writing already failed.
+ * @param pOutput The output.
+ * @param data The bytes to write.
+ * @param length The number of bytes.
+ */
+void writeOutput(OutputBuffer * const pOutput, char const * data, size_t length);
+
+#ifdef CHANGE_BASE_STATISTICS
+
+/**
+ * @brief Reads the timer of the statistics, the time stamp counter if the CPU has one and the
+ *        monotonic clock in nanoseconds otherwise.
+ * @return The ticks of the timer.
+ */
+unsigned long long readTimer(void);
+
+/**
+ * @brief Returns the number of seconds since the given time.
+ * @param pStart The time to measure from.
+ * @return The number of seconds.
+ */
+double secondsSince(struct timespec const * const pStart);
+
+/**
+ * @brief Starts counting the run, and the thread printing its progress if it is needed.
+ * @param progressInterval The number of seconds between two progress messages, or 0 for none.
+ */
+void startStatistics(double const progressInterval);
+
+/**
+ * @brief Stops counting the run, and prints its counters if they are needed.
+ * @param print Non zero for printing the counters.
+ */
+void stopStatistics(int const print);
+
+/**
+ * @brief The routine of the thread printing the progress of the run until the run ends.
+ * @param pStatistics The counters of the run.
+ * @return NULL.
+ */
+void * printProgress(void * pStatistics);
+
+/**
+ * @brief Starts the timer of this thread, if the run is counted.
+ */
+void startTimer(void);
+
+/**
+ * @brief Adds the time since the timer of this thread started to the given phase, and restarts
+ *        the timer, if the run is counted.
+ * @param phase PARSE_TIME, CONVERT_TIME or EMIT_TIME.
+ */
+void countTime(int const phase);
+
+/**
+ * @brief Counts a record of this thread, if the run is counted. Every FLUSH_RECORDS records the
+ *        counters of this thread are added to the counters of the run.
+ */
+void countRecord(void);
+
+/**
+ * @brief Adds the counters of this thread to the counters of the run, and resets them.
+ */
+void flushStatistics(void);
+
+#endif
+
+
+/*----=  Main  =-----*/
+
+
+/**
+ * @brief The main function that runs the program. The function receive input from the user
+ *        and perform the base conversion using the base conversion functions.
+ *        The function determines if the input is valid, and if so it prints the result of the
+ *        base conversion. If the input is invalid, the function will print an error message.
+ *        With '--batch' the function does so for every line of the given file or of the
+ *        standard input. Both are done by the given number of threads, and in batch mode the
+ *        repeating numbers may be copied from a Cache of the given number of megabytes.
+ *        With '--binary', '--pack' and '--unpack' the function converts, writes or reads the
+ *        files of binary records.
+ * @param argc The number of arguments.
+ * @param argv The arguments, which may be '--batch', '--threads' and its number, '--cache' and
+ *        its number and a file name, or '--binary', '--pack' or '--unpack' and their files.
+ * @return 0 when the program ran successfully, 1 otherwise.
+ */
+int main(int argc, char * argv[])
+{
+    if (argc == 4 && strcmp(argv[1], UNPACK_OPTION) == 0)
+    {
+        return unpackRecords(argv[2], argv[3]);
+    }
+    int const limbs = (argc == 5 && strcmp(argv[2], LIMBS_OPTION) == 0);
+    if ((argc == 4 || limbs) && strcmp(argv[1], PACK_OPTION) == 0)
+    {
+        return packRecords(argv[argc - 2], argv[argc - 1], limbs);
+    }
+
+    int index = 1;
+    int const batch = (index < argc && strcmp(argv[index], BATCH_OPTION) == 0);
+    int const binary = (index < argc && strcmp(argv[index], BINARY_OPTION) == 0);
+    if (batch || binary)
+    {
+        index++;
+    }
+    long threads = 1;
+    if (index < argc && strcmp(argv[index], THREADS_OPTION) == 0)
+    {
+        char * end = NULL;
+        threads = (index + 1 < argc) ? strtol(argv[index + 1], &end, STANDARD_BASE) : 0;
+        threads = (end != NULL && *end == '\0') ? threads : 0;
+        index += 2;
+    }
+    long cacheSize = 0;
+    if (batch && index < argc && strcmp(argv[index], CACHE_OPTION) == 0)
+    {
+        char * end = NULL;
+        cacheSize = (index + 1 < argc) ? strtol(argv[index + 1], &end, STANDARD_BASE) : 0;
+        cacheSize = (end != NULL && *end == '\0' && cacheSize >= 1 &&
+                     cacheSize <= MAX_CACHE_SIZE) ? cacheSize : -1;
+        index += 2;
+    }
+#ifdef CHANGE_BASE_STATISTICS
+    int const statistics = ((batch || binary) && index < argc &&
+                            strcmp(argv[index], STATS_OPTION) == 0);
+    if (statistics)
+    {
+        index++;
+    }
+    double progressInterval = 0;
+    if ((batch || binary) && index < argc && strcmp(argv[index], PROGRESS_OPTION) == 0)
+    {
+        char * end = NULL;
+        progressInterval = (index + 1 < argc) ? strtod(argv[index + 1], &end) : 0;
+        progressInterval = (end != NULL && *end == '\0' && progressInterval > 0) ?
+                           progressInterval : -1;
+        index += 2;
+    }
+#endif
+
+    if (threads >= 1 && threads <= CONVERTER_MAX_THREADS && !batch && !binary && index == argc)
+    {
+        return convertInput((size_t) threads);
+    }
+    int valid = (threads >= 1 && threads <= CONVERTER_MAX_THREADS &&
+                 ((binary && argc - index == 2) || (batch && cacheSize >= 0 &&
+                                                    argc - index <= 1)));
+#ifdef CHANGE_BASE_STATISTICS
+    valid = valid && progressInterval >= 0;
+#endif
+    if (!valid)
+    {
+        fprintf(stderr, INVALID_ARGUMENTS_MESSAGE);
+        return INVALID_STATE;
+    }
+
+#ifdef CHANGE_BASE_STATISTICS
+    if (statistics || progressInterval > 0)
+    {
+        startStatistics(progressInterval);
+    }
+#endif
+    int const state = binary ? convertRecords(argv[index], argv[index + 1], (size_t) threads) :
+                               convertBatch(index < argc ? argv[index] : NULL, (size_t) threads,
+                                            (size_t) cacheSize);
+#ifdef CHANGE_BASE_STATISTICS
+    if (statistics || progressInterval > 0)
+    {
+        stopStatistics(statistics);
+    }
+#endif
+    return state;
+}
+
+
+/*----=  Input Conversion  =-----*/
+
+
+/**
+ * @brief Converts a single input from the standard input and prints the result.
+ *        With more than a single thread, a pool of the other threads, held by the Arena of the
+ *        conversion, converts a long number along with this thread.
+ * @param threads The number of threads converting the input.
+ * @return 0 if the input was converted, 1 otherwise.
+ */
+int convertInput(size_t const threads)
+{
+    // Initialize variables.
+    int originalBase = 0;
+    int newBase = 0;
+    char * number = NULL;
+    size_t length = 0;
+
+    // Receive input from user parse it to the relevant variables.
+    if (scanf("%d^%d^", &originalBase, &newBase) != 2 || readNumber(&number, &length))
+    {
+        free(number);
+        fprintf(stderr, INVALID_INPUT_MESSAGE);
+        return INVALID_STATE;
+    }
+
+    // Without an Arena, the number is still converted in this thread from the heap.
+    ConverterArena * const pArena = converterCreateArena(threads);
+    char data[OUTPUT_BUFFER_SIZE];
+    OutputBuffer output = {STDOUT_FILENO, FALSE, 0, OUTPUT_BUFFER_SIZE, data};
+    int const state = convertRecord(originalBase, newBase, number, length, &output, pArena,
+                                    NULL);
+    flushOutput(&output);
+    converterDestroyArena(pArena);
+    if (state == INVALID_STATE)
+    {
+        fprintf(stderr, INVALID_INPUT_MESSAGE);
+    }
+    else if (state == OUT_OF_MEMORY_STATE)
+    {
+        fprintf(stderr, OUT_OF_MEMORY_MESSAGE);
+    }
+
+    free(number);
+    return (state == VALID_STATE && !output.failed) ? VALID_STATE : INVALID_STATE;
+}
+
+/**
+ * @brief Converts every input line of the given file and prints a line for each of them.
+ *        The input is read in large blocks and the output is written in large blocks, an
+ *        invalid line, an empty one too, prints its error message in its place and the
+ *        conversion continues.
+ *        With a Cache, its counters are printed once the lines end. If there is not enough
+ *        memory for the Cache, the lines are converted without it.
+ * @param fileName The name of the file, or NULL for the standard input.
+ * @param threads The number of threads converting the lines.
+ * @param cacheSize The number of megabytes of the Cache, 0 for none.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertBatch(char const * const fileName, size_t const threads, size_t const cacheSize)
+{
+    int fileDescriptor = STDIN_FILENO;
+    if (fileName != NULL && strcmp(fileName, STANDARD_INPUT_NAME) != 0)
+    {
+        fileDescriptor = open(fileName, O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            fprintf(stderr, INVALID_FILE_MESSAGE, fileName);
+            return INVALID_STATE;
+        }
+    }
+
+    ConverterCache * const pCache = (cacheSize > 0) ?
+                                    converterCreateCache(cacheSize << MEGABYTE_SHIFT) : NULL;
+    int const state = (threads > 1) ? convertPipeline(fileDescriptor, threads, pCache) :
+                                      convertLines(fileDescriptor, pCache);
+    if (fileDescriptor != STDIN_FILENO)
+    {
+        close(fileDescriptor);
+    }
+    if (pCache != NULL)
+    {
+        ConverterCacheStatistics statistics;
+        converterCacheStatistics(pCache, &statistics);
+        fprintf(stderr, CACHE_STATISTICS_MESSAGE, statistics.hits, statistics.misses,
+                statistics.evictions);
+#ifdef CHANGE_BASE_STATISTICS
+        runStatistics.cache = statistics;
+        runStatistics.cached = TRUE;
+#endif
+        converterDestroyCache(pCache);
+    }
+    return state;
+}
+
+/**
+ * @brief Converts every input line of the given file in this thread.
+ *        The lines share a single Arena, so once it holds the memory of the longest line no
+ *        line allocates any memory.
+ * @param fileDescriptor The file.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertLines(int const fileDescriptor, ConverterCache * const pCache)
+{
+    LineReader reader = {fileDescriptor, FALSE, NULL, 0, 0, 0};
+    char data[OUTPUT_BUFFER_SIZE];
+    OutputBuffer output = {STDOUT_FILENO, FALSE, 0, OUTPUT_BUFFER_SIZE, data};
+    ConverterArena * const pArena = converterCreateArena(1);
+    int state = VALID_STATE;
+    char const * line = NULL;
+    size_t length = 0;
+    int found = 0;
+    START_TIMER();
+    while ((found = readLine(&reader, &line, &length)) > 0)
+    {
+        if (convertLine(line, length, &output, pArena, pCache) != VALID_STATE)
+        {
+            state = INVALID_STATE;
+        }
+    }
+    flushOutput(&output);
+    COUNT_TIME(EMIT_TIME);
+    FLUSH_STATISTICS();
+    converterDestroyArena(pArena);
+
+    if (found < 0)
+    {
+        fprintf(stderr, READ_ERROR_MESSAGE);
+        state = INVALID_STATE;
+    }
+    if (output.failed)
+    {
+        state = INVALID_STATE;
+    }
+    free(reader.data);
+    return state;
+}
+
+/**
+ * @brief Converts a single input line and appends its output line to the given output, which
+ *        is the converted number or the error message of the line.
+ * @param line The line.
+ * @param length The number of characters of the line.
+ * @param pOutput The output.
+ * @param pArena The Arena converting the number, or NULL.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if the line was converted, 1 otherwise.
+ */
+int convertLine(char const * const line, size_t const length, OutputBuffer * const pOutput,
+                ConverterArena * const pArena, ConverterCache * const pCache)
+{
+    int originalBase = 0;
+    int newBase = 0;
+    char const * number = NULL;
+    size_t numberLength = 0;
+    int state = parseLine(line, length, &originalBase, &newBase, &number, &numberLength);
+    COUNT_TIME(PARSE_TIME);
+    if (state == VALID_STATE)
+    {
+        state = convertRecord(originalBase, newBase, number, numberLength, pOutput, pArena,
+                              pCache);
+    }
+    if (state == INVALID_STATE)
+    {
+        appendOutput(pOutput, INVALID_INPUT_MESSAGE, strlen(INVALID_INPUT_MESSAGE));
+    }
+    else if (state == OUT_OF_MEMORY_STATE)
+    {
+        appendOutput(pOutput, OUT_OF_MEMORY_MESSAGE, strlen(OUT_OF_MEMORY_MESSAGE));
+        state = INVALID_STATE;
+    }
+    COUNT_TIME(EMIT_TIME);
+    COUNT_RECORD();
+    return state;
+}
+
+/**
+ * @brief Converts the given number from the given original base to the given new base and
+ *        appends the result to the given output.
+ *        The converted number is written straight to the output, in room which fits any number
+ *        of its length. A number which does not fit in the output is converted aside.
+ *        With a Cache, a number which was converted before is copied from it.
+ * @param originalBase The base the number is represented in.
+ * @param newBase The base to convert the number to.
+ * @param number The number, which may start with a sign.
+ * @param length The number of characters in the number.
+ * @param pOutput The output to append the result to.
+ * @param pArena The Arena converting the number, or NULL.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if the number was converted, 1 if the input is invalid and 2 if there is not
+ *         enough memory.
+ */
+int convertRecord(int const originalBase, int const newBase, char const * const number,
+                  size_t const length, OutputBuffer * const pOutput,
+                  ConverterArena * const pArena, ConverterCache * const pCache)
+{
+    // The room holds the line separator as well.
+    size_t const capacity = converterBound(originalBase, newBase, length) + 1;
+    char * const room = reserveOutput(pOutput, capacity);
+    char * const result = (room != NULL) ? room : malloc(capacity);
+    if (result == NULL)
+    {
+        return OUT_OF_MEMORY_STATE;
+    }
+
+    COUNT_TIME(EMIT_TIME);
+    size_t resultLength = 0;
+    int const state = converterCacheConvert(pCache, originalBase, newBase, number, length, result,
+                                            capacity - 1, &resultLength, pArena);
+    COUNT_TIME(CONVERT_TIME);
+    if (state == CONVERTER_VALID)
+    {
+        result[resultLength++] = LINE_SEPARATOR;
+        if (room != NULL)
+        {
+            pOutput->size += resultLength;
+        }
+        else
+        {
+            appendOutput(pOutput, result, resultLength);
+        }
+    }
+    if (room == NULL)
+    {
+        free(result);
+    }
+
+    if (state == CONVERTER_VALID)
+    {
+        return VALID_STATE;
+    }
+    return (state == CONVERTER_INVALID) ? INVALID_STATE : OUT_OF_MEMORY_STATE;
+}
+
+
+/*----=  Batch Pipeline  =-----*/
+
+
+/**
+ * @brief Converts every input line of the given file by a pipeline of threads.
+ *        This thread reads blocks of whole lines and deals them in turn to the converting
+ *        threads, and the writing thread collects the converted blocks in the same turn, so the
+ *        output keeps the order of the input. Every pair of threads is connected by a ring of
+ *        a single producer and a single consumer, which needs no lock unless a thread has waited
+ *        long enough for it to sleep.
+ *        If the threads cannot be started, the lines are converted in this thread.
+ * @param fileDescriptor The file.
+ * @param threads The number of threads converting the lines.
+ * @param pCache The Cache, or NULL.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertPipeline(int const fileDescriptor, size_t const threads,
+                    ConverterCache * const pCache)
+{
+    BatchWorker * const workers = calloc(threads, sizeof(BatchWorker));
+    if (workers == NULL)
+    {
+        return convertLines(fileDescriptor, pCache);
+    }
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers[i].pCache = pCache;
+        pthread_mutex_init(&workers[i].input.lock, NULL);
+        pthread_cond_init(&workers[i].input.changed, NULL);
+        pthread_mutex_init(&workers[i].output.lock, NULL);
+        pthread_cond_init(&workers[i].output.changed, NULL);
+    }
+    size_t workersNumber = 0;
+    while (workersNumber < threads &&
+           pthread_create(&workers[workersNumber].thread, NULL, convertBlocks,
+                          &workers[workersNumber]) == 0)
+    {
+        workersNumber++;
+    }
+
+    BatchWriter writer = {0};
+    writer.workers = workers;
+    writer.workersNumber = workersNumber;
+    writer.state = VALID_STATE;
+    int const writing = (workersNumber > 0 &&
+                         pthread_create(&writer.thread, NULL, writeBlocks, &writer) == 0);
+
+    // Without a writing thread, the converting threads are stopped and this thread converts.
+    LineReader reader = {fileDescriptor, FALSE, NULL, 0, 0, 0};
+    int found = 0;
+    if (writing)
+    {
+        RecordBlock * pBlock = NULL;
+        START_TIMER();
+        for (size_t i = 0; (found = readBlock(&reader, &pBlock)) > 0; i = (i + 1) % workersNumber)
+        {
+            COUNT_TIME(PARSE_TIME);
+            pushBlock(&workers[i].input, pBlock);
+            START_TIMER();
+        }
+        COUNT_TIME(PARSE_TIME);
+        FLUSH_STATISTICS();
+    }
+    for (size_t i = 0; i < workersNumber; ++i)
+    {
+        pushBlock(&workers[i].input, NULL);
+    }
+    for (size_t i = 0; i < workersNumber; ++i)
+    {
+        pthread_join(workers[i].thread, NULL);
+    }
+    free(reader.data);
+
+    int state = VALID_STATE;
+    if (writing)
+    {
+        pthread_join(writer.thread, NULL);
+        state = writer.state;
+    }
+    else
+    {
+        state = convertLines(fileDescriptor, pCache);
+    }
+    for (size_t i = 0; i < threads; ++i)
+    {
+        pthread_cond_destroy(&workers[i].input.changed);
+        pthread_mutex_destroy(&workers[i].input.lock);
+        pthread_cond_destroy(&workers[i].output.changed);
+        pthread_mutex_destroy(&workers[i].output.lock);
+    }
+    free(workers);
+
+    if (found < 0)
+    {
+        fprintf(stderr, READ_ERROR_MESSAGE);
+        state = INVALID_STATE;
+    }
+    return state;
+}
+
+/**
+ * @brief Reads the next block of whole lines of the given input, of about BLOCK_SIZE bytes.
+ * @param pReader The input.
+ * @param ppBlock The path to store the block in.
+ * @return 1 if a block was read, 0 if the input has ended and -1 if the input cannot be read or
+ *         there is not enough memory.
+ */
+int readBlock(LineReader * const pReader, RecordBlock ** const ppBlock)
+{
+    RecordBlock * const pBlock = calloc(1, sizeof(RecordBlock));
+    if (pBlock == NULL)
+    {
+        return -1;
+    }
+    pBlock->lines.fileDescriptor = NO_FILE;
+    pBlock->output.fileDescriptor = NO_FILE;
+    pBlock->state = VALID_STATE;
+
+    char const lineSeparator = LINE_SEPARATOR;
+    char const * line = NULL;
+    size_t length = 0;
+    int found = growOutput(&pBlock->lines, BLOCK_SIZE) ? -1 : 1;
+    while (found > 0 && pBlock->lines.size < BLOCK_SIZE &&
+           (found = readLine(pReader, &line, &length)) > 0)
+    {
+        appendOutput(&pBlock->lines, line, length);
+        appendOutput(&pBlock->lines, &lineSeparator, 1);
+    }
+
+    if (pBlock->lines.failed)
+    {
+        found = -1;
+    }
+    if (found < 0 || pBlock->lines.size == 0)
+    {
+        freeBlock(pBlock);
+        return (found < 0) ? -1 : 0;
+    }
+    *ppBlock = pBlock;
+    return 1;
+}
+
+/**
+ * @brief The body of a converting thread, converts the blocks of its input ring and passes them
+ *        to its output ring. The thread converts from an Arena of its own.
+ * @param pWorker The BatchWorker of the thread.
+ * @return NULL.
+ */
+void * convertBlocks(void * pWorker)
+{
+    BatchWorker * const pThis = pWorker;
+    ConverterArena * const pArena = converterCreateArena(1);
+    RecordBlock * pBlock = NULL;
+    while ((pBlock = popBlock(&pThis->input)) != NULL)
+    {
+        START_TIMER();
+        // The lines are split by a reader whose input has already ended.
+        LineReader lines = {NO_FILE, TRUE, pBlock->lines.data, 0, pBlock->lines.size,
+                            pBlock->lines.size};
+        char const * line = NULL;
+        size_t length = 0;
+        while (readLine(&lines, &line, &length) > 0)
+        {
+            if (convertLine(line, length, &pBlock->output, pArena, pThis->pCache) != VALID_STATE)
+            {
+                pBlock->state = INVALID_STATE;
+            }
+        }
+        pushBlock(&pThis->output, pBlock);
+    }
+    FLUSH_STATISTICS();
+    converterDestroyArena(pArena);
+    pushBlock(&pThis->output, NULL);
+    return NULL;
+}
+
+/**
+ * @brief The body of the writing thread, writes the converted blocks in the input order.
+ * @param pWriter The BatchWriter of the thread.
+ * @return NULL.
+ */
+void * writeBlocks(void * pWriter)
+{
+    BatchWriter * const pThis = pWriter;
+    OutputBuffer output = {STDOUT_FILENO, FALSE, 0, 0, NULL};
+    RecordBlock * pBlock = NULL;
+    for (size_t i = 0; (pBlock = popBlock(&pThis->workers[i].output)) != NULL;
+         i = (i + 1) % pThis->workersNumber)
+    {
+        START_TIMER();
+        writeOutput(&output, pBlock->output.data, pBlock->output.size);
+        COUNT_TIME(EMIT_TIME);
+        if (pBlock->output.failed)
+        {
+            fprintf(stderr, OUT_OF_MEMORY_MESSAGE);
+        }
+        if (pBlock->state != VALID_STATE || pBlock->output.failed)
+        {
+            pThis->state = INVALID_STATE;
+        }
+        freeBlock(pBlock);
+    }
+    FLUSH_STATISTICS();
+    if (output.failed)
+    {
+        pThis->state = INVALID_STATE;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Releases the given block.
+ * @param pBlock The block.
+ */
+void freeBlock(RecordBlock * const pBlock)
+{
+    free(pBlock->lines.data);
+    free(pBlock->output.data);
+    free(pBlock);
+}
+
+/**
+ * @brief Puts the given block in the given ring, waiting while the ring is full.
+ * @param pRing The ring, only this thread puts blocks in it.
+ * @param pBlock The block, or NULL to end the stream of blocks.
+ */
+void pushBlock(BlockRing * const pRing, RecordBlock * const pBlock)
+{
+    size_t const tail = pRing->tail;
+    for (int spins = 0; tail - __atomic_load_n(&pRing->head, __ATOMIC_SEQ_CST) == RING_CAPACITY;
+         ++spins)
+    {
+        if (spins < RING_SPINS)
+        {
+            sched_yield();
+            continue;
+        }
+        pthread_mutex_lock(&pRing->lock);
+        __atomic_store_n(&pRing->waiting, TRUE, __ATOMIC_SEQ_CST);
+        while (tail - __atomic_load_n(&pRing->head, __ATOMIC_SEQ_CST) == RING_CAPACITY)
+        {
+            pthread_cond_wait(&pRing->changed, &pRing->lock);
+        }
+        __atomic_store_n(&pRing->waiting, FALSE, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&pRing->lock);
+    }
+    pRing->blocks[tail % RING_CAPACITY] = pBlock;
+    __atomic_store_n(&pRing->tail, tail + 1, __ATOMIC_SEQ_CST);
+    wakeRing(pRing);
+}
+
+/**
+ * @brief Takes the next block of the given ring, waiting while the ring is empty.
+ * @param pRing The ring, only this thread takes blocks from it.
+ * @return The block, or NULL once the stream of blocks has ended.
+ */
+RecordBlock * popBlock(BlockRing * const pRing)
+{
+    size_t const head = pRing->head;
+    for (int spins = 0; __atomic_load_n(&pRing->tail, __ATOMIC_SEQ_CST) == head; ++spins)
+    {
+        if (spins < RING_SPINS)
+        {
+            sched_yield();
+            continue;
+        }
+        pthread_mutex_lock(&pRing->lock);
+        __atomic_store_n(&pRing->waiting, TRUE, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&pRing->tail, __ATOMIC_SEQ_CST) == head)
+        {
+            pthread_cond_wait(&pRing->changed, &pRing->lock);
+        }
+        __atomic_store_n(&pRing->waiting, FALSE, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&pRing->lock);
+    }
+    RecordBlock * const pBlock = pRing->blocks[head % RING_CAPACITY];
+    __atomic_store_n(&pRing->head, head + 1, __ATOMIC_SEQ_CST);
+    wakeRing(pRing);
+    return pBlock;
+}
+
+/**
+ * @brief Wakes the thread sleeping on the given ring, if there is one.
+ *        The index was stored before the flag is read, and a sleeping thread sets the flag
+ *        before it checks the index under the lock, so either the thread sees the new index or
+ *        this thread sees the flag and signals it once it waits.
+ * @param pRing The ring.
+ */
+void wakeRing(BlockRing * const pRing)
+{
+    if (__atomic_load_n(&pRing->waiting, __ATOMIC_SEQ_CST))
+    {
+        pthread_mutex_lock(&pRing->lock);
+        pthread_cond_signal(&pRing->changed);
+        pthread_mutex_unlock(&pRing->lock);
+    }
+}
+
+
+/*----=  Binary Records  =-----*/
+
+
+/**
+ * @brief Converts every record of the given file of input records, and writes a record for each
+ *        of them to the given output file.
+ *        The input file is mapped to the memory, so the digits of a record are converted where
+ *        they are and the limbs of a record are read where they are. The output file is mapped
+ *        to the memory at the size which fits the output of any input, computed by a first pass
+ *        over the headers of the records, so every number is converted straight to its place
+ *        in the output file. The output file is cut to the size of the output at the end.
+ * @param inputName The name of the file of input records.
+ * @param outputName The name of the output file.
+ * @param threads The number of threads converting a long number.
+ * @return 0 if every input was converted, 1 otherwise.
+ */
+int convertRecords(char const * const inputName, char const * const outputName,
+                   size_t const threads)
+{
+    MappedFile input = {NULL, 0};
+    START_TIMER();
+    if (mapRecords(inputName, &input))
+    {
+        return INVALID_STATE;
+    }
+    RecordHeader const * pRecord = NULL;
+    size_t offset = sizeof(RecordsHeader);
+    size_t size = sizeof(RecordsHeader);
+    int found = 0;
+    while ((found = nextRecord(&input, &offset, &pRecord)) > 0)
+    {
+        size += recordSize(payloadBound(pRecord, pRecord->newBase));
+    }
+    if (found < 0 || ((RecordsHeader const *) input.data)->kind != INPUT_RECORDS)
+    {
+        fprintf(stderr, INVALID_RECORDS_MESSAGE, inputName);
+        munmap(input.data, input.size);
+        return INVALID_STATE;
+    }
+
+    COUNT_TIME(PARSE_TIME);
+    int const fileDescriptor = openFile(outputName, TRUE);
+    unsigned char * output = MAP_FAILED;
+    if (fileDescriptor >= 0 && ftruncate(fileDescriptor, (off_t) size) == 0)
+    {
+        output = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    }
+    if (output == MAP_FAILED)
+    {
+        fprintf(stderr, WRITE_ERROR_MESSAGE, outputName);
+        closeFile(fileDescriptor);
+        munmap(input.data, input.size);
+        return INVALID_STATE;
+    }
+
+    RecordsHeader const header = recordsHeader(OUTPUT_RECORDS);
+    memcpy(output, &header, sizeof(RecordsHeader));
+    ConverterArena * const pArena = converterCreateArena(threads);
+    int state = VALID_STATE;
+    size_t outputSize = sizeof(RecordsHeader);
+    offset = sizeof(RecordsHeader);
+    COUNT_TIME(EMIT_TIME);
+    while (nextRecord(&input, &offset, &pRecord) > 0)
+    {
+        // The header is written last, as the payload is the converted number.
+        RecordHeader converted = {pRecord->originalBase, pRecord->newBase, RECORD_DIGITS, 0, 0};
+        char * const result = (char *) output + outputSize + sizeof(RecordHeader);
+        size_t length = 0;
+        COUNT_TIME(PARSE_TIME);
+        int const converterState = convertPayload(pRecord, pRecord->newBase, result,
+                                                  payloadBound(pRecord, pRecord->newBase),
+                                                  &length, pArena);
+        COUNT_TIME(CONVERT_TIME);
+        if (converterState == CONVERTER_VALID)
+        {
+            converted.length = (uint32_t) length;
+        }
+        else
+        {
+            converted.flags = (converterState == CONVERTER_INVALID) ? RECORD_INVALID :
+                                                                       RECORD_OUT_OF_MEMORY;
+            state = INVALID_STATE;
+        }
+        memset(result + converted.length, 0,
+               recordSize(converted.length) - sizeof(RecordHeader) - converted.length);
+        memcpy(output + outputSize, &converted, sizeof(RecordHeader));
+        outputSize += recordSize(converted.length);
+        COUNT_TIME(EMIT_TIME);
+        COUNT_RECORD();
+    }
+    converterDestroyArena(pArena);
+    munmap(input.data, input.size);
+
+    if (munmap(output, size) != 0 || ftruncate(fileDescriptor, (off_t) outputSize) != 0)
+    {
+        fprintf(stderr, WRITE_ERROR_MESSAGE, outputName);
+        state = INVALID_STATE;
+    }
+    closeFile(fileDescriptor);
+    COUNT_TIME(EMIT_TIME);
+    FLUSH_STATISTICS();
+    return state;
+}
+
+/**
+ * @brief Writes every input line of the given text file as an input record of the given output
+ *        file. An empty line is written as a record of invalid bases, as in batch mode it gets
+ *        its error message.
+ * @param inputName The name of the text file, or STANDARD_INPUT_NAME.
+ * @param outputName The name of the output file, or STANDARD_OUTPUT_NAME.
+ * @param limbs Non zero for writing the valid numbers as limbs rather than digits.
+ * @return 0 if every line was written, 1 otherwise.
+ */
+int packRecords(char const * const inputName, char const * const outputName, int const limbs)
+{
+    int const inputFile = openFile(inputName, FALSE);
+    if (inputFile < 0)
+    {
+        fprintf(stderr, INVALID_FILE_MESSAGE, inputName);
+        return INVALID_STATE;
+    }
+    int const outputFile = openFile(outputName, TRUE);
+    if (outputFile < 0)
+    {
+        fprintf(stderr, INVALID_FILE_MESSAGE, outputName);
+        closeFile(inputFile);
+        return INVALID_STATE;
+    }
+
+    LineReader reader = {inputFile, FALSE, NULL, 0, 0, 0};
+    char data[OUTPUT_BUFFER_SIZE];
+    OutputBuffer output = {outputFile, FALSE, 0, OUTPUT_BUFFER_SIZE, data};
+    RecordsHeader const header = recordsHeader(INPUT_RECORDS);
+    appendOutput(&output, (char const *) &header, sizeof(RecordsHeader));
+    uint64_t * limbsBuffer = NULL;
+    size_t limbsCapacity = 0;
+    int state = VALID_STATE;
+    char const * line = NULL;
+    size_t length = 0;
+    int found = 0;
+    while (state == VALID_STATE && (found = readLine(&reader, &line, &length)) > 0)
+    {
+        state = packLine(line, length, &output, limbs, &limbsBuffer, &limbsCapacity);
+    }
+    flushOutput(&output);
+    free(limbsBuffer);
+    free(reader.data);
+    closeFile(inputFile);
+    closeFile(outputFile);
+
+    if (found < 0)
+    {
+        fprintf(stderr, READ_ERROR_MESSAGE);
+        return INVALID_STATE;
+    }
+    if (state != VALID_STATE || output.failed)
+    {
+        fprintf(stderr, WRITE_ERROR_MESSAGE, outputName);
+        return INVALID_STATE;
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief Writes every record of the given file of records as a text line of the given output
+ *        file. Input records are written as input lines, whose numbers of limbs are written in
+ *        their original base, and output records as the output lines of batch mode.
+ * @param inputName The name of the file of records.
+ * @param outputName The name of the output file, or STANDARD_OUTPUT_NAME.
+ * @return 0 if every record was written, 1 otherwise.
+ */
+int unpackRecords(char const * const inputName, char const * const outputName)
+{
+    MappedFile input = {NULL, 0};
+    if (mapRecords(inputName, &input))
+    {
+        return INVALID_STATE;
+    }
+    int const outputFile = openFile(outputName, TRUE);
+    if (outputFile < 0)
+    {
+        fprintf(stderr, INVALID_FILE_MESSAGE, outputName);
+        munmap(input.data, input.size);
+        return INVALID_STATE;
+    }
 
+    int const inputRecords = (((RecordsHeader const *) input.data)->kind == INPUT_RECORDS);
+    char data[OUTPUT_BUFFER_SIZE];
+    OutputBuffer output = {outputFile, FALSE, 0, OUTPUT_BUFFER_SIZE, data};
+    char * digits = NULL;
+    size_t digitsCapacity = 0;
+    int state = VALID_STATE;
+    RecordHeader const * pRecord = NULL;
+    size_t offset = sizeof(RecordsHeader);
+    int found = 0;
+    while (state == VALID_STATE && (found = nextRecord(&input, &offset, &pRecord)) > 0)
+    {
+        char bases[BASES_TEXT_SIZE];
+        int const basesLength = sprintf(bases, "%d%c%d%c", pRecord->originalBase,
+                                        INPUT_SEPARATOR, pRecord->newBase, INPUT_SEPARATOR);
+        if (inputRecords)
+        {
+            appendOutput(&output, bases, (size_t) basesLength);
+        }
+        if (!inputRecords && (pRecord->flags & (RECORD_INVALID | RECORD_OUT_OF_MEMORY)))
+        {
+            char const * const message = (pRecord->flags & RECORD_INVALID) ?
+                                         INVALID_INPUT_MESSAGE : OUT_OF_MEMORY_MESSAGE;
+            appendOutput(&output, message, strlen(message));
+            continue;
+        }
 
-/*----=  Definitions  =-----*/
+        // The digits are written as they are, and the limbs in the base of the record.
+        char const * number = (char const *) (pRecord + 1);
+        size_t length = pRecord->length;
+        if (pRecord->format == RECORD_LIMBS)
+        {
+            int const base = inputRecords ? pRecord->originalBase : pRecord->newBase;
+            size_t const capacity = payloadBound(pRecord, base);
+            if (capacity > digitsCapacity)
+            {
+                free(digits);
+                digits = malloc(capacity);
+                digitsCapacity = (digits != NULL) ? capacity : 0;
+            }
+            if (digits == NULL || convertPayload(pRecord, base, digits, capacity, &length, NULL))
+            {
+                state = INVALID_STATE;
+                break;
+            }
+            number = digits;
+        }
+        char const separators[] = {INPUT_SEPARATOR, LINE_SEPARATOR};
+        appendOutput(&output, number, length);
+        appendOutput(&output, inputRecords ? separators : separators + 1,
+                     inputRecords ? sizeof(separators) : 1);
+    }
+    flushOutput(&output);
+    free(digits);
+    munmap(input.data, input.size);
+    closeFile(outputFile);
 
+    if (found < 0 || state != VALID_STATE)
+    {
+        fprintf(stderr, INVALID_RECORDS_MESSAGE, inputName);
+        return INVALID_STATE;
+    }
+    if (output.failed)
+    {
+        fprintf(stderr, WRITE_ERROR_MESSAGE, outputName);
+        return INVALID_STATE;
+    }
+    return VALID_STATE;
+}
 
 /**
- * @def VALID_STATE 0
- * @brief A Flag for valid state during the program run.
+ * @brief Writes a single input line as an input record to the given output.
+ *        A line which does not have the input format is written as a record of invalid bases,
+ *        whose digits are the whole line, so it stays invalid. A number which is not valid in its
+ *        base is written as digits even when limbs are asked for.
+ * @param line The line.
+ * @param length The number of characters of the line.
+ * @param pOutput The output.
+ * @param limbs Non zero for writing a valid number as limbs rather than digits.
+ * @param ppLimbs The path of the buffer of the limbs, which grows as needed.
+ * @param pCapacity The path of the number of limbs the buffer holds.
+ * @return 0 if the record was written, 1 if the number does not fit in a record or there is not
+ *         enough memory.
  */
-#define VALID_STATE 0
+int packLine(char const * const line, size_t const length, OutputBuffer * const pOutput,
+             int const limbs, uint64_t ** const ppLimbs, size_t * const pCapacity)
+{
+    int originalBase = 0;
+    int newBase = 0;
+    char const * number = NULL;
+    size_t numberLength = 0;
+    if (parseLine(line, length, &originalBase, &newBase, &number, &numberLength) != VALID_STATE)
+    {
+        originalBase = 0;
+        newBase = 0;
+        number = line;
+        numberLength = length;
+    }
+    RecordHeader record = {(uint8_t) originalBase, (uint8_t) newBase, RECORD_DIGITS, 0, 0};
+    char const * payload = number;
+    size_t payloadLength = numberLength;
+
+    size_t const capacity = converterLimbsBound(originalBase, numberLength);
+    if (limbs && capacity > 0)
+    {
+        if (capacity > *pCapacity)
+        {
+            free(*ppLimbs);
+            *ppLimbs = malloc(capacity * sizeof(uint64_t));
+            *pCapacity = (*ppLimbs != NULL) ? capacity : 0;
+        }
+        size_t size = 0;
+        int negative = FALSE;
+        int const state = (*ppLimbs == NULL) ? CONVERTER_OUT_OF_MEMORY :
+                          converterParseLimbs(originalBase, number, numberLength, *ppLimbs,
+                                              capacity, &size, &negative, NULL);
+        if (state == CONVERTER_VALID)
+        {
+            record.format = RECORD_LIMBS;
+            record.flags = negative ? RECORD_NEGATIVE : 0;
+            payload = (char const *) *ppLimbs;
+            payloadLength = size * sizeof(uint64_t);
+        }
+        else if (state != CONVERTER_INVALID)
+        {
+            return INVALID_STATE;
+        }
+    }
+    if (payloadLength > UINT32_MAX)
+    {
+        return INVALID_STATE;
+    }
+
+    char const padding[RECORD_ALIGNMENT] = {0};
+    record.length = (uint32_t) payloadLength;
+    appendOutput(pOutput, (char const *) &record, sizeof(RecordHeader));
+    appendOutput(pOutput, payload, payloadLength);
+    appendOutput(pOutput, padding, recordSize(payloadLength) - sizeof(RecordHeader) -
+                                   payloadLength);
+    return VALID_STATE;
+}
 
 /**
- * @def INVALID_STATE 1
- * @brief A Flag for invalid state during the program run.
+ * @brief Converts the number of the given input record to the given buffer. The digits and the
+ *        limbs are both read in place.
+ * @param pRecord The record.
+ * @param newBase The base to convert the number to.
+ * @param result The buffer.
+ * @param capacity The number of characters the buffer holds.
+ * @param pLength The path to store the number of characters of the converted number in.
+ * @param pArena The Arena converting the number, or NULL.
+ * @return The state of the Base Converter library.
  */
-#define INVALID_STATE 1
+int convertPayload(RecordHeader const * const pRecord, int const newBase, char * const result,
+                   size_t const capacity, size_t * const pLength, ConverterArena * const pArena)
+{
+    if (pRecord->format == RECORD_LIMBS)
+    {
+        return converterConvertLimbs(newBase, (uint64_t const *) (pRecord + 1),
+                                     pRecord->length / sizeof(uint64_t),
+                                     pRecord->flags & RECORD_NEGATIVE, result, capacity,
+                                     pLength, pArena);
+    }
+    return converterConvert(pRecord->originalBase, newBase, (char const *) (pRecord + 1),
+                            pRecord->length, result, capacity, pLength, pArena);
+}
 
 /**
- * @def STANDARD_BASE 10
- * @brief A Macro that sets the standard base which we usually use.
+ * @brief Returns the number of characters which is enough for the converted number of the given
+ *        input record, by the bounds of the Base Converter library. A number of limbs is bound
+ *        as a number of binary digits, with its sign.
+ * @param pRecord The record.
+ * @param newBase The base to convert the number to.
+ * @return The number of characters, or 0 if they may not fit in a record.
  */
-#define STANDARD_BASE 10
+size_t payloadBound(RecordHeader const * const pRecord, int const newBase)
+{
+    size_t const bound = (pRecord->format == RECORD_LIMBS) ?
+                         converterBound(CONVERTER_MIN_BASE, newBase,
+                                        (size_t) pRecord->length * CHAR_BIT) + 1 :
+                         converterBound(pRecord->originalBase, newBase, pRecord->length);
+    return (bound <= UINT32_MAX) ? bound : 0;
+}
 
 /**
- * @def TRUE 1
- * @brief A Flag for true statement.
+ * @brief Returns the number of bytes of a record of the given payload length, with its header
+ *        and its padding to RECORD_ALIGNMENT bytes.
+ * @param length The number of bytes of the payload.
+ * @return The number of bytes of the record.
  */
-#define TRUE 1
+size_t recordSize(size_t const length)
+{
+    return sizeof(RecordHeader) + (length + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT *
+                                  RECORD_ALIGNMENT;
+}
 
 /**
- * @def FALSE 0
- * @brief A Flag for false statement.
+ * @brief Returns the header of a file of records of the given kind.
+ * @param kind INPUT_RECORDS or OUTPUT_RECORDS.
+ * @return The header.
  */
-#define FALSE 0
+RecordsHeader recordsHeader(uint8_t const kind)
+{
+    RecordsHeader header;
+    memset(&header, 0, sizeof(RecordsHeader));
+    memcpy(header.magic, RECORDS_MAGIC, MAGIC_LENGTH);
+    header.kind = kind;
+    return header;
+}
 
 /**
- * @def MAX_RESULT_SIZE 20
- * @brief A Macro that sets the maximum number of digits for the result number after conversion.
+ * @brief Finds the next record of the given file of records, and checks that it is whole and
+ *        that its format is known.
+ * @param pFile The file.
+ * @param pOffset The path of the offset of the next record, which is advanced past it.
+ * @param ppRecord The path to store the record in.
+ * @return 1 if a record was found, 0 if the file has ended and -1 if the record is not valid.
  */
-#define MAX_RESULT_SIZE 20
+int nextRecord(MappedFile const * const pFile, size_t * const pOffset,
+               RecordHeader const ** const ppRecord)
+{
+    size_t const available = pFile->size - *pOffset;
+    if (available == 0)
+    {
+        return 0;
+    }
+    RecordHeader const * const pRecord = (RecordHeader const *) (pFile->data + *pOffset);
+    if (available < sizeof(RecordHeader) || recordSize(pRecord->length) > available ||
+        (pRecord->format != RECORD_DIGITS && pRecord->format != RECORD_LIMBS) ||
+        (pRecord->format == RECORD_LIMBS && pRecord->length % sizeof(uint64_t) != 0))
+    {
+        return -1;
+    }
+    *pOffset += recordSize(pRecord->length);
+    *ppRecord = pRecord;
+    return 1;
+}
 
 /**
- * @def INVALID_INPUT_MESSAGE "invalid!!\n"
- * @brief A Macro that sets the output message for invalid user input.
+ * @brief Maps the given file of records to the memory, for reading only, and checks its header.
+ * @param fileName The name of the file.
+ * @param pFile The path to store the mapped file in.
+ * @return 0 if the file was mapped, 1 otherwise.
  */
-#define INVALID_INPUT_MESSAGE "invalid!!\n"
-
-
-/*----=  Forward Declarations  =-----*/
+int mapRecords(char const * const fileName, MappedFile * const pFile)
+{
+    int const fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        fprintf(stderr, INVALID_FILE_MESSAGE, fileName);
+        return INVALID_STATE;
+    }
+    struct stat status;
+    void * data = MAP_FAILED;
+    if (fstat(fileDescriptor, &status) == 0 && (size_t) status.st_size >= sizeof(RecordsHeader))
+    {
+        data = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    }
+    close(fileDescriptor);
 
+    RecordsHeader const * const pHeader = data;
+    if (data == MAP_FAILED || memcmp(pHeader->magic, RECORDS_MAGIC, MAGIC_LENGTH) != 0 ||
+        (pHeader->kind != INPUT_RECORDS && pHeader->kind != OUTPUT_RECORDS))
+    {
+        if (data != MAP_FAILED)
+        {
+            munmap(data, (size_t) status.st_size);
+        }
+        fprintf(stderr, INVALID_RECORDS_MESSAGE, fileName);
+        return INVALID_STATE;
+    }
+    pFile->data = data;
+    pFile->size = (size_t) status.st_size;
+    return VALID_STATE;
+}
 
 /**
- * @brief Performs the base conversion from a given bases for the desired given number to convert.
- *        The function first convert the number to be represented in base 10, and then convert
- *        from base 10 to the desired new base.
- *        Explanation of the Algorithm: In the description of this function's definition.
- * @param originalBase The base in which the given number is currently represented.
- * @param newBase The base to convert the given number representation to.
- * @param number The given number, represented in the original base, that should be converted.
- * @param result The path to store the conversion result in.
- * @return char array holding the converted number.
+ * @brief Opens the given file, the standard input or output stand for themselves.
+ * @param fileName The name of the file, STANDARD_INPUT_NAME or STANDARD_OUTPUT_NAME.
+ * @param output Non zero for a file to write, which is created and truncated.
+ * @return The file descriptor, or -1 if the file cannot be opened.
  */
-char * baseConverter(int const originalBase, int const newBase, int number, char * result);
+int openFile(char const * const fileName, int const output)
+{
+    if (!output && strcmp(fileName, STANDARD_INPUT_NAME) == 0)
+    {
+        return STDIN_FILENO;
+    }
+    if (output && strcmp(fileName, STANDARD_OUTPUT_NAME) == 0)
+    {
+        return STDOUT_FILENO;
+    }
+    return output ? open(fileName, O_RDWR | O_CREAT | O_TRUNC, OUTPUT_FILE_MODE) :
+                    open(fileName, O_RDONLY);
+}
 
 /**
- * @brief An Helper function for the Base Converter function.
- *        This function perform the actual base conversion from the given number to decimal,
- *        i.e. represented in base 10.
- * @param originalBase The base in which the given number is currently represented.
- * @param number The given number, represented in the original base, that should be converted.
- * @return The number represented in base 10 as decimal.
+ * @brief Closes the given file, unless it is the standard input or output.
+ * @param fileDescriptor The file descriptor, may be -1.
  */
-int decimalConverter(int const originalBase, int number);
+void closeFile(int const fileDescriptor)
+{
+    if (fileDescriptor > STDERR_FILENO)
+    {
+        close(fileDescriptor);
+    }
+}
 
-/**
- * @brief An Helper function for the Base Converter function.
- *        This function perform the actual base conversion, assuming the original base is 10,
- *        and convert the given number to the new base.
- *        The function updates the given result array with the converted number.
- * @param newBase The base to convert the given number representation to.
- * @param number The given number, represented in the original base, that should be converted.
- * @param result The path to store the conversion result in.
- */
-void baseConverterHelper(int const newBase, int number, char * result);
 
-/**
- * @brief A Power operator. Raises the base in the power of degree.
- * @param base The base of the power.
- * @param degree The degree of the power.
- * @return The result of the base raised to the degree.
- */
-int power(int const base, int const degree);
+/*----=  Input Handling  =-----*/
 
-/**
- * @brief Verify that the given number in the user input can be represented in the
- *        given original base.
- * @param originalBase The given original base in the user input.
- * @param number The given number in the user input.
- * @return 0 if the input is invalid, 1 otherwise.
- */
-int checkInput(int const originalBase, int number);
 
 /**
- * @brief Prints the given conversion result to the standard output.
- *        During the conversion, the result is stored backwards, so this function determines which
- *        index is the last index in the result array that contains data, and from this points it
- *        prints the data all the way back.
- * @param The result of the converted number.
+ * @brief Reads the number of the user input, up to the character which ends it.
+ * @param pDigits The path to store the characters of the number in, as a string the caller
+ *        releases.
+ * @param pLength The path to store the number of characters in.
+ * @return 0 if the number was read, 1 if there is not enough memory.
  */
-void printResult(char * result);
-
+int readNumber(char ** const pDigits, size_t * const pLength)
+{
+    size_t capacity = INITIAL_DIGITS_CAPACITY;
+    size_t length = 0;
+    char * digits = malloc(capacity);
 
-/*----=  Main  =-----*/
+    // The number may follow white spaces, as in scanf.
+    int character = getchar();
+    while (character != EOF && isspace(character))
+    {
+        character = getchar();
+    }
+    for ( ; digits != NULL && character != EOF && character != INPUT_SEPARATOR &&
+            !isspace(character); character = getchar())
+    {
+        if (length + 1 == capacity)
+        {
+            capacity *= 2;
+            char * const grown = realloc(digits, capacity);
+            if (grown == NULL)
+            {
+                free(digits);
+                digits = NULL;
+                break;
+            }
+            digits = grown;
+        }
+        digits[length++] = (char) character;
+    }
 
+    if (digits == NULL)
+    {
+        return INVALID_STATE;
+    }
+    digits[length] = '\0';
+    *pDigits = digits;
+    *pLength = length;
+    return VALID_STATE;
+}
 
 /**
- * @brief The main function that runs the program. The function receive input from the user
- *        and perform the base conversion using the base conversion functions.
- *        The function determines if the input is valid, and if so it prints the result of the
- *        base conversion. If the input is invalid, the function will print an error message.
- * @return 0 when the program ran successfully, 1 otherwise.
+ * @brief Reads the next line of the given input, without its line separator and the carriage
+ *        return which may precede it. The input is read in blocks of READ_BUFFER_SIZE bytes, and
+ *        the buffer grows for a line which does not fit in it.
+ * @param pReader The input.
+ * @param pLine The path to store the start of the line in, valid up to the next read.
+ * @param pLength The path to store the number of characters of the line in.
+ * @return 1 if a line was read, 0 if the input has ended and -1 if the input cannot be read or
+ *         there is not enough memory.
  */
-int main()
+int readLine(LineReader * const pReader, char const ** const pLine, size_t * const pLength)
 {
-    // Initialize variables.
-    int originalBase = 0;
-    int newBase = 0;
-    int number = 0;
-    char result[MAX_RESULT_SIZE + 1] = {};
+    while (TRUE)
+    {
+        char * const start = pReader->data + pReader->start;
+        size_t const available = pReader->end - pReader->start;
+        char * const lineEnd = (available > 0) ? memchr(start, LINE_SEPARATOR, available) : NULL;
+        if (lineEnd != NULL || (pReader->ended && available > 0))
+        {
+            // The last line of the input may not end with a line separator.
+            size_t length = (lineEnd != NULL) ? (size_t) (lineEnd - start) : available;
+            pReader->start += (lineEnd != NULL) ? length + 1 : length;
+            if (length > 0 && start[length - 1] == CARRIAGE_RETURN)
+            {
+                length--;
+            }
+            *pLine = start;
+            *pLength = length;
+            return 1;
+        }
+        if (pReader->ended)
+        {
+            return 0;
+        }
 
-    // Receive input from user parse it to the relevant variables.
-    scanf("%d^%d^%d^", &originalBase, &newBase, &number);
+        // Keep the partial line at the start of the buffer, and grow the buffer if it is full.
+        if (pReader->start > 0)
+        {
+            memmove(pReader->data, start, available);
+            pReader->start = 0;
+            pReader->end = available;
+        }
+        if (pReader->end == pReader->capacity)
+        {
+            size_t const capacity = (pReader->capacity == 0) ? READ_BUFFER_SIZE :
+                                    2 * pReader->capacity;
+            char * const grown = realloc(pReader->data, capacity);
+            if (grown == NULL)
+            {
+                return -1;
+            }
+            pReader->data = grown;
+            pReader->capacity = capacity;
+        }
+
+        ssize_t const bytesRead = read(pReader->fileDescriptor, pReader->data + pReader->end,
+                                       pReader->capacity - pReader->end);
+        if (bytesRead < 0)
+        {
+            return -1;
+        }
+        pReader->ended = (bytesRead == 0);
+        pReader->end += (size_t) bytesRead;
+    }
+}
 
-    // If the given number is 0, it does not matter what are the bases, the result will be 0.
-    if (number == 0)
+/**
+ * @brief Parses a single input line of the format <original base>^<new base>^<number>^.
+ *        The final input separator may be missing, and white spaces may follow the input.
+ * @param line The line.
+ * @param length The number of characters of the line.
+ * @param pOriginalBase The path to store the original base in.
+ * @param pNewBase The path to store the new base in.
+ * @param pNumber The path to store the start of the number in.
+ * @param pNumberLength The path to store the number of characters of the number in.
+ * @return 0 if the line has the required format, 1 otherwise.
+ */
+int parseLine(char const * const line, size_t const length, int * const pOriginalBase,
+              int * const pNewBase, char const ** const pNumber, size_t * const pNumberLength)
+{
+    char const * const end = line + length;
+    char const * cursor = parseBase(line, end, pOriginalBase);
+    if (cursor != NULL)
     {
-        printf("%d\n", number);
+        cursor = parseBase(cursor, end, pNewBase);
     }
-    else
+    if (cursor == NULL)
+    {
+        return INVALID_STATE;
+    }
+
+    // The number ends with the input separator, or with the white spaces which end the line. A
+    // character which is not a digit inside the number is found by checking the digits.
+    char const * numberEnd = memchr(cursor, INPUT_SEPARATOR, (size_t) (end - cursor));
+    char const * rest = (numberEnd != NULL) ? numberEnd + 1 : end;
+    if (numberEnd == NULL)
     {
-        // Verify input, Convert the number and print the result.
-        if (checkInput(originalBase, number))
+        numberEnd = end;
+        while (numberEnd != cursor && isspace((unsigned char) numberEnd[-1]))
         {
-            printResult(baseConverter(originalBase, newBase, number, result));
+            numberEnd--;
         }
-        else
+    }
+    *pNumber = cursor;
+    *pNumberLength = (size_t) (numberEnd - cursor);
+
+    for ( ; rest != end; ++rest)
+    {
+        if (!isspace((unsigned char) *rest))
         {
-            fprintf(stderr, INVALID_INPUT_MESSAGE);
             return INVALID_STATE;
         }
     }
-
     return VALID_STATE;
 }
 
+/**
+ * @brief Parses a single base of an input line, which ends with the input separator.
+ * @param cursor The first character of the base.
+ * @param end The end of the line.
+ * @param pBase The path to store the base in, a base of too many digits is stored as 0.
+ * @return The character after the input separator, or NULL if the base is not a number which
+ *         ends with the input separator.
+ */
+char const * parseBase(char const * cursor, char const * const end, int * const pBase)
+{
+    char const * const start = cursor;
+    int base = 0;
+    for ( ; cursor != end && isdigit((unsigned char) *cursor); ++cursor)
+    {
+        // A base larger than the largest base is invalid, but its digits are still skipped.
+        base = (base > CONVERTER_MAX_BASE) ? base : base * STANDARD_BASE + (*cursor - '0');
+    }
+    if (cursor == start || cursor == end || *cursor != INPUT_SEPARATOR)
+    {
+        return NULL;
+    }
+    *pBase = (base > CONVERTER_MAX_BASE) ? 0 : base;
+    return cursor + 1;
+}
+
 
-/*----=  Base Conversion  =-----*/
+/*----=  Output Handling  =-----*/
 
 
 /**
- * @brief Performs the base conversion from a given bases for the desired given number to convert.
- *        The function first convert the number to be represented in base 10, and then convert
- *        from base 10 to the desired new base.
- *        Explanation of the Algorithm:
- *        The algorithm used in order to convert the number is as follow:
- *        We take each digit in the given number, starting from the lowest one, and
- *        perform Euclidean Division of this digit with the new base we want to convert to.
- *        Then, we take the remainder and multiply it with the original base raised to the power
- *        of the digit index.
- *        We take the quotient from the Euclidean Division and perform the same actions on this
- *        number. We keep doing so until the quotient is equals to 0.
- *        We sum up all of our calculations of the remainders multiplied by the original base
- *        powers, and this is the result for the converted number.
- *        The running time complexity of this algorithm is O(n) where n is the number of digits
- *        in the given number to convert.
- *        In the main call for this algorithm, we perform a conversion to base 10 first, and then
- *        convert from base 10 to the new base. So we call this function twice, so the
- *        running time complexity is O(n) + O(n), i.e. O(n).
- *        This algorithm was taught during Linear Algebra class, in order to represent one
- *        polynomial another polynomial's degrees.
- * @param originalBase The base in which the given number is currently represented.
- * @param newBase The base to convert the given number representation to.
- * @param number The given number, represented in the original base, that should be converted.
- * @param result The path to store the conversion result in.
- * @return char array holding the converted number.
+ * @brief Makes room for the given number of bytes at the end of the given output, by writing
+ *        the output once it is full. An output of NO_FILE grows instead.
+ * @param pOutput The output.
+ * @param length The number of bytes.
+ * @return The room, which the caller fills and adds to the size of the output, or NULL if the
+ *         bytes do not fit in an empty output or there is not enough memory.
  */
-char * baseConverter(int const originalBase, int const newBase, int number, char * result)
+char * reserveOutput(OutputBuffer * const pOutput, size_t const length)
 {
-    int baseTenNumber = decimalConverter(originalBase, number);  // Convert to Decimal.
-    baseConverterHelper(newBase, baseTenNumber, result);
-    return result;
+    if (pOutput->size + length > pOutput->capacity)
+    {
+        if (pOutput->fileDescriptor == NO_FILE)
+        {
+            size_t const capacity = 2 * pOutput->capacity;
+            if (growOutput(pOutput, (capacity > pOutput->size + length) ? capacity :
+                                    pOutput->size + length))
+            {
+                return NULL;
+            }
+        }
+        else
+        {
+            flushOutput(pOutput);
+            if (length > pOutput->capacity)
+            {
+                return NULL;
+            }
+        }
+    }
+    return pOutput->data + pOutput->size;
 }
 
 /**
- * @brief An Helper function for the Base Converter function.
- *        This function perform the actual base conversion from the given number to decimal,
- *        i.e. represented in base 10.
- * @param originalBase The base in which the given number is currently represented.
- * @param number The given number, represented in the original base, that should be converted.
- * @return The number represented in base 10 as decimal.
+ * @brief Appends the given bytes to the given output, and writes the output once it is full.
+ *        Bytes which do not fit in an empty output are written at once. An output of NO_FILE
+ *        grows instead.
+ * @param pOutput The output.
+ * @param data The bytes to append.
+ * @param length The number of bytes.
  */
-int decimalConverter(int const originalBase, int number)
+void appendOutput(OutputBuffer * const pOutput, char const * const data, size_t const length)
 {
-    int result = 0;
-
-    int index = 0;
-    while (number != 0)
+    char * const room = reserveOutput(pOutput, length);
+    if (room == NULL)
     {
-        int currentDigit = number % STANDARD_BASE;
-        result += (currentDigit * (power(originalBase, index)));
-        number /= STANDARD_BASE;
-        index++;
+        if (pOutput->fileDescriptor != NO_FILE)
+        {
+            writeOutput(pOutput, data, length);
+        }
+        return;
     }
+    memcpy(room, data, length);
+    pOutput->size += length;
+}
 
-    return result;
+/**
+ * @brief Writes the bytes gathered in the given output.
+ * @param pOutput The output.
+ */
+void flushOutput(OutputBuffer * const pOutput)
+{
+    writeOutput(pOutput, pOutput->data, pOutput->size);
+    pOutput->size = 0;
 }
 
 /**
- * @brief An Helper function for the Base Converter function.
- *        This function perform the actual base conversion, assuming the original base is 10,
- *        and convert the given number to the new base.
- *        The function updates the given result array with the converted number.
- * @param newBase The base to convert the given number representation to.
- * @param number The given number, represented in the original base, that should be converted.
- * @param result The path to store the conversion result in.
+ * @brief Grows the data of the given output of NO_FILE, so it holds the given number of bytes.
+ * @param pOutput The output.
+ * @param capacity The number of bytes.
+ * @return 0 if the output has grown, 1 if there is not enough memory.
  */
-void baseConverterHelper(int const newBase, int number, char * result)
+int growOutput(OutputBuffer * const pOutput, size_t const capacity)
 {
-    int index = 0;
-    while (number != 0)
+    if (pOutput->failed)
     {
-        int currentDigit = number % newBase;
-        result[index] = (char)(currentDigit + '0');
-        number /= newBase;
-        index++;
+        return INVALID_STATE;
     }
+    char * const grown = realloc(pOutput->data, capacity);
+    if (grown == NULL)
+    {
+        pOutput->failed = TRUE;
+        return INVALID_STATE;
+    }
+    pOutput->data = grown;
+    pOutput->capacity = capacity;
+    return VALID_STATE;
 }
 
 /**
- * @brief A Power operator. Raises the base in the power of degree.
- * @param base The base of the power.
- * @param degree The degree of the power.
- * @return The result of the base raised to the degree.
+ * @brief Writes the given bytes to the file of the given output, unless writing already failed.
+ * @param pOutput The output.
+ * @param data The bytes to write.
+ * @param length The number of bytes.
  */
-int power(int const base, int const degree)
+void writeOutput(OutputBuffer * const pOutput, char const * data, size_t length)
 {
-    if (degree == 0)
+    while (length > 0 && !pOutput->failed)
     {
-        return 1;
+        ssize_t const bytesWritten = write(pOutput->fileDescriptor, data, length);
+        if (bytesWritten <= 0)
+        {
+            pOutput->failed = TRUE;
+        }
+        else
+        {
+            data += bytesWritten;
+            length -= (size_t) bytesWritten;
+        }
     }
-    else
+}
+
+
+#ifdef CHANGE_BASE_STATISTICS
+
+/*----=  Statistics  =-----*/
+
+
+/**
+ * @brief Reads the timer of the statistics, the time stamp counter if the CPU has one and the
+ *        monotonic clock in nanoseconds otherwise.
+ * @return The ticks of the timer.
+ */
+unsigned long long readTimer(void)
+{
+#ifdef TIME_STAMP_COUNTER
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long) now.tv_sec * NANOSECONDS_PER_SECOND +
+           (unsigned long long) now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Returns the number of seconds since the given time.
+ * @param pStart The time to measure from.
+ * @return The number of seconds.
+ */
+double secondsSince(struct timespec const * const pStart)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) (now.tv_sec - pStart->tv_sec) +
+           (double) (now.tv_nsec - pStart->tv_nsec) / NANOSECONDS_PER_SECOND;
+}
+
+/**
+ * @brief Starts counting the run, and the thread printing its progress if it is needed.
+ * @param progressInterval The number of seconds between two progress messages, or 0 for none.
+ */
+void startStatistics(double const progressInterval)
+{
+    pthread_mutex_init(&runStatistics.lock, NULL);
+    pthread_cond_init(&runStatistics.stop, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &runStatistics.start);
+    runStatistics.startTicks = readTimer();
+    runStatistics.counting = TRUE;
+
+    // Without its thread the run goes on with no progress messages.
+    runStatistics.progressInterval = progressInterval;
+    if (progressInterval > 0 &&
+        pthread_create(&runStatistics.progressThread, NULL, printProgress, &runStatistics) != 0)
     {
-        return (power(base, degree - 1)) * base;
+        runStatistics.progressInterval = 0;
     }
 }
 
+/**
+ * @brief Stops counting the run, and prints its counters if they are needed.
+ * @param print Non zero for printing the counters.
+ */
+void stopStatistics(int const print)
+{
+    double const seconds = secondsSince(&runStatistics.start);
+    unsigned long long const ticks = readTimer() - runStatistics.startTicks;
+
+    if (runStatistics.progressInterval > 0)
+    {
+        pthread_mutex_lock(&runStatistics.lock);
+        runStatistics.stopped = TRUE;
+        pthread_cond_signal(&runStatistics.stop);
+        pthread_mutex_unlock(&runStatistics.lock);
+        pthread_join(runStatistics.progressThread, NULL);
+    }
+    pthread_cond_destroy(&runStatistics.stop);
+    pthread_mutex_destroy(&runStatistics.lock);
 
-/*----=  Input Handling  =-----*/
+    if (!print)
+    {
+        return;
+    }
 
+    // The timer is calibrated against the clock over the whole run.
+    double const secondsPerTick = (ticks != 0) ? seconds / (double) ticks : 0;
+    fprintf(stderr, STATISTICS_MESSAGE, runStatistics.records, seconds,
+            (seconds > 0) ? (double) runStatistics.records / seconds : 0);
+    fprintf(stderr, TIME_MESSAGE, (double) runStatistics.ticks[PARSE_TIME] * secondsPerTick,
+            (double) runStatistics.ticks[CONVERT_TIME] * secondsPerTick,
+            (double) runStatistics.ticks[EMIT_TIME] * secondsPerTick);
+    if (runStatistics.cached)
+    {
+        unsigned long long const lookups = runStatistics.cache.hits + runStatistics.cache.misses;
+        fprintf(stderr, HIT_RATE_MESSAGE,
+                (lookups != 0) ? PERCENT * (double) runStatistics.cache.hits / (double) lookups :
+                                 0);
+    }
+}
 
 /**
- * @brief Verify that the given number in the user input can be represented in the
- *        given original base.
- * @param originalBase The given original base in the user input.
- * @param number The given number in the user input.
- * @return 0 if the input is invalid, 1 otherwise.
+ * @brief The routine of the thread printing the progress of the run until the run ends.
+ * @param pStatistics The counters of the run.
+ * @return NULL.
  */
-int checkInput(int const originalBase, int number)
+void * printProgress(void * pStatistics)
 {
-    while (number != 0)
+    RunStatistics * const pRun = pStatistics;
+    double const interval = pRun->progressInterval;
+
+    pthread_mutex_lock(&pRun->lock);
+    while (!pRun->stopped)
     {
-        int currentDigit = number % STANDARD_BASE;
-        if (currentDigit >= originalBase)
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        double const nanoseconds = (double) deadline.tv_nsec +
+                                   (interval - (double) (long) interval) * NANOSECONDS_PER_SECOND;
+        deadline.tv_sec += (time_t) interval + (time_t) (nanoseconds / NANOSECONDS_PER_SECOND);
+        deadline.tv_nsec = (long) nanoseconds % NANOSECONDS_PER_SECOND;
+
+        int waitResult = 0;
+        while (!pRun->stopped && waitResult != ETIMEDOUT)
+        {
+            waitResult = pthread_cond_timedwait(&pRun->stop, &pRun->lock, &deadline);
+        }
+        if (!pRun->stopped)
         {
-            return FALSE;
+            // The threads add their records every FLUSH_RECORDS records, so the count lags.
+            double const seconds = secondsSince(&pRun->start);
+            unsigned long long const records = __atomic_load_n(&pRun->records, __ATOMIC_RELAXED);
+            fprintf(stderr, PROGRESS_MESSAGE, seconds, records, (double) records / seconds);
         }
-        number /= STANDARD_BASE;
     }
-    return TRUE;
+    pthread_mutex_unlock(&pRun->lock);
+    return NULL;
 }
 
+/**
+ * @brief Starts the timer of this thread, if the run is counted.
+ */
+void startTimer(void)
+{
+    if (runStatistics.counting)
+    {
+        threadStatistics.timer = readTimer();
+    }
+}
 
-/*----=  Output Handling  =-----*/
-
+/**
+ * @brief Adds the time since the timer of this thread started to the given phase, and restarts
+ *        the timer, if the run is counted.
+ * @param phase PARSE_TIME, CONVERT_TIME or EMIT_TIME.
+ */
+void countTime(int const phase)
+{
+    if (runStatistics.counting)
+    {
+        unsigned long long const now = readTimer();
+        threadStatistics.ticks[phase] += now - threadStatistics.timer;
+        threadStatistics.timer = now;
+    }
+}
 
 /**
- * @brief Prints the given conversion result to the standard output.
- *        During the conversion, the result is stored backwards, so this function determines which
- *        index is the last index in the result array that contains data, and from this points it
- *        prints the data all the way back.
- * @param The result of the converted number.
+ * @brief Counts a record of this thread, if the run is counted. Every FLUSH_RECORDS records the
+ *        counters of this thread are added to the counters of the run.
  */
-void printResult(char * result)
+void countRecord(void)
 {
-    // Determine the indices of result that contain data.
-    int i = 0;
-    while (result[i] != 0)
+    if (runStatistics.counting && ++threadStatistics.records == FLUSH_RECORDS)
     {
-        i++;
+        flushStatistics();
     }
+}
 
-    // Prints the converted number in the required order.
-    i--;  // index 'i' is currently at the '\0' character, we need to take 1 step backwards.
-    for ( ; i >= 0; --i)
+/**
+ * @brief Adds the counters of this thread to the counters of the run, and resets them.
+ */
+void flushStatistics(void)
+{
+    __atomic_fetch_add(&runStatistics.records, threadStatistics.records, __ATOMIC_RELAXED);
+    for (int phase = 0; phase < PHASES_NUMBER; ++phase)
     {
-        printf("%c", result[i]);
+        __atomic_fetch_add(&runStatistics.ticks[phase], threadStatistics.ticks[phase],
+                           __ATOMIC_RELAXED);
+        threadStatistics.ticks[phase] = 0;
     }
-    printf("\n");
+    threadStatistics.records = 0;
 }
+
+#endif
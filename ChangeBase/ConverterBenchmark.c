@@ -0,0 +1,1976 @@
+/**
+ * @file ConverterBenchmark.c
+ * @author Itai Tagar <itagar>
+ * @version 1.0
+ * @date 09 Aug 2016
+ *
+ * @brief A program that measures the performance of the Base Converter library, and checks its
+ *        conversions against a slow reference.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A program that measures the performance of the Base Converter library, and checks its
+ * conversions against a slow reference.
+ * Input:       Options in the format of -
+ *              [--mode <mode>] [--bases <original base>:<new base>] [--length <digits>[K|M|G]]
+ *              [--max-length <digits>[K|M|G]] [--threads <number>] [--repeat <number>] [--json]
+ *              [--fuzz <cases>] [--seed <number>]
+ *              The 'K', 'M' and 'G' suffixes of the lengths are the powers of 1000.
+ *              Without '--bases', '--length' and '--mode' every base pair is measured at every
+ *              length in every mode.
+ * Process:     Generates random numbers of the requested length in the original base, and
+ *              converts them over and over until the conversions take a fraction of a second. The
+ *              base pairs are common pairs, a pair of powers of 2 and a pair of uncommon bases.
+ *              The lengths grow from a single digit to '--max-length', 10M by default, in steps
+ *              of 1, 3, 10, 30 and so on. The numbers are generated before the clock runs, and
+ *              every measurement runs in a child process, so its peak memory usage is its own.
+ *              The modes are:
+ *              baseline - the original conversion through an int, by 'baseConverter' and
+ *                         'power', only for bases up to 10 and numbers of up to 9 digits.
+ *              convert  - 'converterConvert' on a single thread.
+ *              threads  - 'converterConvert' on '--threads' threads, unless there is a single
+ *                         one.
+ *              limbs    - 'converterConvertLimbs' of the numbers parsed beforehand.
+ *              cache    - 'converterCacheConvert' of the same few numbers, so they are copied
+ *                         from the Cache, only for numbers which a Cache keeps.
+ *              With '--fuzz' the given number of random cases is converted instead, through
+ *              every path of the library, and compared with a slow reference which converts
+ *              through 32 bits words, a digit chunk at a time. The cases mix every base pair,
+ *              lengths up to '--max-length', 100K by default, which reach every kernel of the
+ *              library, signs, leading zeros, extreme digits and invalid digits.
+ * Output:      A CSV line per measurement, or a JSON object per measurement with '--json':
+ *              the mode, the bases, the length, the threads, the conversions of the best run and
+ *              their time, the conversions per second, the nanoseconds per digit and the peak
+ *              resident memory in KB. The best run is the fastest of '--repeat' runs.
+ *              With '--fuzz' a single line, or object, of the seed, the cases, the checks and the
+ *              mismatches, and every mismatch is reported to the standard error.
+ * Build:       gcc -std=c99 -O2 -pthread ConverterBenchmark.c BaseConverter.c
+ *              -o ConverterBenchmark
+ */
+
+
+/*----=  Includes  =-----*/
+
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "BaseConverter.h"
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def VALID_STATE 0
+ * @brief A Flag for valid state during the program run.
+ */
+#define VALID_STATE 0
+
+/**
+ * @def INVALID_STATE 1
+ * @brief A Flag for invalid state during the program run.
+ */
+#define INVALID_STATE 1
+
+/**
+ * @def TRUE 1
+ * @brief A Flag for true statement.
+ */
+#define TRUE 1
+
+/**
+ * @def FALSE 0
+ * @brief A Flag for false statement.
+ */
+#define FALSE 0
+
+/**
+ * @def STANDARD_BASE 10
+ * @brief A Macro that sets the standard base which we usually use, the base of the numbers in
+ *        the arguments and of the integer the baseline reads.
+ */
+#define STANDARD_BASE 10
+
+/**
+ * @def INVALID_ARGUMENTS_MESSAGE "usage: ConverterBenchmark ..."
+ * @brief A Macro that sets the output message for invalid arguments.
+ */
+#define INVALID_ARGUMENTS_MESSAGE "usage: ConverterBenchmark [--mode <mode>] " \
+                                  "[--bases <original base>:<new base>] " \
+                                  "[--length <digits>[K|M|G]] [--max-length <digits>[K|M|G]] " \
+                                  "[--threads <number>] [--repeat <number>] [--json] " \
+                                  "[--fuzz <cases>] [--seed <number>]\n"
+
+/**
+ * @def MEASURE_FAILED_MESSAGE "Error! Could not measure the mode '%s' from base %d to ..."
+ * @brief A Macro that sets the output message for a measurement which could not be made.
+ */
+#define MEASURE_FAILED_MESSAGE "Error! Could not measure the mode '%s' from base %d to base %d " \
+                               "of %zu digits.\n"
+
+/**
+ * @def FUZZ_FAILED_MESSAGE "Error! Could not check case %llu of the seed %llu.\n"
+ * @brief A Macro that sets the output message for a case which could not be checked.
+ */
+#define FUZZ_FAILED_MESSAGE "Error! Could not check case %llu of the seed %llu.\n"
+
+/**
+ * @def MISMATCH_MESSAGE "Mismatch! The %s path differs from the reference on case %llu ..."
+ * @brief A Macro that sets the output message for a conversion which differs from the reference.
+ */
+#define MISMATCH_MESSAGE "Mismatch! The %s path differs from the reference on case %llu of the " \
+                         "seed %llu, from base %d to base %d of %zu characters.\n"
+
+/**
+ * @def MISMATCH_NUMBER_MESSAGE "The number: '%.*s'.\n"
+ * @brief A Macro that sets the output message for the number of a mismatch.
+ */
+#define MISMATCH_NUMBER_MESSAGE "The number: '%.*s'.\n"
+
+/**
+ * @def FIRST_OPTION_INDEX 1
+ * @brief A Macro that sets the index of the first option in the arguments array.
+ */
+#define FIRST_OPTION_INDEX 1
+
+/**
+ * @def MODE_OPTION "--mode"
+ * @brief A Macro that sets the option which selects a single mode of conversion.
+ */
+#define MODE_OPTION "--mode"
+
+/**
+ * @def BASES_OPTION "--bases"
+ * @brief A Macro that sets the option which selects a single pair of bases.
+ */
+#define BASES_OPTION "--bases"
+
+/**
+ * @def LENGTH_OPTION "--length"
+ * @brief A Macro that sets the option which selects a single length of the numbers.
+ */
+#define LENGTH_OPTION "--length"
+
+/**
+ * @def MAX_LENGTH_OPTION "--max-length"
+ * @brief A Macro that sets the option which sets the largest length of the numbers.
+ */
+#define MAX_LENGTH_OPTION "--max-length"
+
+/**
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the option which sets the number of threads of the threaded mode.
+ */
+#define THREADS_OPTION "--threads"
+
+/**
+ * @def REPEAT_OPTION "--repeat"
+ * @brief A Macro that sets the option which sets the number of runs of every measurement.
+ */
+#define REPEAT_OPTION "--repeat"
+
+/**
+ * @def JSON_OPTION "--json"
+ * @brief A Macro that sets the option which prints the results as JSON objects.
+ */
+#define JSON_OPTION "--json"
+
+/**
+ * @def FUZZ_OPTION "--fuzz"
+ * @brief A Macro that sets the option which checks random cases instead of measuring.
+ */
+#define FUZZ_OPTION "--fuzz"
+
+/**
+ * @def SEED_OPTION "--seed"
+ * @brief A Macro that sets the option which sets the seed of the random cases.
+ */
+#define SEED_OPTION "--seed"
+
+/**
+ * @def BASES_SEPARATOR ':'
+ * @brief A Macro that sets the character which separates the bases of a pair in the arguments.
+ */
+#define BASES_SEPARATOR ':'
+
+/**
+ * @def LENGTH_UNIT 1000ULL
+ * @brief A Macro that sets the number of digits in the 'K' length suffix, the 'M' and 'G'
+ *        suffixes are its powers.
+ */
+#define LENGTH_UNIT 1000ULL
+
+/**
+ * @def DEFAULT_MAX_LENGTH 10000000ULL
+ * @brief A Macro that sets the largest length of the measured numbers by default.
+ */
+#define DEFAULT_MAX_LENGTH 10000000ULL
+
+/**
+ * @def FUZZ_MAX_LENGTH 100000ULL
+ * @brief A Macro that sets the largest length of the checked numbers by default, long enough for
+ *        the multiplications by transforms and for the threads of the pool.
+ */
+#define FUZZ_MAX_LENGTH 100000ULL
+
+/**
+ * @def DEFAULT_REPEAT 3
+ * @brief A Macro that sets the number of runs of every measurement by default.
+ */
+#define DEFAULT_REPEAT 3
+
+/**
+ * @def MEASURE_SECONDS 0.1
+ * @brief A Macro that sets the least time a single run of a measurement converts for.
+ */
+#define MEASURE_SECONDS 0.1
+
+/**
+ * @def POOL_NUMBERS 64
+ * @brief A Macro that sets the maximal number of different numbers a measurement converts.
+ */
+#define POOL_NUMBERS 64
+
+/**
+ * @def POOL_DIGITS (1 << 20)
+ * @brief A Macro that sets the number of digits of the numbers a measurement converts, above
+ *        which a measurement converts a single number.
+ */
+#define POOL_DIGITS (1 << 20)
+
+/**
+ * @def CACHE_BUDGET (64 << 20)
+ * @brief A Macro that sets the number of bytes of the Cache of the cache mode and of the fuzzing.
+ */
+#define CACHE_BUDGET (64 << 20)
+
+/**
+ * @def FUZZ_MIN_THREADS 2
+ * @brief A Macro that sets the least number of threads of the pool the fuzzing checks.
+ */
+#define FUZZ_MIN_THREADS 2
+
+/**
+ * @def FUZZ_MAX_ZEROS 3
+ * @brief A Macro that sets the maximal number of leading zeros of a checked number.
+ */
+#define FUZZ_MAX_ZEROS 3
+
+/**
+ * @def REPORTED_LENGTH 64
+ * @brief A Macro that sets the maximal number of characters of a number which is printed along
+ *        with its mismatch.
+ */
+#define REPORTED_LENGTH 64
+
+/**
+ * @def BASELINE_MAX_BASE 10
+ * @brief A Macro that sets the largest base the baseline converts, its digits are decimal digits.
+ */
+#define BASELINE_MAX_BASE 10
+
+/**
+ * @def BASELINE_MAX_DIGITS 9
+ * @brief A Macro that sets the maximal number of digits the baseline converts, its numbers are
+ *        read as an int.
+ */
+#define BASELINE_MAX_DIGITS 9
+
+/**
+ * @def MAX_RESULT_SIZE 32
+ * @brief A Macro that sets the maximum number of digits for the result number of the baseline,
+ *        enough for any number it reads in base 2.
+ */
+#define MAX_RESULT_SIZE 32
+
+/**
+ * @def WORD_BITS 32
+ * @brief A Macro that sets the number of bits in a single word of a number of the reference.
+ */
+#define WORD_BITS 32
+
+/**
+ * @def WORD_MASK 0xFFFFFFFFULL
+ * @brief A Macro that sets the largest value of a single word of the reference.
+ */
+#define WORD_MASK 0xFFFFFFFFULL
+
+/**
+ * @def DIGIT_BITS 6
+ * @brief A Macro that sets a number of bits which is enough for a single digit of any base.
+ */
+#define DIGIT_BITS 6
+
+/**
+ * @def NANOSECONDS_PER_SECOND 1e9
+ * @brief A Macro that sets the number of nanoseconds in a second.
+ */
+#define NANOSECONDS_PER_SECOND 1e9
+
+/**
+ * @def RANDOM_SEED 0x9E3779B97F4A7C15ULL
+ * @brief A Macro that sets the seed of the measured numbers, and of the checked cases by default.
+ */
+#define RANDOM_SEED 0x9E3779B97F4A7C15ULL
+
+/**
+ * @def DIGIT_CHARACTERS "0123456789abcdefghijklmnopqrstuvwxyz"
+ * @brief A Macro that sets the digits of the bases, indexed by their values.
+ */
+#define DIGIT_CHARACTERS "0123456789abcdefghijklmnopqrstuvwxyz"
+
+/**
+ * @def INVALID_CHARACTERS "/:@[`{\x80\xC1"
+ * @brief A Macro that sets the characters which are not digits of any base, those next to the
+ *        digits and bytes beyond the ASCII characters.
+ */
+#define INVALID_CHARACTERS "/:@[`{\x80\xC1"
+
+/**
+ * @def CSV_HEADER "mode,original_base,new_base,length,threads,conversions,seconds,..."
+ * @brief A Macro that sets the header line of the CSV output.
+ */
+#define CSV_HEADER "mode,original_base,new_base,length,threads,conversions,seconds," \
+                   "conversions_per_second,ns_per_digit,peak_rss_kb\n"
+
+/**
+ * @def FUZZ_CSV_HEADER "seed,cases,max_length,checks,mismatches"
+ * @brief A Macro that sets the header line of the CSV output of the fuzzing.
+ */
+#define FUZZ_CSV_HEADER "seed,cases,max_length,checks,mismatches\n"
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The ways of converting which are measured.
+ */
+typedef enum ConversionMode
+{
+    BASELINE_MODE,
+    CONVERT_MODE,
+    THREADS_MODE,
+    LIMBS_MODE,
+    CACHE_MODE,
+    MODES_NUMBER
+} ConversionMode;
+
+/**
+ * @brief A pair of bases a number is converted between.
+ */
+typedef struct BasePair
+{
+    /** The base the number is represented in, or 0 for every default pair. */
+    int originalBase;
+    /** The base to convert the number to. */
+    int newBase;
+} BasePair;
+
+/**
+ * @brief The result of measuring a single mode at a single length.
+ */
+typedef struct BenchmarkResult
+{
+    /** 0 if the measurement was made, 1 otherwise. */
+    int state;
+    /** The number of conversions of the best run. */
+    unsigned long long conversions;
+    /** The time of the best run, in seconds. */
+    double seconds;
+    /** The peak resident memory of the measurement, in KB. */
+    long peakRss;
+} BenchmarkResult;
+
+/**
+ * @brief The options of the program, as given in the arguments.
+ */
+typedef struct BenchmarkOptions
+{
+    /** The name of the single mode to measure, or NULL for every mode. */
+    char const * modeName;
+    /** The single pair of bases to measure, or a pair of 0 for every default pair. */
+    BasePair pair;
+    /** The single length to measure, or 0 for every length. */
+    size_t length;
+    /** The largest length to measure or to check, or 0 for the default. */
+    size_t maxLength;
+    /** The number of threads of the threaded mode. */
+    size_t threads;
+    /** The number of runs of every measurement. */
+    int repeat;
+    /** Non zero if the results are printed as JSON objects. */
+    int json;
+    /** The number of random cases to check instead of measuring, or 0. */
+    unsigned long long cases;
+    /** The seed of the random cases. */
+    uint64_t seed;
+} BenchmarkOptions;
+
+/**
+ * @brief A single random case of the fuzzing, with its conversion by the reference.
+ */
+typedef struct FuzzCase
+{
+    /** The index of the case from the start of the fuzzing. */
+    unsigned long long index;
+    /** The base the number is represented in. */
+    int originalBase;
+    /** The base to convert the number to. */
+    int newBase;
+    /** The number, which may start with a sign. */
+    char * number;
+    /** The number of characters in the number. */
+    size_t length;
+    /** The result of the reference, 0 if the number is valid and 1 otherwise. */
+    int state;
+    /** The converted number of the reference. */
+    char * expected;
+    /** The number of characters in the converted number. */
+    size_t expectedLength;
+    /** The 64 bits limbs of the absolute value of the number, the least significant first. */
+    uint64_t * limbs;
+    /** The number of limbs, without leading zero limbs. */
+    size_t size;
+    /** Non zero for a negative number which is not 0. */
+    int negative;
+} FuzzCase;
+
+/**
+ * @brief The Arenas and the Cache the fuzzing converts with, and its counters.
+ */
+typedef struct FuzzState
+{
+    /** The options of the program. */
+    BenchmarkOptions const * pOptions;
+    /** An Arena of a single thread. */
+    ConverterArena * pArena;
+    /** An Arena of a pool of threads. */
+    ConverterArena * pPoolArena;
+    /** The Cache shared by every case. */
+    ConverterCache * pCache;
+    /** The number of conversions compared with the reference. */
+    unsigned long long checks;
+    /** The number of conversions which differ from the reference. */
+    unsigned long long mismatches;
+} FuzzState;
+
+
+/*----=  Forward Declarations  =-----*/
+
+
+/**
+ * @brief Parse the given arguments into the given options.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param pOptions The path to store the parsed options in.
+ * @return 0 if the given arguments are valid, 1 otherwise.
+ */
+int parseArguments(int const argc, char * argv[], BenchmarkOptions * const pOptions);
+
+/**
+ * @brief Parse a number of digits, optionally followed by a 'K', 'M' or 'G' suffix.
+ * @param value The number of digits to parse.
+ * @param pLength The path to store the parsed number of digits in.
+ * @return 0 if the number of digits is valid, 1 otherwise.
+ */
+int parseLength(char const * const value, size_t * const pLength);
+
+/**
+ * @brief Parse a pair of bases in the format of <original base>:<new base>.
+ * @param value The pair to parse.
+ * @param pPair The path to store the parsed pair in.
+ * @return 0 if both bases are between CONVERTER_MIN_BASE and CONVERTER_MAX_BASE, 1 otherwise.
+ */
+int parseBases(char const * const value, BasePair * const pPair);
+
+/**
+ * @brief Finds the mode with the given name.
+ * @param name The name of the mode.
+ * @return The mode, or MODES_NUMBER if there is no such mode.
+ */
+ConversionMode findMode(char const * const name);
+
+/**
+ * @brief Returns the next number of a xorshift random number generator.
+ * @param pRandom The state of the generator.
+ * @return The next number, whose high bits are the most random.
+ */
+uint64_t nextRandom(uint64_t * const pRandom);
+
+/**
+ * @brief Returns a random number below the given limit.
+ * @param pRandom The state of the generator.
+ * @param limit The limit, which is not 0.
+ * @return The random number.
+ */
+size_t randomBelow(uint64_t * const pRandom, size_t const limit);
+
+/**
+ * @brief Generates a random digit of the given value, a letter in either case.
+ * @param pRandom The state of the generator.
+ * @param value The value of the digit.
+ * @return The digit.
+ */
+char randomCase(uint64_t * const pRandom, int const value);
+
+/**
+ * @brief Generates random numbers of the given length in the given base, without leading zeros.
+ * @param base The base of the numbers.
+ * @param numbers The buffer to generate the numbers in, one after the other.
+ * @param count The number of numbers.
+ * @param length The number of digits in every number.
+ */
+void generateNumbers(int const base, char * const numbers, size_t const count,
+                     size_t const length);
+
+/**
+ * @brief Returns the length which follows the given one in the sweep of lengths, 1, 3, 10, 30
+ *        and so on.
+ * @param length The current length.
+ * @return The next length.
+ */
+size_t nextLength(size_t const length);
+
+/**
+ * @brief Measures every selected mode of every selected pair of bases at every selected length,
+ *        and prints the results.
+ * @param pOptions The options of the program.
+ * @return 0 if every measurement was made, 1 otherwise.
+ */
+int runBenchmarks(BenchmarkOptions const * const pOptions);
+
+/**
+ * @brief Checks if the given mode measures numbers of the given length between the given bases.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @return 1 if the mode measures the numbers, 0 otherwise.
+ */
+int modeApplies(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+                BasePair const * const pPair, size_t const length);
+
+/**
+ * @brief Measures a single mode at a single length in a child process.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @param pResult The path to store the result in.
+ */
+void measureInChild(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+                    BasePair const * const pPair, size_t const length,
+                    BenchmarkResult * const pResult);
+
+/**
+ * @brief Measures a single mode at a single length in this process.
+ *        A few different numbers are converted over and over, and only the conversions are
+ *        timed, the numbers are generated and parsed into limbs before the clock runs.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @param pResult The path to store the result in.
+ */
+void measure(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+             BasePair const * const pPair, size_t const length, BenchmarkResult * const pResult);
+
+/**
+ * @brief Converts a single number in the given mode.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param number The number.
+ * @param length The number of digits in the number.
+ * @param limbs The limbs of the number, for the limbs mode.
+ * @param size The number of limbs, for the limbs mode.
+ * @param result The buffer to write the converted number in.
+ * @param capacity The number of characters the buffer holds.
+ * @param pArena The Arena of the conversion.
+ * @param pCache The Cache of the conversion, for the cache mode.
+ * @return The result of the conversion, as the library gives it.
+ */
+int convertNumber(ConversionMode const mode, BasePair const * const pPair,
+                  char const * const number, size_t const length, uint64_t const * const limbs,
+                  size_t const size, char * const result, size_t const capacity,
+                  ConverterArena * const pArena, ConverterCache * const pCache);
+
+/**
+ * @brief Returns the time of a monotonic clock.
+ * @return The time in seconds.
+ */
+double currentSeconds(void);
+
+/**
+ * @brief Converts the given number as the original program did: the digits are read as a
+ *        decimal int, whose decimal digits are the digits of the original base, and the int is
+ *        converted by 'baseConverter'. The result is stored backwards, so it is reversed.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The digits of the number, at most BASELINE_MAX_DIGITS of them.
+ * @param length The number of digits in the number.
+ * @param result The path to store the conversion result in, most significant digit first.
+ * @return The number of digits in the result, 0 if the input is invalid.
+ */
+size_t baselineConverter(int const originalBase, int const newBase, char const * const number,
+                         size_t const length, char * const result);
+
+/**
+ * @brief Performs the base conversion from a given bases for the desired given number to convert.
+ *        The function first convert the number to be represented in base 10, and then convert
+ *        from base 10 to the desired new base.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The given number, represented in the original base, that should be converted.
+ * @param result The path to store the conversion result in.
+ * @return char array holding the converted number.
+ */
+char * baseConverter(int const originalBase, int const newBase, int number, char * result);
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function perform the actual base conversion from the given number to decimal,
+ *        i.e. represented in base 10.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param number The given number, represented in the original base, that should be converted.
+ * @return The number represented in base 10 as decimal.
+ */
+int decimalConverter(int const originalBase, int number);
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function perform the actual base conversion, assuming the original base is 10,
+ *        and convert the given number to the new base.
+ *        The function updates the given result array with the converted number.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The given number, represented in the original base, that should be converted.
+ * @param result The path to store the conversion result in.
+ */
+void baseConverterHelper(int const newBase, int number, char * result);
+
+/**
+ * @brief A Power operator. Raises the base in the power of degree.
+ * @param base The base of the power.
+ * @param degree The degree of the power.
+ * @return The result of the base raised to the degree.
+ */
+int power(int const base, int const degree);
+
+/**
+ * @brief Verify that the given number in the user input can be represented in the
+ *        given original base.
+ * @param originalBase The given original base in the user input.
+ * @param number The given number in the user input.
+ * @return 0 if the input is invalid, 1 otherwise.
+ */
+int checkInput(int const originalBase, int number);
+
+/**
+ * @brief Checks random cases against the reference, and prints the counters.
+ * @param pOptions The options of the program.
+ * @return 0 if every case matches the reference, 1 otherwise.
+ */
+int runFuzz(BenchmarkOptions const * const pOptions);
+
+/**
+ * @brief Generates a random case: a pair of bases, half of the time common bases, and a number.
+ *        The length of the number is within a single limb, a few limbs, tens or hundreds of
+ *        limbs, or up to the largest length, so every kernel of the library is reached. The
+ *        number may have a sign and leading zeros, its digits may be the largest digit only or
+ *        a 1 followed by zeros, and it may have an invalid digit.
+ * @param pRandom The state of the generator.
+ * @param maxLength The largest length of the number.
+ * @param pCase The case, whose number has room for the largest length.
+ */
+void generateCase(uint64_t * const pRandom, size_t const maxLength, FuzzCase * const pCase);
+
+/**
+ * @brief Converts the given case through every path of the library, and compares every result
+ *        with the reference: without an Arena, with an Arena of a single thread and of a pool,
+ *        twice through the Cache, into limbs and from them, and into a buffer which is too small.
+ * @param pFuzz The state of the fuzzing.
+ * @param pCase The case, with its conversion by the reference.
+ * @return 0 if the case was checked, 1 if there is not enough memory.
+ */
+int checkCase(FuzzState * const pFuzz, FuzzCase const * const pCase);
+
+/**
+ * @brief Compares a single conversion of the given case with the reference.
+ * @param pFuzz The state of the fuzzing.
+ * @param pCase The case, with its conversion by the reference.
+ * @param name The name of the path of the library which converted the case.
+ * @param state The result of the conversion.
+ * @param result The converted number.
+ * @param length The number of characters in the converted number.
+ */
+void checkConversion(FuzzState * const pFuzz, FuzzCase const * const pCase,
+                     char const * const name, int const state, char const * const result,
+                     size_t const length);
+
+/**
+ * @brief Reports a conversion of the given case which differs from the reference.
+ * @param pFuzz The state of the fuzzing.
+ * @param pCase The case.
+ * @param name The name of the path of the library which converted the case.
+ */
+void reportMismatch(FuzzState * const pFuzz, FuzzCase const * const pCase,
+                    char const * const name);
+
+/**
+ * @brief Converts the number of the given case by the reference, which is slow but plain: the
+ *        digits are accumulated into 32 bits words a chunk of digits at a time, and the words are
+ *        divided by the power of the new base of a chunk until they are 0. The time is quadratic
+ *        in the length of the number.
+ * @param pCase The case, the result of the reference, its converted number and its limbs are
+ *        stored in it.
+ * @return 0 if the number was converted, 1 if there is not enough memory.
+ */
+int referenceConverter(FuzzCase * const pCase);
+
+/**
+ * @brief Parses the given digits into 32 bits words, a chunk of digits at a time.
+ * @param base The base of the digits.
+ * @param digits The digits, the most significant first, which may be in either case.
+ * @param length The number of digits.
+ * @param words The buffer to store the words in, the least significant first.
+ * @param pSize The path to store the number of words in, without leading zero words.
+ * @return 0 if every digit is a digit of the base, 1 otherwise.
+ */
+int referenceParse(int const base, char const * const digits, size_t const length,
+                   uint32_t * const words, size_t * const pSize);
+
+/**
+ * @brief Writes the given 32 bits words in the given base, a chunk of digits at a time.
+ * @param base The base to write the number in.
+ * @param words The words, the least significant first, which are overwritten.
+ * @param size The number of words, without leading zero words.
+ * @param result The path to write the digits in, the most significant first.
+ * @return The number of digits, without leading zeros, 1 for 0.
+ */
+size_t referenceWrite(int const base, uint32_t * const words, size_t size, char * const result);
+
+/**
+ * @brief Returns the number of digits of the given base in a chunk of the reference, the most
+ *        whose power fits in a single word.
+ * @param base The base.
+ * @return The number of digits.
+ */
+size_t referenceChunk(int const base);
+
+/**
+ * @brief Returns the value of the given digit, the letters in either case follow the decimal
+ *        digits.
+ * @param digit The digit.
+ * @return The value, or CONVERTER_MAX_BASE if the character is not a digit of any base.
+ */
+int digitValue(char const digit);
+
+/**
+ * @brief Prints the result of a single measurement.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @param pResult The result of the measurement.
+ */
+void printResult(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+                 BasePair const * const pPair, size_t const length,
+                 BenchmarkResult const * const pResult);
+
+
+/*----=  Modes And Bases  =-----*/
+
+
+/**
+ * @brief The names of the modes, indexed by the mode.
+ */
+static char const * const MODE_NAMES[MODES_NUMBER] = {"baseline", "convert", "threads", "limbs",
+                                                      "cache"};
+
+/**
+ * @brief The pairs of bases measured by default: decimal from and to binary and hexadecimal, a
+ *        pair of powers of 2 and a pair of uncommon bases.
+ */
+static BasePair const DEFAULT_PAIRS[] = {{10, 2}, {2, 10}, {10, 16}, {16, 10}, {2, 16}, {7, 36}};
+
+/**
+ * @brief The common bases, whose pairs the library converts by specialized kernels.
+ */
+static int const COMMON_BASES[] = {2, 8, 10, 16};
+
+
+/*----=  Main  =-----*/
+
+
+/**
+ * @brief The main function that runs the program.
+ *        It receives arguments from the user and if the arguments are valid, it either checks
+ *        random cases or runs the measurements.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @return 0 if the program succeeded, 1 otherwise.
+ */
+int main(int argc, char * argv[])
+{
+    long const processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t const threads = (processors > 0) ? (size_t) processors : 1;
+    BenchmarkOptions options = {NULL, {0, 0}, 0, 0, threads, DEFAULT_REPEAT, FALSE, 0,
+                                RANDOM_SEED};
+
+    // Check valid arguments.
+    if (parseArguments(argc, argv, &options))
+    {
+        fprintf(stderr, INVALID_ARGUMENTS_MESSAGE);
+        return INVALID_STATE;
+    }
+    else if (options.cases > 0)
+    {
+        return runFuzz(&options);
+    }
+    return runBenchmarks(&options);
+}
+
+
+/*----=  Input Handling  =-----*/
+
+
+/**
+ * @brief Parse the given arguments into the given options.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param pOptions The path to store the parsed options in.
+ * @return 0 if the given arguments are valid, 1 otherwise.
+ */
+int parseArguments(int const argc, char * argv[], BenchmarkOptions * const pOptions)
+{
+    // Every option but '--json' takes a value.
+    int index = FIRST_OPTION_INDEX;
+    while (index < argc)
+    {
+        char const * const option = argv[index++];
+        if (strcmp(option, JSON_OPTION) == 0)
+        {
+            pOptions->json = TRUE;
+            continue;
+        }
+        if (index >= argc)
+        {
+            return INVALID_STATE;
+        }
+
+        char const * const value = argv[index++];
+        char * end = NULL;
+
+        if (strcmp(option, MODE_OPTION) == 0)
+        {
+            if (findMode(value) == MODES_NUMBER)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->modeName = value;
+        }
+        else if (strcmp(option, BASES_OPTION) == 0)
+        {
+            if (parseBases(value, &pOptions->pair))
+            {
+                return INVALID_STATE;
+            }
+        }
+        else if (strcmp(option, LENGTH_OPTION) == 0)
+        {
+            if (parseLength(value, &pOptions->length) || pOptions->length == 0)
+            {
+                return INVALID_STATE;
+            }
+        }
+        else if (strcmp(option, MAX_LENGTH_OPTION) == 0)
+        {
+            if (parseLength(value, &pOptions->maxLength) || pOptions->maxLength == 0)
+            {
+                return INVALID_STATE;
+            }
+        }
+        else if (strcmp(option, THREADS_OPTION) == 0)
+        {
+            unsigned long threads = strtoul(value, &end, STANDARD_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0' || threads == 0 ||
+                threads > CONVERTER_MAX_THREADS)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->threads = (size_t) threads;
+        }
+        else if (strcmp(option, REPEAT_OPTION) == 0)
+        {
+            long repeat = strtol(value, &end, STANDARD_BASE);
+            if (*value == '\0' || *end != '\0' || repeat <= 0)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->repeat = (int) repeat;
+        }
+        else if (strcmp(option, FUZZ_OPTION) == 0)
+        {
+            pOptions->cases = strtoull(value, &end, STANDARD_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0' || pOptions->cases == 0)
+            {
+                return INVALID_STATE;
+            }
+        }
+        else if (strcmp(option, SEED_OPTION) == 0)
+        {
+            pOptions->seed = strtoull(value, &end, STANDARD_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0')
+            {
+                return INVALID_STATE;
+            }
+        }
+        else
+        {
+            return INVALID_STATE;
+        }
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief Parse a number of digits, optionally followed by a 'K', 'M' or 'G' suffix.
+ * @param value The number of digits to parse.
+ * @param pLength The path to store the parsed number of digits in.
+ * @return 0 if the number of digits is valid, 1 otherwise.
+ */
+int parseLength(char const * const value, size_t * const pLength)
+{
+    char * end = NULL;
+    unsigned long long length = strtoull(value, &end, STANDARD_BASE);
+    if (*value == '\0' || *value == '-' || end == value)
+    {
+        return INVALID_STATE;
+    }
+
+    char const * const suffixes = "KMG";
+    if (*end != '\0')
+    {
+        char const * const suffix = strchr(suffixes, *end);
+        if (suffix == NULL || end[1] != '\0')
+        {
+            return INVALID_STATE;
+        }
+        for (char const * pSuffix = suffixes; pSuffix <= suffix; ++pSuffix)
+        {
+            length *= LENGTH_UNIT;
+        }
+    }
+    *pLength = (size_t) length;
+    return VALID_STATE;
+}
+
+/**
+ * @brief Parse a pair of bases in the format of <original base>:<new base>.
+ * @param value The pair to parse.
+ * @param pPair The path to store the parsed pair in.
+ * @return 0 if both bases are between CONVERTER_MIN_BASE and CONVERTER_MAX_BASE, 1 otherwise.
+ */
+int parseBases(char const * const value, BasePair * const pPair)
+{
+    char * end = NULL;
+    long const originalBase = strtol(value, &end, STANDARD_BASE);
+    if (end == value || *end != BASES_SEPARATOR)
+    {
+        return INVALID_STATE;
+    }
+
+    char const * const second = end + 1;
+    long const newBase = strtol(second, &end, STANDARD_BASE);
+    if (end == second || *end != '\0' || originalBase < CONVERTER_MIN_BASE ||
+        originalBase > CONVERTER_MAX_BASE || newBase < CONVERTER_MIN_BASE ||
+        newBase > CONVERTER_MAX_BASE)
+    {
+        return INVALID_STATE;
+    }
+    pPair->originalBase = (int) originalBase;
+    pPair->newBase = (int) newBase;
+    return VALID_STATE;
+}
+
+/**
+ * @brief Finds the mode with the given name.
+ * @param name The name of the mode.
+ * @return The mode, or MODES_NUMBER if there is no such mode.
+ */
+ConversionMode findMode(char const * const name)
+{
+    for (int mode = 0; mode < MODES_NUMBER; ++mode)
+    {
+        if (strcmp(name, MODE_NAMES[mode]) == 0)
+        {
+            return (ConversionMode) mode;
+        }
+    }
+    return MODES_NUMBER;
+}
+
+
+/*----=  Number Generation  =-----*/
+
+
+/**
+ * @brief Returns the next number of a xorshift random number generator.
+ * @param pRandom The state of the generator.
+ * @return The next number, whose high bits are the most random.
+ */
+uint64_t nextRandom(uint64_t * const pRandom)
+{
+    *pRandom ^= *pRandom << 13;
+    *pRandom ^= *pRandom >> 7;
+    *pRandom ^= *pRandom << 17;
+    return *pRandom;
+}
+
+/**
+ * @brief Returns a random number below the given limit.
+ * @param pRandom The state of the generator.
+ * @param limit The limit, which is not 0.
+ * @return The random number.
+ */
+size_t randomBelow(uint64_t * const pRandom, size_t const limit)
+{
+    return (size_t) ((nextRandom(pRandom) >> 16) % limit);
+}
+
+/**
+ * @brief Generates a random digit of the given value, a letter in either case.
+ * @param pRandom The state of the generator.
+ * @param value The value of the digit.
+ * @return The digit.
+ */
+char randomCase(uint64_t * const pRandom, int const value)
+{
+    char const digit = DIGIT_CHARACTERS[value];
+    return (value >= STANDARD_BASE && randomBelow(pRandom, 2) == 0) ?
+           (char) (digit - 'a' + 'A') : digit;
+}
+
+/**
+ * @brief Generates random numbers of the given length in the given base, without leading zeros.
+ * @param base The base of the numbers.
+ * @param numbers The buffer to generate the numbers in, one after the other.
+ * @param count The number of numbers.
+ * @param length The number of digits in every number.
+ */
+void generateNumbers(int const base, char * const numbers, size_t const count,
+                     size_t const length)
+{
+    uint64_t random = RANDOM_SEED;
+    for (size_t i = 0; i < count; ++i)
+    {
+        char * const number = numbers + i * length;
+        number[0] = DIGIT_CHARACTERS[1 + randomBelow(&random, (size_t) base - 1)];
+        for (size_t j = 1; j < length; ++j)
+        {
+            number[j] = DIGIT_CHARACTERS[randomBelow(&random, (size_t) base)];
+        }
+    }
+}
+
+/**
+ * @brief Returns the length which follows the given one in the sweep of lengths, 1, 3, 10, 30
+ *        and so on.
+ * @param length The current length.
+ * @return The next length.
+ */
+size_t nextLength(size_t const length)
+{
+    size_t leading = length;
+    while (leading >= STANDARD_BASE)
+    {
+        leading /= STANDARD_BASE;
+    }
+    return (leading == 1) ? length * 3 : length / 3 * STANDARD_BASE;
+}
+
+
+/*----=  Measurement  =-----*/
+
+
+/**
+ * @brief Measures every selected mode of every selected pair of bases at every selected length,
+ *        and prints the results.
+ * @param pOptions The options of the program.
+ * @return 0 if every measurement was made, 1 otherwise.
+ */
+int runBenchmarks(BenchmarkOptions const * const pOptions)
+{
+    size_t const pairsNumber = (pOptions->pair.originalBase != 0) ?
+                               1 : sizeof(DEFAULT_PAIRS) / sizeof(DEFAULT_PAIRS[0]);
+    size_t const maxLength = (pOptions->maxLength != 0) ? pOptions->maxLength : DEFAULT_MAX_LENGTH;
+
+    if (!pOptions->json)
+    {
+        printf(CSV_HEADER);
+    }
+
+    int result = VALID_STATE;
+    for (size_t i = 0; i < pairsNumber; ++i)
+    {
+        BasePair const * const pPair = (pOptions->pair.originalBase != 0) ?
+                                       &pOptions->pair : &DEFAULT_PAIRS[i];
+        size_t length = (pOptions->length != 0) ? pOptions->length : 1;
+        for ( ; length <= maxLength || length == pOptions->length; length = nextLength(length))
+        {
+            for (int mode = 0; mode < MODES_NUMBER; ++mode)
+            {
+                if ((pOptions->modeName != NULL && findMode(pOptions->modeName) != (ConversionMode) mode) ||
+                    !modeApplies(pOptions, (ConversionMode) mode, pPair, length))
+                {
+                    continue;
+                }
+
+                BenchmarkResult benchmarkResult;
+                measureInChild(pOptions, (ConversionMode) mode, pPair, length, &benchmarkResult);
+                if (benchmarkResult.state != VALID_STATE)
+                {
+                    fprintf(stderr, MEASURE_FAILED_MESSAGE, MODE_NAMES[mode],
+                            pPair->originalBase, pPair->newBase, length);
+                    result = INVALID_STATE;
+                    continue;
+                }
+                printResult(pOptions, (ConversionMode) mode, pPair, length, &benchmarkResult);
+                fflush(stdout);
+            }
+            if (pOptions->length != 0)
+            {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Checks if the given mode measures numbers of the given length between the given bases.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @return 1 if the mode measures the numbers, 0 otherwise.
+ */
+int modeApplies(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+                BasePair const * const pPair, size_t const length)
+{
+    switch (mode)
+    {
+        case BASELINE_MODE:
+            return pPair->originalBase <= BASELINE_MAX_BASE &&
+                   pPair->newBase <= BASELINE_MAX_BASE && length <= BASELINE_MAX_DIGITS;
+        case THREADS_MODE:
+            return pOptions->threads > 1;
+        case CACHE_MODE:
+            return length < CONVERTER_CACHE_ENTRY_SIZE;
+        default:
+            return TRUE;
+    }
+}
+
+/**
+ * @brief Measures a single mode at a single length in a child process.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @param pResult The path to store the result in.
+ */
+void measureInChild(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+                    BasePair const * const pPair, size_t const length,
+                    BenchmarkResult * const pResult)
+{
+    pResult->state = INVALID_STATE;
+    int pipeDescriptors[2];
+    if (pipe(pipeDescriptors) != 0)
+    {
+        return;
+    }
+
+    // The child measures and passes the result back, its peak memory usage is its own.
+    pid_t const child = fork();
+    if (child == 0)
+    {
+        close(pipeDescriptors[0]);
+        measure(pOptions, mode, pPair, length, pResult);
+        ssize_t const written = write(pipeDescriptors[1], pResult, sizeof(BenchmarkResult));
+        _exit(written == (ssize_t) sizeof(BenchmarkResult) ? VALID_STATE : INVALID_STATE);
+    }
+    close(pipeDescriptors[1]);
+    if (child < 0)
+    {
+        close(pipeDescriptors[0]);
+        return;
+    }
+
+    BenchmarkResult childResult;
+    ssize_t const bytesRead = read(pipeDescriptors[0], &childResult, sizeof(BenchmarkResult));
+    close(pipeDescriptors[0]);
+
+    int status;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) == child && WIFEXITED(status) &&
+        WEXITSTATUS(status) == VALID_STATE && bytesRead == (ssize_t) sizeof(BenchmarkResult))
+    {
+        *pResult = childResult;
+        pResult->peakRss = usage.ru_maxrss;
+    }
+}
+
+/**
+ * @brief Measures a single mode at a single length in this process.
+ *        A few different numbers are converted over and over, and only the conversions are
+ *        timed, the numbers are generated and parsed into limbs before the clock runs.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @param pResult The path to store the result in.
+ */
+void measure(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+             BasePair const * const pPair, size_t const length, BenchmarkResult * const pResult)
+{
+    pResult->state = INVALID_STATE;
+    size_t count = POOL_DIGITS / length;
+    count = (count == 0) ? 1 : (count > POOL_NUMBERS) ? POOL_NUMBERS : count;
+    size_t const capacity = converterBound(pPair->originalBase, pPair->newBase, length);
+    size_t const limbsCapacity = (mode == LIMBS_MODE) ?
+                                 converterLimbsBound(pPair->originalBase, length) : 0;
+
+    char * const numbers = malloc(count * length);
+    char * const result = malloc((capacity > MAX_RESULT_SIZE) ? capacity : MAX_RESULT_SIZE);
+    uint64_t * const limbs = malloc((count * limbsCapacity + 1) * sizeof(uint64_t));
+    size_t * const sizes = malloc(count * sizeof(size_t));
+    ConverterArena * const pArena = converterCreateArena((mode == THREADS_MODE) ?
+                                                         pOptions->threads : 1);
+    ConverterCache * const pCache = (mode == CACHE_MODE) ? converterCreateCache(CACHE_BUDGET) :
+                                    NULL;
+    int state = (numbers != NULL && result != NULL && limbs != NULL && sizes != NULL &&
+                 pArena != NULL && (mode != CACHE_MODE || pCache != NULL)) ?
+                CONVERTER_VALID : CONVERTER_OUT_OF_MEMORY;
+
+    if (state == CONVERTER_VALID)
+    {
+        generateNumbers(pPair->originalBase, numbers, count, length);
+    }
+    for (size_t i = 0; i < count && state == CONVERTER_VALID && mode == LIMBS_MODE; ++i)
+    {
+        int negative = FALSE;
+        state = converterParseLimbs(pPair->originalBase, numbers + i * length, length,
+                                    limbs + i * limbsCapacity, limbsCapacity, &sizes[i],
+                                    &negative, pArena);
+    }
+
+    for (int run = 0; run < pOptions->repeat && state == CONVERTER_VALID; ++run)
+    {
+        // The clock is read once per round of the numbers, which is long enough to time.
+        unsigned long long conversions = 0;
+        double const start = currentSeconds();
+        double seconds = 0;
+        do
+        {
+            for (size_t i = 0; i < count && state == CONVERTER_VALID; ++i)
+            {
+                state = convertNumber(mode, pPair, numbers + i * length, length,
+                                      limbs + i * limbsCapacity, sizes[i], result, capacity,
+                                      pArena, pCache);
+            }
+            conversions += count;
+            seconds = currentSeconds() - start;
+        } while (state == CONVERTER_VALID && seconds < MEASURE_SECONDS);
+
+        if (state == CONVERTER_VALID &&
+            (pResult->state != VALID_STATE ||
+             conversions * pResult->seconds > pResult->conversions * seconds))
+        {
+            pResult->state = VALID_STATE;
+            pResult->conversions = conversions;
+            pResult->seconds = seconds;
+        }
+    }
+
+    if (state != CONVERTER_VALID)
+    {
+        pResult->state = INVALID_STATE;
+    }
+    converterDestroyCache(pCache);
+    converterDestroyArena(pArena);
+    free(sizes);
+    free(limbs);
+    free(result);
+    free(numbers);
+}
+
+/**
+ * @brief Converts a single number in the given mode.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param number The number.
+ * @param length The number of digits in the number.
+ * @param limbs The limbs of the number, for the limbs mode.
+ * @param size The number of limbs, for the limbs mode.
+ * @param result The buffer to write the converted number in.
+ * @param capacity The number of characters the buffer holds.
+ * @param pArena The Arena of the conversion.
+ * @param pCache The Cache of the conversion, for the cache mode.
+ * @return The result of the conversion, as the library gives it.
+ */
+int convertNumber(ConversionMode const mode, BasePair const * const pPair,
+                  char const * const number, size_t const length, uint64_t const * const limbs,
+                  size_t const size, char * const result, size_t const capacity,
+                  ConverterArena * const pArena, ConverterCache * const pCache)
+{
+    size_t resultLength = 0;
+    switch (mode)
+    {
+        case BASELINE_MODE:
+            baselineConverter(pPair->originalBase, pPair->newBase, number, length, result);
+            return CONVERTER_VALID;
+        case LIMBS_MODE:
+            return converterConvertLimbs(pPair->newBase, limbs, size, FALSE, result, capacity,
+                                         &resultLength, pArena);
+        case CACHE_MODE:
+            return converterCacheConvert(pCache, pPair->originalBase, pPair->newBase, number,
+                                         length, result, capacity, &resultLength, pArena);
+        default:
+            return converterConvert(pPair->originalBase, pPair->newBase, number, length, result,
+                                    capacity, &resultLength, pArena);
+    }
+}
+
+/**
+ * @brief Returns the time of a monotonic clock.
+ * @return The time in seconds.
+ */
+double currentSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / NANOSECONDS_PER_SECOND;
+}
+
+
+/*----=  Baseline  =-----*/
+
+
+/**
+ * @brief Converts the given number as the original program did: the digits are read as a
+ *        decimal int, whose decimal digits are the digits of the original base, and the int is
+ *        converted by 'baseConverter'. The result is stored backwards, so it is reversed.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The digits of the number, at most BASELINE_MAX_DIGITS of them.
+ * @param length The number of digits in the number.
+ * @param result The path to store the conversion result in, most significant digit first.
+ * @return The number of digits in the result, 0 if the input is invalid.
+ */
+size_t baselineConverter(int const originalBase, int const newBase, char const * const number,
+                         size_t const length, char * const result)
+{
+    int value = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        value = value * STANDARD_BASE + (number[i] - '0');
+    }
+
+    char reversed[MAX_RESULT_SIZE + 1] = {0};
+    if (!checkInput(originalBase, value))
+    {
+        return 0;
+    }
+    baseConverter(originalBase, newBase, value, reversed);
+
+    size_t count = strlen(reversed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = reversed[count - 1 - i];
+    }
+    return count;
+}
+
+/**
+ * @brief Performs the base conversion from a given bases for the desired given number to convert.
+ *        The function first convert the number to be represented in base 10, and then convert
+ *        from base 10 to the desired new base.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The given number, represented in the original base, that should be converted.
+ * @param result The path to store the conversion result in.
+ * @return char array holding the converted number.
+ */
+char * baseConverter(int const originalBase, int const newBase, int number, char * result)
+{
+    int baseTenNumber = decimalConverter(originalBase, number);  // Convert to Decimal.
+    baseConverterHelper(newBase, baseTenNumber, result);
+    return result;
+}
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function perform the actual base conversion from the given number to decimal,
+ *        i.e. represented in base 10.
+ * @param originalBase The base in which the given number is currently represented.
+ * @param number The given number, represented in the original base, that should be converted.
+ * @return The number represented in base 10 as decimal.
+ */
+int decimalConverter(int const originalBase, int number)
+{
+    int result = 0;
+
+    int index = 0;
+    while (number != 0)
+    {
+        int currentDigit = number % STANDARD_BASE;
+        result += (currentDigit * (power(originalBase, index)));
+        number /= STANDARD_BASE;
+        index++;
+    }
+
+    return result;
+}
+
+/**
+ * @brief An Helper function for the Base Converter function.
+ *        This function perform the actual base conversion, assuming the original base is 10,
+ *        and convert the given number to the new base.
+ *        The function updates the given result array with the converted number.
+ * @param newBase The base to convert the given number representation to.
+ * @param number The given number, represented in the original base, that should be converted.
+ * @param result The path to store the conversion result in.
+ */
+void baseConverterHelper(int const newBase, int number, char * result)
+{
+    int index = 0;
+    while (number != 0)
+    {
+        int currentDigit = number % newBase;
+        result[index] = (char)(currentDigit + '0');
+        number /= newBase;
+        index++;
+    }
+}
+
+/**
+ * @brief A Power operator. Raises the base in the power of degree.
+ * @param base The base of the power.
+ * @param degree The degree of the power.
+ * @return The result of the base raised to the degree.
+ */
+int power(int const base, int const degree)
+{
+    if (degree == 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return (power(base, degree - 1)) * base;
+    }
+}
+
+/**
+ * @brief Verify that the given number in the user input can be represented in the
+ *        given original base.
+ * @param originalBase The given original base in the user input.
+ * @param number The given number in the user input.
+ * @return 0 if the input is invalid, 1 otherwise.
+ */
+int checkInput(int const originalBase, int number)
+{
+    while (number != 0)
+    {
+        int currentDigit = number % STANDARD_BASE;
+        if (currentDigit >= originalBase)
+        {
+            return FALSE;
+        }
+        number /= STANDARD_BASE;
+    }
+    return TRUE;
+}
+
+
+/*----=  Fuzzing  =-----*/
+
+
+/**
+ * @brief Checks random cases against the reference, and prints the counters.
+ * @param pOptions The options of the program.
+ * @return 0 if every case matches the reference, 1 otherwise.
+ */
+int runFuzz(BenchmarkOptions const * const pOptions)
+{
+    size_t const maxLength = (pOptions->maxLength != 0) ? pOptions->maxLength : FUZZ_MAX_LENGTH;
+    size_t const threads = (pOptions->threads > FUZZ_MIN_THREADS) ?
+                           pOptions->threads : FUZZ_MIN_THREADS;
+    FuzzState fuzz = {pOptions, converterCreateArena(1), converterCreateArena(threads),
+                      converterCreateCache(CACHE_BUDGET), 0, 0};
+    char * const number = malloc(maxLength);
+
+    int result = (fuzz.pArena != NULL && fuzz.pPoolArena != NULL && fuzz.pCache != NULL &&
+                  number != NULL) ? VALID_STATE : INVALID_STATE;
+    uint64_t random = (pOptions->seed != 0) ? pOptions->seed : RANDOM_SEED;
+    for (unsigned long long index = 0; index < pOptions->cases && result == VALID_STATE; ++index)
+    {
+        FuzzCase fuzzCase = {index, 0, 0, number, 0, VALID_STATE, NULL, 0, NULL, 0, FALSE};
+        generateCase(&random, maxLength, &fuzzCase);
+        if (referenceConverter(&fuzzCase) || checkCase(&fuzz, &fuzzCase))
+        {
+            fprintf(stderr, FUZZ_FAILED_MESSAGE, index, (unsigned long long) pOptions->seed);
+            result = INVALID_STATE;
+        }
+        free(fuzzCase.expected);
+        free(fuzzCase.limbs);
+    }
+
+    if (result == VALID_STATE)
+    {
+        if (pOptions->json)
+        {
+            printf("{\"seed\":%llu,\"cases\":%llu,\"max_length\":%zu,\"checks\":%llu,"
+                   "\"mismatches\":%llu}\n", (unsigned long long) pOptions->seed,
+                   pOptions->cases, maxLength, fuzz.checks, fuzz.mismatches);
+        }
+        else
+        {
+            printf(FUZZ_CSV_HEADER);
+            printf("%llu,%llu,%zu,%llu,%llu\n", (unsigned long long) pOptions->seed,
+                   pOptions->cases, maxLength, fuzz.checks, fuzz.mismatches);
+        }
+    }
+    free(number);
+    converterDestroyCache(fuzz.pCache);
+    converterDestroyArena(fuzz.pPoolArena);
+    converterDestroyArena(fuzz.pArena);
+    return (result == VALID_STATE && fuzz.mismatches == 0) ? VALID_STATE : INVALID_STATE;
+}
+
+/**
+ * @brief Generates a random case: a pair of bases, half of the time common bases, and a number.
+ *        The length of the number is within a single limb, a few limbs, tens or hundreds of
+ *        limbs, or up to the largest length, so every kernel of the library is reached. The
+ *        number may have a sign and leading zeros, its digits may be the largest digit only or
+ *        a 1 followed by zeros, and it may have an invalid digit.
+ * @param pRandom The state of the generator.
+ * @param maxLength The largest length of the number.
+ * @param pCase The case, whose number has room for the largest length.
+ */
+void generateCase(uint64_t * const pRandom, size_t const maxLength, FuzzCase * const pCase)
+{
+    size_t const commonNumber = sizeof(COMMON_BASES) / sizeof(COMMON_BASES[0]);
+    size_t const basesNumber = CONVERTER_MAX_BASE - CONVERTER_MIN_BASE + 1;
+    int const common = randomBelow(pRandom, 2) == 0;
+    pCase->originalBase = common ? COMMON_BASES[randomBelow(pRandom, commonNumber)] :
+                          CONVERTER_MIN_BASE + (int) randomBelow(pRandom, basesNumber);
+    pCase->newBase = common ? COMMON_BASES[randomBelow(pRandom, commonNumber)] :
+                     CONVERTER_MIN_BASE + (int) randomBelow(pRandom, basesNumber);
+
+    // The tiers of lengths, the last tier is less frequent as its reference is slow.
+    size_t const tiers[] = {1, 21, 701, 6001};
+    size_t const tier = randomBelow(pRandom, 8);
+    size_t const low = tiers[(tier < 3) ? 0 : (tier < 5) ? 1 : (tier < 7) ? 2 : 3];
+    size_t const high = (tier < 3) ? tiers[1] : (tier < 5) ? tiers[2] : (tier < 7) ? tiers[3] :
+                        maxLength + 1;
+    size_t length = low + randomBelow(pRandom, (high > low) ? high - low : 1);
+    pCase->length = (length > maxLength) ? maxLength : length;
+
+    // The sign and the leading zeros are taken from the length, at least a digit is left.
+    char * const number = pCase->number;
+    size_t position = 0;
+    size_t const sign = randomBelow(pRandom, 16);
+    if (pCase->length > 1 && sign < 3)
+    {
+        number[position++] = (sign == 0) ? '+' : '-';
+    }
+    size_t zeros = (randomBelow(pRandom, 16) == 0) ? 1 + randomBelow(pRandom, FUZZ_MAX_ZEROS) : 0;
+    for ( ; zeros > 0 && position + 1 < pCase->length; --zeros)
+    {
+        number[position++] = '0';
+    }
+
+    size_t const pattern = randomBelow(pRandom, 16);
+    size_t const first = position;
+    for ( ; position < pCase->length; ++position)
+    {
+        int const value = (pattern == 0) ? pCase->originalBase - 1 :
+                          (pattern == 1) ? (position == first) :
+                          (int) randomBelow(pRandom, (size_t) pCase->originalBase);
+        number[position] = randomCase(pRandom, value);
+    }
+
+    // An invalid digit is either a digit of a larger base or not a digit at all.
+    if (randomBelow(pRandom, 16) == 0)
+    {
+        size_t const index = first + randomBelow(pRandom, pCase->length - first);
+        size_t const larger = (size_t) (CONVERTER_MAX_BASE - pCase->originalBase);
+        size_t const choice = randomBelow(pRandom, larger + strlen(INVALID_CHARACTERS));
+        number[index] = (choice < larger) ?
+                        randomCase(pRandom, pCase->originalBase + (int) choice) :
+                        INVALID_CHARACTERS[choice - larger];
+    }
+}
+
+/**
+ * @brief Converts the given case through every path of the library, and compares every result
+ *        with the reference: without an Arena, with an Arena of a single thread and of a pool,
+ *        twice through the Cache, into limbs and from them, and into a buffer which is too small.
+ * @param pFuzz The state of the fuzzing.
+ * @param pCase The case, with its conversion by the reference.
+ * @return 0 if the case was checked, 1 if there is not enough memory.
+ */
+int checkCase(FuzzState * const pFuzz, FuzzCase const * const pCase)
+{
+    int const originalBase = pCase->originalBase;
+    int const newBase = pCase->newBase;
+    size_t const capacity = converterBound(originalBase, newBase, pCase->length);
+    size_t const limbsCapacity = converterLimbsBound(originalBase, pCase->length);
+    char * const result = malloc(capacity);
+    uint64_t * const limbs = malloc(limbsCapacity * sizeof(uint64_t));
+    if (result == NULL || limbs == NULL)
+    {
+        free(limbs);
+        free(result);
+        return INVALID_STATE;
+    }
+
+    ConverterArena * const arenas[] = {NULL, pFuzz->pArena, pFuzz->pPoolArena};
+    char const * const names[] = {"heap", "arena", "pool"};
+    size_t length = 0;
+    for (size_t i = 0; i < sizeof(arenas) / sizeof(arenas[0]); ++i)
+    {
+        int const state = converterConvert(originalBase, newBase, pCase->number, pCase->length,
+                                           result, capacity, &length, arenas[i]);
+        checkConversion(pFuzz, pCase, names[i], state, result, length);
+    }
+
+    // The first conversion through the Cache may store the number, the second may copy it.
+    for (int i = 0; i < 2; ++i)
+    {
+        int const state = converterCacheConvert(pFuzz->pCache, originalBase, newBase,
+                                                pCase->number, pCase->length, result, capacity,
+                                                &length, pFuzz->pArena);
+        checkConversion(pFuzz, pCase, "cache", state, result, length);
+    }
+
+    size_t size = 0;
+    int negative = FALSE;
+    int state = converterParseLimbs(originalBase, pCase->number, pCase->length, limbs,
+                                    limbsCapacity, &size, &negative, pFuzz->pArena);
+    pFuzz->checks++;
+    if (state != pCase->state ||
+        (state == CONVERTER_VALID &&
+         (size != pCase->size || negative != pCase->negative ||
+          (size > 0 && memcmp(limbs, pCase->limbs, size * sizeof(uint64_t)) != 0))))
+    {
+        reportMismatch(pFuzz, pCase, "parse limbs");
+    }
+    if (state == CONVERTER_VALID)
+    {
+        state = converterConvertLimbs(newBase, limbs, size, negative, result, capacity, &length,
+                                      pFuzz->pPoolArena);
+        checkConversion(pFuzz, pCase, "convert limbs", state, result, length);
+    }
+
+    // A buffer of a character less than the converted number holds none of it.
+    if (pCase->state == CONVERTER_VALID)
+    {
+        state = converterConvert(originalBase, newBase, pCase->number, pCase->length, result,
+                                 pCase->expectedLength - 1, &length, pFuzz->pArena);
+        pFuzz->checks++;
+        if (state != CONVERTER_BUFFER_TOO_SMALL || length != pCase->expectedLength)
+        {
+            reportMismatch(pFuzz, pCase, "small buffer");
+        }
+    }
+    free(limbs);
+    free(result);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Compares a single conversion of the given case with the reference.
+ * @param pFuzz The state of the fuzzing.
+ * @param pCase The case, with its conversion by the reference.
+ * @param name The name of the path of the library which converted the case.
+ * @param state The result of the conversion.
+ * @param result The converted number.
+ * @param length The number of characters in the converted number.
+ */
+void checkConversion(FuzzState * const pFuzz, FuzzCase const * const pCase,
+                     char const * const name, int const state, char const * const result,
+                     size_t const length)
+{
+    pFuzz->checks++;
+    if (state != pCase->state ||
+        (state == CONVERTER_VALID &&
+         (length != pCase->expectedLength || memcmp(result, pCase->expected, length) != 0)))
+    {
+        reportMismatch(pFuzz, pCase, name);
+    }
+}
+
+/**
+ * @brief Reports a conversion of the given case which differs from the reference.
+ * @param pFuzz The state of the fuzzing.
+ * @param pCase The case.
+ * @param name The name of the path of the library which converted the case.
+ */
+void reportMismatch(FuzzState * const pFuzz, FuzzCase const * const pCase,
+                    char const * const name)
+{
+    pFuzz->mismatches++;
+    fprintf(stderr, MISMATCH_MESSAGE, name, pCase->index,
+            (unsigned long long) pFuzz->pOptions->seed, pCase->originalBase, pCase->newBase,
+            pCase->length);
+    if (pCase->length <= REPORTED_LENGTH)
+    {
+        fprintf(stderr, MISMATCH_NUMBER_MESSAGE, (int) pCase->length, pCase->number);
+    }
+}
+
+
+/*----=  Reference  =-----*/
+
+
+/**
+ * @brief Converts the number of the given case by the reference, which is slow but plain: the
+ *        digits are accumulated into 32 bits words a chunk of digits at a time, and the words are
+ *        divided by the power of the new base of a chunk until they are 0. The time is quadratic
+ *        in the length of the number.
+ * @param pCase The case, the result of the reference, its converted number and its limbs are
+ *        stored in it.
+ * @return 0 if the number was converted, 1 if there is not enough memory.
+ */
+int referenceConverter(FuzzCase * const pCase)
+{
+    char const * digits = pCase->number;
+    size_t digitsLength = pCase->length;
+    int const negative = (digitsLength > 0 && *digits == '-');
+    if (digitsLength > 0 && (*digits == '-' || *digits == '+'))
+    {
+        digits++;
+        digitsLength--;
+    }
+
+    size_t const capacity = digitsLength * DIGIT_BITS / WORD_BITS + 2;
+    uint32_t * const words = malloc(capacity * sizeof(uint32_t));
+    pCase->expected = malloc(capacity * WORD_BITS + 2);
+    pCase->limbs = malloc((capacity / 2 + 1) * sizeof(uint64_t));
+    if (words == NULL || pCase->expected == NULL || pCase->limbs == NULL)
+    {
+        free(words);
+        return INVALID_STATE;
+    }
+
+    size_t size = 0;
+    pCase->state = (digitsLength > 0) ?
+                   referenceParse(pCase->originalBase, digits, digitsLength, words, &size) :
+                   INVALID_STATE;
+    if (pCase->state == VALID_STATE)
+    {
+        // The limbs are pairs of words.
+        pCase->size = (size + 1) / 2;
+        pCase->negative = negative && size > 0;
+        for (size_t i = 0; i < pCase->size; ++i)
+        {
+            uint64_t const high = (2 * i + 1 < size) ? words[2 * i + 1] : 0;
+            pCase->limbs[i] = (high << WORD_BITS) | words[2 * i];
+        }
+
+        size_t const sign = pCase->negative ? 1 : 0;
+        pCase->expected[0] = '-';
+        pCase->expectedLength = sign + referenceWrite(pCase->newBase, words, size,
+                                                      pCase->expected + sign);
+    }
+    free(words);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Parses the given digits into 32 bits words, a chunk of digits at a time.
+ * @param base The base of the digits.
+ * @param digits The digits, the most significant first, which may be in either case.
+ * @param length The number of digits.
+ * @param words The buffer to store the words in, the least significant first.
+ * @param pSize The path to store the number of words in, without leading zero words.
+ * @return 0 if every digit is a digit of the base, 1 otherwise.
+ */
+int referenceParse(int const base, char const * const digits, size_t const length,
+                   uint32_t * const words, size_t * const pSize)
+{
+    size_t const chunk = referenceChunk(base);
+    size_t size = 0;
+    for (size_t start = 0; start < length; start += chunk)
+    {
+        size_t const count = (length - start < chunk) ? length - start : chunk;
+        uint64_t multiplier = 1;
+        uint64_t carry = 0;
+        for (size_t i = start; i < start + count; ++i)
+        {
+            int const value = digitValue(digits[i]);
+            if (value >= base)
+            {
+                return INVALID_STATE;
+            }
+            carry = carry * (uint64_t) base + (uint64_t) value;
+            multiplier *= (uint64_t) base;
+        }
+
+        // The words are multiplied by the power of the chunk, and the chunk is added.
+        for (size_t i = 0; i < size; ++i)
+        {
+            uint64_t const product = words[i] * multiplier + carry;
+            words[i] = (uint32_t) product;
+            carry = product >> WORD_BITS;
+        }
+        if (carry != 0)
+        {
+            words[size++] = (uint32_t) carry;
+        }
+    }
+    *pSize = size;
+    return VALID_STATE;
+}
+
+/**
+ * @brief Writes the given 32 bits words in the given base, a chunk of digits at a time.
+ * @param base The base to write the number in.
+ * @param words The words, the least significant first, which are overwritten.
+ * @param size The number of words, without leading zero words.
+ * @param result The path to write the digits in, the most significant first.
+ * @return The number of digits, without leading zeros, 1 for 0.
+ */
+size_t referenceWrite(int const base, uint32_t * const words, size_t size, char * const result)
+{
+    size_t const chunk = referenceChunk(base);
+    uint64_t divisor = 1;
+    for (size_t i = 0; i < chunk; ++i)
+    {
+        divisor *= (uint64_t) base;
+    }
+
+    // The digits are emitted backwards, every chunk but the last is padded with zeros.
+    size_t count = 0;
+    while (size > 0)
+    {
+        uint64_t remainder = 0;
+        for (size_t i = size; i-- > 0; )
+        {
+            uint64_t const current = (remainder << WORD_BITS) | words[i];
+            words[i] = (uint32_t) (current / divisor);
+            remainder = current % divisor;
+        }
+        while (size > 0 && words[size - 1] == 0)
+        {
+            size--;
+        }
+        for (size_t i = 0; i < chunk && (size > 0 || remainder > 0); ++i)
+        {
+            result[count++] = DIGIT_CHARACTERS[remainder % (uint64_t) base];
+            remainder /= (uint64_t) base;
+        }
+    }
+    if (count == 0)
+    {
+        result[count++] = '0';
+    }
+
+    for (size_t i = 0; i < count / 2; ++i)
+    {
+        char const digit = result[i];
+        result[i] = result[count - 1 - i];
+        result[count - 1 - i] = digit;
+    }
+    return count;
+}
+
+/**
+ * @brief Returns the number of digits of the given base in a chunk of the reference, the most
+ *        whose power fits in a single word.
+ * @param base The base.
+ * @return The number of digits.
+ */
+size_t referenceChunk(int const base)
+{
+    size_t chunk = 0;
+    for (uint64_t power = (uint64_t) base; power <= WORD_MASK; power *= (uint64_t) base)
+    {
+        chunk++;
+    }
+    return chunk;
+}
+
+/**
+ * @brief Returns the value of the given digit, the letters in either case follow the decimal
+ *        digits.
+ * @param digit The digit.
+ * @return The value, or CONVERTER_MAX_BASE if the character is not a digit of any base.
+ */
+int digitValue(char const digit)
+{
+    if (digit >= '0' && digit <= '9')
+    {
+        return digit - '0';
+    }
+    if (digit >= 'a' && digit <= 'z')
+    {
+        return digit - 'a' + STANDARD_BASE;
+    }
+    if (digit >= 'A' && digit <= 'Z')
+    {
+        return digit - 'A' + STANDARD_BASE;
+    }
+    return CONVERTER_MAX_BASE;
+}
+
+
+/*----=  Output  =-----*/
+
+
+/**
+ * @brief Prints the result of a single measurement.
+ * @param pOptions The options of the program.
+ * @param mode The mode of conversion.
+ * @param pPair The pair of bases.
+ * @param length The number of digits in the numbers.
+ * @param pResult The result of the measurement.
+ */
+void printResult(BenchmarkOptions const * const pOptions, ConversionMode const mode,
+                 BasePair const * const pPair, size_t const length,
+                 BenchmarkResult const * const pResult)
+{
+    size_t const threads = (mode == THREADS_MODE) ? pOptions->threads : 1;
+    double const rate = (pResult->seconds > 0) ?
+                        (double) pResult->conversions / pResult->seconds : 0;
+    double const perDigit = pResult->seconds * NANOSECONDS_PER_SECOND /
+                            ((double) pResult->conversions * (double) length);
+
+    if (pOptions->json)
+    {
+        printf("{\"mode\":\"%s\",\"original_base\":%d,\"new_base\":%d,\"length\":%zu,"
+               "\"threads\":%zu,\"conversions\":%llu,\"seconds\":%.9f,"
+               "\"conversions_per_second\":%.1f,\"ns_per_digit\":%.3f,\"peak_rss_kb\":%ld}\n",
+               MODE_NAMES[mode], pPair->originalBase, pPair->newBase, length, threads,
+               pResult->conversions, pResult->seconds, rate, perDigit, pResult->peakRss);
+    }
+    else
+    {
+        printf("%s,%d,%d,%zu,%zu,%llu,%.9f,%.1f,%.3f,%ld\n", MODE_NAMES[mode],
+               pPair->originalBase, pPair->newBase, length, threads, pResult->conversions,
+               pResult->seconds, rate, perDigit, pResult->peakRss);
+    }
+}
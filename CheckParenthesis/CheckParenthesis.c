@@ -11,19 +11,92 @@
  *
  * @section DESCRIPTION
  * A program that verify text files that satisfies a desired parenthesis structure.
- * Input:       A name or a path to a text file.
+ * Input:       A name or a path to a text file ('-' for the standard input), optionally preceded
+ *              by options in the format of -
+ *              [--json] [--max-depth <depth>] [--scanner <scalar|sse2|avx2>]
+ *              [--pairs <pairs>] [--lexer] [--line-comment <prefix>] [--threads <number>]
+ *              [--profile <regions>] [--index <file>] <filename>
+ *              The pairs are UTF-8 characters, each Opening-Parenthesis followed by its
+ *              Closing-Parenthesis, "()[]<>{}" by default.
+ *              With '--lexer' the Parenthesis inside string and character literals and inside
+ *              comments are skipped. The prefix of line comments is "//" by default, and an
+ *              empty prefix means there are none. '--line-comment' implies '--lexer'.
+ *              In batch mode ('--batch' before the other options) any number of files and
+ *              directories may be given, directories are walked recursively for regular files,
+ *              other files found on the way, such as FIFOs, are skipped. If none is given,
+ *              a NUL separated list of files is read from the standard input.
+ *              With '--io <map|uring|pread>' in batch mode, the files are read asynchronously
+ *              instead of being mapped. '--index' is not accepted in batch mode.
+ *              A statistics build also accepts [--stats] [--progress <seconds>].
  * Process:     Validates input, if the input is valid the program starts to analyze the text file
  *              for determine if the structure of parenthesis is valid or invalid.
+ *              The analysis itself is done by the Parenthesis Validator library.
+ *              Regular files are memory mapped and fed to the validator at once, so they may be
+ *              scanned in parallel chunks. Other files (e.g. pipes) are read in large buffers.
  *              If the file is invalid the program ends with an error message.
+ *              In batch mode the files are checked by a pool of '--threads' workers.
+ *              With '--io uring', a single thread keeps reads of many files in flight through
+ *              io_uring, into buffers registered with the kernel once, and hands every filled
+ *              buffer to the workers, which validate it while the next reads are in flight.
+ *              Where io_uring is not available, and with '--io pread', the reads are done by a
+ *              pool of threads calling pread instead.
  * Output:      A message that states the file analysis results, if the input was valid.
- *              An error message in case of bad input.
+ *              An error message in case of bad input, or if the file exceeds the nesting depth.
+ *              In batch mode, a line of '<path>\t<ok|bad structure|error>' per file.
+ *              With '--json', a JSON object per file instead, holding the path, the verdict and
+ *              the first violation: its kind, its byte offset, line and column, and the position
+ *              of the Opening-Parenthesis involved.
+ *              With '--profile', the depth profile of every valid file follows its verdict: the
+ *              maximal nesting depth, the number of Opening-Parenthesis in every range of depths
+ *              of a power of two, and the offsets of the given number of deepest regions, which
+ *              are the pairs that enclose no other Parenthesis.
+ *              With '--index', the index of the pairs of a valid File is written to the given
+ *              file: the offsets of the two Parenthesis and the kind of every pair, in the order
+ *              of their Opening-Parenthesis, built while the File is validated. The index is
+ *              written through a mapping of the file, in the layout of ValidatorIndexHeader, so
+ *              it may be mapped as it is and a pair is found by its ordinal in constant time.
+ *              With '--stats', the counters of the run are printed to the standard error once it
+ *              ends: the files, the bytes read and scanned, the Parenthesis, the maximal depth,
+ *              and the time spent reading the files apart from the time spent validating them.
+ *              With '--progress', the files and the bytes read so far are printed to the
+ *              standard error every given number of seconds.
+ * Build:       gcc -std=c99 -O2 -pthread CheckParenthesis.c ParenthesisValidator.c
+ *              FileReader.c -o CheckParenthesis
+ *              The statistics build adds -DVALIDATOR_STATISTICS, otherwise the counters and the
+ *              timers are not compiled at all.
  */
 
 
 /*----=  Includes  =-----*/
 
 
+#define _DEFAULT_SOURCE
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ParenthesisValidator.h"
+#include "FileReader.h"
+
+#ifdef VALIDATOR_STATISTICS
+#include <time.h>
+#include <sys/resource.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+/**
+ * @def TIME_STAMP_COUNTER
+ * @brief A Flag which states that the timer reads the time stamp counter of the CPU.
+ */
+#define TIME_STAMP_COUNTER
+#endif
+#endif
 
 
 /*----=  Definitions  =-----*/
@@ -41,30 +114,271 @@
  */
 #define INVALID_STATE 1
 
+#ifdef VALIDATOR_STATISTICS
 /**
- * @def VALID_ARGUMENTS_NUMBER 2
- * @brief A Macro that sets the valid number of arguments for this program.
+ * @def STATISTICS_USAGE "[--stats] [--progress <seconds>] "
+ * @brief A Macro that sets the usage of the statistics options, which exist only if they are
+ *        compiled in.
  */
-#define VALID_ARGUMENTS_NUMBER 2
+#define STATISTICS_USAGE "[--stats] [--progress <seconds>] "
+#else
+#define STATISTICS_USAGE ""
+#endif
 
 /**
- * @def INVALID_ARGUMENTS_MESSAGE "Please supply a file!\nusage: CheckParenthesis <filename>\n"
+ * @def INVALID_ARGUMENTS_MESSAGE "Please supply a file!\nusage: CheckParenthesis ..."
  * @brief A Macro that sets the output message for invalid arguments.
  */
-#define INVALID_ARGUMENTS_MESSAGE "Please supply a file!\nusage: CheckParenthesis <filename>\n"
+#define INVALID_ARGUMENTS_MESSAGE "Please supply a file!\n" \
+                                  "usage: CheckParenthesis [--json] [--max-depth <depth>] " \
+                                  "[--scanner <scalar|sse2|avx2>] [--pairs <pairs>] " \
+                                  "[--lexer] [--line-comment <prefix>] " \
+                                  "[--threads <number>] [--profile <regions>] " \
+                                  "[--index <file>] " STATISTICS_USAGE "<filename>\n" \
+                                  "       CheckParenthesis --batch [--io <map|uring|pread>] " \
+                                  "[options] [<path>...]\n"
 
 /**
  * @def FILE_NAME_INDEX 1
- * @brief A Macro that sets the index of the File name in the arguments array.
+ * @brief A Macro that sets the index of the first argument in the arguments array.
  */
 #define FILE_NAME_INDEX 1
 
+/**
+ * @def OPTION_PREFIX "--"
+ * @brief A Macro that sets the prefix of every option of the program.
+ */
+#define OPTION_PREFIX "--"
+
+/**
+ * @def BATCH_OPTION "--batch"
+ * @brief A Macro that sets the option which checks many Files in a single run.
+ */
+#define BATCH_OPTION "--batch"
+
+/**
+ * @def JSON_OPTION "--json"
+ * @brief A Macro that sets the option which prints the results as JSON objects.
+ */
+#define JSON_OPTION "--json"
+
+/**
+ * @def LEXER_OPTION "--lexer"
+ * @brief A Macro that sets the option which skips the Parenthesis inside literals and comments.
+ */
+#define LEXER_OPTION "--lexer"
+
+/**
+ * @def STANDARD_INPUT_NAME "-"
+ * @brief A Macro that sets the File name which stands for the standard input.
+ */
+#define STANDARD_INPUT_NAME "-"
+
+/**
+ * @def MAX_DEPTH_OPTION "--max-depth"
+ * @brief A Macro that sets the option which limits the nesting depth of the File.
+ */
+#define MAX_DEPTH_OPTION "--max-depth"
+
+/**
+ * @def SCANNER_OPTION "--scanner"
+ * @brief A Macro that sets the option which forces a specific Parenthesis scanner.
+ */
+#define SCANNER_OPTION "--scanner"
+
+/**
+ * @def PAIRS_OPTION "--pairs"
+ * @brief A Macro that sets the option which sets the Parenthesis pairs checked in the File.
+ */
+#define PAIRS_OPTION "--pairs"
+
+/**
+ * @def LINE_COMMENT_OPTION "--line-comment"
+ * @brief A Macro that sets the option which sets the prefix of line comments, and skips the
+ *        Parenthesis inside literals and comments.
+ */
+#define LINE_COMMENT_OPTION "--line-comment"
+
+/**
+ * @def DEFAULT_LINE_COMMENT "//"
+ * @brief A Macro that sets the prefix of line comments used if none is given.
+ */
+#define DEFAULT_LINE_COMMENT "//"
+
+/**
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the option which sets the number of threads scanning the File.
+ */
+#define THREADS_OPTION "--threads"
+
+/**
+ * @def DEFAULT_THREADS 1
+ * @brief A Macro that sets the number of threads scanning the File by default.
+ */
+#define DEFAULT_THREADS 1
+
+/**
+ * @def PROFILE_OPTION "--profile"
+ * @brief A Macro that sets the option which prints the depth profile of every valid File.
+ */
+#define PROFILE_OPTION "--profile"
+
+/**
+ * @def INDEX_OPTION "--index"
+ * @brief A Macro that sets the option which writes the index of the pairs of the File.
+ */
+#define INDEX_OPTION "--index"
+
+/**
+ * @def INDEX_FILE_MODE 0644
+ * @brief A Macro that sets the permissions of a new index File.
+ */
+#define INDEX_FILE_MODE 0644
+
+/**
+ * @def IO_OPTION "--io"
+ * @brief A Macro that sets the option which sets how the Files are read in batch mode.
+ */
+#define IO_OPTION "--io"
+
+/**
+ * @def IO_MAP "map"
+ * @brief A Macro that sets the name of the default reading, which maps every File.
+ */
+#define IO_MAP "map"
+
+/**
+ * @def DECIMAL_BASE 10
+ * @brief A Macro that sets the base of numeric arguments.
+ */
+#define DECIMAL_BASE 10
+
 /**
  * @def INVALID_FILE_ARGUMENTS_MESSAGE "Error! trying to open the file %s\n"
  * @brief A Macro that sets the output message for an invalid File argument.
  */
 #define INVALID_FILE_ARGUMENTS_MESSAGE "Error! trying to open the file %s\n"
 
+/**
+ * @def DEPTH_LIMIT_MESSAGE "Error! the file %s exceeds the nesting depth of %zu\n"
+ * @brief A Macro that sets the output message for a File that could not be analyzed.
+ */
+#define DEPTH_LIMIT_MESSAGE "Error! the file %s exceeds the nesting depth of %zu\n"
+
+/**
+ * @def READ_FAILED_MESSAGE "Error! trying to read the file %s\n"
+ * @brief A Macro that sets the output message for a File which could not be read.
+ */
+#define READ_FAILED_MESSAGE "Error! trying to read the file %s\n"
+
+/**
+ * @def WRITE_FAILED_MESSAGE "Error! trying to write the file %s\n"
+ * @brief A Macro that sets the output message for a File which could not be written.
+ */
+#define WRITE_FAILED_MESSAGE "Error! trying to write the file %s\n"
+
+/**
+ * @def OUT_OF_MEMORY_MESSAGE "Error! not enough memory to analyze the file %s\n"
+ * @brief A Macro that sets the output message for a File that is nested beyond the memory.
+ */
+#define OUT_OF_MEMORY_MESSAGE "Error! not enough memory to analyze the file %s\n"
+
+/**
+ * @def OPEN_FAILED_STATE 3
+ * @brief A Flag for a File which could not be opened.
+ */
+#define OPEN_FAILED_STATE 3
+
+/**
+ * @def WRITE_FAILED_STATE 4
+ * @brief A Flag for a File whose index could not be written.
+ */
+#define WRITE_FAILED_STATE 4
+
+/**
+ * @def READ_FAILED_STATE 5
+ * @brief A Flag for a File which could not be read to its end.
+ */
+#define READ_FAILED_STATE 5
+
+/**
+ * @def BATCH_RESULT_FORMAT "%s\t%s\n"
+ * @brief A Macro that sets the format of the result line of a single File in batch mode.
+ */
+#define BATCH_RESULT_FORMAT "%s\t%s\n"
+
+/**
+ * @def VALID_VERDICT "ok"
+ * @brief A Macro that sets the batch mode verdict of a valid File.
+ */
+#define VALID_VERDICT "ok"
+
+/**
+ * @def INVALID_VERDICT "bad structure"
+ * @brief A Macro that sets the batch mode verdict of an invalid File.
+ */
+#define INVALID_VERDICT "bad structure"
+
+/**
+ * @def ERROR_VERDICT "error"
+ * @brief A Macro that sets the batch mode verdict of a File which could not be analyzed.
+ */
+#define ERROR_VERDICT "error"
+
+/**
+ * @def MISMATCHED_PAIR_KIND "mismatched pair"
+ * @brief A Macro that sets the JSON name of a Closing-Parenthesis of the wrong kind.
+ */
+#define MISMATCHED_PAIR_KIND "mismatched pair"
+
+/**
+ * @def STRAY_CLOSER_KIND "stray closer"
+ * @brief A Macro that sets the JSON name of a Closing-Parenthesis which closes nothing.
+ */
+#define STRAY_CLOSER_KIND "stray closer"
+
+/**
+ * @def UNCLOSED_OPENER_KIND "unclosed opener"
+ * @brief A Macro that sets the JSON name of an Opening-Parenthesis left open.
+ */
+#define UNCLOSED_OPENER_KIND "unclosed opener"
+
+/**
+ * @def MAX_DEPTH_FORMAT "\tmaximal depth %llu\n"
+ * @brief A Macro that sets the format of the maximal depth in the depth profile of a File.
+ */
+#define MAX_DEPTH_FORMAT "\tmaximal depth %llu\n"
+
+/**
+ * @def DEPTHS_FORMAT "\tdepths %llu-%llu: %llu\n"
+ * @brief A Macro that sets the format of a range of depths in the depth profile of a File.
+ */
+#define DEPTHS_FORMAT "\tdepths %llu-%llu: %llu\n"
+
+/**
+ * @def REGION_FORMAT "\tregion of depth %llu: %llu-%llu\n"
+ * @brief A Macro that sets the format of a deepest region in the depth profile of a File.
+ */
+#define REGION_FORMAT "\tregion of depth %llu: %llu-%llu\n"
+
+/**
+ * @def JSON_CONTROL_FORMAT "\\u%04x"
+ * @brief A Macro that sets the format of a control character in a JSON string.
+ */
+#define JSON_CONTROL_FORMAT "\\u%04x"
+
+/**
+ * @def PATH_QUEUE_CAPACITY 1024
+ * @brief A Macro that sets the number of File paths waiting for the batch mode workers.
+ */
+#define PATH_QUEUE_CAPACITY 1024
+
+/**
+ * @def PATH_SEPARATOR '/'
+ * @brief A Macro that sets the separator of directories in a path.
+ */
+#define PATH_SEPARATOR '/'
+
 /**
  * @def VALID_FILE "ok\n"
  * @brief A Macro that sets the output message for a valid File.
@@ -78,290 +392,2300 @@
 #define INVALID_FILE "bad structure\n"
 
 /**
- * @def INITIAL_SCOPE_NUMBER 0
- * @brief A Macro that sets the initial scope number in a given File.
+ * @def READ_BUFFER_SIZE (1 << 20)
+ * @brief A Macro that sets the size of the buffer used for Files which cannot be mapped.
  */
-#define INITIAL_SCOPE_NUMBER 0
+#define READ_BUFFER_SIZE (1 << 20)
 
 /**
- * @def OPEN_ROUND '('
- * @brief A Flag for the Round Opening-Parenthesis character.
+ * @def ASYNC_BUFFER_SIZE (128 << 10)
+ * @brief A Macro that sets the size of a single read of the asynchronous batch mode.
  */
-#define OPEN_ROUND '('
+#define ASYNC_BUFFER_SIZE (128 << 10)
 
 /**
- * @def CLOSE_ROUND ')'
- * @brief A Flag for the Round Closing-Parenthesis character.
+ * @def ASYNC_BUFFERS_NUMBER 64
+ * @brief A Macro that sets the number of buffers of the asynchronous batch mode, which is small
+ *        enough for them to be locked in the memory by default.
  */
-#define CLOSE_ROUND ')'
+#define ASYNC_BUFFERS_NUMBER 64
 
 /**
- * @def OPEN_SQUARE '['
- * @brief A Flag for the Square Opening-Parenthesis character.
+ * @def ASYNC_FILES_NUMBER 16
+ * @brief A Macro that sets the number of Files open at once in the asynchronous batch mode.
  */
-#define OPEN_SQUARE '['
+#define ASYNC_FILES_NUMBER 16
 
 /**
- * @def CLOSE_SQUARE ']'
- * @brief A Flag for the Square Closing-Parenthesis character.
+ * @def ASYNC_FILE_BUFFERS 4
+ * @brief A Macro that sets the number of filled buffers a single File may hold while they wait
+ *        for a worker, so a slow File does not take all the buffers.
  */
-#define CLOSE_SQUARE ']'
+#define ASYNC_FILE_BUFFERS 4
 
 /**
- * @def OPEN_TRIANGLE '<'
- * @brief A Flag for the Triangle Opening-Parenthesis character.
+ * @def READER_THREADS 16
+ * @brief A Macro that sets the number of threads calling pread, if io_uring is not used.
  */
-#define OPEN_TRIANGLE '<'
+#define READER_THREADS 16
 
 /**
- * @def CLOSE_TRIANGLE '>'
- * @brief A Flag for the Triangle Closing-Parenthesis character.
+ * @def NO_BUFFER ((size_t) -1)
+ * @brief A Macro that sets the index which ends a list of buffers.
  */
-#define CLOSE_TRIANGLE '>'
+#define NO_BUFFER ((size_t) -1)
+
+#ifdef VALIDATOR_STATISTICS
 
 /**
- * @def OPEN_CURLY '{'
- * @brief A Flag for the Curly Opening-Parenthesis character.
+ * @def STATS_OPTION "--stats"
+ * @brief A Macro that sets the option which prints the counters of the run once it ends.
  */
-#define OPEN_CURLY '{'
+#define STATS_OPTION "--stats"
 
 /**
- * @def CLOSE_CURLY '}'
- * @brief A Flag for the Curly Closing-Parenthesis character.
+ * @def PROGRESS_OPTION "--progress"
+ * @brief A Macro that sets the option which prints the progress of the run periodically.
  */
-#define CLOSE_CURLY '}'
+#define PROGRESS_OPTION "--progress"
 
+/**
+ * @def STATISTICS_PART_SIZE (64 << 20)
+ * @brief A Macro that sets the size of the parts a mapped File is fed in while counting, so the
+ *        progress of a large File is seen.
+ */
+#define STATISTICS_PART_SIZE (64 << 20)
 
-/*----=  Forward Declarations  =-----*/
+/**
+ * @def INPUT_TIME 0
+ * @brief A Flag for the time spent opening, mapping and reading Files.
+ */
+#define INPUT_TIME 0
 
+/**
+ * @def VALIDATION_TIME 1
+ * @brief A Flag for the time spent in the Validator, including the page faults of mapped Files.
+ */
+#define VALIDATION_TIME 1
 
 /**
- * @brief Analyze the results of the 'checkFile' functions, and perform the
- *        required actions for each scenario.
- * @param checkFileResult The given result of the 'checkFile' functions.
+ * @def NANOSECONDS_PER_SECOND 1000000000
+ * @brief A Macro that sets the number of nanoseconds in a second.
  */
-void analyzeResults(int const checkFileResult);
+#define NANOSECONDS_PER_SECOND 1000000000
 
 /**
- * @brief Checks the given File for valid parenthesis structure.
- * @param pFile The given File to check.
- * @return 0 if the given File satisfies the required parenthesis structure, 1 otherwise.
+ * @def BYTES_PER_MEGABYTE 1e6
+ * @brief A Macro that sets the number of bytes in a megabyte of the throughput.
  */
-int checkFile(FILE * const pFile);
+#define BYTES_PER_MEGABYTE 1e6
 
 /**
- * @brief Checks the given File for valid parenthesis structure.
- *        This function perform recursive calls each time a new parenthesis is opened.
- * @param currentType The current type of Opening-Parenthesis in this call of the function.
- * @param pFile The given File to check.
- * @return 0 if the given File satisfies the required parenthesis structure, 1 otherwise.
+ * @def PROGRESS_MESSAGE "Progress: %.1f seconds, %llu files, %llu bytes read, %.1f MB/s\n"
+ * @brief A Macro that sets the output message of the periodic progress.
  */
-int checkFileHelper(char const currentType, FILE * const pFile);
+#define PROGRESS_MESSAGE "Progress: %.1f seconds, %llu files, %llu bytes read, %.1f MB/s\n"
 
 /**
- * @brief Checks if a given 2 parenthesis are matching each other (i.e. one closes the other).
- * @param close The Closing-Parenthesis character.
- * @param open The Opening-Parenthesis character.
- * @return 0 if the given 2 parenthesis are matching each other, 1 otherwise.
+ * @def STATISTICS_MESSAGE "Statistics: %llu files, %llu bytes read, %llu bytes scanned, ..."
+ * @brief A Macro that sets the output message of the counters of the run.
  */
-int checkMatchingParenthesis(char const close, char const open);
+#define STATISTICS_MESSAGE "Statistics: %llu files, %llu bytes read, %llu bytes scanned, " \
+                           "%llu parenthesis, maximal depth %llu\n"
 
+/**
+ * @def TIME_MESSAGE "Time: %.3f seconds, %.3f reading, %.3f validating, ..."
+ * @brief A Macro that sets the output message of the time of the run, the reading and the
+ *        validating times are summed over the threads.
+ */
+#define TIME_MESSAGE "Time: %.3f seconds, %.3f reading, %.3f validating, %.1f MB/s, " \
+                     "%ld major page faults\n"
 
-/*----=  Main  =-----*/
+/**
+ * @def JSON_STATISTICS_FORMAT "{\"statistics\":{\"files\":%llu,..."
+ * @brief A Macro that sets the format of the counters of the run as a JSON object.
+ */
+#define JSON_STATISTICS_FORMAT "{\"statistics\":{\"files\":%llu,\"bytes_read\":%llu," \
+                               "\"bytes_scanned\":%llu,\"parenthesis\":%llu," \
+                               "\"max_depth\":%llu,\"seconds\":%.6f," \
+                               "\"reading_seconds\":%.6f,\"validating_seconds\":%.6f," \
+                               "\"major_faults\":%ld}}\n"
 
+/**
+ * @def START_TIMER(timer)
+ * @brief A Macro that declares a timer and starts it.
+ */
+#define START_TIMER(timer) unsigned long long timer = readTimer()
 
 /**
- * @brief The main function that runs the program.
- *        It receives arguments from the user and if the arguments are valid, it runs the File
- *        Analysis.
- * @param argc The number of given arguments.
- * @param argv[] The arguments from the user.
- * @return 0 if the given File is a text file which satisfies the required
- *         parenthesis structure, 1 otherwise.
+ * @def COUNT_TIME(pOptions, phase, timer)
+ * @brief A Macro that adds the time since the given timer started to the given phase of the
+ *        run, and restarts the timer.
  */
-int main(int argc, char * argv[])
-{
+#define COUNT_TIME(pOptions, phase, timer) countTime((pOptions)->pStatistics, phase, &(timer))
 
-    // Check valid arguments.
-    if (argc != VALID_ARGUMENTS_NUMBER)
-    {
-        fprintf(stderr, INVALID_ARGUMENTS_MESSAGE);
-        return INVALID_STATE;
-    }
-    else
-    {
-        // Receive the File to check.
-        FILE * pFile;
-        pFile = fopen(argv[FILE_NAME_INDEX], "r");
+/**
+ * @def COUNT_BYTES(pOptions, length)
+ * @brief A Macro that adds the given number of bytes read to the counters of the run.
+ */
+#define COUNT_BYTES(pOptions, length) countBytes((pOptions)->pStatistics, length)
 
-        // In case of a bad File.
-        if (pFile == 0)
-        {
-            fprintf(stderr, INVALID_FILE_ARGUMENTS_MESSAGE, argv[FILE_NAME_INDEX]);
-            fclose(pFile);
-            return INVALID_STATE;
-        }
+/**
+ * @def COUNT_FILE(pOptions, pValidator)
+ * @brief A Macro that adds the counters of the given Validator to the counters of the run.
+ */
+#define COUNT_FILE(pOptions, pValidator) countFile((pOptions)->pStatistics, pValidator)
 
-        // Analyze the File and close its Stream.
-        int checkFileResult = checkFile(pFile);
-        fclose(pFile);
+#else
 
-        // Analyze the results.
-        analyzeResults(checkFileResult);
-        return VALID_STATE;
-    }
-}
+#define START_TIMER(timer) ((void) 0)
+#define COUNT_TIME(pOptions, phase, timer) ((void) (pOptions))
+#define COUNT_BYTES(pOptions, length) ((void) (pOptions))
+#define COUNT_FILE(pOptions, pValidator) ((void) (pOptions))
 
+#endif
 
-/*----=  Analyze File  =-----*/
 
 
+/*----=  Type Definitions  =-----*/
+
+
+#ifdef VALIDATOR_STATISTICS
+
 /**
- * @brief Analyze the results of the 'checkFile' functions, and perform the
- *        required actions for each scenario.
- * @param checkFileResult The given result of the 'checkFile' functions.
+ * @brief The counters of a run, shared by the batch mode workers, and the thread printing its
+ *        progress.
  */
-void analyzeResults(int const checkFileResult)
+typedef struct RunStatistics
 {
-    if (!(checkFileResult))  // If the File is valid, 'checkFileResult' will be equal to 0.
-    {
-        printf(VALID_FILE);
-    }
-    else
-    {
-        printf(INVALID_FILE);
-    }
-}
+    /** The number of Files checked. */
+    unsigned long long files;
+    /** The number of bytes read from the Files. */
+    unsigned long long bytesRead;
+    /** The number of bytes scanned by the Validators. */
+    unsigned long long bytesScanned;
+    /** The number of Parenthesis applied by the Validators. */
+    unsigned long long parenthesis;
+    /** The maximal nesting depth of the Files. */
+    unsigned long long maxDepth;
+    /** The timer ticks spent opening, mapping and reading the Files. */
+    unsigned long long inputTicks;
+    /** The timer ticks spent in the Validators. */
+    unsigned long long validationTicks;
+    /** The timer when the run started. */
+    unsigned long long startTicks;
+    /** The time when the run started. */
+    struct timespec start;
+    /** The number of seconds between two progress messages, or 0 for none. */
+    double progressInterval;
+    /** The thread printing the progress. */
+    pthread_t progressThread;
+    /** Non zero once the run ended. */
+    int stopped;
+    /** The lock of 'stopped'. */
+    pthread_mutex_t lock;
+    /** Signaled when the run ends. */
+    pthread_cond_t stop;
+} RunStatistics;
+
+#endif
 
 /**
- * @brief Checks the given File for valid parenthesis structure.
- * @param pFile The given File to check.
- * @return 0 if the given File satisfies the required parenthesis structure, 1 otherwise.
+ * @brief The options of the program, as given in the arguments.
  */
-int checkFile(FILE * const pFile)
+typedef struct CheckOptions
 {
-    return checkFileHelper(EOF, pFile);
-}
+    /** The names of the Files to check, a single File unless in batch mode. */
+    char ** fileNames;
+    /** The number of File names. */
+    int fileNamesNumber;
+    /** Non zero if many Files are checked in a single run. */
+    int batch;
+    /** Non zero if the results are printed as JSON objects. */
+    int json;
+    /** Non zero if the Parenthesis inside literals and comments are skipped. */
+    int lexical;
+    /** The maximal nesting depth allowed in the File, or VALIDATOR_UNLIMITED_DEPTH. */
+    size_t maxDepth;
+    /** The name of the scanner used for locating the Parenthesis in the File, or NULL. */
+    char const * scannerName;
+    /** The Parenthesis pairs checked in the File, or NULL for the default pairs. */
+    char const * pairs;
+    /** The prefix of line comments, or NULL for none. */
+    char const * lineComment;
+    /** The number of threads scanning the File. */
+    size_t threads;
+    /** The backend reading the Files in batch mode, or NULL for mapping them. */
+    char const * ioBackend;
+    /** Non zero if the depth profile of every valid File is printed. */
+    int profile;
+    /** The number of deepest regions in the depth profile. */
+    size_t regions;
+    /** The name of the File to write the index of the pairs to, or NULL. */
+    char const * indexName;
+#ifdef VALIDATOR_STATISTICS
+    /** Non zero if the counters of the run are printed once it ends. */
+    int statistics;
+    /** The number of seconds between two progress messages, or 0 for none. */
+    double progressInterval;
+    /** The counters of the run, or NULL if they are not needed. */
+    RunStatistics * pStatistics;
+#endif
+} CheckOptions;
 
 /**
- * @brief Checks the given File for valid parenthesis structure.
- *        This function perform recursive calls each time a new parenthesis is opened.
- * @param currentType The current type of Opening-Parenthesis in this call of the function.
- * @param pFile The given File to check.
- * @return 0 if the given File satisfies the required parenthesis structure, 1 otherwise.
+ * @brief A bounded queue of File paths, filled while walking the batch mode input and emptied
+ *        by the batch mode workers.
  */
-int checkFileHelper(char const currentType, FILE * const pFile)
+typedef struct PathQueue
 {
-    static int scopeCounter = INITIAL_SCOPE_NUMBER;
+    /** The paths in the queue, each was allocated on the heap. */
+    char * paths[PATH_QUEUE_CAPACITY];
+    /** The index of the first path in the queue. */
+    size_t head;
+    /** The number of paths in the queue. */
+    size_t size;
+    /** Non zero once no more paths will be added to the queue. */
+    int closed;
+    /** The options used for checking each path. */
+    CheckOptions const * pOptions;
+    /** The number of paths which could not be analyzed. */
+    size_t failures;
+    /** The lock of the queue. */
+    pthread_mutex_t lock;
+    /** Signaled when a path is added or the queue is closed. */
+    pthread_cond_t notEmpty;
+    /** Signaled when a path is removed. */
+    pthread_cond_t notFull;
+} PathQueue;
 
-    int currentChar;  // The current character in the given File.
+/**
+ * @brief A File of the asynchronous batch mode, from its opening until its verdict is printed.
+ */
+typedef struct AsyncFile
+{
+    /** The path of the File, which was allocated on the heap. */
+    char * path;
+    /** The descriptor of the File. */
+    int fileDescriptor;
+    /** The Validator of the File. */
+    ParenthesisValidator * pValidator;
+    /** The result of the last buffer fed to the Validator. */
+    int result;
+    /** The offset of the next read. */
+    unsigned long long offset;
+    /** The size of the File when it was opened. */
+    unsigned long long size;
+    /** The index of the File among the open Files. */
+    size_t slot;
+    /** Non zero if the File is not regular, so it is read by the worker instead. */
+    int streamed;
+    /** Non zero while a read of the File is in flight. */
+    int reading;
+    /** Non zero once no more reads of the File are needed. */
+    int ended;
+    /** Non zero if a read of the File failed. */
+    int failed;
+    /** Non zero while the File is ready or fed by a worker. */
+    int scanning;
+    /** The first filled buffer of the File which was not fed yet, or NO_BUFFER. */
+    size_t firstBuffer;
+    /** The last filled buffer of the File which was not fed yet. */
+    size_t lastBuffer;
+    /** The number of filled buffers of the File which were not fed yet. */
+    size_t buffersNumber;
+    /** The next File ready for the workers. */
+    struct AsyncFile * pNextReady;
+} AsyncFile;
 
-    while ((currentChar = fgetc(pFile)) != EOF)
-    {
-        // In case we reached any kind of Opening-Parenthesis, we enter a recursive call
-        // and increase the 'scopeCounter' by 1.
-        if (currentChar == OPEN_ROUND)
-        {
-            scopeCounter++;
-            checkFileHelper(OPEN_ROUND, pFile);
-        }
-        else if (currentChar == OPEN_SQUARE)
-        {
-            scopeCounter++;
-            checkFileHelper(OPEN_SQUARE, pFile);
-        }
-        else if (currentChar == OPEN_TRIANGLE)
-        {
-            scopeCounter++;
-            checkFileHelper(OPEN_TRIANGLE, pFile);
-        }
-        else if (currentChar == OPEN_CURLY)
-        {
-            scopeCounter++;
-            checkFileHelper(OPEN_CURLY, pFile);
-        }
+/**
+ * @brief The state of the asynchronous batch mode. It is guarded by the lock of its queue of
+ *        paths, so the thread reading the Files waits on the 'notEmpty' signal of the queue
+ *        for new paths and for released buffers alike.
+ */
+typedef struct AsyncBatch
+{
+    /** The queue of paths to check. */
+    PathQueue * pPaths;
+    /** The Reader of the Files, used only by the thread reading them. */
+    FileReader * pReader;
+    /** The thread reading the Files. */
+    pthread_t readingThread;
+    /** The open Files, NULL for a free slot. */
+    AsyncFile * openFiles[ASYNC_FILES_NUMBER];
+    /** The number of open Files. */
+    size_t openFilesNumber;
+    /** The buffers which are neither read into nor filled. */
+    size_t freeBuffers[ASYNC_BUFFERS_NUMBER];
+    /** The number of free buffers. */
+    size_t freeBuffersNumber;
+    /** The next filled buffer of the same File, or NO_BUFFER. */
+    size_t nextBuffers[ASYNC_BUFFERS_NUMBER];
+    /** The number of bytes in each filled buffer. */
+    size_t lengths[ASYNC_BUFFERS_NUMBER];
+    /** The number of reads in flight. */
+    size_t readsNumber;
+    /** The first File ready for the workers. */
+    AsyncFile * pFirstReady;
+    /** The last File ready for the workers. */
+    AsyncFile * pLastReady;
+    /** Non zero once all the Files were checked. */
+    int finished;
+    /** Signaled when a File is ready or all the Files were checked. */
+    pthread_cond_t ready;
+} AsyncBatch;
 
-        // In case we reached any kind of Closing-Parenthesis, we determine if it is valid.
-        // If it is valid we exit the current recursive call and decrease the 'scopeCounter' by 1.
-        // If it is invalid, we exit the recursive call with the value 1.
-        if (currentChar == CLOSE_ROUND || currentChar == CLOSE_SQUARE ||
-            currentChar == CLOSE_TRIANGLE || currentChar == CLOSE_CURLY)
-        {
-            if (!(checkMatchingParenthesis((char) currentChar, currentType)))
-            {
-                scopeCounter--;
-                return VALID_STATE;
-            }
-            else
-            {
-                return INVALID_STATE;
-            }
-        }
-    }
 
-    // In case we reached the end of the File, we check that there are no Opening-Parenthesis
-    // left unclosed, using the 'scopeCounter'.
-    if (scopeCounter == INITIAL_SCOPE_NUMBER)
-    {
-        return VALID_STATE;
-    }
-    else
-    {
-        return INVALID_STATE;
-    }
-}
+/*----=  Forward Declarations  =-----*/
+
 
 /**
- * @brief Checks if a given 2 parenthesis are matching each other (i.e. one closes the other).
- * @param close The Closing-Parenthesis character.
- * @param open The Opening-Parenthesis character.
- * @return 0 if the given 2 parenthesis are matching each other, 1 otherwise.
+ * @brief Parse the given arguments of the program.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param pOptions The path to store the parsed options in.
+ * @return 0 if the given arguments are valid, 1 otherwise.
  */
-int checkMatchingParenthesis(char const close, char const open)
-{
-    switch (close)
-    {
-        case (CLOSE_ROUND):
-            if (open != OPEN_ROUND)
-            {
-                return INVALID_STATE;
-            }
-            else
-            {
-                return VALID_STATE;
-            }
-
-        case (CLOSE_SQUARE):
-            if (open != OPEN_SQUARE)
-            {
-                return INVALID_STATE;
-            }
-            else
-            {
-                return VALID_STATE;
-            }
+int parseArguments(int const argc, char * argv[], CheckOptions * const pOptions);
 
-        case (CLOSE_TRIANGLE):
-            if (open != OPEN_TRIANGLE)
-            {
-                return INVALID_STATE;
-            }
-            else
-            {
-                return VALID_STATE;
-            }
+/**
+ * @brief Analyze the results of the 'checkFile' functions, and perform the
+ *        required actions for each scenario.
+ * @param checkFileResult The given result of the 'checkFile' functions.
+ */
+void analyzeResults(int const checkFileResult);
 
-        case (CLOSE_CURLY):
-            if (open != OPEN_CURLY)
-            {
-                return INVALID_STATE;
-            }
-            else
-            {
-                return VALID_STATE;
-            }
+/**
+ * @brief Opens and checks the File at the given path, errors are reported to the standard
+ *        error.
+ * @param fileName The name of the File to check, or STANDARD_INPUT_NAME.
+ * @param pOptions The options of the check.
+ * @param pError The path to store the first violation in, or NULL.
+ * @param pProfile The path to store the depth profile in, or NULL.
+ * @return The result of 'checkFile', or 3 if the File could not be opened.
+ */
+int checkPath(char const * const fileName, CheckOptions const * const pOptions,
+              ValidatorError * const pError, ValidatorProfile * const pProfile);
 
-        default:
+/**
+ * @brief Prints the error of a File which could not be analyzed within the nesting depth limit
+ *        or the memory.
+ * @param fileName The name of the File.
+ * @param pOptions The options of the check.
+ */
+void printLimitError(char const * const fileName, CheckOptions const * const pOptions);
+
+/**
+ * @brief Checks the single File given, and prints its result.
+ * @param pOptions The options of the check.
+ * @return 0 if the File was analyzed, 1 otherwise.
+ */
+int runSingle(CheckOptions const * const pOptions);
+
+/**
+ * @brief Checks all the Files given in batch mode using a pool of worker threads.
+ * @param pOptions The options of the check.
+ * @return 0 if all the Files were analyzed, 1 otherwise.
+ */
+int runBatch(CheckOptions const * const pOptions);
+
+/**
+ * @brief The routine of a batch mode worker, it checks the paths of the given queue until it is
+ *        closed and empty, and prints a verdict line for each.
+ * @param pQueue The queue of paths to check.
+ * @return NULL.
+ */
+void * batchWorker(void * pQueue);
+
+/**
+ * @brief Prints the verdict line of a single File in batch mode.
+ * @param fileName The name of the File.
+ * @param checkFileResult The result of 'checkPath' for the File.
+ * @param pError The first violation in the File, used only for JSON objects.
+ * @param pProfile The depth profile of the File, printed if the File is valid, or NULL.
+ * @param pOptions The options of the check.
+ * @return 0 if the File was analyzed, 1 otherwise.
+ */
+int printVerdict(char const * const fileName, int const checkFileResult,
+                 ValidatorError const * const pError, ValidatorProfile const * const pProfile,
+                 CheckOptions const * const pOptions);
+
+/**
+ * @brief Adds a copy of the given path to the given queue, waiting while the queue is full.
+ * @param pQueue The queue to add to.
+ * @param path The path to add.
+ * @return 0 if the path was added, 2 if there is not enough memory.
+ */
+int enqueuePath(PathQueue * const pQueue, char const * const path);
+
+/**
+ * @brief Adds the given path to the given queue, if it is a directory all the regular Files in
+ *        it are added recursively instead.
+ * @param pQueue The queue to add to.
+ * @param path The path to add.
+ * @return 0 if the path was added, 2 if there is not enough memory.
+ */
+int enqueueTree(PathQueue * const pQueue, char const * const path);
+
+/**
+ * @brief Removes the first path of the given queue, waiting while the queue is empty.
+ * @param pQueue The queue to remove from.
+ * @return The removed path, or NULL if the queue is closed and empty.
+ */
+char * dequeuePath(PathQueue * const pQueue);
+
+/**
+ * @brief Creates the state of the asynchronous batch mode, and starts the thread reading the
+ *        Files of the given queue.
+ * @param pBatch The state to create.
+ * @param pQueue The queue of paths to check.
+ * @param backend The backend of the Reader of the Files.
+ * @return 0 if the thread started, 2 if there is not enough memory.
+ */
+int createAsyncBatch(AsyncBatch * const pBatch, PathQueue * const pQueue,
+                     char const * const backend);
+
+/**
+ * @brief Waits for the thread reading the Files, once the queue of paths is closed, and
+ *        releases the state of the asynchronous batch mode.
+ * @param pBatch The state to release.
+ */
+void destroyAsyncBatch(AsyncBatch * const pBatch);
+
+/**
+ * @brief The routine of the thread reading the Files of the asynchronous batch mode. It opens
+ *        the paths of the queue, keeps reads of the open Files in flight and hands the filled
+ *        buffers to the workers, until the queue is closed and all the Files were checked.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @return NULL.
+ */
+void * readFiles(void * pBatch);
+
+/**
+ * @brief Opens the File at the given path, and creates its Validator. The verdict of a File
+ *        which could not be opened is printed.
+ * @param path The path of the File, which was allocated on the heap, and is owned by the new
+ *        File or released.
+ * @param pOptions The options of the check.
+ * @return The new File, or NULL if it could not be opened.
+ */
+AsyncFile * openAsyncFile(char * const path, CheckOptions const * const pOptions);
+
+/**
+ * @brief Submits a read of every open File that needs one, while there are free buffers. The
+ *        lock of the batch is held.
+ * @param pBatch The state of the asynchronous batch mode.
+ */
+void submitReads(AsyncBatch * const pBatch);
+
+/**
+ * @brief Hands the given completed reads to their Files, and the Files to the workers. The lock
+ *        of the batch is held.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @param completions The completed reads.
+ * @param completionsNumber The number of completed reads.
+ */
+void completeReads(AsyncBatch * const pBatch, ReaderCompletion const * const completions,
+                   size_t const completionsNumber);
+
+/**
+ * @brief Adds the given File to the Files ready for the workers. The lock of the batch is held.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @param pFile The File, which is not ready or fed yet.
+ */
+void readyFile(AsyncBatch * const pBatch, AsyncFile * const pFile);
+
+/**
+ * @brief The routine of an asynchronous batch mode worker, it feeds the filled buffers of the
+ *        ready Files to their Validators, and prints the verdict of every File read to its end.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @return NULL.
+ */
+void * asyncWorker(void * pBatch);
+
+/**
+ * @brief Finishes the check of the given File, prints its verdict and releases it.
+ * @param pFile The File, which was read to its end.
+ * @param pOptions The options of the check.
+ * @return 0 if the File was analyzed, 1 otherwise.
+ */
+int finishAsyncFile(AsyncFile * const pFile, CheckOptions const * const pOptions);
+
+/**
+ * @brief Checks the given File for valid parenthesis structure.
+ *        Regular Files are memory mapped, any other File is read using a buffer.
+ *        The index of the pairs of a valid File is written if the options request it.
+ * @param fileDescriptor The given File to check.
+ * @param pOptions The options of the check.
+ * @param pError The path to store the first violation in, or NULL.
+ * @param pProfile The path to store the depth profile in, or NULL.
+ * @return 0 if the given File satisfies the required parenthesis structure, 1 if it does not,
+ *         2 if the File could not be analyzed within the nesting depth limit or the memory,
+ *         4 if its index could not be written and 5 if the File could not be read.
+ */
+int checkFile(int const fileDescriptor, CheckOptions const * const pOptions,
+              ValidatorError * const pError, ValidatorProfile * const pProfile);
+
+/**
+ * @brief Prints the result of a single File as a JSON object in a line of its own.
+ * @param fileName The name of the File.
+ * @param checkFileResult The result of 'checkPath' for the File.
+ * @param pError The first violation in the File.
+ * @param pProfile The depth profile of the File, printed if the File is valid, or NULL.
+ */
+void printJsonResult(char const * const fileName, int const checkFileResult,
+                     ValidatorError const * const pError, ValidatorProfile const * const pProfile);
+
+/**
+ * @brief Prints the given string as a JSON string.
+ * @param string The string to print.
+ */
+void printJsonString(char const * const string);
+
+/**
+ * @brief Prints the given position as the members of a JSON object, the line and the column are
+ *        printed only if they are known.
+ * @param pPosition The position to print.
+ */
+void printJsonPosition(ValidatorPosition const * const pPosition);
+
+/**
+ * @brief Prints the given depth profile as a member of a JSON object.
+ * @param pProfile The profile to print.
+ */
+void printJsonProfile(ValidatorProfile const * const pProfile);
+
+/**
+ * @brief Prints the given depth profile, a line for the maximal depth, for every range of depths
+ *        reached and for every deepest region.
+ * @param pProfile The profile to print.
+ */
+void printProfile(ValidatorProfile const * const pProfile);
+
+/**
+ * @brief Checks the given mapped File for valid parenthesis structure. The File is fed at once,
+ *        so it may be scanned in parallel chunks, unless the run is counted.
+ * @param pValidator The Validator of the File.
+ * @param data The mapping of the File.
+ * @param length The number of bytes in the File.
+ * @param pOptions The options of the check.
+ * @return 0 if the given File does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the File could not be analyzed within the nesting depth limit or the memory.
+ */
+int checkMappedFile(ParenthesisValidator * const pValidator, void const * const data,
+                    size_t const length, CheckOptions const * const pOptions);
+
+/**
+ * @brief Checks the given File for valid parenthesis structure by reading it into a buffer,
+ *        this is used for Files which cannot be memory mapped, such as pipes.
+ * @param pValidator The Validator of the File.
+ * @param fileDescriptor The given File to check.
+ * @param pOptions The options of the check.
+ * @return 0 if the given File does not break the required parenthesis structure, 1 if it does,
+ *         2 if the File could not be analyzed within the nesting depth limit or the memory and
+ *         5 if the File could not be read.
+ */
+int checkStreamedFile(ParenthesisValidator * const pValidator, int const fileDescriptor,
+                      CheckOptions const * const pOptions);
+
+/**
+ * @brief Writes the index of the pairs of the given Validator to the File of the given name,
+ *        through a shared mapping of the File. Errors are reported to the standard error.
+ * @param pValidator The Validator of the File, which builds an index.
+ * @param indexName The name of the File to write.
+ * @return 0 if the index was written, 1 otherwise.
+ */
+int writeIndex(ParenthesisValidator const * const pValidator, char const * const indexName);
+
+#ifdef VALIDATOR_STATISTICS
+
+/**
+ * @brief Reads the timer of the statistics, the time stamp counter if the CPU has one and the
+ *        monotonic clock in nanoseconds otherwise.
+ * @return The ticks of the timer.
+ */
+unsigned long long readTimer(void);
+
+/**
+ * @brief Returns the number of seconds since the given time.
+ * @param pStart The time to measure from.
+ * @return The number of seconds.
+ */
+double secondsSince(struct timespec const * const pStart);
+
+/**
+ * @brief Starts counting a run, and the thread printing its progress if it is needed.
+ * @param pStatistics The counters of the run.
+ * @param progressInterval The number of seconds between two progress messages, or 0 for none.
+ */
+void startStatistics(RunStatistics * const pStatistics, double const progressInterval);
+
+/**
+ * @brief Stops counting a run, and prints its counters if they are needed.
+ * @param pStatistics The counters of the run.
+ * @param print Non zero for printing the counters.
+ * @param json Non zero for printing the counters as a JSON object.
+ */
+void stopStatistics(RunStatistics * const pStatistics, int const print, int const json);
+
+/**
+ * @brief The routine of the thread printing the progress of a run until the run ends.
+ * @param pStatistics The counters of the run.
+ * @return NULL.
+ */
+void * printProgress(void * pStatistics);
+
+/**
+ * @brief Adds the time since the given timer started to the given phase of the run, and
+ *        restarts the timer.
+ * @param pStatistics The counters of the run, or NULL if the run is not counted.
+ * @param phase INPUT_TIME or VALIDATION_TIME.
+ * @param pTimer The timer.
+ */
+void countTime(RunStatistics * const pStatistics, int const phase,
+               unsigned long long * const pTimer);
+
+/**
+ * @brief Adds the given number of bytes read to the counters of the run.
+ * @param pStatistics The counters of the run, or NULL if the run is not counted.
+ * @param length The number of bytes read.
+ */
+void countBytes(RunStatistics * const pStatistics, size_t const length);
+
+/**
+ * @brief Adds the counters of the given Validator, which checked a whole File, to the counters
+ *        of the run.
+ * @param pStatistics The counters of the run, or NULL if the run is not counted.
+ * @param pValidator The Validator of the File.
+ */
+void countFile(RunStatistics * const pStatistics, ParenthesisValidator const * const pValidator);
+
+#endif
+
+
+/*----=  Main  =-----*/
+
+
+/**
+ * @brief The main function that runs the program.
+ *        It receives arguments from the user and if the arguments are valid, it runs the File
+ *        Analysis.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @return 0 if the given File is a text file which satisfies the required
+ *         parenthesis structure, 1 otherwise.
+ */
+int main(int argc, char * argv[])
+{
+    CheckOptions options = {NULL, 0, 0, 0, 0, VALIDATOR_UNLIMITED_DEPTH, NULL, NULL,
+                            DEFAULT_LINE_COMMENT, DEFAULT_THREADS, NULL, 0, 0, NULL
+#ifdef VALIDATOR_STATISTICS
+                            , 0, 0, NULL
+#endif
+                           };
+
+    // Check valid arguments.
+    if (parseArguments(argc, argv, &options))
+    {
+        fprintf(stderr, INVALID_ARGUMENTS_MESSAGE);
+        return INVALID_STATE;
+    }
+
+#ifdef VALIDATOR_STATISTICS
+    RunStatistics statistics;
+    if (options.statistics || options.progressInterval > 0)
+    {
+        startStatistics(&statistics, options.progressInterval);
+        options.pStatistics = &statistics;
+    }
+#endif
+
+    int const state = options.batch ? runBatch(&options) : runSingle(&options);
+
+#ifdef VALIDATOR_STATISTICS
+    if (options.pStatistics != NULL)
+    {
+        stopStatistics(&statistics, options.statistics, options.json);
+    }
+#endif
+    return state;
+}
+
+
+/*----=  Input Handling  =-----*/
+
+
+/**
+ * @brief Parse the given arguments of the program.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param pOptions The path to store the parsed options in.
+ * @return 0 if the given arguments are valid, 1 otherwise.
+ */
+int parseArguments(int const argc, char * argv[], CheckOptions * const pOptions)
+{
+    char const * scannerName = NULL;
+
+    // The options come before the File names, every option but the modes takes a value.
+    int index = FILE_NAME_INDEX;
+    while (index < argc && strncmp(argv[index], OPTION_PREFIX, strlen(OPTION_PREFIX)) == 0)
+    {
+        char const * const option = argv[index++];
+        if (strcmp(option, BATCH_OPTION) == 0)
+        {
+            pOptions->batch = 1;
+            continue;
+        }
+        if (strcmp(option, JSON_OPTION) == 0)
+        {
+            pOptions->json = 1;
+            continue;
+        }
+        if (strcmp(option, LEXER_OPTION) == 0)
+        {
+            pOptions->lexical = 1;
+            continue;
+        }
+#ifdef VALIDATOR_STATISTICS
+        if (strcmp(option, STATS_OPTION) == 0)
+        {
+            pOptions->statistics = 1;
+            continue;
+        }
+#endif
+        if (index >= argc)
+        {
+            return INVALID_STATE;
+        }
+
+        char const * const value = argv[index++];
+
+        if (strcmp(option, MAX_DEPTH_OPTION) == 0)
+        {
+            char * end = NULL;
+            unsigned long long maxDepth = strtoull(value, &end, DECIMAL_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0')
+            {
+                return INVALID_STATE;
+            }
+            pOptions->maxDepth = (size_t) maxDepth;
+        }
+        else if (strcmp(option, SCANNER_OPTION) == 0)
+        {
+            scannerName = value;
+        }
+        else if (strcmp(option, PAIRS_OPTION) == 0)
+        {
+            if (!validatorPairsSupported(value))
+            {
+                return INVALID_STATE;
+            }
+            pOptions->pairs = value;
+        }
+        else if (strcmp(option, LINE_COMMENT_OPTION) == 0)
+        {
+            pOptions->lexical = 1;
+            pOptions->lineComment = (*value != '\0') ? value : NULL;
+        }
+        else if (strcmp(option, THREADS_OPTION) == 0)
+        {
+            char * end = NULL;
+            unsigned long threads = strtoul(value, &end, DECIMAL_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0' || threads == 0)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->threads = (size_t) threads;
+        }
+        else if (strcmp(option, PROFILE_OPTION) == 0)
+        {
+            char * end = NULL;
+            unsigned long regions = strtoul(value, &end, DECIMAL_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0' || regions > VALIDATOR_MAX_REGIONS)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->profile = 1;
+            pOptions->regions = (size_t) regions;
+        }
+        else if (strcmp(option, IO_OPTION) == 0)
+        {
+            if (strcmp(value, READER_URING) != 0 && strcmp(value, READER_PREAD) != 0 &&
+                strcmp(value, IO_MAP) != 0)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->ioBackend = (strcmp(value, IO_MAP) != 0) ? value : NULL;
+        }
+        else if (strcmp(option, INDEX_OPTION) == 0)
+        {
+            pOptions->indexName = value;
+        }
+#ifdef VALIDATOR_STATISTICS
+        else if (strcmp(option, PROGRESS_OPTION) == 0)
+        {
+            char * end = NULL;
+            double const interval = strtod(value, &end);
+            if (*value == '\0' || *end != '\0' || !(interval > 0))
+            {
+                return INVALID_STATE;
+            }
+            pOptions->progressInterval = interval;
+        }
+#endif
+        else
+        {
             return INVALID_STATE;
+        }
+    }
+
+    // A single File name, which is always mapped, unless in batch mode. Only a single File
+    // has an index.
+    if (!pOptions->batch && (index != argc - 1 || pOptions->ioBackend != NULL))
+    {
+        return INVALID_STATE;
+    }
+    if (pOptions->batch && pOptions->indexName != NULL)
+    {
+        return INVALID_STATE;
+    }
+
+    if (!validatorScannerSupported(scannerName))
+    {
+        return INVALID_STATE;
+    }
+    pOptions->scannerName = scannerName;
+
+    // The pairs may not end with a lexical byte, which is known once all the options are parsed.
+    if (pOptions->lexical && !validatorLexerSupported(pOptions->pairs, pOptions->lineComment))
+    {
+        return INVALID_STATE;
+    }
+
+    pOptions->fileNames = argv + index;
+    pOptions->fileNamesNumber = argc - index;
+    return VALID_STATE;
+}
+
+
+/*----=  Analyze File  =-----*/
+
+
+/**
+ * @brief Analyze the results of the 'checkFile' functions, and perform the
+ *        required actions for each scenario.
+ * @param checkFileResult The given result of the 'checkFile' functions.
+ */
+void analyzeResults(int const checkFileResult)
+{
+    if (!(checkFileResult))  // If the File is valid, 'checkFileResult' will be equal to 0.
+    {
+        printf(VALID_FILE);
+    }
+    else
+    {
+        printf(INVALID_FILE);
+    }
+}
+
+/**
+ * @brief Checks the single File given, and prints its result.
+ * @param pOptions The options of the check.
+ * @return 0 if the File was analyzed, 1 otherwise.
+ */
+int runSingle(CheckOptions const * const pOptions)
+{
+    // Analyze the File.
+    ValidatorError error;
+    ValidatorProfile profile;
+    ValidatorProfile * const pProfile = pOptions->profile ? &profile : NULL;
+    int checkFileResult = checkPath(pOptions->fileNames[0], pOptions,
+                                    pOptions->json ? &error : NULL, pProfile);
+    if (pOptions->json)
+    {
+        printJsonResult(pOptions->fileNames[0], checkFileResult, &error, pProfile);
     }
+
+    // In case the File could not be opened, read or analyzed, or its index could not be written.
+    if (checkFileResult == OPEN_FAILED_STATE || checkFileResult == READ_FAILED_STATE ||
+        checkFileResult == VALIDATOR_LIMIT_EXCEEDED || checkFileResult == WRITE_FAILED_STATE)
+    {
+        return INVALID_STATE;
+    }
+
+    // Analyze the results.
+    if (!pOptions->json)
+    {
+        analyzeResults(checkFileResult);
+        if (checkFileResult == VALIDATOR_VALID && pProfile != NULL)
+        {
+            printProfile(pProfile);
+        }
+    }
+    return VALID_STATE;
 }
+
+/**
+ * @brief Opens and checks the File at the given path, errors are reported to the standard
+ *        error.
+ * @param fileName The name of the File to check, or STANDARD_INPUT_NAME.
+ * @param pOptions The options of the check.
+ * @param pError The path to store the first violation in, or NULL.
+ * @param pProfile The path to store the depth profile in, or NULL.
+ * @return The result of 'checkFile', or 3 if the File could not be opened.
+ */
+int checkPath(char const * const fileName, CheckOptions const * const pOptions,
+              ValidatorError * const pError, ValidatorProfile * const pProfile)
+{
+    if (pError != NULL)
+    {
+        pError->kind = VALIDATOR_NO_ERROR;
+    }
+
+    // Receive the File to check.
+    int fileDescriptor = STDIN_FILENO;
+    if (strcmp(fileName, STANDARD_INPUT_NAME) != 0)
+    {
+        fileDescriptor = open(fileName, O_RDONLY);
+    }
+
+    // In case of a bad File.
+    if (fileDescriptor < 0)
+    {
+        fprintf(stderr, INVALID_FILE_ARGUMENTS_MESSAGE, fileName);
+        return OPEN_FAILED_STATE;
+    }
+
+    // Analyze the File and close it.
+    int checkFileResult = checkFile(fileDescriptor, pOptions, pError, pProfile);
+    if (fileDescriptor != STDIN_FILENO)
+    {
+        close(fileDescriptor);
+    }
+
+    // In case the File could not be read or analyzed.
+    if (checkFileResult == READ_FAILED_STATE)
+    {
+        fprintf(stderr, READ_FAILED_MESSAGE, fileName);
+    }
+    else if (checkFileResult == VALIDATOR_LIMIT_EXCEEDED)
+    {
+        printLimitError(fileName, pOptions);
+    }
+    return checkFileResult;
+}
+
+/**
+ * @brief Prints the error of a File which could not be analyzed within the nesting depth limit
+ *        or the memory.
+ * @param fileName The name of the File.
+ * @param pOptions The options of the check.
+ */
+void printLimitError(char const * const fileName, CheckOptions const * const pOptions)
+{
+    if (pOptions->maxDepth != VALIDATOR_UNLIMITED_DEPTH)
+    {
+        fprintf(stderr, DEPTH_LIMIT_MESSAGE, fileName, pOptions->maxDepth);
+    }
+    else
+    {
+        fprintf(stderr, OUT_OF_MEMORY_MESSAGE, fileName);
+    }
+}
+
+/**
+ * @brief Checks the given File for valid parenthesis structure.
+ *        Regular Files are memory mapped, any other File is read using a buffer.
+ *        The index of the pairs of a valid File is written if the options request it.
+ * @param fileDescriptor The given File to check.
+ * @param pOptions The options of the check.
+ * @param pError The path to store the first violation in, or NULL.
+ * @param pProfile The path to store the depth profile in, or NULL.
+ * @return 0 if the given File satisfies the required parenthesis structure, 1 if it does not,
+ *         2 if the File could not be analyzed within the nesting depth limit or the memory,
+ *         4 if its index could not be written and 5 if the File could not be read.
+ */
+int checkFile(int const fileDescriptor, CheckOptions const * const pOptions,
+              ValidatorError * const pError, ValidatorProfile * const pProfile)
+{
+    START_TIMER(timer);
+    struct stat fileStatus;
+    void * mapping = MAP_FAILED;
+    if (fstat(fileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) &&
+        fileStatus.st_size > 0)
+    {
+        mapping = mmap(NULL, (size_t) fileStatus.st_size, PROT_READ, MAP_PRIVATE,
+                       fileDescriptor, 0);
+    }
+
+    // A mapped File is still available once the violation is found, so its lines are counted
+    // only then. The lines of any other File are counted while it is read.
+    ValidatorOptions const validatorOptions = {pOptions->maxDepth, pOptions->scannerName,
+                                               pOptions->threads, pError != NULL,
+                                               pError != NULL && mapping == MAP_FAILED,
+                                               pOptions->pairs, pOptions->lexical,
+                                               pOptions->lineComment, pProfile != NULL,
+                                               pOptions->regions, pOptions->indexName != NULL};
+    COUNT_TIME(pOptions, INPUT_TIME, timer);
+    ParenthesisValidator * const pValidator = validatorCreate(&validatorOptions);
+    if (pValidator == NULL)
+    {
+        if (mapping != MAP_FAILED)
+        {
+            munmap(mapping, (size_t) fileStatus.st_size);
+        }
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    int streamResult = VALIDATOR_VALID;
+    if (mapping != MAP_FAILED)
+    {
+        madvise(mapping, (size_t) fileStatus.st_size, MADV_SEQUENTIAL);
+        checkMappedFile(pValidator, mapping, (size_t) fileStatus.st_size, pOptions);
+        if (pError != NULL && validatorError(pValidator, pError) != VALIDATOR_NO_ERROR)
+        {
+            validatorLocate(mapping, (size_t) fileStatus.st_size, &pError->position);
+            if (pError->hasOpener)
+            {
+                validatorLocate(mapping, (size_t) fileStatus.st_size, &pError->opener);
+            }
+        }
+        COUNT_TIME(pOptions, VALIDATION_TIME, timer);
+        munmap(mapping, (size_t) fileStatus.st_size);
+        COUNT_TIME(pOptions, INPUT_TIME, timer);
+    }
+    else
+    {
+        streamResult = checkStreamedFile(pValidator, fileDescriptor, pOptions);
+        if (pError != NULL)
+        {
+            validatorError(pValidator, pError);
+        }
+    }
+
+    int result = (streamResult == READ_FAILED_STATE) ? READ_FAILED_STATE :
+                                                       validatorFinish(pValidator);
+    if (pProfile != NULL)
+    {
+        validatorProfile(pValidator, pProfile);
+    }
+    if (result == VALIDATOR_VALID && pOptions->indexName != NULL &&
+        writeIndex(pValidator, pOptions->indexName))
+    {
+        result = WRITE_FAILED_STATE;
+    }
+    COUNT_FILE(pOptions, pValidator);
+    validatorDestroy(pValidator);
+    return result;
+}
+
+/**
+ * @brief Checks the given mapped File for valid parenthesis structure. The File is fed at once,
+ *        so it may be scanned in parallel chunks, unless the run is counted.
+ * @param pValidator The Validator of the File.
+ * @param data The mapping of the File.
+ * @param length The number of bytes in the File.
+ * @param pOptions The options of the check.
+ * @return 0 if the given File does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the File could not be analyzed within the nesting depth limit or the memory.
+ */
+int checkMappedFile(ParenthesisValidator * const pValidator, void const * const data,
+                    size_t const length, CheckOptions const * const pOptions)
+{
+#ifdef VALIDATOR_STATISTICS
+    // A counted File is fed in large parts, which are still scanned in parallel chunks, so its
+    // progress is seen while it is validated.
+    if (pOptions->pStatistics != NULL)
+    {
+        int result = VALIDATOR_VALID;
+        for (size_t offset = 0; offset < length && result == VALIDATOR_VALID;
+             offset += STATISTICS_PART_SIZE)
+        {
+            size_t const partLength = (length - offset < STATISTICS_PART_SIZE) ?
+                                      length - offset : STATISTICS_PART_SIZE;
+            result = validatorFeed(pValidator, (unsigned char const *) data + offset,
+                                   partLength);
+            COUNT_BYTES(pOptions, partLength);
+        }
+        return result;
+    }
+#else
+    (void) pOptions;
+#endif
+    return validatorFeed(pValidator, data, length);
+}
+
+/**
+ * @brief Checks the given File for valid parenthesis structure by reading it into a buffer,
+ *        this is used for Files which cannot be memory mapped, such as pipes.
+ * @param pValidator The Validator of the File.
+ * @param fileDescriptor The given File to check.
+ * @param pOptions The options of the check.
+ * @return 0 if the given File does not break the required parenthesis structure, 1 if it does,
+ *         2 if the File could not be analyzed within the nesting depth limit or the memory and
+ *         5 if the File could not be read.
+ */
+int checkStreamedFile(ParenthesisValidator * const pValidator, int const fileDescriptor,
+                      CheckOptions const * const pOptions)
+{
+    unsigned char * buffer = malloc(READ_BUFFER_SIZE);
+    if (buffer == NULL)
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    int result = VALIDATOR_VALID;
+    START_TIMER(timer);
+    while (result == VALIDATOR_VALID)
+    {
+        // A failed read must not pass for the end of the File, which would give a verdict on
+        // a part of it.
+        ssize_t const bytesRead = read(fileDescriptor, buffer, READ_BUFFER_SIZE);
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytesRead < 0)
+        {
+            result = READ_FAILED_STATE;
+        }
+        if (bytesRead <= 0)
+        {
+            break;
+        }
+        COUNT_TIME(pOptions, INPUT_TIME, timer);
+        COUNT_BYTES(pOptions, (size_t) bytesRead);
+        result = validatorFeed(pValidator, buffer, (size_t) bytesRead);
+        COUNT_TIME(pOptions, VALIDATION_TIME, timer);
+    }
+    COUNT_TIME(pOptions, INPUT_TIME, timer);
+
+    free(buffer);
+    return result;
+}
+
+/**
+ * @brief Writes the index of the pairs of the given Validator to the File of the given name,
+ *        through a shared mapping of the File. Errors are reported to the standard error.
+ * @param pValidator The Validator of the File, which builds an index.
+ * @param indexName The name of the File to write.
+ * @return 0 if the index was written, 1 otherwise.
+ */
+int writeIndex(ParenthesisValidator const * const pValidator, char const * const indexName)
+{
+    size_t const size = validatorIndexSize(pValidator);
+    int const fileDescriptor = open(indexName, O_RDWR | O_CREAT | O_TRUNC, INDEX_FILE_MODE);
+    void * mapping = MAP_FAILED;
+    if (fileDescriptor >= 0 && ftruncate(fileDescriptor, (off_t) size) == 0)
+    {
+        mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    }
+
+    int state = INVALID_STATE;
+    if (mapping != MAP_FAILED)
+    {
+        validatorIndex(pValidator, mapping);
+        state = (munmap(mapping, size) == 0) ? VALID_STATE : INVALID_STATE;
+    }
+    if (fileDescriptor >= 0 && close(fileDescriptor) != 0)
+    {
+        state = INVALID_STATE;
+    }
+    if (state != VALID_STATE)
+    {
+        fprintf(stderr, WRITE_FAILED_MESSAGE, indexName);
+    }
+    return state;
+}
+
+
+/*----=  JSON Output  =-----*/
+
+
+/**
+ * @brief Prints the result of a single File as a JSON object in a line of its own.
+ * @param fileName The name of the File.
+ * @param checkFileResult The result of 'checkPath' for the File.
+ * @param pError The first violation in the File.
+ * @param pProfile The depth profile of the File, printed if the File is valid, or NULL.
+ */
+void printJsonResult(char const * const fileName, int const checkFileResult,
+                     ValidatorError const * const pError, ValidatorProfile const * const pProfile)
+{
+    char const * verdict = ERROR_VERDICT;
+    if (checkFileResult == VALIDATOR_VALID)
+    {
+        verdict = VALID_VERDICT;
+    }
+    else if (checkFileResult == VALIDATOR_INVALID)
+    {
+        verdict = INVALID_VERDICT;
+    }
+
+    // The line is printed in parts, so it is locked against the other batch mode workers.
+    flockfile(stdout);
+    printf("{\"file\":");
+    printJsonString(fileName);
+    printf(",\"verdict\":\"%s\"", verdict);
+
+    if (checkFileResult == VALIDATOR_INVALID && pError->kind != VALIDATOR_NO_ERROR)
+    {
+        char const * kind = UNCLOSED_OPENER_KIND;
+        if (pError->kind == VALIDATOR_MISMATCHED_PAIR)
+        {
+            kind = MISMATCHED_PAIR_KIND;
+        }
+        else if (pError->kind == VALIDATOR_STRAY_CLOSER)
+        {
+            kind = STRAY_CLOSER_KIND;
+        }
+
+        printf(",\"error\":{\"kind\":\"%s\",", kind);
+        printJsonPosition(&pError->position);
+        if (pError->found[0] != '\0')
+        {
+            printf(",\"found\":");
+            printJsonString(pError->found);
+        }
+        if (pError->expected[0] != '\0')
+        {
+            printf(",\"expected\":");
+            printJsonString(pError->expected);
+        }
+        if (pError->hasOpener)
+        {
+            printf(",\"opener\":{");
+            printJsonPosition(&pError->opener);
+            printf("}");
+        }
+        printf("}");
+    }
+
+    if (checkFileResult == VALIDATOR_VALID && pProfile != NULL)
+    {
+        printJsonProfile(pProfile);
+    }
+    printf("}\n");
+    funlockfile(stdout);
+}
+
+/**
+ * @brief Prints the given string as a JSON string.
+ * @param string The string to print.
+ */
+void printJsonString(char const * const string)
+{
+    putchar('"');
+    for (unsigned char const * pCharacter = (unsigned char const *) string;
+         *pCharacter != '\0'; ++pCharacter)
+    {
+        if (*pCharacter == '"' || *pCharacter == '\\')
+        {
+            putchar('\\');
+            putchar(*pCharacter);
+        }
+        else if (*pCharacter < ' ')
+        {
+            printf(JSON_CONTROL_FORMAT, *pCharacter);
+        }
+        else
+        {
+            putchar(*pCharacter);
+        }
+    }
+    putchar('"');
+}
+
+/**
+ * @brief Prints the given position as the members of a JSON object, the line and the column are
+ *        printed only if they are known.
+ * @param pPosition The position to print.
+ */
+void printJsonPosition(ValidatorPosition const * const pPosition)
+{
+    printf("\"offset\":%llu", pPosition->offset);
+    if (pPosition->line != VALIDATOR_UNKNOWN_LINE)
+    {
+        printf(",\"line\":%llu,\"column\":%llu", pPosition->line, pPosition->column);
+    }
+}
+
+/**
+ * @brief Prints the given depth profile as a member of a JSON object.
+ * @param pProfile The profile to print.
+ */
+void printJsonProfile(ValidatorProfile const * const pProfile)
+{
+    printf(",\"profile\":{\"max_depth\":%llu,\"histogram\":[", pProfile->maxDepth);
+    char const * separator = "";
+    for (int i = 0; i < VALIDATOR_PROFILE_BUCKETS; ++i)
+    {
+        if (pProfile->histogram[i] != 0)
+        {
+            printf("%s{\"from\":%llu,\"to\":%llu,\"count\":%llu}", separator, 1ULL << i,
+                   (2ULL << i) - 1, pProfile->histogram[i]);
+            separator = ",";
+        }
+    }
+
+    printf("],\"regions\":[");
+    for (size_t i = 0; i < pProfile->regionsNumber; ++i)
+    {
+        ValidatorRegion const * const pRegion = &pProfile->regions[i];
+        printf("%s{\"depth\":%llu,\"opener\":%llu,\"closer\":%llu}", (i != 0) ? "," : "",
+               pRegion->depth, pRegion->opener, pRegion->closer);
+    }
+    printf("]}");
+}
+
+/**
+ * @brief Prints the given depth profile, a line for the maximal depth, for every range of depths
+ *        reached and for every deepest region.
+ * @param pProfile The profile to print.
+ */
+void printProfile(ValidatorProfile const * const pProfile)
+{
+    printf(MAX_DEPTH_FORMAT, pProfile->maxDepth);
+    for (int i = 0; i < VALIDATOR_PROFILE_BUCKETS; ++i)
+    {
+        if (pProfile->histogram[i] != 0)
+        {
+            printf(DEPTHS_FORMAT, 1ULL << i, (2ULL << i) - 1, pProfile->histogram[i]);
+        }
+    }
+    for (size_t i = 0; i < pProfile->regionsNumber; ++i)
+    {
+        printf(REGION_FORMAT, pProfile->regions[i].depth, pProfile->regions[i].opener,
+               pProfile->regions[i].closer);
+    }
+}
+
+
+/*----=  Batch Mode  =-----*/
+
+
+/**
+ * @brief Checks all the Files given in batch mode using a pool of worker threads.
+ * @param pOptions The options of the check.
+ * @return 0 if all the Files were analyzed, 1 otherwise.
+ */
+int runBatch(CheckOptions const * const pOptions)
+{
+    // Every File is scanned by a single worker, the threads are used for the pool.
+    CheckOptions fileOptions = *pOptions;
+    fileOptions.threads = DEFAULT_THREADS;
+
+    PathQueue queue;
+    queue.head = 0;
+    queue.size = 0;
+    queue.closed = 0;
+    queue.pOptions = &fileOptions;
+    queue.failures = 0;
+    pthread_mutex_init(&queue.lock, NULL);
+    pthread_cond_init(&queue.notEmpty, NULL);
+    pthread_cond_init(&queue.notFull, NULL);
+
+    // With a backend reading the Files, the workers validate the buffers it fills.
+    AsyncBatch batch;
+    void * (* worker)(void *) = batchWorker;
+    void * pWorkerArgument = &queue;
+    int result = VALID_STATE;
+    if (pOptions->ioBackend != NULL)
+    {
+        worker = asyncWorker;
+        pWorkerArgument = &batch;
+        result = createAsyncBatch(&batch, &queue, pOptions->ioBackend);
+    }
+
+    pthread_t * workers = malloc(pOptions->threads * sizeof(pthread_t));
+    size_t workersNumber = 0;
+    while (result == VALID_STATE && workers != NULL && workersNumber < pOptions->threads &&
+           pthread_create(&workers[workersNumber], NULL, worker, pWorkerArgument) == 0)
+    {
+        workersNumber++;
+    }
+
+    // Fill the queue with the given paths, or with the list in the standard input.
+    if (workersNumber == 0)
+    {
+        result = VALIDATOR_LIMIT_EXCEEDED;
+    }
+    for (int i = 0; i < pOptions->fileNamesNumber && result == VALID_STATE; ++i)
+    {
+        result = enqueueTree(&queue, pOptions->fileNames[i]);
+    }
+    if (pOptions->fileNamesNumber == 0 && result == VALID_STATE)
+    {
+        char * line = NULL;
+        size_t lineCapacity = 0;
+        ssize_t lineLength;
+        while (result == VALID_STATE &&
+               (lineLength = getdelim(&line, &lineCapacity, '\0', stdin)) > 0)
+        {
+            if (lineLength > 1)
+            {
+                result = enqueueTree(&queue, line);
+            }
+        }
+        free(line);
+    }
+
+    // Let the workers drain the queue.
+    pthread_mutex_lock(&queue.lock);
+    queue.closed = 1;
+    pthread_cond_broadcast(&queue.notEmpty);
+    pthread_mutex_unlock(&queue.lock);
+    for (size_t i = 0; i < workersNumber; ++i)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    if (pOptions->ioBackend != NULL && batch.pReader != NULL)
+    {
+        destroyAsyncBatch(&batch);
+    }
+
+    free(workers);
+    pthread_cond_destroy(&queue.notFull);
+    pthread_cond_destroy(&queue.notEmpty);
+    pthread_mutex_destroy(&queue.lock);
+
+    if (result != VALID_STATE || queue.failures != 0)
+    {
+        return INVALID_STATE;
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief The routine of a batch mode worker, it checks the paths of the given queue until it is
+ *        closed and empty, and prints a verdict line for each.
+ * @param pQueue The queue of paths to check.
+ * @return NULL.
+ */
+void * batchWorker(void * pQueue)
+{
+    PathQueue * const pPaths = pQueue;
+
+    char * path;
+    while ((path = dequeuePath(pPaths)) != NULL)
+    {
+        ValidatorError error;
+        ValidatorProfile profile;
+        ValidatorProfile * const pProfile = pPaths->pOptions->profile ? &profile : NULL;
+        int const checkFileResult = checkPath(path, pPaths->pOptions,
+                                              pPaths->pOptions->json ? &error : NULL, pProfile);
+        if (printVerdict(path, checkFileResult, &error, pProfile, pPaths->pOptions))
+        {
+            pthread_mutex_lock(&pPaths->lock);
+            pPaths->failures++;
+            pthread_mutex_unlock(&pPaths->lock);
+        }
+        free(path);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Prints the verdict line of a single File in batch mode.
+ * @param fileName The name of the File.
+ * @param checkFileResult The result of 'checkPath' for the File.
+ * @param pError The first violation in the File, used only for JSON objects.
+ * @param pProfile The depth profile of the File, printed if the File is valid, or NULL.
+ * @param pOptions The options of the check.
+ * @return 0 if the File was analyzed, 1 otherwise.
+ */
+int printVerdict(char const * const fileName, int const checkFileResult,
+                 ValidatorError const * const pError, ValidatorProfile const * const pProfile,
+                 CheckOptions const * const pOptions)
+{
+    char const * verdict = ERROR_VERDICT;
+    if (checkFileResult == VALIDATOR_VALID)
+    {
+        verdict = VALID_VERDICT;
+    }
+    else if (checkFileResult == VALIDATOR_INVALID)
+    {
+        verdict = INVALID_VERDICT;
+    }
+
+    if (pOptions->json)
+    {
+        printJsonResult(fileName, checkFileResult, pError, pProfile);
+    }
+    else
+    {
+        // The profile follows its verdict, so the lines are locked against the other workers.
+        flockfile(stdout);
+        printf(BATCH_RESULT_FORMAT, fileName, verdict);
+        if (checkFileResult == VALIDATOR_VALID && pProfile != NULL)
+        {
+            printProfile(pProfile);
+        }
+        funlockfile(stdout);
+    }
+    return (checkFileResult == VALIDATOR_VALID || checkFileResult == VALIDATOR_INVALID) ?
+           VALID_STATE : INVALID_STATE;
+}
+
+/**
+ * @brief Adds a copy of the given path to the given queue, waiting while the queue is full.
+ * @param pQueue The queue to add to.
+ * @param path The path to add.
+ * @return 0 if the path was added, 2 if there is not enough memory.
+ */
+int enqueuePath(PathQueue * const pQueue, char const * const path)
+{
+    char * copy = strdup(path);
+    if (copy == NULL)
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    pthread_mutex_lock(&pQueue->lock);
+    while (pQueue->size == PATH_QUEUE_CAPACITY)
+    {
+        pthread_cond_wait(&pQueue->notFull, &pQueue->lock);
+    }
+    pQueue->paths[(pQueue->head + pQueue->size) % PATH_QUEUE_CAPACITY] = copy;
+    pQueue->size++;
+    pthread_cond_signal(&pQueue->notEmpty);
+    pthread_mutex_unlock(&pQueue->lock);
+    return VALID_STATE;
+}
+
+/**
+ * @brief Adds the given path to the given queue, if it is a directory all the regular Files in
+ *        it are added recursively instead.
+ * @param pQueue The queue to add to.
+ * @param path The path to add.
+ * @return 0 if the path was added, 2 if there is not enough memory.
+ */
+int enqueueTree(PathQueue * const pQueue, char const * const path)
+{
+    // Symbolic links to directories are not followed, so the walk cannot loop.
+    struct stat pathStatus;
+    DIR * directory = NULL;
+    if (lstat(path, &pathStatus) != 0 || !S_ISDIR(pathStatus.st_mode) ||
+        (directory = opendir(path)) == NULL)
+    {
+        return enqueuePath(pQueue, path);
+    }
+
+    int result = VALID_STATE;
+    size_t const pathLength = strlen(path);
+    struct dirent * entry;
+    while (result == VALID_STATE && (entry = readdir(directory)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+        {
+            continue;
+        }
+
+        char * const entryPath = malloc(pathLength + strlen(entry->d_name) + 2);
+        if (entryPath == NULL)
+        {
+            result = VALIDATOR_LIMIT_EXCEEDED;
+            break;
+        }
+        strcpy(entryPath, path);
+        if (pathLength == 0 || path[pathLength - 1] != PATH_SEPARATOR)
+        {
+            entryPath[pathLength] = PATH_SEPARATOR;
+            entryPath[pathLength + 1] = '\0';
+        }
+        strcat(entryPath, entry->d_name);
+
+        // Only regular Files are checked, either directly or through a symbolic link, since
+        // reading a FIFO or a device found on the way could block its worker forever.
+        if (lstat(entryPath, &pathStatus) == 0)
+        {
+            if (S_ISDIR(pathStatus.st_mode))
+            {
+                result = enqueueTree(pQueue, entryPath);
+            }
+            else if (S_ISREG(pathStatus.st_mode) ||
+                     (S_ISLNK(pathStatus.st_mode) && stat(entryPath, &pathStatus) == 0 &&
+                      S_ISREG(pathStatus.st_mode)))
+            {
+                result = enqueuePath(pQueue, entryPath);
+            }
+        }
+        free(entryPath);
+    }
+
+    closedir(directory);
+    return result;
+}
+
+/**
+ * @brief Removes the first path of the given queue, waiting while the queue is empty.
+ * @param pQueue The queue to remove from.
+ * @return The removed path, or NULL if the queue is closed and empty.
+ */
+char * dequeuePath(PathQueue * const pQueue)
+{
+    pthread_mutex_lock(&pQueue->lock);
+    while (pQueue->size == 0 && !pQueue->closed)
+    {
+        pthread_cond_wait(&pQueue->notEmpty, &pQueue->lock);
+    }
+
+    char * path = NULL;
+    if (pQueue->size != 0)
+    {
+        path = pQueue->paths[pQueue->head];
+        pQueue->head = (pQueue->head + 1) % PATH_QUEUE_CAPACITY;
+        pQueue->size--;
+        pthread_cond_signal(&pQueue->notFull);
+    }
+
+    pthread_mutex_unlock(&pQueue->lock);
+    return path;
+}
+
+
+/*----=  Asynchronous Batch Mode  =-----*/
+
+
+/**
+ * @brief Creates the state of the asynchronous batch mode, and starts the thread reading the
+ *        Files of the given queue.
+ * @param pBatch The state to create.
+ * @param pQueue The queue of paths to check.
+ * @param backend The backend of the Reader of the Files.
+ * @return 0 if the thread started, 2 if there is not enough memory.
+ */
+int createAsyncBatch(AsyncBatch * const pBatch, PathQueue * const pQueue,
+                     char const * const backend)
+{
+    pBatch->pPaths = pQueue;
+    pBatch->openFilesNumber = 0;
+    pBatch->readsNumber = 0;
+    pBatch->pFirstReady = NULL;
+    pBatch->pLastReady = NULL;
+    pBatch->finished = 0;
+    for (size_t i = 0; i < ASYNC_FILES_NUMBER; ++i)
+    {
+        pBatch->openFiles[i] = NULL;
+    }
+    for (size_t i = 0; i < ASYNC_BUFFERS_NUMBER; ++i)
+    {
+        pBatch->freeBuffers[i] = i;
+    }
+    pBatch->freeBuffersNumber = ASYNC_BUFFERS_NUMBER;
+
+    pBatch->pReader = readerCreate(backend, ASYNC_BUFFERS_NUMBER, ASYNC_BUFFER_SIZE,
+                                   READER_THREADS);
+    if (pBatch->pReader == NULL)
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+    pthread_cond_init(&pBatch->ready, NULL);
+    if (pthread_create(&pBatch->readingThread, NULL, readFiles, pBatch) != 0)
+    {
+        pthread_cond_destroy(&pBatch->ready);
+        readerDestroy(pBatch->pReader);
+        pBatch->pReader = NULL;
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief Waits for the thread reading the Files, once the queue of paths is closed, and
+ *        releases the state of the asynchronous batch mode.
+ * @param pBatch The state to release.
+ */
+void destroyAsyncBatch(AsyncBatch * const pBatch)
+{
+    pthread_join(pBatch->readingThread, NULL);
+    pthread_cond_destroy(&pBatch->ready);
+    readerDestroy(pBatch->pReader);
+    pBatch->pReader = NULL;
+}
+
+/**
+ * @brief The routine of the thread reading the Files of the asynchronous batch mode. It opens
+ *        the paths of the queue, keeps reads of the open Files in flight and hands the filled
+ *        buffers to the workers, until the queue is closed and all the Files were checked.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @return NULL.
+ */
+void * readFiles(void * pBatch)
+{
+    AsyncBatch * const pThis = pBatch;
+    PathQueue * const pPaths = pThis->pPaths;
+    ReaderCompletion completions[ASYNC_BUFFERS_NUMBER];
+
+    pthread_mutex_lock(&pPaths->lock);
+    while (1)
+    {
+        submitReads(pThis);
+
+        // A new File is opened only if it can be read at once.
+        while (pPaths->size != 0 && pThis->openFilesNumber < ASYNC_FILES_NUMBER &&
+               pThis->freeBuffersNumber != 0)
+        {
+            char * const path = pPaths->paths[pPaths->head];
+            pPaths->head = (pPaths->head + 1) % PATH_QUEUE_CAPACITY;
+            pPaths->size--;
+            pthread_cond_signal(&pPaths->notFull);
+            pthread_mutex_unlock(&pPaths->lock);
+
+            START_TIMER(timer);
+            AsyncFile * const pFile = openAsyncFile(path, pPaths->pOptions);
+            COUNT_TIME(pPaths->pOptions, INPUT_TIME, timer);
+
+            pthread_mutex_lock(&pPaths->lock);
+            if (pFile == NULL)
+            {
+                pPaths->failures++;
+                continue;
+            }
+            size_t slot = 0;
+            while (pThis->openFiles[slot] != NULL)
+            {
+                slot++;
+            }
+            pFile->slot = slot;
+            pThis->openFiles[slot] = pFile;
+            pThis->openFilesNumber++;
+            if (pFile->ended)
+            {
+                readyFile(pThis, pFile);
+            }
+            submitReads(pThis);
+        }
+
+        if (pPaths->closed && pPaths->size == 0 && pThis->openFilesNumber == 0)
+        {
+            break;
+        }
+
+        // Without reads in flight, only the workers or new paths make progress.
+        if (pThis->readsNumber == 0)
+        {
+            pthread_cond_wait(&pPaths->notEmpty, &pPaths->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&pPaths->lock);
+        START_TIMER(timer);
+        size_t const completionsNumber = readerWait(pThis->pReader, completions,
+                                                    ASYNC_BUFFERS_NUMBER);
+        COUNT_TIME(pPaths->pOptions, INPUT_TIME, timer);
+        pthread_mutex_lock(&pPaths->lock);
+        completeReads(pThis, completions, completionsNumber);
+    }
+
+    pThis->finished = 1;
+    pthread_cond_broadcast(&pThis->ready);
+    pthread_mutex_unlock(&pPaths->lock);
+    return NULL;
+}
+
+/**
+ * @brief Opens the File at the given path, and creates its Validator. The verdict of a File
+ *        which could not be opened is printed.
+ * @param path The path of the File, which was allocated on the heap, and is owned by the new
+ *        File or released.
+ * @param pOptions The options of the check.
+ * @return The new File, or NULL if it could not be opened.
+ */
+AsyncFile * openAsyncFile(char * const path, CheckOptions const * const pOptions)
+{
+    int fileDescriptor = STDIN_FILENO;
+    if (strcmp(path, STANDARD_INPUT_NAME) != 0)
+    {
+        fileDescriptor = open(path, O_RDONLY);
+    }
+    if (fileDescriptor < 0)
+    {
+        fprintf(stderr, INVALID_FILE_ARGUMENTS_MESSAGE, path);
+        printVerdict(path, OPEN_FAILED_STATE, NULL, NULL, pOptions);
+        free(path);
+        return NULL;
+    }
+
+    // The buffers are gone once they are fed, so the lines are counted while the File is read.
+    ValidatorOptions const validatorOptions = {pOptions->maxDepth, pOptions->scannerName,
+                                               pOptions->threads, pOptions->json,
+                                               pOptions->json, pOptions->pairs,
+                                               pOptions->lexical, pOptions->lineComment,
+                                               pOptions->profile, pOptions->regions, 0};
+    AsyncFile * const pFile = malloc(sizeof(AsyncFile));
+    ParenthesisValidator * const pValidator = validatorCreate(&validatorOptions);
+    if (pFile == NULL || pValidator == NULL)
+    {
+        free(pFile);
+        validatorDestroy(pValidator);
+        if (fileDescriptor != STDIN_FILENO)
+        {
+            close(fileDescriptor);
+        }
+        printLimitError(path, pOptions);
+        printVerdict(path, VALIDATOR_LIMIT_EXCEEDED, NULL, NULL, pOptions);
+        free(path);
+        return NULL;
+    }
+
+    struct stat fileStatus;
+    int const regular = fstat(fileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode);
+    pFile->path = path;
+    pFile->fileDescriptor = fileDescriptor;
+    pFile->pValidator = pValidator;
+    pFile->result = VALIDATOR_VALID;
+    pFile->offset = 0;
+    pFile->size = regular ? (unsigned long long) fileStatus.st_size : 0;
+    // As when mapping, an empty regular File is read by the worker, since files such as those
+    // of /proc have a size of 0 and their content, or their read error, only shows when read.
+    pFile->streamed = !regular || fileStatus.st_size == 0;
+    pFile->reading = 0;
+    pFile->ended = (pFile->size == 0);
+    pFile->failed = 0;
+    pFile->scanning = 0;
+    pFile->firstBuffer = NO_BUFFER;
+    pFile->lastBuffer = NO_BUFFER;
+    pFile->buffersNumber = 0;
+    pFile->pNextReady = NULL;
+    return pFile;
+}
+
+/**
+ * @brief Submits a read of every open File that needs one, while there are free buffers. The
+ *        lock of the batch is held.
+ * @param pBatch The state of the asynchronous batch mode.
+ */
+void submitReads(AsyncBatch * const pBatch)
+{
+    for (size_t i = 0; i < ASYNC_FILES_NUMBER && pBatch->freeBuffersNumber != 0; ++i)
+    {
+        AsyncFile * const pFile = pBatch->openFiles[i];
+        if (pFile == NULL || pFile->reading || pFile->ended ||
+            pFile->buffersNumber >= ASYNC_FILE_BUFFERS)
+        {
+            continue;
+        }
+
+        ReaderRequest request;
+        request.fileDescriptor = pFile->fileDescriptor;
+        request.offset = pFile->offset;
+        request.buffer = pBatch->freeBuffers[--pBatch->freeBuffersNumber];
+        request.context = pFile;
+        readerSubmit(pBatch->pReader, &request);
+        pFile->reading = 1;
+        pBatch->readsNumber++;
+    }
+}
+
+/**
+ * @brief Hands the given completed reads to their Files, and the Files to the workers. The lock
+ *        of the batch is held.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @param completions The completed reads.
+ * @param completionsNumber The number of completed reads.
+ */
+void completeReads(AsyncBatch * const pBatch, ReaderCompletion const * const completions,
+                   size_t const completionsNumber)
+{
+    for (size_t i = 0; i < completionsNumber; ++i)
+    {
+        AsyncFile * const pFile = completions[i].context;
+        size_t const buffer = completions[i].buffer;
+        long long const result = completions[i].result;
+        pFile->reading = 0;
+        pBatch->readsNumber--;
+
+        // A File whose verdict is already known drops the rest of its reads.
+        if (result > 0 && !pFile->ended)
+        {
+            COUNT_BYTES(pBatch->pPaths->pOptions, (size_t) result);
+            pBatch->lengths[buffer] = (size_t) result;
+            pBatch->nextBuffers[buffer] = NO_BUFFER;
+            if (pFile->firstBuffer == NO_BUFFER)
+            {
+                pFile->firstBuffer = buffer;
+            }
+            else
+            {
+                pBatch->nextBuffers[pFile->lastBuffer] = buffer;
+            }
+            pFile->lastBuffer = buffer;
+            pFile->buffersNumber++;
+            pFile->offset += (unsigned long long) result;
+            pFile->ended = (pFile->offset >= pFile->size);
+        }
+        else
+        {
+            pBatch->freeBuffers[pBatch->freeBuffersNumber++] = buffer;
+            pFile->failed |= (result < 0 && !pFile->ended);
+            pFile->ended = 1;
+        }
+
+        if (!pFile->scanning)
+        {
+            readyFile(pBatch, pFile);
+        }
+    }
+}
+
+/**
+ * @brief Adds the given File to the Files ready for the workers. The lock of the batch is held.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @param pFile The File, which is not ready or fed yet.
+ */
+void readyFile(AsyncBatch * const pBatch, AsyncFile * const pFile)
+{
+    pFile->scanning = 1;
+    pFile->pNextReady = NULL;
+    if (pBatch->pLastReady == NULL)
+    {
+        pBatch->pFirstReady = pFile;
+    }
+    else
+    {
+        pBatch->pLastReady->pNextReady = pFile;
+    }
+    pBatch->pLastReady = pFile;
+    pthread_cond_signal(&pBatch->ready);
+}
+
+/**
+ * @brief The routine of an asynchronous batch mode worker, it feeds the filled buffers of the
+ *        ready Files to their Validators, and prints the verdict of every File read to its end.
+ * @param pBatch The state of the asynchronous batch mode.
+ * @return NULL.
+ */
+void * asyncWorker(void * pBatch)
+{
+    AsyncBatch * const pThis = pBatch;
+    PathQueue * const pPaths = pThis->pPaths;
+    CheckOptions const * const pOptions = pPaths->pOptions;
+
+    pthread_mutex_lock(&pPaths->lock);
+    while (1)
+    {
+        while (pThis->pFirstReady == NULL && !pThis->finished)
+        {
+            pthread_cond_wait(&pThis->ready, &pPaths->lock);
+        }
+        AsyncFile * const pFile = pThis->pFirstReady;
+        if (pFile == NULL)
+        {
+            break;
+        }
+        pThis->pFirstReady = pFile->pNextReady;
+        if (pThis->pFirstReady == NULL)
+        {
+            pThis->pLastReady = NULL;
+        }
+
+        // The filled buffers are owned by this worker until they are released.
+        size_t const firstBuffer = pFile->firstBuffer;
+        pFile->firstBuffer = NO_BUFFER;
+        pFile->buffersNumber = 0;
+        pthread_mutex_unlock(&pPaths->lock);
+
+        START_TIMER(timer);
+        for (size_t buffer = firstBuffer; buffer != NO_BUFFER && pFile->result == VALIDATOR_VALID;
+             buffer = pThis->nextBuffers[buffer])
+        {
+            pFile->result = validatorFeed(pFile->pValidator,
+                                          readerBuffer(pThis->pReader, buffer),
+                                          pThis->lengths[buffer]);
+        }
+        COUNT_TIME(pOptions, VALIDATION_TIME, timer);
+
+        pthread_mutex_lock(&pPaths->lock);
+        for (size_t buffer = firstBuffer; buffer != NO_BUFFER; buffer = pThis->nextBuffers[buffer])
+        {
+            pThis->freeBuffers[pThis->freeBuffersNumber++] = buffer;
+        }
+        pFile->ended |= (pFile->result != VALIDATOR_VALID);
+        pthread_cond_signal(&pPaths->notEmpty);
+
+        if (pFile->buffersNumber != 0)
+        {
+            readyFile(pThis, pFile);
+        }
+        else if (!pFile->ended || pFile->reading)
+        {
+            pFile->scanning = 0;
+        }
+        else
+        {
+            pThis->openFiles[pFile->slot] = NULL;
+            pthread_mutex_unlock(&pPaths->lock);
+            int const failed = finishAsyncFile(pFile, pOptions);
+            pthread_mutex_lock(&pPaths->lock);
+            pPaths->failures += (size_t) failed;
+            pThis->openFilesNumber--;
+            pthread_cond_signal(&pPaths->notEmpty);
+        }
+    }
+    pthread_mutex_unlock(&pPaths->lock);
+    return NULL;
+}
+
+/**
+ * @brief Finishes the check of the given File, prints its verdict and releases it.
+ * @param pFile The File, which was read to its end.
+ * @param pOptions The options of the check.
+ * @return 0 if the File was analyzed, 1 otherwise.
+ */
+int finishAsyncFile(AsyncFile * const pFile, CheckOptions const * const pOptions)
+{
+    if (pFile->streamed &&
+        checkStreamedFile(pFile->pValidator, pFile->fileDescriptor, pOptions) == READ_FAILED_STATE)
+    {
+        pFile->failed = 1;
+    }
+
+    ValidatorError error;
+    error.kind = VALIDATOR_NO_ERROR;
+    if (pOptions->json)
+    {
+        validatorError(pFile->pValidator, &error);
+    }
+    int result = validatorFinish(pFile->pValidator);
+    if (pFile->failed)
+    {
+        fprintf(stderr, READ_FAILED_MESSAGE, pFile->path);
+        result = READ_FAILED_STATE;
+    }
+    else if (result == VALIDATOR_LIMIT_EXCEEDED)
+    {
+        printLimitError(pFile->path, pOptions);
+    }
+    ValidatorProfile profile;
+    if (pOptions->profile)
+    {
+        validatorProfile(pFile->pValidator, &profile);
+    }
+    COUNT_FILE(pOptions, pFile->pValidator);
+
+    int const failed = printVerdict(pFile->path, result, &error,
+                                    pOptions->profile ? &profile : NULL, pOptions);
+    validatorDestroy(pFile->pValidator);
+    if (pFile->fileDescriptor != STDIN_FILENO)
+    {
+        close(pFile->fileDescriptor);
+    }
+    free(pFile->path);
+    free(pFile);
+    return failed;
+}
+
+
+#ifdef VALIDATOR_STATISTICS
+
+/*----=  Statistics  =-----*/
+
+
+/**
+ * @brief Reads the timer of the statistics, the time stamp counter if the CPU has one and the
+ *        monotonic clock in nanoseconds otherwise.
+ * @return The ticks of the timer.
+ */
+unsigned long long readTimer(void)
+{
+#ifdef TIME_STAMP_COUNTER
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long) now.tv_sec * NANOSECONDS_PER_SECOND +
+           (unsigned long long) now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Returns the number of seconds since the given time.
+ * @param pStart The time to measure from.
+ * @return The number of seconds.
+ */
+double secondsSince(struct timespec const * const pStart)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) (now.tv_sec - pStart->tv_sec) +
+           (double) (now.tv_nsec - pStart->tv_nsec) / NANOSECONDS_PER_SECOND;
+}
+
+/**
+ * @brief Starts counting a run, and the thread printing its progress if it is needed.
+ * @param pStatistics The counters of the run.
+ * @param progressInterval The number of seconds between two progress messages, or 0 for none.
+ */
+void startStatistics(RunStatistics * const pStatistics, double const progressInterval)
+{
+    memset(pStatistics, 0, sizeof(RunStatistics));
+    pthread_mutex_init(&pStatistics->lock, NULL);
+    pthread_cond_init(&pStatistics->stop, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &pStatistics->start);
+    pStatistics->startTicks = readTimer();
+
+    // Without its thread the run goes on with no progress messages.
+    pStatistics->progressInterval = progressInterval;
+    if (progressInterval > 0 &&
+        pthread_create(&pStatistics->progressThread, NULL, printProgress, pStatistics) != 0)
+    {
+        pStatistics->progressInterval = 0;
+    }
+}
+
+/**
+ * @brief Stops counting a run, and prints its counters if they are needed.
+ * @param pStatistics The counters of the run.
+ * @param print Non zero for printing the counters.
+ * @param json Non zero for printing the counters as a JSON object.
+ */
+void stopStatistics(RunStatistics * const pStatistics, int const print, int const json)
+{
+    double const seconds = secondsSince(&pStatistics->start);
+    unsigned long long const ticks = readTimer() - pStatistics->startTicks;
+
+    if (pStatistics->progressInterval > 0)
+    {
+        pthread_mutex_lock(&pStatistics->lock);
+        pStatistics->stopped = 1;
+        pthread_cond_signal(&pStatistics->stop);
+        pthread_mutex_unlock(&pStatistics->lock);
+        pthread_join(pStatistics->progressThread, NULL);
+    }
+    pthread_cond_destroy(&pStatistics->stop);
+    pthread_mutex_destroy(&pStatistics->lock);
+
+    if (!print)
+    {
+        return;
+    }
+
+    // The timer is calibrated against the clock over the whole run.
+    double const secondsPerTick = (ticks != 0) ? seconds / (double) ticks : 0;
+    double const inputSeconds = (double) pStatistics->inputTicks * secondsPerTick;
+    double const validationSeconds = (double) pStatistics->validationTicks * secondsPerTick;
+    struct rusage usage;
+    long majorFaults = 0;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        majorFaults = usage.ru_majflt;
+    }
+
+    if (json)
+    {
+        fprintf(stderr, JSON_STATISTICS_FORMAT, pStatistics->files, pStatistics->bytesRead,
+                pStatistics->bytesScanned, pStatistics->parenthesis, pStatistics->maxDepth,
+                seconds, inputSeconds, validationSeconds, majorFaults);
+    }
+    else
+    {
+        fprintf(stderr, STATISTICS_MESSAGE, pStatistics->files, pStatistics->bytesRead,
+                pStatistics->bytesScanned, pStatistics->parenthesis, pStatistics->maxDepth);
+        fprintf(stderr, TIME_MESSAGE, seconds, inputSeconds, validationSeconds,
+                (seconds > 0) ? (double) pStatistics->bytesRead / seconds / BYTES_PER_MEGABYTE : 0,
+                majorFaults);
+    }
+}
+
+/**
+ * @brief The routine of the thread printing the progress of a run until the run ends.
+ * @param pStatistics The counters of the run.
+ * @return NULL.
+ */
+void * printProgress(void * pStatistics)
+{
+    RunStatistics * const pRun = pStatistics;
+    double const interval = pRun->progressInterval;
+
+    pthread_mutex_lock(&pRun->lock);
+    while (!pRun->stopped)
+    {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        double const nanoseconds = (double) deadline.tv_nsec +
+                                   (interval - (double) (long) interval) * NANOSECONDS_PER_SECOND;
+        deadline.tv_sec += (time_t) interval + (time_t) (nanoseconds / NANOSECONDS_PER_SECOND);
+        deadline.tv_nsec = (long) nanoseconds % NANOSECONDS_PER_SECOND;
+
+        int waitResult = 0;
+        while (!pRun->stopped && waitResult != ETIMEDOUT)
+        {
+            waitResult = pthread_cond_timedwait(&pRun->stop, &pRun->lock, &deadline);
+        }
+        if (!pRun->stopped)
+        {
+            double const seconds = secondsSince(&pRun->start);
+            unsigned long long const bytesRead = __atomic_load_n(&pRun->bytesRead,
+                                                                 __ATOMIC_RELAXED);
+            fprintf(stderr, PROGRESS_MESSAGE, seconds,
+                    __atomic_load_n(&pRun->files, __ATOMIC_RELAXED), bytesRead,
+                    (double) bytesRead / seconds / BYTES_PER_MEGABYTE);
+        }
+    }
+    pthread_mutex_unlock(&pRun->lock);
+    return NULL;
+}
+
+/**
+ * @brief Adds the time since the given timer started to the given phase of the run, and
+ *        restarts the timer.
+ * @param pStatistics The counters of the run, or NULL if the run is not counted.
+ * @param phase INPUT_TIME or VALIDATION_TIME.
+ * @param pTimer The timer.
+ */
+void countTime(RunStatistics * const pStatistics, int const phase,
+               unsigned long long * const pTimer)
+{
+    if (pStatistics != NULL)
+    {
+        unsigned long long const now = readTimer();
+        unsigned long long * const pTicks = (phase == INPUT_TIME) ? &pStatistics->inputTicks :
+                                            &pStatistics->validationTicks;
+        __atomic_fetch_add(pTicks, now - *pTimer, __ATOMIC_RELAXED);
+        *pTimer = now;
+    }
+}
+
+/**
+ * @brief Adds the given number of bytes read to the counters of the run.
+ * @param pStatistics The counters of the run, or NULL if the run is not counted.
+ * @param length The number of bytes read.
+ */
+void countBytes(RunStatistics * const pStatistics, size_t const length)
+{
+    if (pStatistics != NULL)
+    {
+        __atomic_fetch_add(&pStatistics->bytesRead, length, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Adds the counters of the given Validator, which checked a whole File, to the counters
+ *        of the run.
+ * @param pStatistics The counters of the run, or NULL if the run is not counted.
+ * @param pValidator The Validator of the File.
+ */
+void countFile(RunStatistics * const pStatistics, ParenthesisValidator const * const pValidator)
+{
+    if (pStatistics == NULL)
+    {
+        return;
+    }
+
+    ValidatorStatistics fileStatistics;
+    validatorStatistics(pValidator, &fileStatistics);
+    __atomic_fetch_add(&pStatistics->files, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&pStatistics->bytesScanned, fileStatistics.bytes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&pStatistics->parenthesis, fileStatistics.parenthesis, __ATOMIC_RELAXED);
+
+    unsigned long long maxDepth = __atomic_load_n(&pStatistics->maxDepth, __ATOMIC_RELAXED);
+    while (fileStatistics.maxDepth > maxDepth &&
+           !__atomic_compare_exchange_n(&pStatistics->maxDepth, &maxDepth,
+                                        fileStatistics.maxDepth, 0, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+    {
+        // Another worker raised it meanwhile, the exchange reloaded its depth.
+    }
+}
+
+#endif
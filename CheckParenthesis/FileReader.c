@@ -0,0 +1,757 @@
+/**
+ * @file FileReader.c
+ * @author Itai Tagar <itagar>
+ * @version 1.0
+ * @date 09 Aug 2016
+ *
+ * @brief A library that reads many files at once into a fixed set of buffers.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A library that reads many files at once into a fixed set of buffers.
+ * The buffers are a single anonymous mapping, split into buffers of the same size, and every
+ * buffer has at most a single read in flight, so the reads in flight never exceed the number of
+ * buffers and the rings and queues sized by it never overflow.
+ * The io_uring backend uses the system calls directly, as the kernel interface is small. Its
+ * submission queue is filled by 'readerSubmit' and handed to the kernel along with the wait for
+ * completions, so a batch of reads costs a single system call. The buffers are registered with
+ * the kernel, so their pages are not mapped again for every read. If registering fails, e.g.
+ * for a low limit of locked memory, the reads are plain io_uring reads of the same buffers.
+ * The pread backend keeps a queue of requests, which its threads take in turn, and a queue of
+ * completions, which the waiting thread empties.
+ */
+
+
+/*----=  Includes  =-----*/
+
+
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include "FileReader.h"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#ifdef __NR_io_uring_setup
+#include <linux/io_uring.h>
+/**
+ * @def URING_BACKEND
+ * @brief A Flag which states that the io_uring backend is compiled in.
+ */
+#define URING_BACKEND
+#endif
+#endif
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def TRUE 1
+ * @brief A Macro that sets the value of a true flag.
+ */
+#define TRUE 1
+
+/**
+ * @def FALSE 0
+ * @brief A Macro that sets the value of a false flag.
+ */
+#define FALSE 0
+
+/**
+ * @def COMPLETION_RING_FACTOR 2
+ * @brief A Macro that sets the size of the io_uring completion ring relative to its
+ *        submission ring, as the kernel sizes it by default.
+ */
+#define COMPLETION_RING_FACTOR 2
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The buffers, and the reads in flight, of a set of files.
+ */
+struct FileReader
+{
+    /** Non zero if the reads are done by io_uring. */
+    int uring;
+    /** The bytes of all the buffers. */
+    unsigned char * buffers;
+    /** The number of buffers. */
+    size_t buffersNumber;
+    /** The number of bytes of each buffer. */
+    size_t bufferSize;
+    /** The read in flight of every buffer. */
+    ReaderRequest * requests;
+    /** Non zero for every buffer whose read is in flight. */
+    unsigned char * inFlight;
+
+    /** The file descriptor of the io_uring. */
+    int ringDescriptor;
+    /** The mapping of the submission ring. */
+    unsigned char * submissionRing;
+    /** The number of bytes of the mapping of the submission ring. */
+    size_t submissionRingSize;
+    /** The mapping of the completion ring, which may be the submission ring's mapping. */
+    unsigned char * completionRing;
+    /** The number of bytes of the mapping of the completion ring. */
+    size_t completionRingSize;
+    /** The mapping of the submission entries. */
+    void * entries;
+    /** The number of bytes of the mapping of the submission entries. */
+    size_t entriesSize;
+    /** The index of the first submission the kernel has not consumed yet. */
+    unsigned * pSubmissionHead;
+    /** The index after the last submission. */
+    unsigned * pSubmissionTail;
+    /** The mask of the indices of the submission ring. */
+    unsigned submissionMask;
+    /** The indices of the submission entries, in the order they are submitted. */
+    unsigned * submissionArray;
+    /** The index of the first completion not taken yet. */
+    unsigned * pCompletionHead;
+    /** The index after the last completion. */
+    unsigned * pCompletionTail;
+    /** The mask of the indices of the completion ring. */
+    unsigned completionMask;
+    /** The completion entries. */
+    void * completions;
+    /** The number of submissions not handed to the kernel yet. */
+    unsigned pendingSubmissions;
+    /** Non zero if the buffers are registered with the kernel. */
+    int registered;
+
+    /** The threads calling pread. */
+    pthread_t * threads;
+    /** The number of threads. */
+    size_t threadsNumber;
+    /** The queue of the buffers whose reads wait for a thread. */
+    size_t * requested;
+    /** The index of the first buffer in the queue of requests. */
+    size_t requestedHead;
+    /** The number of buffers in the queue of requests. */
+    size_t requestedSize;
+    /** The queue of the completed reads. */
+    ReaderCompletion * completed;
+    /** The index of the first read in the queue of completions. */
+    size_t completedHead;
+    /** The number of reads in the queue of completions. */
+    size_t completedSize;
+    /** Non zero once the threads should end. */
+    int stopping;
+    /** The lock of both queues. */
+    pthread_mutex_t lock;
+    /** Signaled when a read is requested or the threads should end. */
+    pthread_cond_t requestAdded;
+    /** Signaled when a read completes. */
+    pthread_cond_t completionAdded;
+};
+
+
+/*----=  Forward Declarations  =-----*/
+
+
+/**
+ * @brief Sets up the io_uring of the given Reader, and registers its buffers.
+ * @param pReader The Reader, whose buffers are allocated.
+ * @return 0 if the io_uring is set up, 1 if the kernel does not support it.
+ */
+static int createUring(FileReader * const pReader);
+
+/**
+ * @brief Releases the io_uring of the given Reader.
+ * @param pReader The Reader.
+ */
+static void destroyUring(FileReader * const pReader);
+
+/**
+ * @brief Adds a read to the submission ring of the given Reader.
+ * @param pReader The Reader, which uses io_uring.
+ * @param buffer The index of the buffer of the read, whose request is stored.
+ */
+static void submitUring(FileReader * const pReader, size_t const buffer);
+
+/**
+ * @brief Hands the pending submissions of the given Reader to the kernel, and waits for at least
+ *        a single completion.
+ * @param pReader The Reader, which uses io_uring.
+ * @param completions The array to store the completed reads in.
+ * @param capacity The number of completions the array holds.
+ * @return The number of completed reads stored.
+ */
+static size_t waitUring(FileReader * const pReader, ReaderCompletion * const completions,
+                        size_t const capacity);
+
+/**
+ * @brief Starts the threads of the given Reader calling pread.
+ * @param pReader The Reader, whose buffers are allocated.
+ * @param threads The number of threads.
+ * @return 0 if any thread started, 1 otherwise.
+ */
+static int createPool(FileReader * const pReader, size_t const threads);
+
+/**
+ * @brief Stops the threads of the given Reader.
+ * @param pReader The Reader.
+ */
+static void destroyPool(FileReader * const pReader);
+
+/**
+ * @brief The routine of a thread calling pread, it reads the requested buffers until the Reader
+ *        is released.
+ * @param pReader The Reader.
+ * @return NULL.
+ */
+static void * readBuffers(void * pReader);
+
+/**
+ * @brief Completes the given read of the given Reader.
+ * @param pReader The Reader.
+ * @param buffer The index of the buffer of the read.
+ * @param result The number of bytes read, or a negative error number.
+ * @return The completion.
+ */
+static ReaderCompletion completeRead(FileReader * const pReader, size_t const buffer,
+                                     long long const result);
+
+
+/*----=  Reader  =-----*/
+
+
+/**
+ * @brief Creates a Reader of the given number of buffers.
+ * @param backend READER_URING, which falls back to READER_PREAD if the kernel does not support
+ *        io_uring, or READER_PREAD.
+ * @param buffersNumber The number of buffers, which is the maximal number of reads in flight.
+ * @param bufferSize The number of bytes of each buffer.
+ * @param threads The number of threads calling pread, if they are used.
+ * @return The new Reader, or NULL if the backend is not known or there is not enough memory.
+ */
+FileReader * readerCreate(char const * const backend, size_t const buffersNumber,
+                          size_t const bufferSize, size_t const threads)
+{
+    int const uring = (strcmp(backend, READER_URING) == 0);
+    if ((!uring && strcmp(backend, READER_PREAD) != 0) || buffersNumber == 0 || bufferSize == 0)
+    {
+        return NULL;
+    }
+
+    FileReader * const pReader = calloc(1, sizeof(FileReader));
+    if (pReader == NULL)
+    {
+        return NULL;
+    }
+    pReader->ringDescriptor = -1;
+    pReader->buffersNumber = buffersNumber;
+    pReader->bufferSize = bufferSize;
+    pReader->requests = malloc(buffersNumber * sizeof(ReaderRequest));
+    pReader->inFlight = calloc(buffersNumber, sizeof(unsigned char));
+    pReader->buffers = mmap(NULL, buffersNumber * bufferSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pReader->buffers == MAP_FAILED)
+    {
+        pReader->buffers = NULL;
+    }
+    if (pReader->requests == NULL || pReader->inFlight == NULL || pReader->buffers == NULL)
+    {
+        readerDestroy(pReader);
+        return NULL;
+    }
+
+    // Without io_uring, the reads are done by the threads.
+    pReader->uring = uring && createUring(pReader) == 0;
+    if (!pReader->uring && createPool(pReader, threads))
+    {
+        readerDestroy(pReader);
+        return NULL;
+    }
+    return pReader;
+}
+
+/**
+ * @brief Returns the name of the backend the given Reader actually uses.
+ * @param pReader The Reader.
+ * @return READER_URING or READER_PREAD.
+ */
+char const * readerBackend(FileReader const * const pReader)
+{
+    return pReader->uring ? READER_URING : READER_PREAD;
+}
+
+/**
+ * @brief Returns the buffer of the given index of the given Reader.
+ * @param pReader The Reader.
+ * @param buffer The index of the buffer, smaller than the number of buffers.
+ * @return The bytes of the buffer.
+ */
+unsigned char * readerBuffer(FileReader const * const pReader, size_t const buffer)
+{
+    return pReader->buffers + buffer * pReader->bufferSize;
+}
+
+/**
+ * @brief Submits a read to the given Reader. The read starts no later than the next wait.
+ * @param pReader The Reader.
+ * @param pRequest The read, its buffer must not be in flight.
+ */
+void readerSubmit(FileReader * const pReader, ReaderRequest const * const pRequest)
+{
+    size_t const buffer = pRequest->buffer;
+    pReader->requests[buffer] = *pRequest;
+    pReader->inFlight[buffer] = TRUE;
+    if (pReader->uring)
+    {
+        submitUring(pReader, buffer);
+        return;
+    }
+
+    pthread_mutex_lock(&pReader->lock);
+    pReader->requested[(pReader->requestedHead + pReader->requestedSize) %
+                       pReader->buffersNumber] = buffer;
+    pReader->requestedSize++;
+    pthread_cond_signal(&pReader->requestAdded);
+    pthread_mutex_unlock(&pReader->lock);
+}
+
+/**
+ * @brief Waits for at least a single read of the given Reader to complete.
+ * @param pReader The Reader, which must have reads in flight.
+ * @param completions The array to store the completed reads in.
+ * @param capacity The number of completions the array holds.
+ * @return The number of completed reads stored.
+ */
+size_t readerWait(FileReader * const pReader, ReaderCompletion * const completions,
+                  size_t const capacity)
+{
+    if (pReader->uring)
+    {
+        return waitUring(pReader, completions, capacity);
+    }
+
+    pthread_mutex_lock(&pReader->lock);
+    while (pReader->completedSize == 0)
+    {
+        pthread_cond_wait(&pReader->completionAdded, &pReader->lock);
+    }
+    size_t number = 0;
+    while (number < capacity && pReader->completedSize > 0)
+    {
+        completions[number++] = pReader->completed[pReader->completedHead];
+        pReader->completedHead = (pReader->completedHead + 1) % pReader->buffersNumber;
+        pReader->completedSize--;
+    }
+    pthread_mutex_unlock(&pReader->lock);
+    return number;
+}
+
+/**
+ * @brief Releases the given Reader, which has no reads in flight.
+ * @param pReader The Reader to release, may be NULL.
+ */
+void readerDestroy(FileReader * const pReader)
+{
+    if (pReader == NULL)
+    {
+        return;
+    }
+    if (pReader->uring)
+    {
+        destroyUring(pReader);
+    }
+    else if (pReader->threads != NULL)
+    {
+        destroyPool(pReader);
+    }
+    if (pReader->buffers != NULL)
+    {
+        munmap(pReader->buffers, pReader->buffersNumber * pReader->bufferSize);
+    }
+    free(pReader->inFlight);
+    free(pReader->requests);
+    free(pReader);
+}
+
+
+/*----=  io_uring  =-----*/
+
+
+#ifdef URING_BACKEND
+
+/**
+ * @brief Sets up the io_uring of the given Reader, and registers its buffers.
+ * @param pReader The Reader, whose buffers are allocated.
+ * @return 0 if the io_uring is set up, 1 if the kernel does not support it.
+ */
+static int createUring(FileReader * const pReader)
+{
+    struct io_uring_params parameters;
+    memset(&parameters, 0, sizeof(parameters));
+    int const ringDescriptor = (int) syscall(__NR_io_uring_setup,
+                                             (unsigned) pReader->buffersNumber, &parameters);
+    if (ringDescriptor < 0)
+    {
+        return TRUE;
+    }
+    pReader->ringDescriptor = ringDescriptor;
+
+    // Older kernels map the two rings apart, newer ones share a single mapping.
+    pReader->submissionRingSize = parameters.sq_off.array + parameters.sq_entries *
+                                                            sizeof(unsigned);
+    pReader->completionRingSize = parameters.cq_off.cqes + parameters.cq_entries *
+                                                           sizeof(struct io_uring_cqe);
+    int const singleMapping = (parameters.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMapping && pReader->completionRingSize > pReader->submissionRingSize)
+    {
+        pReader->submissionRingSize = pReader->completionRingSize;
+    }
+    void * const submissionRing = mmap(NULL, pReader->submissionRingSize,
+                                       PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                       ringDescriptor, IORING_OFF_SQ_RING);
+    void * completionRing = submissionRing;
+    if (submissionRing != MAP_FAILED && !singleMapping)
+    {
+        completionRing = mmap(NULL, pReader->completionRingSize, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, ringDescriptor, IORING_OFF_CQ_RING);
+    }
+    pReader->entriesSize = parameters.sq_entries * sizeof(struct io_uring_sqe);
+    void * const entries = mmap(NULL, pReader->entriesSize, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, ringDescriptor, IORING_OFF_SQES);
+    pReader->submissionRing = (submissionRing != MAP_FAILED) ? submissionRing : NULL;
+    pReader->completionRing = (completionRing != MAP_FAILED) ? completionRing : NULL;
+    pReader->entries = (entries != MAP_FAILED) ? entries : NULL;
+    if (pReader->submissionRing == NULL || pReader->completionRing == NULL ||
+        pReader->entries == NULL)
+    {
+        destroyUring(pReader);
+        return TRUE;
+    }
+
+    unsigned char * const pSubmission = pReader->submissionRing;
+    pReader->pSubmissionHead = (unsigned *) (pSubmission + parameters.sq_off.head);
+    pReader->pSubmissionTail = (unsigned *) (pSubmission + parameters.sq_off.tail);
+    pReader->submissionMask = *(unsigned *) (pSubmission + parameters.sq_off.ring_mask);
+    pReader->submissionArray = (unsigned *) (pSubmission + parameters.sq_off.array);
+    unsigned char * const pCompletion = pReader->completionRing;
+    pReader->pCompletionHead = (unsigned *) (pCompletion + parameters.cq_off.head);
+    pReader->pCompletionTail = (unsigned *) (pCompletion + parameters.cq_off.tail);
+    pReader->completionMask = *(unsigned *) (pCompletion + parameters.cq_off.ring_mask);
+    pReader->completions = pCompletion + parameters.cq_off.cqes;
+
+    // The buffers stay plain if they cannot be locked in the memory.
+    struct iovec * const vectors = malloc(pReader->buffersNumber * sizeof(struct iovec));
+    if (vectors != NULL)
+    {
+        for (size_t i = 0; i < pReader->buffersNumber; ++i)
+        {
+            vectors[i].iov_base = readerBuffer(pReader, i);
+            vectors[i].iov_len = pReader->bufferSize;
+        }
+        pReader->registered = syscall(__NR_io_uring_register, ringDescriptor,
+                                      IORING_REGISTER_BUFFERS, vectors,
+                                      (unsigned) pReader->buffersNumber) == 0;
+        free(vectors);
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Releases the io_uring of the given Reader.
+ * @param pReader The Reader.
+ */
+static void destroyUring(FileReader * const pReader)
+{
+    if (pReader->entries != NULL)
+    {
+        munmap(pReader->entries, pReader->entriesSize);
+    }
+    if (pReader->completionRing != NULL && pReader->completionRing != pReader->submissionRing)
+    {
+        munmap(pReader->completionRing, pReader->completionRingSize);
+    }
+    if (pReader->submissionRing != NULL)
+    {
+        munmap(pReader->submissionRing, pReader->submissionRingSize);
+    }
+    if (pReader->ringDescriptor >= 0)
+    {
+        close(pReader->ringDescriptor);
+    }
+    pReader->entries = NULL;
+    pReader->completionRing = NULL;
+    pReader->submissionRing = NULL;
+    pReader->ringDescriptor = -1;
+}
+
+/**
+ * @brief Adds a read to the submission ring of the given Reader.
+ * @param pReader The Reader, which uses io_uring.
+ * @param buffer The index of the buffer of the read, whose request is stored.
+ */
+static void submitUring(FileReader * const pReader, size_t const buffer)
+{
+    // Only this thread writes the tail, and the ring holds every buffer's read.
+    unsigned const tail = *pReader->pSubmissionTail;
+    unsigned const index = tail & pReader->submissionMask;
+    struct io_uring_sqe * const pEntry = (struct io_uring_sqe *) pReader->entries + index;
+    ReaderRequest const * const pRequest = &pReader->requests[buffer];
+
+    memset(pEntry, 0, sizeof(struct io_uring_sqe));
+    pEntry->opcode = pReader->registered ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    pEntry->fd = pRequest->fileDescriptor;
+    pEntry->off = pRequest->offset;
+    pEntry->addr = (unsigned long long) (uintptr_t) readerBuffer(pReader, buffer);
+    pEntry->len = (unsigned) pReader->bufferSize;
+    pEntry->buf_index = (unsigned short) buffer;
+    pEntry->user_data = buffer;
+    pReader->submissionArray[index] = index;
+    __atomic_store_n(pReader->pSubmissionTail, tail + 1, __ATOMIC_RELEASE);
+    pReader->pendingSubmissions++;
+}
+
+/**
+ * @brief Hands the pending submissions of the given Reader to the kernel, and waits for at least
+ *        a single completion.
+ * @param pReader The Reader, which uses io_uring.
+ * @param completions The array to store the completed reads in.
+ * @param capacity The number of completions the array holds.
+ * @return The number of completed reads stored.
+ */
+static size_t waitUring(FileReader * const pReader, ReaderCompletion * const completions,
+                        size_t const capacity)
+{
+    size_t number = 0;
+    while (TRUE)
+    {
+        unsigned head = *pReader->pCompletionHead;
+        unsigned const tail = __atomic_load_n(pReader->pCompletionTail, __ATOMIC_ACQUIRE);
+        while (number < capacity && head != tail)
+        {
+            struct io_uring_cqe const * const pEntry = (struct io_uring_cqe const *)
+                                                       pReader->completions +
+                                                       (head & pReader->completionMask);
+            completions[number++] = completeRead(pReader, (size_t) pEntry->user_data,
+                                                 pEntry->res);
+            head++;
+        }
+        __atomic_store_n(pReader->pCompletionHead, head, __ATOMIC_RELEASE);
+        if (number > 0 && pReader->pendingSubmissions == 0)
+        {
+            return number;
+        }
+
+        // Submit what is pending, and block only if no read has completed yet.
+        unsigned const minimum = (number == 0) ? 1 : 0;
+        long const submitted = syscall(__NR_io_uring_enter, pReader->ringDescriptor,
+                                       pReader->pendingSubmissions, minimum,
+                                       minimum ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (submitted >= 0)
+        {
+            pReader->pendingSubmissions -= (unsigned) submitted;
+        }
+        else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            // The ring is broken, so every read in flight fails with its error.
+            int const error = errno;
+            for (size_t i = 0; i < pReader->buffersNumber && number < capacity; ++i)
+            {
+                if (pReader->inFlight[i])
+                {
+                    completions[number++] = completeRead(pReader, i, -error);
+                }
+            }
+            pReader->pendingSubmissions = 0;
+            return number;
+        }
+    }
+}
+
+#else
+
+/**
+ * @brief Sets up the io_uring of the given Reader, and registers its buffers.
+ * @param pReader The Reader, whose buffers are allocated.
+ * @return 0 if the io_uring is set up, 1 if the kernel does not support it.
+ */
+static int createUring(FileReader * const pReader)
+{
+    (void) pReader;
+    return TRUE;
+}
+
+/**
+ * @brief Releases the io_uring of the given Reader.
+ * @param pReader The Reader.
+ */
+static void destroyUring(FileReader * const pReader)
+{
+    (void) pReader;
+}
+
+/**
+ * @brief Adds a read to the submission ring of the given Reader.
+ * @param pReader The Reader, which uses io_uring.
+ * @param buffer The index of the buffer of the read, whose request is stored.
+ */
+static void submitUring(FileReader * const pReader, size_t const buffer)
+{
+    (void) pReader;
+    (void) buffer;
+}
+
+/**
+ * @brief Hands the pending submissions of the given Reader to the kernel, and waits for at least
+ *        a single completion.
+ * @param pReader The Reader, which uses io_uring.
+ * @param completions The array to store the completed reads in.
+ * @param capacity The number of completions the array holds.
+ * @return The number of completed reads stored.
+ */
+static size_t waitUring(FileReader * const pReader, ReaderCompletion * const completions,
+                        size_t const capacity)
+{
+    (void) pReader;
+    (void) completions;
+    (void) capacity;
+    return 0;
+}
+
+#endif
+
+
+/*----=  Thread Pool  =-----*/
+
+
+/**
+ * @brief Starts the threads of the given Reader calling pread.
+ * @param pReader The Reader, whose buffers are allocated.
+ * @param threads The number of threads.
+ * @return 0 if any thread started, 1 otherwise.
+ */
+static int createPool(FileReader * const pReader, size_t const threads)
+{
+    size_t const threadsNumber = (threads > 0) ? threads : 1;
+    pReader->requested = malloc(pReader->buffersNumber * sizeof(size_t));
+    pReader->completed = malloc(pReader->buffersNumber * sizeof(ReaderCompletion));
+    pReader->threads = malloc(threadsNumber * sizeof(pthread_t));
+    if (pReader->requested == NULL || pReader->completed == NULL || pReader->threads == NULL)
+    {
+        free(pReader->requested);
+        free(pReader->completed);
+        free(pReader->threads);
+        pReader->threads = NULL;
+        return TRUE;
+    }
+    pthread_mutex_init(&pReader->lock, NULL);
+    pthread_cond_init(&pReader->requestAdded, NULL);
+    pthread_cond_init(&pReader->completionAdded, NULL);
+
+    while (pReader->threadsNumber < threadsNumber &&
+           pthread_create(&pReader->threads[pReader->threadsNumber], NULL, readBuffers,
+                          pReader) == 0)
+    {
+        pReader->threadsNumber++;
+    }
+    if (pReader->threadsNumber == 0)
+    {
+        destroyPool(pReader);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Stops the threads of the given Reader.
+ * @param pReader The Reader.
+ */
+static void destroyPool(FileReader * const pReader)
+{
+    pthread_mutex_lock(&pReader->lock);
+    pReader->stopping = TRUE;
+    pthread_cond_broadcast(&pReader->requestAdded);
+    pthread_mutex_unlock(&pReader->lock);
+    for (size_t i = 0; i < pReader->threadsNumber; ++i)
+    {
+        pthread_join(pReader->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pReader->completionAdded);
+    pthread_cond_destroy(&pReader->requestAdded);
+    pthread_mutex_destroy(&pReader->lock);
+    free(pReader->requested);
+    free(pReader->completed);
+    free(pReader->threads);
+    pReader->threads = NULL;
+}
+
+/**
+ * @brief The routine of a thread calling pread, it reads the requested buffers until the Reader
+ *        is released.
+ * @param pReader The Reader.
+ * @return NULL.
+ */
+static void * readBuffers(void * pReader)
+{
+    FileReader * const pThis = pReader;
+
+    pthread_mutex_lock(&pThis->lock);
+    while (TRUE)
+    {
+        while (pThis->requestedSize == 0 && !pThis->stopping)
+        {
+            pthread_cond_wait(&pThis->requestAdded, &pThis->lock);
+        }
+        if (pThis->requestedSize == 0)
+        {
+            break;
+        }
+        size_t const buffer = pThis->requested[pThis->requestedHead];
+        pThis->requestedHead = (pThis->requestedHead + 1) % pThis->buffersNumber;
+        pThis->requestedSize--;
+        ReaderRequest const request = pThis->requests[buffer];
+        pthread_mutex_unlock(&pThis->lock);
+
+        ssize_t bytesRead;
+        do
+        {
+            bytesRead = pread(request.fileDescriptor, readerBuffer(pThis, buffer),
+                              pThis->bufferSize, (off_t) request.offset);
+        } while (bytesRead < 0 && errno == EINTR);
+        long long const result = (bytesRead >= 0) ? (long long) bytesRead : -(long long) errno;
+
+        pthread_mutex_lock(&pThis->lock);
+        pThis->completed[(pThis->completedHead + pThis->completedSize) % pThis->buffersNumber] =
+            completeRead(pThis, buffer, result);
+        pThis->completedSize++;
+        pthread_cond_signal(&pThis->completionAdded);
+    }
+    pthread_mutex_unlock(&pThis->lock);
+    return NULL;
+}
+
+/**
+ * @brief Completes the given read of the given Reader.
+ * @param pReader The Reader.
+ * @param buffer The index of the buffer of the read.
+ * @param result The number of bytes read, or a negative error number.
+ * @return The completion.
+ */
+static ReaderCompletion completeRead(FileReader * const pReader, size_t const buffer,
+                                     long long const result)
+{
+    ReaderCompletion completion;
+    completion.context = pReader->requests[buffer].context;
+    completion.buffer = buffer;
+    completion.result = result;
+    pReader->inFlight[buffer] = FALSE;
+    return completion;
+}
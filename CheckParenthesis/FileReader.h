@@ -0,0 +1,147 @@
+/**
+ * @file FileReader.h
+ * @author Itai Tagar <itagar>
+ * @version 1.0
+ * @date 09 Aug 2016
+ *
+ * @brief A library that reads many files at once into a fixed set of buffers.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A library that reads many files at once into a fixed set of buffers.
+ * The caller submits reads, each of a part of a file into a buffer of the Reader, and waits for
+ * their completions, so any number of reads of any number of files are in flight together.
+ * A buffer is owned by the Reader from the submission of its read until its completion, and by
+ * the caller otherwise, so the caller may hand the data of a completed read to other threads
+ * and submit the buffer again once they are done with it.
+ * The reads are done by io_uring where the kernel supports it, into buffers which are
+ * registered with the kernel once. Otherwise they are done by a pool of threads calling pread.
+ * A Reader is used by a single thread at a time.
+ * Usage:       FileReader * pReader = readerCreate(READER_URING, buffers, bufferSize, threads);
+ *              ReaderRequest request = {fileDescriptor, offset, buffer, context};
+ *              readerSubmit(pReader, &request);
+ *              size_t number = readerWait(pReader, completions, capacity);
+ *              readerDestroy(pReader);
+ */
+
+#ifndef FILE_READER_H
+#define FILE_READER_H
+
+
+/*----=  Includes  =-----*/
+
+
+#include <stddef.h>
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def READER_URING "uring"
+ * @brief A Macro that sets the name of the io_uring backend.
+ */
+#define READER_URING "uring"
+
+/**
+ * @def READER_PREAD "pread"
+ * @brief A Macro that sets the name of the backend of a pool of threads calling pread.
+ */
+#define READER_PREAD "pread"
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The buffers, and the reads in flight, of a set of files.
+ */
+typedef struct FileReader FileReader;
+
+/**
+ * @brief A read of a part of a file into a buffer of a Reader.
+ */
+typedef struct ReaderRequest
+{
+    /** The file to read. */
+    int fileDescriptor;
+    /** The offset in the file to read from. */
+    unsigned long long offset;
+    /** The index of the buffer to read into, which is filled up to its size if the file is
+     *  long enough. */
+    size_t buffer;
+    /** The context of the read, returned with its completion. */
+    void * context;
+} ReaderRequest;
+
+/**
+ * @brief The completion of a read.
+ */
+typedef struct ReaderCompletion
+{
+    /** The context of the read. */
+    void * context;
+    /** The index of the buffer read into. */
+    size_t buffer;
+    /** The number of bytes read, 0 at the end of the file, or a negative error number. */
+    long long result;
+} ReaderCompletion;
+
+
+/*----=  Reader  =-----*/
+
+
+/**
+ * @brief Creates a Reader of the given number of buffers.
+ * @param backend READER_URING, which falls back to READER_PREAD if the kernel does not support
+ *        io_uring, or READER_PREAD.
+ * @param buffersNumber The number of buffers, which is the maximal number of reads in flight.
+ * @param bufferSize The number of bytes of each buffer.
+ * @param threads The number of threads calling pread, if they are used.
+ * @return The new Reader, or NULL if the backend is not known or there is not enough memory.
+ */
+FileReader * readerCreate(char const * const backend, size_t const buffersNumber,
+                          size_t const bufferSize, size_t const threads);
+
+/**
+ * @brief Returns the name of the backend the given Reader actually uses.
+ * @param pReader The Reader.
+ * @return READER_URING or READER_PREAD.
+ */
+char const * readerBackend(FileReader const * const pReader);
+
+/**
+ * @brief Returns the buffer of the given index of the given Reader.
+ * @param pReader The Reader.
+ * @param buffer The index of the buffer, smaller than the number of buffers.
+ * @return The bytes of the buffer.
+ */
+unsigned char * readerBuffer(FileReader const * const pReader, size_t const buffer);
+
+/**
+ * @brief Submits a read to the given Reader. The read starts no later than the next wait.
+ * @param pReader The Reader.
+ * @param pRequest The read, its buffer must not be in flight.
+ */
+void readerSubmit(FileReader * const pReader, ReaderRequest const * const pRequest);
+
+/**
+ * @brief Waits for at least a single read of the given Reader to complete.
+ * @param pReader The Reader, which must have reads in flight.
+ * @param completions The array to store the completed reads in.
+ * @param capacity The number of completions the array holds.
+ * @return The number of completed reads stored.
+ */
+size_t readerWait(FileReader * const pReader, ReaderCompletion * const completions,
+                  size_t const capacity);
+
+/**
+ * @brief Releases the given Reader, which has no reads in flight.
+ * @param pReader The Reader to release, may be NULL.
+ */
+void readerDestroy(FileReader * const pReader);
+
+
+#endif
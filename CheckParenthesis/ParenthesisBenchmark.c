@@ -0,0 +1,1019 @@
+/**
+ * @file ParenthesisBenchmark.c
+ * @author Itai Tagar <itagar>
+ * @version 1.2
+ * @date 09 Aug 2016
+ *
+ * @brief A program that measures the performance of the Parenthesis Validator library.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A program that measures the performance of the Parenthesis Validator library.
+ * Input:       Options in the format of -
+ *              [--shape <wide|deep|random|early>] [--size <bytes>[K|M|G]] [--mode <mode>]
+ *              [--threads <number>] [--repeat <number>] [--fail-at <bytes>[K|M|G]] [--json]
+ *              [--output <filename>]
+ *              Without '--shape' and '--mode' every shape is measured in every mode.
+ * Process:     Generates a synthetic corpus of the requested shape and size:
+ *              wide    - many shallow pairs, such as "(a)[b]{c}<d>".
+ *              deep    - a single narrow nest, all the Opening-Parenthesis and then all the
+ *                        Closing-Parenthesis, so the stack grows to half of the size.
+ *              random  - random valid text with a bounded nesting depth.
+ *              early   - random text which breaks the structure at the '--fail-at' offset, a few
+ *                        KB by default, or at its start if the corpus is shorter.
+ *              The corpus is generated in parts and fed to a Validator part by part, so any size
+ *              fits in a bounded memory, and only the Validator is timed. Every measurement runs
+ *              in a child process, so its peak memory usage is its own, and the memory the child
+ *              holds before the Validator is created, such as the part, is not counted in it.
+ *              The modes are the scanners the CPU supports on a single thread, the widest scanner
+ *              on '--threads' threads, unless there is a single one, and the widest scanner
+ *              with the lexer.
+ *              With '--output' the corpus of a single shape is written to the File instead, so it
+ *              can be checked by CheckParenthesis.
+ * Output:      A CSV line per measurement, or a JSON object per measurement with '--json':
+ *              the shape, the size, the mode, the verdict, the bytes scanned until the verdict, the
+ *              latency to the verdict, the throughput and the peak resident memory of the
+ *              Validator in KB.
+ *              The latency and the throughput are the best of '--repeat' runs.
+ * Build:       gcc -std=c99 -O2 -pthread ParenthesisBenchmark.c ParenthesisValidator.c
+ *              -o ParenthesisBenchmark
+ */
+
+
+/*----=  Includes  =-----*/
+
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "ParenthesisValidator.h"
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def VALID_STATE 0
+ * @brief A Flag for valid state during the program run.
+ */
+#define VALID_STATE 0
+
+/**
+ * @def INVALID_STATE 1
+ * @brief A Flag for invalid state during the program run.
+ */
+#define INVALID_STATE 1
+
+/**
+ * @def INVALID_ARGUMENTS_MESSAGE "usage: ParenthesisBenchmark ..."
+ * @brief A Macro that sets the output message for invalid arguments.
+ */
+#define INVALID_ARGUMENTS_MESSAGE "usage: ParenthesisBenchmark " \
+                                  "[--shape <wide|deep|random|early>] " \
+                                  "[--size <bytes>[K|M|G]] [--mode <mode>] " \
+                                  "[--threads <number>] [--repeat <number>] " \
+                                  "[--fail-at <bytes>[K|M|G]] [--json] " \
+                                  "[--output <filename>]\n"
+
+/**
+ * @def OUTPUT_FAILED_MESSAGE "Error! Could not write the corpus to '%s'.\n"
+ * @brief A Macro that sets the output message for a corpus which could not be written.
+ */
+#define OUTPUT_FAILED_MESSAGE "Error! Could not write the corpus to '%s'.\n"
+
+/**
+ * @def MEASURE_FAILED_MESSAGE "Error! Could not measure the shape '%s' in the mode '%s'.\n"
+ * @brief A Macro that sets the output message for a measurement which could not be made.
+ */
+#define MEASURE_FAILED_MESSAGE "Error! Could not measure the shape '%s' in the mode '%s'.\n"
+
+/**
+ * @def FIRST_OPTION_INDEX 1
+ * @brief A Macro that sets the index of the first option in the arguments array.
+ */
+#define FIRST_OPTION_INDEX 1
+
+/**
+ * @def SHAPE_OPTION "--shape"
+ * @brief A Macro that sets the option which selects a single shape of corpus.
+ */
+#define SHAPE_OPTION "--shape"
+
+/**
+ * @def SIZE_OPTION "--size"
+ * @brief A Macro that sets the option which sets the number of bytes in the corpus.
+ */
+#define SIZE_OPTION "--size"
+
+/**
+ * @def MODE_OPTION "--mode"
+ * @brief A Macro that sets the option which selects a single mode of the Validator.
+ */
+#define MODE_OPTION "--mode"
+
+/**
+ * @def THREADS_OPTION "--threads"
+ * @brief A Macro that sets the option which sets the number of threads of the threaded mode.
+ */
+#define THREADS_OPTION "--threads"
+
+/**
+ * @def REPEAT_OPTION "--repeat"
+ * @brief A Macro that sets the option which sets the number of runs of every measurement.
+ */
+#define REPEAT_OPTION "--repeat"
+
+/**
+ * @def FAIL_AT_OPTION "--fail-at"
+ * @brief A Macro that sets the option which sets the offset of the violation in the early
+ *        failure corpus.
+ */
+#define FAIL_AT_OPTION "--fail-at"
+
+/**
+ * @def JSON_OPTION "--json"
+ * @brief A Macro that sets the option which prints the results as JSON objects.
+ */
+#define JSON_OPTION "--json"
+
+/**
+ * @def OUTPUT_OPTION "--output"
+ * @brief A Macro that sets the option which writes the corpus to a File instead of measuring.
+ */
+#define OUTPUT_OPTION "--output"
+
+/**
+ * @def THREADS_MODE "threads"
+ * @brief A Macro that sets the name of the mode which scans with the widest scanner on many
+ *        threads.
+ */
+#define THREADS_MODE "threads"
+
+/**
+ * @def LEXER_MODE "lexer"
+ * @brief A Macro that sets the name of the mode which scans with the widest scanner and skips
+ *        literals and comments.
+ */
+#define LEXER_MODE "lexer"
+
+/**
+ * @def DEFAULT_SIZE (64 << 20)
+ * @brief A Macro that sets the number of bytes in the corpus by default.
+ */
+#define DEFAULT_SIZE (64 << 20)
+
+/**
+ * @def DEFAULT_REPEAT 3
+ * @brief A Macro that sets the number of runs of every measurement by default.
+ */
+#define DEFAULT_REPEAT 3
+
+/**
+ * @def PART_SIZE (64 << 20)
+ * @brief A Macro that sets the number of bytes generated and fed to the Validator at once, large
+ *        enough for every thread of the threaded mode.
+ */
+#define PART_SIZE (64 << 20)
+
+/**
+ * @def DECIMAL_BASE 10
+ * @brief A Macro that sets the base of the numbers in the arguments.
+ */
+#define DECIMAL_BASE 10
+
+/**
+ * @def KILOBYTE 1024ULL
+ * @brief A Macro that sets the number of bytes in the 'K' size suffix, the 'M' and 'G' suffixes
+ *        are its powers.
+ */
+#define KILOBYTE 1024ULL
+
+/**
+ * @def GIGABYTE 1e9
+ * @brief A Macro that sets the number of bytes in a GB of the throughput.
+ */
+#define GIGABYTE 1e9
+
+/**
+ * @def NANOSECONDS_PER_SECOND 1e9
+ * @brief A Macro that sets the number of nanoseconds in a second.
+ */
+#define NANOSECONDS_PER_SECOND 1e9
+
+/**
+ * @def WIDE_PATTERN "(a)[b]{c}<d> "
+ * @brief A Macro that sets the text repeated in the wide corpus.
+ */
+#define WIDE_PATTERN "(a)[b]{c}<d> "
+
+/**
+ * @def FILLER_CHARACTER ' '
+ * @brief A Macro that sets the character which fills a corpus up to its size.
+ */
+#define FILLER_CHARACTER ' '
+
+/**
+ * @def PAIRS_NUMBER 4
+ * @brief A Macro that sets the number of Parenthesis pairs in VALIDATOR_DEFAULT_PAIRS, which
+ *        every corpus is made of.
+ */
+#define PAIRS_NUMBER 4
+
+/**
+ * @def RANDOM_MAX_DEPTH 64
+ * @brief A Macro that sets the maximal nesting depth of the random corpora.
+ */
+#define RANDOM_MAX_DEPTH 64
+
+/**
+ * @def EARLY_FAILURE_OFFSET 4096
+ * @brief A Macro that sets the offset of the violation in the early failure corpus by default.
+ */
+#define EARLY_FAILURE_OFFSET 4096
+
+/**
+ * @def RANDOM_SEED 0x9E3779B97F4A7C15ULL
+ * @brief A Macro that sets the seed of the random corpora, so every run measures the same text.
+ */
+#define RANDOM_SEED 0x9E3779B97F4A7C15ULL
+
+/**
+ * @def CSV_HEADER "shape,size,mode,verdict,bytes,first_verdict_seconds,..."
+ * @brief A Macro that sets the header line of the CSV output.
+ */
+#define CSV_HEADER "shape,size,mode,verdict,bytes,first_verdict_seconds,throughput_gbps," \
+                   "peak_rss_kb\n"
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The shapes of the synthetic corpora.
+ */
+typedef enum CorpusShape
+{
+    WIDE_SHAPE,
+    DEEP_SHAPE,
+    RANDOM_SHAPE,
+    EARLY_SHAPE,
+    SHAPES_NUMBER
+} CorpusShape;
+
+/**
+ * @brief The state of the generation of a single corpus, which is generated in parts.
+ */
+typedef struct CorpusGenerator
+{
+    /** The shape of the corpus. */
+    CorpusShape shape;
+    /** The number of bytes in the corpus. */
+    unsigned long long size;
+    /** The number of bytes generated so far. */
+    unsigned long long offset;
+    /** The offset of the violation in an early failure corpus. */
+    unsigned long long failureOffset;
+    /** The state of the random number generator. */
+    uint64_t random;
+    /** The number of currently opened Parenthesis in a random corpus. */
+    size_t depth;
+    /** The kinds of the currently opened Parenthesis in a random corpus. */
+    unsigned char kinds[RANDOM_MAX_DEPTH];
+} CorpusGenerator;
+
+/**
+ * @brief A way of running the Validator which is measured.
+ */
+typedef struct BenchmarkMode
+{
+    /** The name of the mode. */
+    char const * name;
+    /** The name of the scanner, or NULL for the widest scanner the CPU supports. */
+    char const * scanner;
+    /** The number of threads scanning every part. */
+    size_t threads;
+    /** Non zero if literals and comments are skipped. */
+    int lexical;
+} BenchmarkMode;
+
+/**
+ * @brief The result of measuring a single shape in a single mode.
+ */
+typedef struct BenchmarkResult
+{
+    /** The verdict of the Validator, or -1 if the measurement failed. */
+    int verdict;
+    /** The number of bytes scanned until the verdict, up to the first violation if any. */
+    unsigned long long bytes;
+    /** The best time from the creation of the Validator until its verdict, in seconds. */
+    double seconds;
+    /** The peak resident memory of the measurement above baseRss, in KB. */
+    long peakRss;
+    /** The resident memory once the part is allocated, before any Validator is created, in KB. */
+    long baseRss;
+} BenchmarkResult;
+
+/**
+ * @brief The options of the program, as given in the arguments.
+ */
+typedef struct BenchmarkOptions
+{
+    /** The name of the single shape to measure, or NULL for every shape. */
+    char const * shapeName;
+    /** The name of the single mode to measure, or NULL for every mode. */
+    char const * modeName;
+    /** The number of bytes in every corpus. */
+    unsigned long long size;
+    /** The number of threads of the threaded mode. */
+    size_t threads;
+    /** The number of runs of every measurement. */
+    int repeat;
+    /** The offset of the violation in the early failure corpus. */
+    unsigned long long failureOffset;
+    /** Non zero if the results are printed as JSON objects. */
+    int json;
+    /** The File to write the corpus to instead of measuring, or NULL. */
+    char const * outputName;
+} BenchmarkOptions;
+
+
+/*----=  Forward Declarations  =-----*/
+
+
+/**
+ * @brief Parse the given arguments into the given options.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param pOptions The path to store the parsed options in.
+ * @return 0 if the given arguments are valid, 1 otherwise.
+ */
+int parseArguments(int const argc, char * argv[], BenchmarkOptions * const pOptions);
+
+/**
+ * @brief Parse a size in bytes, optionally followed by a 'K', 'M' or 'G' suffix.
+ * @param value The size to parse.
+ * @param pSize The path to store the parsed size in.
+ * @return 0 if the size is valid, 1 otherwise.
+ */
+int parseSize(char const * const value, unsigned long long * const pSize);
+
+/**
+ * @brief Finds the shape with the given name.
+ * @param name The name of the shape.
+ * @return The shape, or SHAPES_NUMBER if there is no such shape.
+ */
+CorpusShape findShape(char const * const name);
+
+/**
+ * @brief Starts the generation of a corpus.
+ * @param pGenerator The generator to start.
+ * @param shape The shape of the corpus.
+ * @param size The number of bytes in the corpus.
+ * @param failureOffset The offset of the violation in an early failure corpus, the violation is
+ *        at the start of the corpus if the offset is beyond it.
+ */
+void startCorpus(CorpusGenerator * const pGenerator, CorpusShape const shape,
+                 unsigned long long const size, unsigned long long const failureOffset);
+
+/**
+ * @brief Generates the next part of a corpus.
+ * @param pGenerator The generator of the corpus.
+ * @param buffer The buffer to generate the part in.
+ * @param length The number of bytes in the buffer.
+ * @return The number of bytes generated, 0 once the corpus ends.
+ */
+size_t generateCorpus(CorpusGenerator * const pGenerator, unsigned char * const buffer,
+                      size_t const length);
+
+/**
+ * @brief Generates the next byte of a random corpus.
+ * @param pGenerator The generator of the corpus.
+ * @return The next byte.
+ */
+unsigned char generateRandomByte(CorpusGenerator * const pGenerator);
+
+/**
+ * @brief Writes the corpus of a single shape to the output File.
+ * @param pOptions The options of the program.
+ * @return 0 if the corpus was written, 1 otherwise.
+ */
+int writeCorpus(BenchmarkOptions const * const pOptions);
+
+/**
+ * @brief Measures every selected shape in every selected mode, and prints the results.
+ * @param pOptions The options of the program.
+ * @return 0 if every measurement was made, 1 otherwise.
+ */
+int runBenchmarks(BenchmarkOptions const * const pOptions);
+
+/**
+ * @brief Measures a single shape in a single mode in a child process.
+ * @param pOptions The options of the program.
+ * @param shape The shape of the corpus.
+ * @param pMode The mode of the Validator.
+ * @param pResult The path to store the result in.
+ */
+void measureInChild(BenchmarkOptions const * const pOptions, CorpusShape const shape,
+                    BenchmarkMode const * const pMode, BenchmarkResult * const pResult);
+
+/**
+ * @brief Measures a single shape in a single mode in this process.
+ * @param pOptions The options of the program.
+ * @param shape The shape of the corpus.
+ * @param pMode The mode of the Validator.
+ * @param pResult The path to store the result in.
+ */
+void measure(BenchmarkOptions const * const pOptions, CorpusShape const shape,
+             BenchmarkMode const * const pMode, BenchmarkResult * const pResult);
+
+/**
+ * @brief Returns the time of a monotonic clock.
+ * @return The time in seconds.
+ */
+double currentSeconds(void);
+
+/**
+ * @brief Prints the result of a single measurement.
+ * @param pOptions The options of the program.
+ * @param shape The shape of the corpus.
+ * @param pMode The mode of the Validator.
+ * @param pResult The result of the measurement.
+ */
+void printResult(BenchmarkOptions const * const pOptions, CorpusShape const shape,
+                 BenchmarkMode const * const pMode, BenchmarkResult const * const pResult);
+
+
+/*----=  Shapes  =-----*/
+
+
+/**
+ * @brief The names of the shapes, indexed by the shape.
+ */
+static char const * const SHAPE_NAMES[SHAPES_NUMBER] = {"wide", "deep", "random", "early"};
+
+
+/*----=  Main  =-----*/
+
+
+/**
+ * @brief The main function that runs the program.
+ *        It receives arguments from the user and if the arguments are valid, it either writes a
+ *        corpus or runs the measurements.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @return 0 if the program succeeded, 1 otherwise.
+ */
+int main(int argc, char * argv[])
+{
+    long const processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t const threads = (processors > 0) ? (size_t) processors : 1;
+    BenchmarkOptions options = {NULL, NULL, DEFAULT_SIZE, threads, DEFAULT_REPEAT,
+                                EARLY_FAILURE_OFFSET, 0, NULL};
+
+    // Check valid arguments.
+    if (parseArguments(argc, argv, &options))
+    {
+        fprintf(stderr, INVALID_ARGUMENTS_MESSAGE);
+        return INVALID_STATE;
+    }
+    else if (options.outputName != NULL)
+    {
+        return writeCorpus(&options);
+    }
+    return runBenchmarks(&options);
+}
+
+
+/*----=  Input Handling  =-----*/
+
+
+/**
+ * @brief Parse the given arguments into the given options.
+ * @param argc The number of given arguments.
+ * @param argv[] The arguments from the user.
+ * @param pOptions The path to store the parsed options in.
+ * @return 0 if the given arguments are valid, 1 otherwise.
+ */
+int parseArguments(int const argc, char * argv[], BenchmarkOptions * const pOptions)
+{
+    // Every option but '--json' takes a value.
+    int index = FIRST_OPTION_INDEX;
+    while (index < argc)
+    {
+        char const * const option = argv[index++];
+        if (strcmp(option, JSON_OPTION) == 0)
+        {
+            pOptions->json = 1;
+            continue;
+        }
+        if (index >= argc)
+        {
+            return INVALID_STATE;
+        }
+
+        char const * const value = argv[index++];
+        char * end = NULL;
+
+        if (strcmp(option, SHAPE_OPTION) == 0)
+        {
+            if (findShape(value) == SHAPES_NUMBER)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->shapeName = value;
+        }
+        else if (strcmp(option, SIZE_OPTION) == 0)
+        {
+            if (parseSize(value, &pOptions->size) || pOptions->size == 0)
+            {
+                return INVALID_STATE;
+            }
+        }
+        else if (strcmp(option, FAIL_AT_OPTION) == 0)
+        {
+            if (parseSize(value, &pOptions->failureOffset))
+            {
+                return INVALID_STATE;
+            }
+        }
+        else if (strcmp(option, MODE_OPTION) == 0)
+        {
+            pOptions->modeName = value;
+        }
+        else if (strcmp(option, THREADS_OPTION) == 0)
+        {
+            unsigned long threads = strtoul(value, &end, DECIMAL_BASE);
+            if (*value == '\0' || *value == '-' || *end != '\0' || threads == 0)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->threads = (size_t) threads;
+        }
+        else if (strcmp(option, REPEAT_OPTION) == 0)
+        {
+            long repeat = strtol(value, &end, DECIMAL_BASE);
+            if (*value == '\0' || *end != '\0' || repeat <= 0)
+            {
+                return INVALID_STATE;
+            }
+            pOptions->repeat = (int) repeat;
+        }
+        else if (strcmp(option, OUTPUT_OPTION) == 0)
+        {
+            pOptions->outputName = value;
+        }
+        else
+        {
+            return INVALID_STATE;
+        }
+    }
+
+    // A written corpus has a single shape.
+    if (pOptions->outputName != NULL && pOptions->shapeName == NULL)
+    {
+        return INVALID_STATE;
+    }
+    return VALID_STATE;
+}
+
+/**
+ * @brief Parse a size in bytes, optionally followed by a 'K', 'M' or 'G' suffix.
+ * @param value The size to parse.
+ * @param pSize The path to store the parsed size in.
+ * @return 0 if the size is valid, 1 otherwise.
+ */
+int parseSize(char const * const value, unsigned long long * const pSize)
+{
+    char * end = NULL;
+    unsigned long long size = strtoull(value, &end, DECIMAL_BASE);
+    if (*value == '\0' || *value == '-' || end == value)
+    {
+        return INVALID_STATE;
+    }
+
+    char const * const suffixes = "KMG";
+    if (*end != '\0')
+    {
+        char const * const suffix = strchr(suffixes, *end);
+        if (suffix == NULL || end[1] != '\0')
+        {
+            return INVALID_STATE;
+        }
+        for (char const * pSuffix = suffixes; pSuffix <= suffix; ++pSuffix)
+        {
+            size *= KILOBYTE;
+        }
+    }
+    *pSize = size;
+    return VALID_STATE;
+}
+
+/**
+ * @brief Finds the shape with the given name.
+ * @param name The name of the shape.
+ * @return The shape, or SHAPES_NUMBER if there is no such shape.
+ */
+CorpusShape findShape(char const * const name)
+{
+    for (int shape = 0; shape < SHAPES_NUMBER; ++shape)
+    {
+        if (strcmp(name, SHAPE_NAMES[shape]) == 0)
+        {
+            return (CorpusShape) shape;
+        }
+    }
+    return SHAPES_NUMBER;
+}
+
+
+/*----=  Corpus Generation  =-----*/
+
+
+/**
+ * @brief Starts the generation of a corpus.
+ * @param pGenerator The generator to start.
+ * @param shape The shape of the corpus.
+ * @param size The number of bytes in the corpus.
+ * @param failureOffset The offset of the violation in an early failure corpus, the violation is
+ *        at the start of the corpus if the offset is beyond it.
+ */
+void startCorpus(CorpusGenerator * const pGenerator, CorpusShape const shape,
+                 unsigned long long const size, unsigned long long const failureOffset)
+{
+    memset(pGenerator, 0, sizeof(CorpusGenerator));
+    pGenerator->shape = shape;
+    pGenerator->size = size;
+    pGenerator->random = RANDOM_SEED;
+    pGenerator->failureOffset = (failureOffset < size) ? failureOffset : 0;
+}
+
+/**
+ * @brief Generates the next part of a corpus.
+ * @param pGenerator The generator of the corpus.
+ * @param buffer The buffer to generate the part in.
+ * @param length The number of bytes in the buffer.
+ * @return The number of bytes generated, 0 once the corpus ends.
+ */
+size_t generateCorpus(CorpusGenerator * const pGenerator, unsigned char * const buffer,
+                      size_t const length)
+{
+    char const * const pairs = VALIDATOR_DEFAULT_PAIRS;
+    size_t const patternLength = strlen(WIDE_PATTERN);
+    unsigned long long const size = pGenerator->size;
+    unsigned long long const half = size / 2;
+
+    size_t generated = 0;
+    for ( ; generated < length && pGenerator->offset < size; ++generated, ++pGenerator->offset)
+    {
+        unsigned long long const offset = pGenerator->offset;
+        switch (pGenerator->shape)
+        {
+            case WIDE_SHAPE:
+                // A pattern which does not fit before the end is replaced by the filler.
+                buffer[generated] = (offset < size - size % patternLength) ?
+                                    (unsigned char) WIDE_PATTERN[offset % patternLength] :
+                                    FILLER_CHARACTER;
+                break;
+            case DEEP_SHAPE:
+                // The Closing-Parenthesis mirror the Opening-Parenthesis around the middle.
+                if (offset < half)
+                {
+                    buffer[generated] = (unsigned char) pairs[2 * (offset % PAIRS_NUMBER)];
+                }
+                else if (offset < 2 * half)
+                {
+                    buffer[generated] = (unsigned char) pairs[2 * ((2 * half - 1 - offset) %
+                                                                   PAIRS_NUMBER) + 1];
+                }
+                else
+                {
+                    buffer[generated] = FILLER_CHARACTER;
+                }
+                break;
+            default:
+                buffer[generated] = generateRandomByte(pGenerator);
+                break;
+        }
+    }
+    return generated;
+}
+
+/**
+ * @brief Generates the next byte of a random corpus.
+ * @param pGenerator The generator of the corpus.
+ * @return The next byte.
+ */
+unsigned char generateRandomByte(CorpusGenerator * const pGenerator)
+{
+    char const * const pairs = VALIDATOR_DEFAULT_PAIRS;
+    unsigned long long const remaining = pGenerator->size - pGenerator->offset;
+
+    // A xorshift generator, its high bits choose the byte.
+    pGenerator->random ^= pGenerator->random << 13;
+    pGenerator->random ^= pGenerator->random >> 7;
+    pGenerator->random ^= pGenerator->random << 17;
+    unsigned int const choice = (unsigned int) (pGenerator->random >> 32);
+
+    // The early failure corpus closes the wrong kind, or closes nothing, at a fixed offset.
+    if (pGenerator->shape == EARLY_SHAPE &&
+        pGenerator->offset == pGenerator->failureOffset)
+    {
+        size_t const kind = (pGenerator->depth > 0) ?
+                            (pGenerator->kinds[pGenerator->depth - 1] + 1) % PAIRS_NUMBER : 0;
+        return (unsigned char) pairs[2 * kind + 1];
+    }
+
+    // Every opened Parenthesis must be closed before the end.
+    int const mustClose = pGenerator->depth >= remaining;
+    int const mayOpen = pGenerator->depth < RANDOM_MAX_DEPTH && pGenerator->depth + 2 <= remaining;
+    if (mustClose || (pGenerator->depth > 0 && choice % 8 >= 6))
+    {
+        return (unsigned char) pairs[2 * pGenerator->kinds[--pGenerator->depth] + 1];
+    }
+    if (mayOpen && choice % 8 >= 3)
+    {
+        unsigned char const kind = (unsigned char) ((choice >> 8) % PAIRS_NUMBER);
+        pGenerator->kinds[pGenerator->depth++] = kind;
+        return (unsigned char) pairs[2 * kind];
+    }
+    return (unsigned char) ('a' + (choice >> 16) % 26);
+}
+
+/**
+ * @brief Writes the corpus of a single shape to the output File.
+ * @param pOptions The options of the program.
+ * @return 0 if the corpus was written, 1 otherwise.
+ */
+int writeCorpus(BenchmarkOptions const * const pOptions)
+{
+    unsigned char * const buffer = malloc(PART_SIZE);
+    FILE * const pFile = fopen(pOptions->outputName, "wb");
+    if (buffer == NULL || pFile == NULL)
+    {
+        free(buffer);
+        if (pFile != NULL)
+        {
+            fclose(pFile);
+        }
+        fprintf(stderr, OUTPUT_FAILED_MESSAGE, pOptions->outputName);
+        return INVALID_STATE;
+    }
+
+    CorpusGenerator generator;
+    startCorpus(&generator, findShape(pOptions->shapeName), pOptions->size,
+                pOptions->failureOffset);
+    int result = VALID_STATE;
+    size_t length;
+    while (result == VALID_STATE && (length = generateCorpus(&generator, buffer, PART_SIZE)) > 0)
+    {
+        if (fwrite(buffer, 1, length, pFile) != length)
+        {
+            result = INVALID_STATE;
+        }
+    }
+
+    if (fclose(pFile) != 0)
+    {
+        result = INVALID_STATE;
+    }
+    free(buffer);
+    if (result != VALID_STATE)
+    {
+        fprintf(stderr, OUTPUT_FAILED_MESSAGE, pOptions->outputName);
+    }
+    return result;
+}
+
+
+/*----=  Measurement  =-----*/
+
+
+/**
+ * @brief Measures every selected shape in every selected mode, and prints the results.
+ * @param pOptions The options of the program.
+ * @return 0 if every measurement was made, 1 otherwise.
+ */
+int runBenchmarks(BenchmarkOptions const * const pOptions)
+{
+    BenchmarkMode const modes[] = {
+        {VALIDATOR_SCALAR_SCANNER, VALIDATOR_SCALAR_SCANNER, 1, 0},
+        {VALIDATOR_SSE2_SCANNER, VALIDATOR_SSE2_SCANNER, 1, 0},
+        {VALIDATOR_AVX2_SCANNER, VALIDATOR_AVX2_SCANNER, 1, 0},
+        {THREADS_MODE, NULL, pOptions->threads, 0},
+        {LEXER_MODE, NULL, 1, 1}
+    };
+
+    if (!pOptions->json)
+    {
+        printf(CSV_HEADER);
+    }
+
+    int result = VALID_STATE;
+    for (int shape = 0; shape < SHAPES_NUMBER; ++shape)
+    {
+        if (pOptions->shapeName != NULL && findShape(pOptions->shapeName) != (CorpusShape) shape)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i)
+        {
+            BenchmarkMode const * const pMode = &modes[i];
+            if ((pOptions->modeName != NULL && strcmp(pOptions->modeName, pMode->name) != 0) ||
+                !validatorScannerSupported(pMode->scanner) ||
+                (strcmp(pMode->name, THREADS_MODE) == 0 && pMode->threads <= 1))
+            {
+                continue;
+            }
+
+            BenchmarkResult benchmarkResult;
+            measureInChild(pOptions, (CorpusShape) shape, pMode, &benchmarkResult);
+            if (benchmarkResult.verdict < 0)
+            {
+                fprintf(stderr, MEASURE_FAILED_MESSAGE, SHAPE_NAMES[shape], pMode->name);
+                result = INVALID_STATE;
+                continue;
+            }
+            printResult(pOptions, (CorpusShape) shape, pMode, &benchmarkResult);
+            fflush(stdout);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Measures a single shape in a single mode in a child process.
+ * @param pOptions The options of the program.
+ * @param shape The shape of the corpus.
+ * @param pMode The mode of the Validator.
+ * @param pResult The path to store the result in.
+ */
+void measureInChild(BenchmarkOptions const * const pOptions, CorpusShape const shape,
+                    BenchmarkMode const * const pMode, BenchmarkResult * const pResult)
+{
+    pResult->verdict = -1;
+    int pipeDescriptors[2];
+    if (pipe(pipeDescriptors) != 0)
+    {
+        return;
+    }
+
+    // The child measures and passes the result back, its peak memory usage is its own.
+    pid_t const child = fork();
+    if (child == 0)
+    {
+        close(pipeDescriptors[0]);
+        measure(pOptions, shape, pMode, pResult);
+        ssize_t const written = write(pipeDescriptors[1], pResult, sizeof(BenchmarkResult));
+        _exit(written == (ssize_t) sizeof(BenchmarkResult) ? VALID_STATE : INVALID_STATE);
+    }
+    close(pipeDescriptors[1]);
+    if (child < 0)
+    {
+        close(pipeDescriptors[0]);
+        return;
+    }
+
+    BenchmarkResult childResult;
+    ssize_t const bytesRead = read(pipeDescriptors[0], &childResult, sizeof(BenchmarkResult));
+    close(pipeDescriptors[0]);
+
+    int status;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) == child && WIFEXITED(status) &&
+        WEXITSTATUS(status) == VALID_STATE && bytesRead == (ssize_t) sizeof(BenchmarkResult))
+    {
+        *pResult = childResult;
+        pResult->peakRss = usage.ru_maxrss - childResult.baseRss;
+    }
+}
+
+/**
+ * @brief Measures a single shape in a single mode in this process.
+ * @param pOptions The options of the program.
+ * @param shape The shape of the corpus.
+ * @param pMode The mode of the Validator.
+ * @param pResult The path to store the result in.
+ */
+void measure(BenchmarkOptions const * const pOptions, CorpusShape const shape,
+             BenchmarkMode const * const pMode, BenchmarkResult * const pResult)
+{
+    pResult->verdict = -1;
+    unsigned char * const buffer = malloc(PART_SIZE);
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    // The part is made resident before the baseline, so only the Validator is left above it.
+    // It is filled with spaces, a fill of zeros after malloc may become a calloc which does not
+    // touch the memory.
+    struct rusage usage;
+    memset(buffer, ' ', PART_SIZE);
+    getrusage(RUSAGE_SELF, &usage);
+    pResult->baseRss = usage.ru_maxrss;
+
+    ValidatorOptions const validatorOptions = {VALIDATOR_UNLIMITED_DEPTH, pMode->scanner,
+                                               pMode->threads, 0, 0, NULL, pMode->lexical, NULL,
+                                               0, 0, 0};
+    for (int run = 0; run < pOptions->repeat; ++run)
+    {
+        // Only the Validator is timed, every part is generated before the clock runs.
+        CorpusGenerator generator;
+        startCorpus(&generator, shape, pOptions->size, pOptions->failureOffset);
+        double seconds = 0;
+        double start = currentSeconds();
+        ParenthesisValidator * const pValidator = validatorCreate(&validatorOptions);
+        seconds += currentSeconds() - start;
+        if (pValidator == NULL)
+        {
+            break;
+        }
+
+        int verdict = VALIDATOR_VALID;
+        unsigned long long bytes = 0;
+        size_t length;
+        while (verdict == VALIDATOR_VALID &&
+               (length = generateCorpus(&generator, buffer, PART_SIZE)) > 0)
+        {
+            start = currentSeconds();
+            verdict = validatorFeed(pValidator, buffer, length);
+            seconds += currentSeconds() - start;
+            bytes += length;
+        }
+        start = currentSeconds();
+        verdict = validatorFinish(pValidator);
+        seconds += currentSeconds() - start;
+
+        // A broken stream is scanned only up to its first violation.
+        ValidatorError error;
+        if (validatorError(pValidator, &error) != VALIDATOR_NO_ERROR &&
+            error.position.offset < bytes)
+        {
+            bytes = error.position.offset;
+        }
+        validatorDestroy(pValidator);
+
+        if (pResult->verdict < 0 || seconds < pResult->seconds)
+        {
+            pResult->verdict = verdict;
+            pResult->bytes = bytes;
+            pResult->seconds = seconds;
+        }
+    }
+    free(buffer);
+}
+
+/**
+ * @brief Returns the time of a monotonic clock.
+ * @return The time in seconds.
+ */
+double currentSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / NANOSECONDS_PER_SECOND;
+}
+
+
+/*----=  Output  =-----*/
+
+
+/**
+ * @brief Prints the result of a single measurement.
+ * @param pOptions The options of the program.
+ * @param shape The shape of the corpus.
+ * @param pMode The mode of the Validator.
+ * @param pResult The result of the measurement.
+ */
+void printResult(BenchmarkOptions const * const pOptions, CorpusShape const shape,
+                 BenchmarkMode const * const pMode, BenchmarkResult const * const pResult)
+{
+    char const * const verdicts[] = {"ok", "bad structure", "error"};
+    double const throughput = (pResult->seconds > 0) ?
+                              (double) pResult->bytes / pResult->seconds / GIGABYTE : 0;
+
+    if (pOptions->json)
+    {
+        printf("{\"shape\":\"%s\",\"size\":%llu,\"mode\":\"%s\",\"threads\":%zu,"
+               "\"verdict\":\"%s\",\"bytes\":%llu,\"first_verdict_seconds\":%.9f,"
+               "\"throughput_gbps\":%.3f,\"peak_rss_kb\":%ld}\n",
+               SHAPE_NAMES[shape], pOptions->size, pMode->name, pMode->threads,
+               verdicts[pResult->verdict], pResult->bytes, pResult->seconds, throughput,
+               pResult->peakRss);
+    }
+    else
+    {
+        printf("%s,%llu,%s,%s,%llu,%.9f,%.3f,%ld\n", SHAPE_NAMES[shape], pOptions->size,
+               pMode->name, verdicts[pResult->verdict], pResult->bytes, pResult->seconds,
+               throughput, pResult->peakRss);
+    }
+}
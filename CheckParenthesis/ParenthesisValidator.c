@@ -0,0 +1,3655 @@
+/**
+ * @file ParenthesisValidator.c
+ * @author Itai Tagar <itagar>
+ * @version 1.2
+ * @date 09 Aug 2016
+ *
+ * @brief A library that verify data satisfies a desired parenthesis structure.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A library that verify data satisfies a desired parenthesis structure.
+ * The Validator keeps the currently opened parenthesis in an explicit stack, so its memory usage
+ * is bounded by the actual nesting depth of the data.
+ * The parenthesis pairs form an alphabet, every byte is classified by a table of 256 entries
+ * which is built from the alphabet. A parenthesis of a few UTF-8 bytes is classified by its last
+ * byte, and its preceding bytes are compared only when the last byte is found.
+ * The parenthesis characters are located using the widest vector scanner the CPU supports, so
+ * only the parenthesis positions reach the stack. The default alphabets have scanners which are
+ * specialized for their characters at compile time, any other alphabet is scanned for the
+ * characters in its table.
+ * Optionally, a lexer skips the parenthesis inside literals and comments. Its bytes are located
+ * by the same vector scanners, escaped bytes are found with carried additions over the backslash
+ * positions, and the lexical state changes only at the located bytes, so the parenthesis between
+ * them are applied to the stack at once.
+ * The violation is recorded where it is found, so reporting it costs nothing while the data is
+ * valid. The positions of the opened parenthesis are kept only if they were requested, and lines
+ * are counted only for streams which are not available in whole once the violation is reported.
+ * Large parts of data may be split into chunks which are scanned on separate threads, each chunk
+ * is reduced to its unmatched parenthesis and the chunks are merged in order, which gives the
+ * same result as scanning the whole data.
+ * The depth profile is kept by the same Stacks: the depth of every Opening-Parenthesis is the
+ * size of the Stack once it is pushed, which a chunk knows only relative to its start. A chunk
+ * counts its depths relative to its start and the merge shifts them by the size of the Stack
+ * the chunk starts at, so every chunk is profiled on its own thread.
+ */
+
+
+/*----=  Includes  =-----*/
+
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "ParenthesisValidator.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+/**
+ * @def VECTOR_SCANNERS
+ * @brief A Flag which states that the SSE2 and AVX2 scanners are compiled in.
+ */
+#define VECTOR_SCANNERS
+#endif
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def MIN_CHUNK_SIZE (1 << 20)
+ * @brief A Macro that sets the minimal number of bytes scanned by a single thread.
+ */
+#define MIN_CHUNK_SIZE (1 << 20)
+
+/**
+ * @def CANCEL_CHECK_SIZE (1 << 18)
+ * @brief A Macro that sets the number of bytes a thread scans before it checks whether its chunk
+ *        still matters.
+ */
+#define CANCEL_CHECK_SIZE (1 << 18)
+
+/**
+ * @def INITIAL_SCOPE_NUMBER 0
+ * @brief A Macro that sets the initial scope number in a given stream of data.
+ */
+#define INITIAL_SCOPE_NUMBER 0
+
+/**
+ * @def INITIAL_STACK_CAPACITY 256
+ * @brief A Macro that sets the number of scopes the Parenthesis Stack holds before it grows.
+ */
+#define INITIAL_STACK_CAPACITY 256
+
+/**
+ * @def KIND_BITS 4
+ * @brief A Macro that sets the number of bits used for storing a single Parenthesis kind, enough
+ *        for VALIDATOR_MAX_PAIRS kinds.
+ */
+#define KIND_BITS 4
+
+/**
+ * @def KIND_MASK 15
+ * @brief A Macro that sets the mask which extracts a single Parenthesis kind.
+ */
+#define KIND_MASK 15
+
+/**
+ * @def KINDS_PER_BYTE 2
+ * @brief A Macro that sets the number of Parenthesis kinds packed in a single byte.
+ */
+#define KINDS_PER_BYTE 2
+
+/**
+ * @def NOT_PARENTHESIS -1
+ * @brief A Flag for a character which is not a Parenthesis of the required kind.
+ */
+#define NOT_PARENTHESIS -1
+
+/**
+ * @def BLOCK_SIZE 64
+ * @brief A Macro that sets the number of bytes a scanner classifies into a single mask.
+ */
+#define BLOCK_SIZE 64
+
+/**
+ * @def OPENING_CLASS 0x80
+ * @brief A Flag in the class of a byte which ends an Opening-Parenthesis.
+ */
+#define OPENING_CLASS 0x80
+
+/**
+ * @def CLOSING_CLASS 0x40
+ * @brief A Flag in the class of a byte which ends a Closing-Parenthesis.
+ */
+#define CLOSING_CLASS 0x40
+
+/**
+ * @def SEQUENCE_CLASS 0x20
+ * @brief A Flag in the class of a byte which ends a Parenthesis of a few bytes, the preceding
+ *        bytes must be compared as well.
+ */
+#define SEQUENCE_CLASS 0x20
+
+/**
+ * @def KIND_CLASS_MASK 0x0F
+ * @brief A Macro that sets the mask which extracts the Parenthesis kind from the class of a byte.
+ */
+#define KIND_CLASS_MASK 0x0F
+
+/**
+ * @def PREVIOUS_BYTES_NUMBER (VALIDATOR_MAX_PARENTHESIS_LENGTH - 1)
+ * @brief A Macro that sets the number of bytes kept from the previous part of the stream, so a
+ *        Parenthesis of a few bytes is found even if it is split between parts.
+ */
+#define PREVIOUS_BYTES_NUMBER (VALIDATOR_MAX_PARENTHESIS_LENGTH - 1)
+
+/**
+ * @def BRACES_PAIRS "()[]{}"
+ * @brief A Macro that sets the pairs of the alphabet without the Triangle Parenthesis, which are
+ *        comparison operators in most programming languages.
+ */
+#define BRACES_PAIRS "()[]{}"
+
+/**
+ * @def GENERIC_ALPHABET 0
+ * @brief A Flag for an alphabet which has no specialized scanners.
+ */
+#define GENERIC_ALPHABET 0
+
+/**
+ * @def DEFAULT_ALPHABET 1
+ * @brief A Flag for the alphabet of VALIDATOR_DEFAULT_PAIRS.
+ */
+#define DEFAULT_ALPHABET 1
+
+/**
+ * @def BRACES_ALPHABET 2
+ * @brief A Flag for the alphabet of BRACES_PAIRS.
+ */
+#define BRACES_ALPHABET 2
+
+/**
+ * @def LEXICAL_ALPHABET 3
+ * @brief A Flag for an alphabet which is scanned together with the lexical state.
+ */
+#define LEXICAL_ALPHABET 3
+
+/**
+ * @def CODE_STATE 0
+ * @brief A Flag for the lexical state outside of any literal or comment.
+ */
+#define CODE_STATE 0
+
+/**
+ * @def STRING_STATE 1
+ * @brief A Flag for the lexical state inside a string literal.
+ */
+#define STRING_STATE 1
+
+/**
+ * @def CHARACTER_STATE 2
+ * @brief A Flag for the lexical state inside a character literal.
+ */
+#define CHARACTER_STATE 2
+
+/**
+ * @def BLOCK_COMMENT_STATE 3
+ * @brief A Flag for the lexical state inside a block comment.
+ */
+#define BLOCK_COMMENT_STATE 3
+
+/**
+ * @def LINE_COMMENT_STATE 4
+ * @brief A Flag for the lexical state inside a line comment.
+ */
+#define LINE_COMMENT_STATE 4
+
+/**
+ * @def LEXICAL_STATES_NUMBER 5
+ * @brief A Macro that sets the number of lexical states.
+ */
+#define LEXICAL_STATES_NUMBER 5
+
+/**
+ * @def DOUBLE_QUOTE '"'
+ * @brief A Macro that sets the delimiter of string literals.
+ */
+#define DOUBLE_QUOTE '"'
+
+/**
+ * @def SINGLE_QUOTE '\''
+ * @brief A Macro that sets the delimiter of character literals.
+ */
+#define SINGLE_QUOTE '\''
+
+/**
+ * @def ESCAPE_CHARACTER '\\'
+ * @brief A Macro that sets the character which escapes the character after it.
+ */
+#define ESCAPE_CHARACTER '\\'
+
+/**
+ * @def NEW_LINE '\n'
+ * @brief A Macro that sets the character which ends line comments and unterminated literals.
+ */
+#define NEW_LINE '\n'
+
+/**
+ * @def BLOCK_COMMENT_START "/" "*"
+ * @brief A Macro that sets the delimiter which starts a block comment, a slash and an asterisk.
+ */
+#define BLOCK_COMMENT_START "/" "*"
+
+/**
+ * @def BLOCK_COMMENT_END "*" "/"
+ * @brief A Macro that sets the delimiter which ends a block comment, an asterisk and a slash.
+ */
+#define BLOCK_COMMENT_END "*" "/"
+
+/**
+ * @def LEXER_BYTES_CAPACITY 10
+ * @brief A Macro that sets the maximal number of bytes located for the lexer: the escape
+ *        character, the quotes, the new line, the bytes of the block comment delimiters and of
+ *        the prefix of line comments.
+ */
+#define LEXER_BYTES_CAPACITY 10
+
+/**
+ * @def LEXER_DELIMITERS_CAPACITY 4
+ * @brief A Macro that sets the maximal number of delimiters which may end a single lexical state.
+ */
+#define LEXER_DELIMITERS_CAPACITY 4
+
+/**
+ * @def ESCAPE_INDEX 0
+ * @brief A Macro that sets the index of the escape character among the bytes located for the
+ *        lexer.
+ */
+#define ESCAPE_INDEX 0
+
+/**
+ * @def ANY_INDEX LEXER_BYTES_CAPACITY
+ * @brief A Macro that sets the index of the mask of all the positions, which pads the delimiters
+ *        shorter than VALIDATOR_MAX_COMMENT_LENGTH.
+ */
+#define ANY_INDEX LEXER_BYTES_CAPACITY
+
+/**
+ * @def EVEN_BITS 0x5555555555555555ULL
+ * @brief A Macro that sets the mask of the even positions in a block.
+ */
+#define EVEN_BITS 0x5555555555555555ULL
+
+/**
+ * @def UTF8_CONTINUATION_MASK 0xC0
+ * @brief A Macro that sets the mask of the bits which identify a UTF-8 continuation byte.
+ */
+#define UTF8_CONTINUATION_MASK 0xC0
+
+/**
+ * @def UTF8_CONTINUATION 0x80
+ * @brief A Macro that sets the identifying bits of a UTF-8 continuation byte.
+ */
+#define UTF8_CONTINUATION 0x80
+
+/**
+ * @def UTF8_TWO_BYTES_LEAD 0xC0
+ * @brief A Macro that sets the first leading byte of a UTF-8 character of two bytes.
+ */
+#define UTF8_TWO_BYTES_LEAD 0xC0
+
+/**
+ * @def UTF8_THREE_BYTES_LEAD 0xE0
+ * @brief A Macro that sets the first leading byte of a UTF-8 character of three bytes.
+ */
+#define UTF8_THREE_BYTES_LEAD 0xE0
+
+/**
+ * @def UTF8_FOUR_BYTES_LEAD 0xF0
+ * @brief A Macro that sets the first leading byte of a UTF-8 character of four bytes.
+ */
+#define UTF8_FOUR_BYTES_LEAD 0xF0
+
+/**
+ * @def UTF8_INVALID_LEAD 0xF8
+ * @brief A Macro that sets the first byte which cannot lead a UTF-8 character.
+ */
+#define UTF8_INVALID_LEAD 0xF8
+
+/**
+ * @def NO_ENTRY SIZE_MAX
+ * @brief A Macro that sets the index of an entry of a pair index which stands for no entry.
+ */
+#define NO_ENTRY SIZE_MAX
+
+/**
+ * @def VARINT_BITS 7
+ * @brief A Macro that sets the number of bits of a number held by a single byte of a varint.
+ */
+#define VARINT_BITS 7
+
+/**
+ * @def VARINT_CONTINUATION 0x80
+ * @brief A Flag in a byte of a varint which is followed by another byte of the same varint.
+ */
+#define VARINT_CONTINUATION 0x80
+
+/**
+ * @def MAX_VARINT_LENGTH 10
+ * @brief A Macro that sets the maximal number of bytes of a varint of 64 bits.
+ */
+#define MAX_VARINT_LENGTH 10
+
+/**
+ * @def INDEX_ALIGNMENT 8
+ * @brief A Macro that sets the alignment of the table of a pair index.
+ */
+#define INDEX_ALIGNMENT 8
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The Parenthesis pairs the data is checked against.
+ *        The kind of a pair is its index in the pairs given to the Validator.
+ */
+typedef struct ParenthesisAlphabet
+{
+    /** The class of every byte, 0 for a byte which does not end a Parenthesis, otherwise the
+     *  class flags of the Parenthesis it ends and its kind. */
+    unsigned char classes[UCHAR_MAX + 1];
+    /** The number of pairs in the alphabet. */
+    size_t pairsNumber;
+    /** The Opening-Parenthesis of every kind, as UTF-8 strings. */
+    char openings[VALIDATOR_MAX_PAIRS][VALIDATOR_MAX_PARENTHESIS_LENGTH + 1];
+    /** The Closing-Parenthesis of every kind, as UTF-8 strings. */
+    char closings[VALIDATOR_MAX_PAIRS][VALIDATOR_MAX_PARENTHESIS_LENGTH + 1];
+    /** The bytes which end a Parenthesis, these are located by the vector scanners. */
+    unsigned char triggers[2 * VALIDATOR_MAX_PAIRS];
+    /** The number of bytes which end a Parenthesis. */
+    size_t triggersNumber;
+    /** Non zero if a pair of the alphabet opens and closes with the same character. */
+    int symmetric;
+    /** Non zero if the alphabet has neither Parenthesis of a few bytes nor Parenthesis which both
+     *  open and close. */
+    int plain;
+    /** The default alphabet this alphabet equals to, or GENERIC_ALPHABET. */
+    int specialization;
+} ParenthesisAlphabet;
+
+/**
+ * @brief The lexical state of a stream, which skips the Parenthesis inside literals and comments.
+ */
+typedef struct Lexer
+{
+    /** The index of every byte among the bytes located for the lexer plus 1, or 0 for a byte
+     *  which is not located. */
+    unsigned char indexes[UCHAR_MAX + 1];
+    /** The bytes located for the lexer, the escape character is at ESCAPE_INDEX. */
+    unsigned char bytes[LEXER_BYTES_CAPACITY];
+    /** The number of bytes located for the lexer. */
+    size_t bytesNumber;
+    /** The delimiters which may end every lexical state, each is the indexes of its bytes among
+     *  the bytes located for the lexer, from its last byte backwards, padded with ANY_INDEX. */
+    unsigned char delimiters[LEXICAL_STATES_NUMBER][LEXER_DELIMITERS_CAPACITY]
+                            [VALIDATOR_MAX_COMMENT_LENGTH];
+    /** The number of delimiters which may end every lexical state. */
+    size_t delimitersNumbers[LEXICAL_STATES_NUMBER];
+    /** The prefix of line comments, or an empty string for none. */
+    char lineComment[VALIDATOR_MAX_COMMENT_LENGTH + 1];
+    /** The current lexical state. */
+    int state;
+    /** The offset right after the byte which last changed the lexical state, a delimiter must
+     *  start at or after it. */
+    unsigned long long tokenEnd;
+    /** 1 if the first byte of the next block is escaped, 0 otherwise. */
+    uint64_t escapedCarry;
+} Lexer;
+
+/**
+ * @brief A growing array of counters indexed by depth.
+ */
+typedef struct DepthCounts
+{
+    /** The counters, those beyond 'number' are 0. */
+    unsigned long long * counts;
+    /** The number of counters allocated. */
+    size_t capacity;
+    /** The number of counters up to the last one which was counted. */
+    size_t number;
+} DepthCounts;
+
+/**
+ * @brief A pair of Parenthesis which encloses no other Parenthesis, its depth is relative to the
+ *        start of the chunk it was found in.
+ */
+typedef struct ProfileRegion
+{
+    /** The depth of the pair. */
+    long long depth;
+    /** The offset of the Opening-Parenthesis of the pair. */
+    unsigned long long opener;
+    /** The offset of the Closing-Parenthesis of the pair. */
+    unsigned long long closer;
+} ProfileRegion;
+
+/**
+ * @brief The depth profile of a stream, or of a chunk relative to its start. A chunk goes 0 or
+ *        below its start once it closes Parenthesis of previous chunks.
+ */
+typedef struct DepthProfile
+{
+    /** The number of Opening-Parenthesis which reached every depth from 1 upwards, index 0 for
+     *  depth 1. */
+    DepthCounts deeper;
+    /** The number of Opening-Parenthesis which reached every depth from 0 downwards, index 0
+     *  for depth 0. */
+    DepthCounts shallower;
+    /** The number of deepest regions kept. */
+    size_t regionsCapacity;
+    /** The number of deepest regions found so far. */
+    size_t regionsNumber;
+    /** The deepest regions found so far, sorted as in ValidatorProfile. */
+    ProfileRegion regions[VALIDATOR_MAX_REGIONS];
+    /** Non zero once any Parenthesis was applied. */
+    int applied;
+    /** Non zero if the last Parenthesis applied opened. */
+    int opened;
+    /** The offset of the last Opening-Parenthesis applied. */
+    unsigned long long lastOpener;
+    /** Non zero if the first Parenthesis applied closed. */
+    int closesFirst;
+    /** The offset of the first Parenthesis applied, if it closed. */
+    unsigned long long firstCloser;
+} DepthProfile;
+
+/**
+ * @brief A pair of Parenthesis of a pair index which is not encoded yet.
+ */
+typedef struct IndexEntry
+{
+    /** The offset of the Opening-Parenthesis of the pair. */
+    unsigned long long opener;
+    /** The offset of the Closing-Parenthesis of the pair once it is closed. While it is open,
+     *  the entry of the innermost open pair enclosing it, or NO_ENTRY. */
+    unsigned long long closer;
+    /** The kind of the pair. */
+    int kind;
+} IndexEntry;
+
+/**
+ * @brief The index of the pairs of a stream, or the pairs of a chunk which are left for the
+ *        merge. The open pairs are chained from the innermost one outwards, like the Stack.
+ */
+typedef struct PairIndex
+{
+    /** Non zero for the index of a stream, which encodes its entries once none is open. */
+    int encodes;
+    /** The pairs which are not encoded yet, in the order of their Opening-Parenthesis. */
+    IndexEntry * entries;
+    /** The number of entries allocated. */
+    size_t entriesCapacity;
+    /** The number of entries. */
+    size_t entriesNumber;
+    /** The entry of the innermost open pair, or NO_ENTRY. */
+    size_t innermost;
+    /** The encoded pairs. */
+    unsigned char * bytes;
+    /** The number of bytes allocated. */
+    size_t bytesCapacity;
+    /** The number of bytes of the encoded pairs. */
+    size_t bytesLength;
+    /** The offset in 'bytes' of every block of encoded pairs. */
+    uint64_t * blocks;
+    /** The number of blocks allocated. */
+    size_t blocksCapacity;
+    /** The number of encoded pairs. */
+    unsigned long long pairsNumber;
+    /** The offset of the Opening-Parenthesis of the last encoded pair. */
+    unsigned long long lastOpener;
+} PairIndex;
+
+/**
+ * @brief A Stack of the currently opened Parenthesis.
+ *        Each opened Parenthesis is stored as its kind, using KIND_BITS bits, so the Stack
+ *        consumes half a byte per nesting level and grows only as deep as the data is.
+ */
+typedef struct ParenthesisStack
+{
+    /** The packed kinds of the opened Parenthesis, the top of the Stack is at index 'size - 1'. */
+    unsigned char * kinds;
+    /** The number of opened Parenthesis in the Stack. */
+    size_t size;
+    /** The number of Parenthesis the Stack can hold before it needs to grow. */
+    size_t capacity;
+    /** The maximal number of opened Parenthesis allowed, or VALIDATOR_UNLIMITED_DEPTH. */
+    size_t maxDepth;
+    /** The alphabet of the Parenthesis. */
+    ParenthesisAlphabet const * pAlphabet;
+    /** The lexical state of the stream, or NULL if literals and comments are not skipped. */
+    Lexer * pLexer;
+    /** The Stack which collects the Closing-Parenthesis that close nothing in this Stack, or
+     *  NULL if such Closing-Parenthesis break the structure. */
+    struct ParenthesisStack * pUnmatched;
+    /** Non zero if the position of every Parenthesis in the Stack is kept. */
+    int tracksPositions;
+    /** The positions of the Parenthesis in the Stack, if they are kept. A position which has no
+     *  line yet has VALIDATOR_UNKNOWN_LINE. */
+    ValidatorPosition * positions;
+    /** The data currently applied to the Stack. */
+    unsigned char const * base;
+    /** The offset of 'base' in the stream. */
+    unsigned long long baseOffset;
+    /** The bytes of the stream right before 'base', the last one is the closest, or 0 if there
+     *  are none. */
+    unsigned char previous[PREVIOUS_BYTES_NUMBER];
+    /** The violation which broke the structure. */
+    ValidatorError error;
+    /** The depth profile of the Parenthesis applied to the Stack, or NULL if it is not kept. */
+    DepthProfile * pProfile;
+    /** The index of the pairs applied to the Stack, or NULL if it is not built. */
+    PairIndex * pIndex;
+#ifdef VALIDATOR_STATISTICS
+    /** The number of Parenthesis applied to the Stack. */
+    unsigned long long parenthesisNumber;
+    /** The maximal number of opened Parenthesis, beyond those closed by 'pUnmatched'. */
+    size_t deepest;
+#endif
+} ParenthesisStack;
+
+/**
+ * @brief A scanner which checks a part of the data, it locates the Parenthesis in the given data
+ *        and applies them to the given Stack.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param data The data to check.
+ * @param length The number of bytes in the data.
+ * @return 0 if the data does not break the required parenthesis structure, 1 if it does and
+ *         2 if the Stack exceeds its depth limit or the memory.
+ */
+typedef int (* ScanFunction)(ParenthesisStack * const pStack, unsigned char const * const data,
+                             size_t const length);
+
+/**
+ * @brief The summary of a single chunk of data which is scanned on its own thread.
+ *        A chunk is summarized by the Closing-Parenthesis at its start which close Parenthesis
+ *        of previous chunks, and by the Opening-Parenthesis at its end which are left for the
+ *        next chunks to close.
+ */
+typedef struct ChunkSummary
+{
+    /** The thread which scans the chunk. */
+    pthread_t thread;
+    /** The scanner used for locating the Parenthesis in the chunk. */
+    ScanFunction scanner;
+    /** The data of the chunk. */
+    unsigned char const * data;
+    /** The number of bytes in the chunk. */
+    size_t length;
+    /** The offset of the chunk in the stream. */
+    unsigned long long offset;
+    /** The index of the chunk in its part of data. */
+    size_t index;
+    /** The index of the first chunk known to break the structure, shared by all the chunks of
+     *  the part. The chunks after it do not matter and stop scanning. */
+    size_t * pFailedChunk;
+    /** The unmatched Closing-Parenthesis, in the order they appear in the chunk. */
+    ParenthesisStack closers;
+    /** The unmatched Opening-Parenthesis, the last one is at the top of the Stack. */
+    ParenthesisStack openers;
+    /** The depth profile of the chunk, if the stream is profiled. */
+    DepthProfile profile;
+    /** The pairs of the chunk, if the stream is indexed. */
+    PairIndex pairs;
+    /** The result of scanning the chunk. */
+    int result;
+} ChunkSummary;
+
+/**
+ * @brief The state of the validation of a single stream of data.
+ */
+struct ParenthesisValidator
+{
+    /** The alphabet of the Parenthesis. */
+    ParenthesisAlphabet alphabet;
+    /** The lexical state of the stream, used only if literals and comments are skipped. */
+    Lexer lexer;
+    /** The Stack of the currently opened Parenthesis. */
+    ParenthesisStack stack;
+    /** The depth profile of the stream, used only if it is requested. */
+    DepthProfile profile;
+    /** The index of the pairs of the stream, used only if it is requested. */
+    PairIndex index;
+    /** The scanner used for locating the Parenthesis. */
+    ScanFunction scanner;
+    /** The number of threads scanning large parts of data. */
+    size_t threads;
+    /** The result of the data fed so far, once it is not valid it does not change. */
+    int result;
+    /** The number of bytes fed so far. */
+    unsigned long long streamLength;
+    /** Non zero if the lines of every fed part are counted. */
+    int countsLines;
+    /** The line at the end of the data fed so far. */
+    unsigned long long line;
+    /** The offset of the first byte of that line. */
+    unsigned long long lineStart;
+};
+
+/**
+ * @brief A cursor which counts the lines of a part of the stream up to a given offset.
+ */
+typedef struct LineCursor
+{
+    /** The line of the cursor. */
+    unsigned long long line;
+    /** The offset of the first byte of the cursor's line. */
+    unsigned long long lineStart;
+    /** The offset of the cursor. */
+    unsigned long long offset;
+} LineCursor;
+
+
+/*----=  Forward Declarations  =-----*/
+
+
+/**
+ * @brief Builds the alphabet of the given pairs.
+ * @param pAlphabet The alphabet to build.
+ * @param pairs The Parenthesis pairs, or NULL for VALIDATOR_DEFAULT_PAIRS.
+ * @return 0 if the pairs form a valid alphabet, 1 otherwise.
+ */
+static int buildAlphabet(ParenthesisAlphabet * const pAlphabet, char const * pairs);
+
+/**
+ * @brief Adds a single Parenthesis to the table of the given alphabet.
+ * @param pAlphabet The alphabet to add to.
+ * @param parenthesis The Parenthesis, as a UTF-8 string.
+ * @param byteClass The class flags and the kind of the Parenthesis.
+ * @return 0 if the Parenthesis was added, 1 if its last byte already ends another Parenthesis.
+ */
+static int addParenthesis(ParenthesisAlphabet * const pAlphabet, char const * const parenthesis,
+                          int byteClass);
+
+/**
+ * @brief Determines the number of bytes of the UTF-8 character at the given string.
+ * @param character The character.
+ * @return The number of bytes of the character, or 0 if it is not a valid UTF-8 character.
+ */
+static size_t characterLength(unsigned char const * const character);
+
+/**
+ * @brief Builds the lexical state which skips literals and comments.
+ * @param pLexer The lexical state to build.
+ * @param pAlphabet The alphabet of the Parenthesis, none of them may end with a lexical byte.
+ * @param lineComment The prefix of line comments, or NULL for none.
+ * @return 0 if the lexical state was built, 1 otherwise.
+ */
+static int buildLexer(Lexer * const pLexer, ParenthesisAlphabet const * const pAlphabet,
+                      char const * lineComment);
+
+/**
+ * @brief Adds the given delimiter to the given lexical state, and locates its bytes.
+ * @param pLexer The lexical state to add to.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param delimiter The delimiter, an empty one is ignored.
+ * @param states The lexical states the delimiter may end, a bit per state.
+ * @return 0 if the delimiter was added, 1 if a Parenthesis ends with one of its bytes.
+ */
+static int addDelimiter(Lexer * const pLexer, ParenthesisAlphabet const * const pAlphabet,
+                        char const * const delimiter, int const states);
+
+/**
+ * @brief Locates the given byte for the given lexical state, unless it is already located.
+ * @param pLexer The lexical state to add to.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param byte The byte.
+ * @return 0 if the byte was added, 1 if a Parenthesis ends with it.
+ */
+static int addLexicalByte(Lexer * const pLexer, ParenthesisAlphabet const * const pAlphabet,
+                          unsigned char const byte);
+
+/**
+ * @brief Appends the end of the given data to the given bytes of the stream.
+ * @param previous The last bytes of the stream, the last one is the closest.
+ * @param data The data which follows these bytes in the stream.
+ * @param length The number of bytes in the data.
+ */
+static void rememberBytes(unsigned char previous[PREVIOUS_BYTES_NUMBER],
+                          unsigned char const * const data, size_t const length);
+
+/**
+ * @brief Counts the lines of the given part of the stream, and sets the lines and columns of the
+ *        positions which belong to it.
+ * @param pValidator The Validator of the stream.
+ * @param data The part of the stream which was just fed.
+ * @param length The number of bytes in the data.
+ */
+static void countLines(ParenthesisValidator * const pValidator,
+                       unsigned char const * const data, size_t const length);
+
+/**
+ * @brief Moves the given cursor forward to the given offset, counting the lines on the way.
+ * @param pCursor The cursor to move.
+ * @param data The part of the stream the cursor is in.
+ * @param dataOffset The offset of the data in the stream.
+ * @param offset The offset to move to, it must be within the data.
+ */
+static void moveCursor(LineCursor * const pCursor, unsigned char const * const data,
+                       unsigned long long const dataOffset, unsigned long long const offset);
+
+/**
+ * @brief Sets the line and column of the given position to those of the given cursor, after
+ *        moving the cursor to the position's offset.
+ * @param pCursor The cursor.
+ * @param data The part of the stream the position is in.
+ * @param dataOffset The offset of the data in the stream.
+ * @param pPosition The position to set.
+ */
+static void locatePosition(LineCursor * const pCursor, unsigned char const * const data,
+                           unsigned long long const dataOffset,
+                           ValidatorPosition * const pPosition);
+
+/**
+ * @brief Feeds the given part of data to the given Validator, splitting it into chunks which are
+ *        scanned in parallel if the Validator has more than a single thread.
+ * @param pValidator The Validator of the stream.
+ * @param data The part of data to check.
+ * @param length The number of bytes in the data.
+ * @return 0 if the given data does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the data could not be analyzed within the nesting depth limit or the memory.
+ */
+static int feedChunks(ParenthesisValidator * const pValidator, unsigned char const * const data,
+                      size_t const length);
+
+/**
+ * @brief Scans a single chunk of data into its summary, this is the routine of the threads
+ *        of 'feedChunks'.
+ * @param pChunk The summary of the chunk to scan.
+ * @return NULL.
+ */
+static void * scanChunk(void * pChunk);
+
+/**
+ * @brief Marks the chunk with the given index as breaking the structure, unless an earlier
+ *        chunk already does, so the chunks after it stop scanning.
+ * @param pFailedChunk The index of the first chunk known to break the structure.
+ * @param index The index of the chunk.
+ */
+static void failChunk(size_t * const pFailedChunk, size_t const index);
+
+/**
+ * @brief Merges the summary of the next chunk of data into the given Stack: the unmatched
+ *        Closing-Parenthesis of the chunk close the top of the Stack, and the unmatched
+ *        Opening-Parenthesis of the chunk are pushed to it.
+ * @param pStack The Stack of the Opening-Parenthesis left open by all the previous chunks.
+ * @param pChunk The summary of the next chunk.
+ * @return 0 if the chunk does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the Stack exceeds its depth limit or the memory.
+ */
+static int mergeChunkSummary(ParenthesisStack * const pStack,
+                             ChunkSummary const * const pChunk);
+
+/**
+ * @brief Checks the given part of data using the given scanner.
+ *        This function keeps each opened parenthesis in the given Stack and removes it when
+ *        the matching closing parenthesis is reached.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param scanner The scanner used for locating the Parenthesis.
+ * @param data The part of the data to check.
+ * @param length The number of bytes in the data.
+ * @param offset The offset of the data in the stream.
+ * @return 0 if the given data does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the data could not be analyzed within the nesting depth limit or the memory.
+ */
+static int checkFileHelper(ParenthesisStack * const pStack, ScanFunction const scanner,
+                           unsigned char const * const data, size_t const length,
+                           unsigned long long const offset);
+
+/**
+ * @brief Returns the Parenthesis which ends with the given byte.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param byteClass The class of the byte.
+ * @return The Parenthesis, as a UTF-8 string.
+ */
+static char const * classParenthesis(ParenthesisAlphabet const * const pAlphabet,
+                                     int const byteClass);
+
+/**
+ * @brief Checks if the given byte, which ends a sequence of a few bytes, is preceded by the rest
+ *        of the sequence.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ * @param sequence The sequence, a Parenthesis or a lexical delimiter.
+ * @return 1 if the whole sequence is found, 0 otherwise.
+ */
+static int matchesSequence(ParenthesisStack const * const pStack,
+                           unsigned char const * const pCharacter, char const * const sequence);
+
+/**
+ * @brief Computes the offset in the stream of the Parenthesis which ends with the given byte of
+ *        the data applied to the given Stack.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ * @param byteClass The class of the byte.
+ * @return The offset of the first byte of the Parenthesis in the stream.
+ */
+static unsigned long long parenthesisOffset(ParenthesisStack const * const pStack,
+                                            unsigned char const * const pCharacter,
+                                            int const byteClass);
+
+/**
+ * @brief Checks if the given byte ends the given lexical delimiter, which starts after the byte
+ *        which last changed the lexical state.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ * @param delimiter The delimiter.
+ * @return 1 if the byte ends the delimiter, 0 otherwise.
+ */
+static int endsDelimiter(ParenthesisStack const * const pStack,
+                         unsigned char const * const pCharacter, char const * const delimiter);
+
+/**
+ * @brief Applies the given byte, which may change the lexical state, to the lexical state of the
+ *        given Stack.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ */
+static void lexCharacter(ParenthesisStack * const pStack, unsigned char const * const pCharacter);
+
+/**
+ * @brief Records a violation of the required parenthesis structure in the given Stack.
+ * @param pStack The Stack which is broken.
+ * @param offset The offset of the breaking Closing-Parenthesis in the stream.
+ * @param closedKind The kind of the breaking Closing-Parenthesis.
+ * @param openedKind The kind of the Opening-Parenthesis it failed to close, which was just popped
+ *        from the Stack, or NOT_PARENTHESIS if there was none.
+ * @return 1.
+ */
+static int breakStructure(ParenthesisStack * const pStack, unsigned long long const offset,
+                          int const closedKind, int const openedKind);
+
+/**
+ * @brief Selects a scanner by its name.
+ * @param name The name of the scanner, or NULL for the widest scanner the CPU supports.
+ * @param pAlphabet The alphabet the scanner locates, or NULL for any alphabet.
+ * @return The selected scanner, or NULL if the scanner is unknown or unsupported by the CPU.
+ */
+static ScanFunction selectScanner(char const * const name,
+                                  ParenthesisAlphabet const * const pAlphabet);
+
+/**
+ * @brief A scanner which classifies the data byte by byte.
+ */
+static int scanScalar(ParenthesisStack * const pStack, unsigned char const * const data,
+                      size_t const length);
+
+/**
+ * @brief A scanner which classifies the data byte by byte, skipping literals and comments.
+ */
+static int scanLexicalScalar(ParenthesisStack * const pStack, unsigned char const * const data,
+                             size_t const length);
+
+#ifdef VECTOR_SCANNERS
+
+/**
+ * @brief A scanner which classifies the data 16 bytes at a time using SSE2 instructions.
+ */
+static int scanSse2(ParenthesisStack * const pStack, unsigned char const * const data,
+                    size_t const length);
+
+/**
+ * @brief A scanner of the default alphabet which classifies the data 16 bytes at a time using
+ *        SSE2 instructions.
+ */
+static int scanSse2Default(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length);
+
+/**
+ * @brief A scanner of the braces alphabet which classifies the data 16 bytes at a time using
+ *        SSE2 instructions.
+ */
+static int scanSse2Braces(ParenthesisStack * const pStack, unsigned char const * const data,
+                          size_t const length);
+
+/**
+ * @brief A scanner which classifies the data 16 bytes at a time using SSE2 instructions,
+ *        skipping literals and comments.
+ */
+static int scanLexicalSse2(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length);
+
+/**
+ * @brief A scanner which classifies the data 32 bytes at a time using AVX2 instructions.
+ */
+static int scanAvx2(ParenthesisStack * const pStack, unsigned char const * const data,
+                    size_t const length);
+
+/**
+ * @brief A scanner of the default alphabet which classifies the data 32 bytes at a time using
+ *        AVX2 instructions.
+ */
+static int scanAvx2Default(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length);
+
+/**
+ * @brief A scanner of the braces alphabet which classifies the data 32 bytes at a time using
+ *        AVX2 instructions.
+ */
+static int scanAvx2Braces(ParenthesisStack * const pStack, unsigned char const * const data,
+                          size_t const length);
+
+/**
+ * @brief A scanner which classifies the data 32 bytes at a time using AVX2 instructions,
+ *        skipping literals and comments.
+ */
+static int scanLexicalAvx2(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length);
+
+#endif
+
+/**
+ * @brief Push an Opening-Parenthesis kind to the top of the given Stack, the Stack grows if
+ *        it is full.
+ * @param pStack The Stack to push to.
+ * @param kind The kind of the opened Parenthesis.
+ * @return 0 if the kind was pushed, 2 if the Stack exceeds its depth limit or the memory.
+ */
+static int pushParenthesis(ParenthesisStack * const pStack, int const kind);
+
+/**
+ * @brief Remove the Opening-Parenthesis kind at the top of the given Stack.
+ * @param pStack The Stack to pop from, it must not be empty.
+ * @return The kind of the removed Parenthesis.
+ */
+static int popParenthesis(ParenthesisStack * const pStack);
+
+/**
+ * @brief Returns the Opening-Parenthesis kind at the given index of the given Stack.
+ * @param pStack The Stack to read from.
+ * @param index The index to read, it must be smaller than the size of the Stack.
+ * @return The kind of the Parenthesis.
+ */
+static int parenthesisAt(ParenthesisStack const * const pStack, size_t const index);
+
+/**
+ * @brief Sets the position of the Parenthesis at the top of the given Stack, which keeps
+ *        positions. The line of the position is not known yet.
+ * @param pStack The Stack to set.
+ * @param offset The offset of the Parenthesis in the stream.
+ */
+static void setTopPosition(ParenthesisStack * const pStack, unsigned long long const offset);
+
+/**
+ * @brief Records the Opening-Parenthesis just pushed to the given Stack in its profile and its
+ *        index, those which are kept.
+ * @param pStack The Stack.
+ * @param offset The offset of the Parenthesis in the stream.
+ * @param kind The kind of the Parenthesis.
+ * @return 0 if the Parenthesis was recorded, 2 if there is not enough memory.
+ */
+static int annotateOpener(ParenthesisStack * const pStack, unsigned long long const offset,
+                          int const kind);
+
+/**
+ * @brief Records the Closing-Parenthesis which just closed the top of the given Stack in its
+ *        profile and its index, those which are kept.
+ * @param pStack The Stack, after the pair was popped.
+ * @param offset The offset of the Parenthesis in the stream.
+ * @return 0 if the Parenthesis was recorded, 2 if there is not enough memory.
+ */
+static int annotateCloser(ParenthesisStack * const pStack, unsigned long long const offset);
+
+/**
+ * @brief Adds the given count to the counter of the given index, the counters grow if needed.
+ * @param pCounts The counters.
+ * @param index The index of the counter.
+ * @param count The count to add.
+ * @return 0 if the count was added, 2 if there is not enough memory.
+ */
+static int countDepths(DepthCounts * const pCounts, size_t const index,
+                       unsigned long long const count);
+
+/**
+ * @brief Profiles the Opening-Parenthesis just pushed to the given Stack, which keeps a profile.
+ * @param pStack The Stack.
+ * @param offset The offset of the Parenthesis in the stream.
+ * @return 0 if the Parenthesis was profiled, 2 if there is not enough memory.
+ */
+static int profileOpener(ParenthesisStack * const pStack, unsigned long long const offset);
+
+/**
+ * @brief Profiles the Closing-Parenthesis just applied to the given Stack, which keeps a
+ *        profile. If it closed the last Opening-Parenthesis applied, their pair is a region.
+ * @param pStack The Stack, after the pair was popped.
+ * @param offset The offset of the Parenthesis in the stream.
+ */
+static void profileCloser(ParenthesisStack * const pStack, unsigned long long const offset);
+
+/**
+ * @brief Keeps the given region in the given profile, if it is among its deepest regions.
+ * @param pProfile The profile.
+ * @param depth The depth of the region.
+ * @param opener The offset of the Opening-Parenthesis of the region.
+ * @param closer The offset of the Closing-Parenthesis of the region.
+ */
+static void keepRegion(DepthProfile * const pProfile, long long const depth,
+                       unsigned long long const opener, unsigned long long const closer);
+
+/**
+ * @brief Merges the profile of the next chunk of data into the given profile.
+ * @param pProfile The profile of all the previous chunks.
+ * @param pChunk The profile of the next chunk, relative to its start.
+ * @param base The depth the chunk starts at.
+ * @return 0 if the profile was merged, 2 if there is not enough memory.
+ */
+static int mergeChunkProfile(DepthProfile * const pProfile, DepthProfile const * const pChunk,
+                             size_t const base);
+
+/**
+ * @brief Clears the given profile, keeping its memory.
+ * @param pProfile The profile to clear.
+ */
+static void clearProfile(DepthProfile * const pProfile);
+
+/**
+ * @brief Releases the memory of the given profile.
+ * @param pProfile The profile to release.
+ */
+static void releaseProfile(DepthProfile * const pProfile);
+
+/**
+ * @brief Grows the given array to hold at least the given number of elements, doubling its
+ *        capacity.
+ * @param pArray The path of the array.
+ * @param pCapacity The path of the number of elements allocated.
+ * @param number The number of elements needed.
+ * @param elementSize The number of bytes of an element.
+ * @return 0 if the array holds the elements, 2 if there is not enough memory.
+ */
+static int growArray(void ** const pArray, size_t * const pCapacity, size_t const number,
+                     size_t const elementSize);
+
+/**
+ * @brief Adds an open pair to the given index, inside its innermost open pair.
+ * @param pIndex The index.
+ * @param opener The offset of the Opening-Parenthesis of the pair.
+ * @param kind The kind of the pair.
+ * @return 0 if the pair was added, 2 if there is not enough memory.
+ */
+static int openPair(PairIndex * const pIndex, unsigned long long const opener, int const kind);
+
+/**
+ * @brief Closes the innermost open pair of the given index. The index of a stream encodes its
+ *        pairs once none is open.
+ * @param pIndex The index, which has an open pair.
+ * @param closer The offset of the Closing-Parenthesis of the pair.
+ * @return 0 if the pair was closed, 2 if there is not enough memory.
+ */
+static int closePair(PairIndex * const pIndex, unsigned long long const closer);
+
+/**
+ * @brief Encodes all the entries of the given index, none of which is open.
+ * @param pIndex The index.
+ * @return 0 if the entries were encoded, 2 if there is not enough memory.
+ */
+static int encodePairs(PairIndex * const pIndex);
+
+/**
+ * @brief Writes the given number as an unsigned LEB128 varint.
+ * @param bytes The address to write to, with room for MAX_VARINT_LENGTH bytes.
+ * @param value The number.
+ * @return The number of bytes written.
+ */
+static size_t writeVarint(unsigned char * const bytes, unsigned long long value);
+
+/**
+ * @brief Reads an unsigned LEB128 varint.
+ * @param pBytes The path of the address to read from, which is advanced past the varint.
+ * @param end The address right after the last byte which may be read.
+ * @param pValue The path to store the number in.
+ * @return 0 if the varint was read, 1 if it does not end before 'end' or exceeds 64 bits.
+ */
+static int readVarint(unsigned char const ** const pBytes, unsigned char const * const end,
+                      unsigned long long * const pValue);
+
+/**
+ * @brief Merges the pairs of the next chunk of data into the given index, after the
+ *        Closing-Parenthesis at the start of the chunk closed the pairs of the previous chunks.
+ * @param pIndex The index of all the previous chunks.
+ * @param pChunk The pairs of the next chunk.
+ * @return 0 if the pairs were merged, 2 if there is not enough memory.
+ */
+static int mergeChunkIndex(PairIndex * const pIndex, PairIndex const * const pChunk);
+
+/**
+ * @brief Clears the given index, keeping its memory.
+ * @param pIndex The index to clear.
+ */
+static void clearIndex(PairIndex * const pIndex);
+
+/**
+ * @brief Releases the memory of the given index.
+ * @param pIndex The index to release.
+ */
+static void releaseIndex(PairIndex * const pIndex);
+
+#ifdef VALIDATOR_STATISTICS
+
+/**
+ * @brief Raises the maximal depth of the given Stack to its current depth, which does not count
+ *        the Parenthesis closed by its unmatched Closing-Parenthesis.
+ * @param pStack The Stack to count.
+ */
+static void countDepth(ParenthesisStack * const pStack);
+
+#endif
+
+
+/*----=  Validator  =-----*/
+
+
+/**
+ * @brief Checks if the scanner with the given name is known and supported by the CPU.
+ * @param name The name of the scanner, or NULL for the widest scanner the CPU supports.
+ * @return 1 if the scanner is supported, 0 otherwise.
+ */
+int validatorScannerSupported(char const * const name)
+{
+    return selectScanner(name, NULL) != NULL;
+}
+
+/**
+ * @brief Checks if the given Parenthesis pairs form a valid alphabet: an even number of UTF-8
+ *        characters, at most VALIDATOR_MAX_PAIRS pairs, where no two different characters end
+ *        with the same byte.
+ * @param pairs The Parenthesis pairs, or NULL for VALIDATOR_DEFAULT_PAIRS.
+ * @return 1 if the pairs are valid, 0 otherwise.
+ */
+int validatorPairsSupported(char const * const pairs)
+{
+    ParenthesisAlphabet alphabet;
+    return buildAlphabet(&alphabet, pairs) == VALIDATOR_VALID;
+}
+
+/**
+ * @brief Checks if literals and comments may be skipped with the given Parenthesis pairs and
+ *        prefix of line comments: the pairs must be valid, the prefix must be at most
+ *        VALIDATOR_MAX_COMMENT_LENGTH bytes, and no Parenthesis may end with a quote, a
+ *        backslash, a byte of a comment delimiter or a new line.
+ * @param pairs The Parenthesis pairs, or NULL for VALIDATOR_DEFAULT_PAIRS.
+ * @param lineComment The prefix of line comments, or NULL for none.
+ * @return 1 if the lexical options are valid, 0 otherwise.
+ */
+int validatorLexerSupported(char const * const pairs, char const * const lineComment)
+{
+    ParenthesisAlphabet alphabet;
+    Lexer lexer;
+    return buildAlphabet(&alphabet, pairs) == VALIDATOR_VALID &&
+           buildLexer(&lexer, &alphabet, lineComment) == VALIDATOR_VALID;
+}
+
+/**
+ * @brief Creates a Validator for a new stream of data.
+ * @param pOptions The options of the Validator.
+ * @return The new Validator, or NULL if its scanner, its pairs or its lexical options are not
+ *         supported or there is not enough memory.
+ */
+ParenthesisValidator * validatorCreate(ValidatorOptions const * const pOptions)
+{
+    ParenthesisValidator * const pValidator = calloc(1, sizeof(ParenthesisValidator));
+    if (pValidator == NULL)
+    {
+        return NULL;
+    }
+
+    if (buildAlphabet(&pValidator->alphabet, pOptions->pairs) != VALIDATOR_VALID ||
+        (pOptions->lexical && buildLexer(&pValidator->lexer, &pValidator->alphabet,
+                                         pOptions->lineComment) != VALIDATOR_VALID))
+    {
+        free(pValidator);
+        return NULL;
+    }
+
+    // The lexical state changes the meaning of the Parenthesis, so it has its own scanners.
+    if (pOptions->lexical)
+    {
+        pValidator->alphabet.specialization = LEXICAL_ALPHABET;
+        pValidator->stack.pLexer = &pValidator->lexer;
+    }
+    pValidator->scanner = selectScanner(pOptions->scanner, &pValidator->alphabet);
+    if (pValidator->scanner == NULL)
+    {
+        free(pValidator);
+        return NULL;
+    }
+
+    pValidator->stack.maxDepth = pOptions->maxDepth;
+    pValidator->stack.pAlphabet = &pValidator->alphabet;
+    pValidator->stack.tracksPositions = pOptions->trackOpeners;
+    pValidator->threads = pOptions->threads;
+    pValidator->countsLines = pOptions->countLines;
+    if (pOptions->profile)
+    {
+        pValidator->profile.regionsCapacity = (pOptions->regions < VALIDATOR_MAX_REGIONS) ?
+                                              pOptions->regions : VALIDATOR_MAX_REGIONS;
+        pValidator->stack.pProfile = &pValidator->profile;
+    }
+    if (pOptions->index)
+    {
+        pValidator->index.encodes = 1;
+        pValidator->stack.pIndex = &pValidator->index;
+    }
+    validatorReset(pValidator);
+    return pValidator;
+}
+
+/**
+ * @brief Feeds the next part of the stream to the given Validator.
+ *        Once the stream breaks the required parenthesis structure the rest of it is ignored.
+ * @param pValidator The Validator of the stream.
+ * @param data The next part of the stream.
+ * @param length The number of bytes in the data.
+ * @return 0 if the stream does not break the required parenthesis structure so far, 1 if it
+ *         does and 2 if the stream exceeds the nesting depth limit or the memory.
+ */
+int validatorFeed(ParenthesisValidator * const pValidator, void const * const data,
+                  size_t const length)
+{
+    if (pValidator->result == VALIDATOR_VALID)
+    {
+        pValidator->result = feedChunks(pValidator, data, length);
+        if (pValidator->countsLines)
+        {
+            countLines(pValidator, data, length);
+        }
+        rememberBytes(pValidator->stack.previous, data, length);
+        pValidator->streamLength += length;
+    }
+    return pValidator->result;
+}
+
+/**
+ * @brief Gives the verdict of the given Validator, assuming its stream has ended.
+ * @param pValidator The Validator of the stream.
+ * @return 0 if the stream satisfies the required parenthesis structure, 1 if it does not and
+ *         2 if the stream exceeds the nesting depth limit or the memory.
+ */
+int validatorFinish(ParenthesisValidator const * const pValidator)
+{
+    // In case we reached the end of the stream, we check that there are no Opening-Parenthesis
+    // left unclosed.
+    if (pValidator->result == VALIDATOR_VALID && pValidator->stack.size != INITIAL_SCOPE_NUMBER)
+    {
+        return VALIDATOR_INVALID;
+    }
+    return pValidator->result;
+}
+
+/**
+ * @brief Reports the first violation of the required parenthesis structure in the stream of the
+ *        given Validator, assuming its stream has ended.
+ * @param pValidator The Validator of the stream.
+ * @param pError The address to store the violation in.
+ * @return The kind of the violation, VALIDATOR_NO_ERROR if there is none.
+ */
+int validatorError(ParenthesisValidator const * const pValidator, ValidatorError * const pError)
+{
+    ParenthesisStack const * const pStack = &pValidator->stack;
+
+    if (pValidator->result == VALIDATOR_INVALID)
+    {
+        *pError = pStack->error;
+    }
+    else if (pValidator->result == VALIDATOR_VALID && pStack->size != INITIAL_SCOPE_NUMBER)
+    {
+        // The Opening-Parenthesis at the top of the Stack is the first one the end of the
+        // stream should have closed.
+        pError->kind = VALIDATOR_UNCLOSED_OPENER;
+        pError->position.offset = pValidator->streamLength;
+        pError->position.line = VALIDATOR_UNKNOWN_LINE;
+        pError->position.column = VALIDATOR_UNKNOWN_LINE;
+        if (pValidator->countsLines)
+        {
+            pError->position.line = pValidator->line;
+            pError->position.column = pValidator->streamLength - pValidator->lineStart + 1;
+        }
+        pError->found[0] = '\0';
+        strcpy(pError->expected,
+               pValidator->alphabet.closings[parenthesisAt(pStack, pStack->size - 1)]);
+        pError->hasOpener = pStack->tracksPositions;
+        if (pError->hasOpener)
+        {
+            pError->opener = pStack->positions[pStack->size - 1];
+        }
+    }
+    else
+    {
+        pError->kind = VALIDATOR_NO_ERROR;
+    }
+    return pError->kind;
+}
+
+/**
+ * @brief Computes the line and the column of the given position, by counting the lines of the
+ *        given stream up to the position's offset.
+ * @param data The whole stream of data the position refers to.
+ * @param length The number of bytes in the stream.
+ * @param pPosition The position to compute, its offset must be set.
+ */
+void validatorLocate(void const * const data, size_t const length,
+                     ValidatorPosition * const pPosition)
+{
+    LineCursor cursor = {1, 0, 0};
+    if (pPosition->offset <= length)
+    {
+        locatePosition(&cursor, data, 0, pPosition);
+    }
+}
+
+/**
+ * @brief Reads the depth profile of the given Validator, which keeps one. The profile is
+ *        complete only for a stream which satisfies the required parenthesis structure.
+ * @param pValidator The Validator of the stream.
+ * @param pProfile The address to store the profile in.
+ * @return 0 if the profile was stored, 1 if the Validator does not keep one.
+ */
+int validatorProfile(ParenthesisValidator const * const pValidator,
+                     ValidatorProfile * const pProfile)
+{
+    DepthProfile const * const pDepths = pValidator->stack.pProfile;
+    if (pDepths == NULL)
+    {
+        return VALIDATOR_INVALID;
+    }
+
+    // The depths of the stream itself start at 1, so the last one counted is the deepest.
+    pProfile->maxDepth = pDepths->deeper.number;
+    memset(pProfile->histogram, 0, sizeof(pProfile->histogram));
+    for (size_t i = 0; i < pDepths->deeper.number; ++i)
+    {
+        unsigned long long const depth = i + 1;
+        pProfile->histogram[VALIDATOR_PROFILE_BUCKETS - 1 - __builtin_clzll(depth)] +=
+            pDepths->deeper.counts[i];
+    }
+
+    pProfile->regionsNumber = pDepths->regionsNumber;
+    for (size_t i = 0; i < pDepths->regionsNumber; ++i)
+    {
+        pProfile->regions[i].depth = (unsigned long long) pDepths->regions[i].depth;
+        pProfile->regions[i].opener = pDepths->regions[i].opener;
+        pProfile->regions[i].closer = pDepths->regions[i].closer;
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Returns the number of bytes of the index of the pairs of the given Validator.
+ * @param pValidator The Validator of the stream.
+ * @return The number of bytes, or 0 if the Validator does not build an index.
+ */
+size_t validatorIndexSize(ParenthesisValidator const * const pValidator)
+{
+    PairIndex const * const pIndex = pValidator->stack.pIndex;
+    if (pIndex == NULL)
+    {
+        return 0;
+    }
+
+    size_t const blocksNumber = (size_t) ((pIndex->pairsNumber + VALIDATOR_INDEX_BLOCK_PAIRS - 1) /
+                                          VALIDATOR_INDEX_BLOCK_PAIRS);
+    size_t const tableOffset = (sizeof(ValidatorIndexHeader) + pIndex->bytesLength +
+                                INDEX_ALIGNMENT - 1) / INDEX_ALIGNMENT * INDEX_ALIGNMENT;
+    return tableOffset + blocksNumber * sizeof(uint64_t);
+}
+
+/**
+ * @brief Stores the index of the pairs of the given Validator, which builds one. The index is
+ *        complete only for a stream which satisfies the required parenthesis structure.
+ * @param pValidator The Validator of the stream.
+ * @param index The address to store the index in, of 'validatorIndexSize' bytes aligned to 8.
+ * @return 0 if the index was stored, 1 if the Validator does not build one.
+ */
+int validatorIndex(ParenthesisValidator const * const pValidator, void * const index)
+{
+    PairIndex const * const pIndex = pValidator->stack.pIndex;
+    if (pIndex == NULL)
+    {
+        return VALIDATOR_INVALID;
+    }
+
+    // The pairs which are still open at the end of an invalid stream are left out.
+    size_t const size = validatorIndexSize(pValidator);
+    ValidatorIndexHeader header;
+    memset(&header, 0, sizeof(ValidatorIndexHeader));
+    memcpy(header.magic, VALIDATOR_INDEX_MAGIC, VALIDATOR_INDEX_MAGIC_LENGTH);
+    header.blockPairs = VALIDATOR_INDEX_BLOCK_PAIRS;
+    header.pairsNumber = pIndex->pairsNumber;
+    header.blocksNumber = (pIndex->pairsNumber + VALIDATOR_INDEX_BLOCK_PAIRS - 1) /
+                          VALIDATOR_INDEX_BLOCK_PAIRS;
+    header.tableOffset = size - header.blocksNumber * sizeof(uint64_t);
+
+    unsigned char * const bytes = index;
+    memcpy(bytes, &header, sizeof(ValidatorIndexHeader));
+    if (pIndex->bytesLength != 0)
+    {
+        memcpy(bytes + sizeof(ValidatorIndexHeader), pIndex->bytes, pIndex->bytesLength);
+    }
+    memset(bytes + sizeof(ValidatorIndexHeader) + pIndex->bytesLength, 0,
+           header.tableOffset - sizeof(ValidatorIndexHeader) - pIndex->bytesLength);
+    uint64_t * const table = (uint64_t *) (bytes + header.tableOffset);
+    for (size_t i = 0; i < header.blocksNumber; ++i)
+    {
+        table[i] = sizeof(ValidatorIndexHeader) + pIndex->blocks[i];
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Finds a pair in the given index by its ordinal, which is the number of
+ *        Opening-Parenthesis before the pair's own, so a parser counting the Opening-Parenthesis
+ *        it meets finds the end of every scope without scanning for it.
+ *        Only the block of the pair is decoded, the index is checked as far as it is read.
+ * @param index The index, as stored by 'validatorIndex', aligned to 8 bytes.
+ * @param length The number of bytes in the index.
+ * @param ordinal The ordinal of the pair.
+ * @param pPair The address to store the pair in.
+ * @return 0 if the pair was found, 1 if the index holds no such pair or is not valid.
+ */
+int validatorIndexPair(void const * const index, size_t const length,
+                       unsigned long long const ordinal, ValidatorPair * const pPair)
+{
+    unsigned char const * const bytes = index;
+    ValidatorIndexHeader const * const pHeader = index;
+    if (length < sizeof(ValidatorIndexHeader) ||
+        memcmp(pHeader->magic, VALIDATOR_INDEX_MAGIC, VALIDATOR_INDEX_MAGIC_LENGTH) != 0 ||
+        pHeader->blockPairs == 0 || ordinal >= pHeader->pairsNumber ||
+        ordinal / pHeader->blockPairs >= pHeader->blocksNumber ||
+        pHeader->tableOffset < sizeof(ValidatorIndexHeader) ||
+        pHeader->tableOffset % INDEX_ALIGNMENT != 0 || pHeader->tableOffset > length ||
+        pHeader->blocksNumber > (length - pHeader->tableOffset) / sizeof(uint64_t))
+    {
+        return VALIDATOR_INVALID;
+    }
+
+    // The pairs of a block are decoded from its start, the distances add up to the offsets.
+    uint64_t const * const table = (uint64_t const *) (bytes + pHeader->tableOffset);
+    uint64_t const blockOffset = table[ordinal / pHeader->blockPairs];
+    if (blockOffset < sizeof(ValidatorIndexHeader) || blockOffset >= pHeader->tableOffset)
+    {
+        return VALIDATOR_INVALID;
+    }
+    unsigned char const * pBytes = bytes + blockOffset;
+    unsigned char const * const end = bytes + pHeader->tableOffset;
+    unsigned long long opener = 0;
+    unsigned long long distance = 0;
+    unsigned long long closing = 0;
+    for (unsigned long long i = ordinal / pHeader->blockPairs * pHeader->blockPairs;
+         i <= ordinal; ++i)
+    {
+        if (readVarint(&pBytes, end, &distance) || readVarint(&pBytes, end, &closing))
+        {
+            return VALIDATOR_INVALID;
+        }
+        opener += distance;
+    }
+    pPair->opener = opener;
+    pPair->closer = opener + closing / VALIDATOR_MAX_PAIRS;
+    pPair->kind = (int) (closing % VALIDATOR_MAX_PAIRS);
+    return VALIDATOR_VALID;
+}
+
+#ifdef VALIDATOR_STATISTICS
+
+/**
+ * @brief Reads the counters of the given Validator.
+ * @param pValidator The Validator of the stream.
+ * @param pStatistics The address to store the counters in.
+ */
+void validatorStatistics(ParenthesisValidator const * const pValidator,
+                         ValidatorStatistics * const pStatistics)
+{
+    pStatistics->bytes = pValidator->streamLength;
+    if (pValidator->result == VALIDATOR_INVALID &&
+        pValidator->stack.error.position.offset < pValidator->streamLength)
+    {
+        // The rest of the part which broke the structure was not scanned.
+        pStatistics->bytes = pValidator->stack.error.position.offset;
+    }
+    pStatistics->parenthesis = pValidator->stack.parenthesisNumber;
+    pStatistics->maxDepth = pValidator->stack.deepest;
+}
+
+#endif
+
+/**
+ * @brief Resets the given Validator, so it can be used for a new stream of data.
+ * @param pValidator The Validator to reset.
+ */
+void validatorReset(ParenthesisValidator * const pValidator)
+{
+    pValidator->stack.size = INITIAL_SCOPE_NUMBER;
+    pValidator->stack.error.kind = VALIDATOR_NO_ERROR;
+    memset(pValidator->stack.previous, 0, sizeof(pValidator->stack.previous));
+    pValidator->lexer.state = CODE_STATE;
+    pValidator->lexer.tokenEnd = 0;
+    pValidator->lexer.escapedCarry = 0;
+    pValidator->result = VALIDATOR_VALID;
+    pValidator->streamLength = 0;
+    pValidator->line = 1;
+    pValidator->lineStart = 0;
+    clearProfile(&pValidator->profile);
+    clearIndex(&pValidator->index);
+#ifdef VALIDATOR_STATISTICS
+    pValidator->stack.parenthesisNumber = 0;
+    pValidator->stack.deepest = INITIAL_SCOPE_NUMBER;
+#endif
+}
+
+/**
+ * @brief Releases the given Validator.
+ * @param pValidator The Validator to release, may be NULL.
+ */
+void validatorDestroy(ParenthesisValidator * const pValidator)
+{
+    if (pValidator != NULL)
+    {
+        free(pValidator->stack.kinds);
+        free(pValidator->stack.positions);
+        releaseProfile(&pValidator->profile);
+        releaseIndex(&pValidator->index);
+        free(pValidator);
+    }
+}
+
+
+/*----=  Alphabet  =-----*/
+
+
+/**
+ * @brief Builds the alphabet of the given pairs.
+ * @param pAlphabet The alphabet to build.
+ * @param pairs The Parenthesis pairs, or NULL for VALIDATOR_DEFAULT_PAIRS.
+ * @return 0 if the pairs form a valid alphabet, 1 otherwise.
+ */
+static int buildAlphabet(ParenthesisAlphabet * const pAlphabet, char const * pairs)
+{
+    memset(pAlphabet, 0, sizeof(ParenthesisAlphabet));
+    if (pairs == NULL)
+    {
+        pairs = VALIDATOR_DEFAULT_PAIRS;
+    }
+
+    // Split the pairs into characters, every even character opens and the next one closes.
+    size_t charactersNumber = 0;
+    for (char const * pCharacter = pairs; *pCharacter != '\0'; charactersNumber++)
+    {
+        size_t const length = characterLength((unsigned char const *) pCharacter);
+        if (length == 0 || charactersNumber == 2 * VALIDATOR_MAX_PAIRS)
+        {
+            return VALIDATOR_INVALID;
+        }
+
+        size_t const kind = charactersNumber / 2;
+        char * const parenthesis = (charactersNumber % 2 == 0) ? pAlphabet->openings[kind] :
+                                                                 pAlphabet->closings[kind];
+        memcpy(parenthesis, pCharacter, length);
+        parenthesis[length] = '\0';
+        pCharacter += length;
+    }
+    if (charactersNumber == 0 || charactersNumber % 2 != 0)
+    {
+        return VALIDATOR_INVALID;
+    }
+    pAlphabet->pairsNumber = charactersNumber / 2;
+
+    // Every byte may end a single Parenthesis, or both Parenthesis of a symmetric pair.
+    for (size_t kind = 0; kind < pAlphabet->pairsNumber; ++kind)
+    {
+        if (addParenthesis(pAlphabet, pAlphabet->openings[kind], OPENING_CLASS | (int) kind))
+        {
+            return VALIDATOR_INVALID;
+        }
+
+        if (strcmp(pAlphabet->openings[kind], pAlphabet->closings[kind]) == 0)
+        {
+            char const * const closing = pAlphabet->closings[kind];
+            pAlphabet->classes[(unsigned char) closing[strlen(closing) - 1]] |= CLOSING_CLASS;
+            pAlphabet->symmetric = 1;
+        }
+        else if (addParenthesis(pAlphabet, pAlphabet->closings[kind], CLOSING_CLASS | (int) kind))
+        {
+            return VALIDATOR_INVALID;
+        }
+    }
+
+    pAlphabet->plain = !pAlphabet->symmetric && strlen(pairs) == charactersNumber;
+    pAlphabet->specialization = GENERIC_ALPHABET;
+    if (strcmp(pairs, VALIDATOR_DEFAULT_PAIRS) == 0)
+    {
+        pAlphabet->specialization = DEFAULT_ALPHABET;
+    }
+    else if (strcmp(pairs, BRACES_PAIRS) == 0)
+    {
+        pAlphabet->specialization = BRACES_ALPHABET;
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Adds a single Parenthesis to the table of the given alphabet.
+ * @param pAlphabet The alphabet to add to.
+ * @param parenthesis The Parenthesis, as a UTF-8 string.
+ * @param byteClass The class flags and the kind of the Parenthesis.
+ * @return 0 if the Parenthesis was added, 1 if its last byte already ends another Parenthesis.
+ */
+static int addParenthesis(ParenthesisAlphabet * const pAlphabet, char const * const parenthesis,
+                          int byteClass)
+{
+    size_t const length = strlen(parenthesis);
+    unsigned char const lastByte = (unsigned char) parenthesis[length - 1];
+    if (pAlphabet->classes[lastByte] != 0)
+    {
+        return VALIDATOR_INVALID;
+    }
+
+    if (length > 1)
+    {
+        byteClass |= SEQUENCE_CLASS;
+    }
+    pAlphabet->classes[lastByte] = (unsigned char) byteClass;
+    pAlphabet->triggers[pAlphabet->triggersNumber++] = lastByte;
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Determines the number of bytes of the UTF-8 character at the given string.
+ * @param character The character.
+ * @return The number of bytes of the character, or 0 if it is not a valid UTF-8 character.
+ */
+static size_t characterLength(unsigned char const * const character)
+{
+    size_t length = 1;
+    if (*character >= UTF8_INVALID_LEAD)
+    {
+        return 0;
+    }
+    else if (*character >= UTF8_FOUR_BYTES_LEAD)
+    {
+        length = 4;
+    }
+    else if (*character >= UTF8_THREE_BYTES_LEAD)
+    {
+        length = 3;
+    }
+    else if (*character >= UTF8_TWO_BYTES_LEAD)
+    {
+        length = 2;
+    }
+    else if ((*character & UTF8_CONTINUATION_MASK) == UTF8_CONTINUATION)
+    {
+        return 0;
+    }
+
+    // The terminating NUL is not a continuation byte, so a truncated character stops here.
+    for (size_t i = 1; i < length; ++i)
+    {
+        if ((character[i] & UTF8_CONTINUATION_MASK) != UTF8_CONTINUATION)
+        {
+            return 0;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Builds the lexical state which skips literals and comments.
+ * @param pLexer The lexical state to build.
+ * @param pAlphabet The alphabet of the Parenthesis, none of them may end with a lexical byte.
+ * @param lineComment The prefix of line comments, or NULL for none.
+ * @return 0 if the lexical state was built, 1 otherwise.
+ */
+static int buildLexer(Lexer * const pLexer, ParenthesisAlphabet const * const pAlphabet,
+                      char const * lineComment)
+{
+    memset(pLexer, 0, sizeof(Lexer));
+    if (lineComment == NULL)
+    {
+        lineComment = "";
+    }
+    if (strlen(lineComment) > VALIDATOR_MAX_COMMENT_LENGTH)
+    {
+        return VALIDATOR_INVALID;
+    }
+    strcpy(pLexer->lineComment, lineComment);
+
+    // Every delimiter is looked for only in the states it may end, so a new line in the code or
+    // an asterisk in a block comment is skipped at once.
+    char const doubleQuote[] = {DOUBLE_QUOTE, '\0'};
+    char const singleQuote[] = {SINGLE_QUOTE, '\0'};
+    char const newLine[] = {NEW_LINE, '\0'};
+    if (addLexicalByte(pLexer, pAlphabet, ESCAPE_CHARACTER) ||
+        addDelimiter(pLexer, pAlphabet, doubleQuote, (1 << CODE_STATE) | (1 << STRING_STATE)) ||
+        addDelimiter(pLexer, pAlphabet, singleQuote,
+                     (1 << CODE_STATE) | (1 << CHARACTER_STATE)) ||
+        addDelimiter(pLexer, pAlphabet, newLine,
+                     (1 << STRING_STATE) | (1 << CHARACTER_STATE) | (1 << LINE_COMMENT_STATE)) ||
+        addDelimiter(pLexer, pAlphabet, BLOCK_COMMENT_START, 1 << CODE_STATE) ||
+        addDelimiter(pLexer, pAlphabet, BLOCK_COMMENT_END, 1 << BLOCK_COMMENT_STATE) ||
+        addDelimiter(pLexer, pAlphabet, lineComment, 1 << CODE_STATE))
+    {
+        return VALIDATOR_INVALID;
+    }
+    pLexer->state = CODE_STATE;
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Adds the given delimiter to the given lexical state, and locates its bytes.
+ * @param pLexer The lexical state to add to.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param delimiter The delimiter, an empty one is ignored.
+ * @param states The lexical states the delimiter may end, a bit per state.
+ * @return 0 if the delimiter was added, 1 if a Parenthesis ends with one of its bytes.
+ */
+static int addDelimiter(Lexer * const pLexer, ParenthesisAlphabet const * const pAlphabet,
+                        char const * const delimiter, int const states)
+{
+    size_t const length = strlen(delimiter);
+    if (length == 0)
+    {
+        return VALIDATOR_VALID;
+    }
+
+    unsigned char indexes[VALIDATOR_MAX_COMMENT_LENGTH];
+    for (size_t distance = 0; distance < VALIDATOR_MAX_COMMENT_LENGTH; ++distance)
+    {
+        indexes[distance] = ANY_INDEX;
+        if (distance < length)
+        {
+            unsigned char const byte = (unsigned char) delimiter[length - 1 - distance];
+            if (addLexicalByte(pLexer, pAlphabet, byte))
+            {
+                return VALIDATOR_INVALID;
+            }
+            indexes[distance] = (unsigned char) (pLexer->indexes[byte] - 1);
+        }
+    }
+
+    for (int state = 0; state < LEXICAL_STATES_NUMBER; ++state)
+    {
+        if (states & (1 << state))
+        {
+            memcpy(pLexer->delimiters[state][pLexer->delimitersNumbers[state]++], indexes,
+                   sizeof(indexes));
+        }
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Locates the given byte for the given lexical state, unless it is already located.
+ * @param pLexer The lexical state to add to.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param byte The byte.
+ * @return 0 if the byte was added, 1 if a Parenthesis ends with it.
+ */
+static int addLexicalByte(Lexer * const pLexer, ParenthesisAlphabet const * const pAlphabet,
+                          unsigned char const byte)
+{
+    if (pAlphabet->classes[byte] != 0)
+    {
+        return VALIDATOR_INVALID;
+    }
+
+    if (pLexer->indexes[byte] == 0)
+    {
+        pLexer->bytes[pLexer->bytesNumber++] = byte;
+        pLexer->indexes[byte] = (unsigned char) pLexer->bytesNumber;
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Appends the end of the given data to the given bytes of the stream.
+ * @param previous The last bytes of the stream, the last one is the closest.
+ * @param data The data which follows these bytes in the stream.
+ * @param length The number of bytes in the data.
+ */
+static void rememberBytes(unsigned char previous[PREVIOUS_BYTES_NUMBER],
+                          unsigned char const * const data, size_t const length)
+{
+    size_t i = (length > PREVIOUS_BYTES_NUMBER) ? length - PREVIOUS_BYTES_NUMBER : 0;
+    for ( ; i < length; ++i)
+    {
+        memmove(previous, previous + 1, PREVIOUS_BYTES_NUMBER - 1);
+        previous[PREVIOUS_BYTES_NUMBER - 1] = data[i];
+    }
+}
+
+
+/*----=  Lines  =-----*/
+
+
+/**
+ * @brief Counts the lines of the given part of the stream, and sets the lines and columns of the
+ *        positions which belong to it.
+ * @param pValidator The Validator of the stream.
+ * @param data The part of the stream which was just fed.
+ * @param length The number of bytes in the data.
+ */
+static void countLines(ParenthesisValidator * const pValidator,
+                       unsigned char const * const data, size_t const length)
+{
+    ParenthesisStack * const pStack = &pValidator->stack;
+    ValidatorError * const pError = &pStack->error;
+    unsigned long long const dataOffset = pValidator->streamLength;
+    LineCursor cursor = {pValidator->line, pValidator->lineStart, dataOffset};
+
+    // The Opening-Parenthesis of a violation was popped, so it may be anywhere before it.
+    if (pValidator->result == VALIDATOR_INVALID && pError->hasOpener &&
+        pError->opener.line == VALIDATOR_UNKNOWN_LINE)
+    {
+        LineCursor openerCursor = cursor;
+        locatePosition(&openerCursor, data, dataOffset, &pError->opener);
+    }
+
+    // The Opening-Parenthesis left open by this part are at the top of the Stack, they are the
+    // only ones without a line.
+    if (pStack->tracksPositions)
+    {
+        size_t first = pStack->size;
+        while (first > INITIAL_SCOPE_NUMBER &&
+               pStack->positions[first - 1].line == VALIDATOR_UNKNOWN_LINE)
+        {
+            first--;
+        }
+        for (size_t i = first; i < pStack->size; ++i)
+        {
+            locatePosition(&cursor, data, dataOffset, &pStack->positions[i]);
+        }
+    }
+
+    if (pValidator->result == VALIDATOR_INVALID)
+    {
+        locatePosition(&cursor, data, dataOffset, &pError->position);
+    }
+    else
+    {
+        moveCursor(&cursor, data, dataOffset, dataOffset + length);
+    }
+
+    pValidator->line = cursor.line;
+    pValidator->lineStart = cursor.lineStart;
+}
+
+/**
+ * @brief Moves the given cursor forward to the given offset, counting the lines on the way.
+ * @param pCursor The cursor to move.
+ * @param data The part of the stream the cursor is in.
+ * @param dataOffset The offset of the data in the stream.
+ * @param offset The offset to move to, it must be within the data.
+ */
+static void moveCursor(LineCursor * const pCursor, unsigned char const * const data,
+                       unsigned long long const dataOffset, unsigned long long const offset)
+{
+    unsigned char const * current = data + (pCursor->offset - dataOffset);
+    unsigned char const * const end = data + (offset - dataOffset);
+
+    while (current < end && (current = memchr(current, '\n', (size_t) (end - current))) != NULL)
+    {
+        current++;
+        pCursor->line++;
+        pCursor->lineStart = dataOffset + (unsigned long long) (current - data);
+    }
+    pCursor->offset = offset;
+}
+
+/**
+ * @brief Sets the line and column of the given position to those of the given cursor, after
+ *        moving the cursor to the position's offset.
+ * @param pCursor The cursor.
+ * @param data The part of the stream the position is in.
+ * @param dataOffset The offset of the data in the stream.
+ * @param pPosition The position to set.
+ */
+static void locatePosition(LineCursor * const pCursor, unsigned char const * const data,
+                           unsigned long long const dataOffset,
+                           ValidatorPosition * const pPosition)
+{
+    moveCursor(pCursor, data, dataOffset, pPosition->offset);
+    pPosition->line = pCursor->line;
+    pPosition->column = pPosition->offset - pCursor->lineStart + 1;
+}
+
+
+/*----=  Chunks  =-----*/
+
+
+/**
+ * @brief Feeds the given part of data to the given Validator, splitting it into chunks which are
+ *        scanned in parallel if the Validator has more than a single thread.
+ * @param pValidator The Validator of the stream.
+ * @param data The part of data to check.
+ * @param length The number of bytes in the data.
+ * @return 0 if the given data does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the data could not be analyzed within the nesting depth limit or the memory.
+ */
+static int feedChunks(ParenthesisValidator * const pValidator, unsigned char const * const data,
+                      size_t const length)
+{
+    // Small parts of data are not worth the threads. A Parenthesis which both opens and closes
+    // cannot be summarized without what precedes it, and neither can a chunk whose lexical state
+    // at its start is unknown, so such alphabets and the lexer use a single thread.
+    size_t chunksNumber = pValidator->threads;
+    if (chunksNumber > length / MIN_CHUNK_SIZE)
+    {
+        chunksNumber = length / MIN_CHUNK_SIZE;
+    }
+    if (chunksNumber <= 1 || pValidator->alphabet.symmetric || pValidator->stack.pLexer != NULL)
+    {
+        return checkFileHelper(&pValidator->stack, pValidator->scanner, data, length,
+                               pValidator->streamLength);
+    }
+
+    ChunkSummary * chunks = calloc(chunksNumber, sizeof(ChunkSummary));
+    if (chunks == NULL)
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    // Scan all the chunks, the first chunk is scanned by this thread.
+    size_t const chunkLength = length / chunksNumber;
+    size_t startedChunks = 0;
+    size_t failedChunk = chunksNumber;
+    for (size_t i = 0; i < chunksNumber; ++i)
+    {
+        ChunkSummary * const pChunk = &chunks[i];
+        pChunk->scanner = pValidator->scanner;
+        pChunk->data = data + i * chunkLength;
+        pChunk->length = (i == chunksNumber - 1) ? length - i * chunkLength : chunkLength;
+        pChunk->offset = pValidator->streamLength + i * chunkLength;
+        pChunk->index = i;
+        pChunk->pFailedChunk = &failedChunk;
+        pChunk->closers.maxDepth = pValidator->stack.maxDepth;
+        pChunk->closers.tracksPositions = 1;
+        pChunk->openers.maxDepth = pValidator->stack.maxDepth;
+        pChunk->openers.pAlphabet = &pValidator->alphabet;
+        pChunk->openers.tracksPositions = pValidator->stack.tracksPositions;
+        pChunk->openers.pUnmatched = &pChunk->closers;
+        if (pValidator->stack.pProfile != NULL)
+        {
+            pChunk->profile.regionsCapacity = pValidator->profile.regionsCapacity;
+            pChunk->openers.pProfile = &pChunk->profile;
+        }
+        pChunk->pairs.innermost = NO_ENTRY;
+        if (pValidator->stack.pIndex != NULL)
+        {
+            pChunk->openers.pIndex = &pChunk->pairs;
+        }
+        memcpy(pChunk->openers.previous, pValidator->stack.previous, PREVIOUS_BYTES_NUMBER);
+        rememberBytes(pChunk->openers.previous, data, i * chunkLength);
+
+        if (i != 0 && pthread_create(&pChunk->thread, NULL, scanChunk, pChunk) != 0)
+        {
+            break;
+        }
+        startedChunks++;
+    }
+
+    int result = VALIDATOR_VALID;
+    if (startedChunks == chunksNumber)
+    {
+        scanChunk(&chunks[0]);
+    }
+    else
+    {
+        result = VALIDATOR_LIMIT_EXCEEDED;
+        failChunk(&failedChunk, 0);
+    }
+
+    // Merge the summaries in the order of the chunks. Once the structure is broken the verdict
+    // is certain, so the chunks which are still scanning are cancelled.
+    for (size_t i = 0; i < startedChunks; ++i)
+    {
+        if (i != 0)
+        {
+            pthread_join(chunks[i].thread, NULL);
+        }
+        if (result == VALIDATOR_VALID)
+        {
+            result = mergeChunkSummary(&pValidator->stack, &chunks[i]);
+            if (result != VALIDATOR_VALID)
+            {
+                failChunk(&failedChunk, i);
+            }
+        }
+        free(chunks[i].closers.kinds);
+        free(chunks[i].closers.positions);
+        free(chunks[i].openers.kinds);
+        free(chunks[i].openers.positions);
+        releaseProfile(&chunks[i].profile);
+        releaseIndex(&chunks[i].pairs);
+    }
+
+    free(chunks);
+    return result;
+}
+
+/**
+ * @brief Scans a single chunk of data into its summary, this is the routine of the threads
+ *        of 'feedChunks'.
+ * @param pChunk The summary of the chunk to scan.
+ * @return NULL.
+ */
+static void * scanChunk(void * pChunk)
+{
+    ChunkSummary * const pSummary = pChunk;
+    ParenthesisStack * const pOpeners = &pSummary->openers;
+
+    // The chunk is scanned in slices, so it stops soon after an earlier chunk breaks the
+    // structure. A cancelled chunk is left valid, since it is never merged.
+    pSummary->result = VALIDATOR_VALID;
+    size_t scanned = 0;
+    while (pSummary->result == VALIDATOR_VALID && scanned < pSummary->length &&
+           __atomic_load_n(pSummary->pFailedChunk, __ATOMIC_RELAXED) > pSummary->index)
+    {
+        size_t const sliceLength = (pSummary->length - scanned < CANCEL_CHECK_SIZE) ?
+                                   pSummary->length - scanned : CANCEL_CHECK_SIZE;
+        pSummary->result = checkFileHelper(pOpeners, pSummary->scanner,
+                                           pSummary->data + scanned, sliceLength,
+                                           pSummary->offset + scanned);
+        rememberBytes(pOpeners->previous, pSummary->data + scanned, sliceLength);
+        scanned += sliceLength;
+    }
+
+    if (pSummary->result != VALIDATOR_VALID)
+    {
+        failChunk(pSummary->pFailedChunk, pSummary->index);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Marks the chunk with the given index as breaking the structure, unless an earlier
+ *        chunk already does, so the chunks after it stop scanning.
+ * @param pFailedChunk The index of the first chunk known to break the structure.
+ * @param index The index of the chunk.
+ */
+static void failChunk(size_t * const pFailedChunk, size_t const index)
+{
+    size_t failedChunk = __atomic_load_n(pFailedChunk, __ATOMIC_RELAXED);
+    while (index < failedChunk &&
+           !__atomic_compare_exchange_n(pFailedChunk, &failedChunk, index, 0, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+    {
+        // Another chunk failed meanwhile, the exchange reloaded its index.
+    }
+}
+
+/**
+ * @brief Merges the summary of the next chunk of data into the given Stack: the unmatched
+ *        Closing-Parenthesis of the chunk close the top of the Stack, and the unmatched
+ *        Opening-Parenthesis of the chunk are pushed to it.
+ * @param pStack The Stack of the Opening-Parenthesis left open by all the previous chunks.
+ * @param pChunk The summary of the next chunk.
+ * @return 0 if the chunk does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the Stack exceeds its depth limit or the memory.
+ */
+static int mergeChunkSummary(ParenthesisStack * const pStack,
+                             ChunkSummary const * const pChunk)
+{
+    size_t const base = pStack->size;
+#ifdef VALIDATOR_STATISTICS
+    // The depths within the chunk are relative to its start, which is the top of the Stack.
+    pStack->parenthesisNumber += pChunk->openers.parenthesisNumber;
+    if (pStack->size + pChunk->openers.deepest > pStack->deepest)
+    {
+        pStack->deepest = pStack->size + pChunk->openers.deepest;
+    }
+#endif
+
+    for (size_t i = 0; i < pChunk->closers.size; ++i)
+    {
+        int const kind = parenthesisAt(&pChunk->closers, i);
+        unsigned long long const offset = pChunk->closers.positions[i].offset;
+
+        if (pStack->size == INITIAL_SCOPE_NUMBER)
+        {
+            return breakStructure(pStack, offset, kind, NOT_PARENTHESIS);
+        }
+
+        int const openedKind = popParenthesis(pStack);
+        if (openedKind != kind)
+        {
+            return breakStructure(pStack, offset, kind, openedKind);
+        }
+        if (pStack->pIndex != NULL && closePair(pStack->pIndex, offset))
+        {
+            return VALIDATOR_LIMIT_EXCEEDED;
+        }
+    }
+
+    // A chunk which failed on its own is summarized only up to its failure, which comes after
+    // all its unmatched Closing-Parenthesis.
+    if (pChunk->result != VALIDATOR_VALID)
+    {
+        if (pChunk->result == VALIDATOR_INVALID)
+        {
+            pStack->error = pChunk->openers.error;
+        }
+        return pChunk->result;
+    }
+
+    if ((pStack->pProfile != NULL &&
+         mergeChunkProfile(pStack->pProfile, &pChunk->profile, base)) ||
+        (pStack->pIndex != NULL && mergeChunkIndex(pStack->pIndex, &pChunk->pairs)))
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    for (size_t i = 0; i < pChunk->openers.size; ++i)
+    {
+        if (pushParenthesis(pStack, parenthesisAt(&pChunk->openers, i)))
+        {
+            return VALIDATOR_LIMIT_EXCEEDED;
+        }
+        if (pStack->tracksPositions)
+        {
+            pStack->positions[pStack->size - 1] = pChunk->openers.positions[i];
+        }
+    }
+    return VALIDATOR_VALID;
+}
+
+
+/*----=  Parenthesis  =-----*/
+
+
+/**
+ * @brief Checks the given part of data using the given scanner.
+ *        This function keeps each opened parenthesis in the given Stack and removes it when
+ *        the matching closing parenthesis is reached.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param scanner The scanner used for locating the Parenthesis.
+ * @param data The part of the data to check.
+ * @param length The number of bytes in the data.
+ * @param offset The offset of the data in the stream.
+ * @return 0 if the given data does not break the required parenthesis structure, 1 if it does
+ *         and 2 if the data could not be analyzed within the nesting depth limit or the memory.
+ */
+static int checkFileHelper(ParenthesisStack * const pStack, ScanFunction const scanner,
+                           unsigned char const * const data, size_t const length,
+                           unsigned long long const offset)
+{
+    pStack->base = data;
+    pStack->baseOffset = offset;
+    return scanner(pStack, data, length);
+}
+
+/**
+ * @brief Returns the Parenthesis which ends with the given byte.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param byteClass The class of the byte.
+ * @return The Parenthesis, as a UTF-8 string.
+ */
+static char const * classParenthesis(ParenthesisAlphabet const * const pAlphabet,
+                                     int const byteClass)
+{
+    int const kind = byteClass & KIND_CLASS_MASK;
+    if (byteClass & OPENING_CLASS)
+    {
+        return pAlphabet->openings[kind];
+    }
+    return pAlphabet->closings[kind];
+}
+
+/**
+ * @brief Checks if the given byte, which ends a sequence of a few bytes, is preceded by the rest
+ *        of the sequence.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ * @param sequence The sequence, a Parenthesis or a lexical delimiter.
+ * @return 1 if the whole sequence is found, 0 otherwise.
+ */
+static int matchesSequence(ParenthesisStack const * const pStack,
+                           unsigned char const * const pCharacter, char const * const sequence)
+{
+    size_t const length = strlen(sequence);
+    size_t const index = (size_t) (pCharacter - pStack->base);
+
+    // The bytes before the data are taken from the previous part of the stream.
+    for (size_t distance = 1; distance < length; ++distance)
+    {
+        unsigned char const byte = (distance <= index) ? pCharacter[-(ptrdiff_t) distance] :
+                                   pStack->previous[PREVIOUS_BYTES_NUMBER - (distance - index)];
+        if (byte != (unsigned char) sequence[length - 1 - distance])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Computes the offset in the stream of the Parenthesis which ends with the given byte of
+ *        the data applied to the given Stack.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ * @param byteClass The class of the byte.
+ * @return The offset of the first byte of the Parenthesis in the stream.
+ */
+static unsigned long long parenthesisOffset(ParenthesisStack const * const pStack,
+                                            unsigned char const * const pCharacter,
+                                            int const byteClass)
+{
+    unsigned long long offset = pStack->baseOffset +
+                                (unsigned long long) (pCharacter - pStack->base);
+    if (byteClass & SEQUENCE_CLASS)
+    {
+        offset -= strlen(classParenthesis(pStack->pAlphabet, byteClass)) - 1;
+    }
+    return offset;
+}
+
+/**
+ * @brief Checks if the given byte ends the given lexical delimiter, which starts after the byte
+ *        which last changed the lexical state.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ * @param delimiter The delimiter.
+ * @return 1 if the byte ends the delimiter, 0 otherwise.
+ */
+static int endsDelimiter(ParenthesisStack const * const pStack,
+                         unsigned char const * const pCharacter, char const * const delimiter)
+{
+    size_t const length = strlen(delimiter);
+    unsigned long long const offset = pStack->baseOffset +
+                                      (unsigned long long) (pCharacter - pStack->base);
+
+    // A delimiter may not reuse the bytes of the previous one, so "/*/" does not end a comment.
+    return length != 0 && *pCharacter == (unsigned char) delimiter[length - 1] &&
+           offset - pStack->pLexer->tokenEnd >= length - 1 &&
+           matchesSequence(pStack, pCharacter, delimiter);
+}
+
+/**
+ * @brief Applies the given byte, which may change the lexical state, to the lexical state of the
+ *        given Stack.
+ * @param pStack The Stack the data is applied to.
+ * @param pCharacter The byte.
+ */
+static void lexCharacter(ParenthesisStack * const pStack, unsigned char const * const pCharacter)
+{
+    Lexer * const pLexer = pStack->pLexer;
+    int state = pLexer->state;
+
+    switch (state)
+    {
+        case CODE_STATE:
+            if (*pCharacter == DOUBLE_QUOTE)
+            {
+                state = STRING_STATE;
+            }
+            else if (*pCharacter == SINGLE_QUOTE)
+            {
+                state = CHARACTER_STATE;
+            }
+            else if (endsDelimiter(pStack, pCharacter, BLOCK_COMMENT_START))
+            {
+                state = BLOCK_COMMENT_STATE;
+            }
+            else if (endsDelimiter(pStack, pCharacter, pLexer->lineComment))
+            {
+                state = LINE_COMMENT_STATE;
+            }
+            break;
+        case STRING_STATE:
+            if (*pCharacter == DOUBLE_QUOTE || *pCharacter == NEW_LINE)
+            {
+                state = CODE_STATE;
+            }
+            break;
+        case CHARACTER_STATE:
+            if (*pCharacter == SINGLE_QUOTE || *pCharacter == NEW_LINE)
+            {
+                state = CODE_STATE;
+            }
+            break;
+        case BLOCK_COMMENT_STATE:
+            if (endsDelimiter(pStack, pCharacter, BLOCK_COMMENT_END))
+            {
+                state = CODE_STATE;
+            }
+            break;
+        default:
+            if (*pCharacter == NEW_LINE)
+            {
+                state = CODE_STATE;
+            }
+            break;
+    }
+
+    if (state != pLexer->state)
+    {
+        unsigned long long const offset = pStack->baseOffset +
+                                          (unsigned long long) (pCharacter - pStack->base);
+        pLexer->state = state;
+        pLexer->tokenEnd = offset + 1;
+    }
+}
+
+/**
+ * @brief Records a violation of the required parenthesis structure in the given Stack.
+ * @param pStack The Stack which is broken.
+ * @param offset The offset of the breaking Closing-Parenthesis in the stream.
+ * @param closedKind The kind of the breaking Closing-Parenthesis.
+ * @param openedKind The kind of the Opening-Parenthesis it failed to close, which was just popped
+ *        from the Stack, or NOT_PARENTHESIS if there was none.
+ * @return 1.
+ */
+static int breakStructure(ParenthesisStack * const pStack, unsigned long long const offset,
+                          int const closedKind, int const openedKind)
+{
+    ValidatorError * const pError = &pStack->error;
+    pError->position.offset = offset;
+    pError->position.line = VALIDATOR_UNKNOWN_LINE;
+    pError->position.column = VALIDATOR_UNKNOWN_LINE;
+    strcpy(pError->found, pStack->pAlphabet->closings[closedKind]);
+
+    if (openedKind == NOT_PARENTHESIS)
+    {
+        pError->kind = VALIDATOR_STRAY_CLOSER;
+        pError->expected[0] = '\0';
+        pError->hasOpener = 0;
+    }
+    else
+    {
+        // The popped position is still in the Stack, right above its top.
+        pError->kind = VALIDATOR_MISMATCHED_PAIR;
+        strcpy(pError->expected, pStack->pAlphabet->closings[openedKind]);
+        pError->hasOpener = pStack->tracksPositions;
+        if (pError->hasOpener)
+        {
+            pError->opener = pStack->positions[pStack->size];
+        }
+    }
+    return VALIDATOR_INVALID;
+}
+
+
+/*----=  Scanners  =-----*/
+
+
+/**
+ * @brief Applies the Parenthesis located by a scanner to the given Stack.
+ *        In case we reached any kind of Opening-Parenthesis, we push its kind to the Stack.
+ *        In case we reached any kind of Closing-Parenthesis, it is valid only if it closes the
+ *        Opening-Parenthesis at the top of the Stack. A Parenthesis which both opens and closes
+ *        closes the top of the Stack if it is of its kind, and opens otherwise.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param block The block of data the mask refers to.
+ * @param mask A mask of the Parenthesis positions in the block, bit i stands for block[i].
+ * @param plain Non zero if the alphabet is known to have neither Parenthesis of a few bytes nor
+ *        Parenthesis which both open and close, so these checks are skipped.
+ * @param annotated Non zero if the Stack keeps a profile or an index, so the Parenthesis are
+ *        recorded in them.
+ * @return 0 if the Parenthesis do not break the required parenthesis structure, 1 if they do and
+ *         2 if the Stack exceeds its depth limit or the memory.
+ */
+__attribute__((always_inline))
+static inline int walkParenthesis(ParenthesisStack * const pStack,
+                                  unsigned char const * const block, uint64_t mask,
+                                  int const plain, int const annotated)
+{
+    unsigned char const * const classes = pStack->pAlphabet->classes;
+    while (mask != 0)
+    {
+        unsigned char const * const pCharacter = block + __builtin_ctzll(mask);
+        mask &= mask - 1;
+
+        int const byteClass = classes[*pCharacter];
+        if (!plain && (byteClass & SEQUENCE_CLASS) &&
+            !matchesSequence(pStack, pCharacter, classParenthesis(pStack->pAlphabet, byteClass)))
+        {
+            continue;
+        }
+#ifdef VALIDATOR_STATISTICS
+        pStack->parenthesisNumber++;
+#endif
+
+        int const kind = byteClass & KIND_CLASS_MASK;
+        if (!(byteClass & CLOSING_CLASS) ||
+            (!plain && (byteClass & OPENING_CLASS) &&
+             (pStack->size == INITIAL_SCOPE_NUMBER ||
+              parenthesisAt(pStack, pStack->size - 1) != kind)))
+        {
+            if (pushParenthesis(pStack, kind))
+            {
+                return VALIDATOR_LIMIT_EXCEEDED;
+            }
+            if (pStack->tracksPositions)
+            {
+                setTopPosition(pStack, parenthesisOffset(pStack, pCharacter, byteClass));
+            }
+            if (annotated &&
+                annotateOpener(pStack, parenthesisOffset(pStack, pCharacter, byteClass), kind))
+            {
+                return VALIDATOR_LIMIT_EXCEEDED;
+            }
+#ifdef VALIDATOR_STATISTICS
+            countDepth(pStack);
+#endif
+        }
+        else if (pStack->size == INITIAL_SCOPE_NUMBER)
+        {
+            // A Closing-Parenthesis with nothing to close, it might close a Parenthesis of
+            // a previous chunk.
+            if (pStack->pUnmatched == NULL)
+            {
+                return breakStructure(pStack, parenthesisOffset(pStack, pCharacter, byteClass),
+                                      kind, NOT_PARENTHESIS);
+            }
+            if (pushParenthesis(pStack->pUnmatched, kind))
+            {
+                return VALIDATOR_LIMIT_EXCEEDED;
+            }
+            if (pStack->pUnmatched->tracksPositions)
+            {
+                setTopPosition(pStack->pUnmatched,
+                               parenthesisOffset(pStack, pCharacter, byteClass));
+            }
+            // A pair split between chunks is indexed once the chunks are merged.
+            if (annotated && pStack->pProfile != NULL)
+            {
+                profileCloser(pStack, parenthesisOffset(pStack, pCharacter, byteClass));
+            }
+        }
+        else
+        {
+            int const openedKind = popParenthesis(pStack);
+            if (openedKind != kind)
+            {
+                return breakStructure(pStack, parenthesisOffset(pStack, pCharacter, byteClass),
+                                      kind, openedKind);
+            }
+            if (annotated &&
+                annotateCloser(pStack, parenthesisOffset(pStack, pCharacter, byteClass)))
+            {
+                return VALIDATOR_LIMIT_EXCEEDED;
+            }
+        }
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Applies the Parenthesis located by a scanner to the given Stack, as walkParenthesis
+ *        does. The profile and the index are checked once for the whole mask, rather than for
+ *        each Parenthesis.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param block The block of data the mask refers to.
+ * @param mask A mask of the Parenthesis positions in the block, bit i stands for block[i].
+ * @param plain Non zero if the alphabet is known to have neither Parenthesis of a few bytes nor
+ *        Parenthesis which both open and close, so these checks are skipped.
+ * @return 0 if the Parenthesis do not break the required parenthesis structure, 1 if they do and
+ *         2 if the Stack exceeds its depth limit or the memory.
+ */
+static inline int applyParenthesis(ParenthesisStack * const pStack,
+                                   unsigned char const * const block, uint64_t const mask,
+                                   int const plain)
+{
+    if (pStack->pProfile != NULL || pStack->pIndex != NULL)
+    {
+        return walkParenthesis(pStack, block, mask, plain, 1);
+    }
+    return walkParenthesis(pStack, block, mask, plain, 0);
+}
+
+/**
+ * @brief Classifies up to BLOCK_SIZE bytes one byte at a time.
+ * @param pAlphabet The alphabet of the Parenthesis.
+ * @param block The block of data to classify.
+ * @param length The number of bytes in the block.
+ * @return A mask of the Parenthesis positions in the block.
+ */
+static inline uint64_t scalarMask(ParenthesisAlphabet const * const pAlphabet,
+                                  unsigned char const * const block, size_t const length)
+{
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (pAlphabet->classes[block[i]] != 0)
+        {
+            mask |= (uint64_t) 1 << i;
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Locates the bytes of the lexer in up to BLOCK_SIZE bytes, one byte at a time.
+ * @param pLexer The lexical state.
+ * @param block The block of data to classify.
+ * @param length The number of bytes in the block.
+ * @param masks The address to store a mask of the positions of every located byte in.
+ */
+static inline void lexicalMasks(Lexer const * const pLexer, unsigned char const * const block,
+                                size_t const length, uint64_t masks[LEXER_BYTES_CAPACITY + 1])
+{
+    memset(masks, 0, LEXER_BYTES_CAPACITY * sizeof(uint64_t));
+    masks[ANY_INDEX] = ~(uint64_t) 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        int const index = pLexer->indexes[block[i]];
+        if (index != 0)
+        {
+            masks[index - 1] |= (uint64_t) 1 << i;
+        }
+    }
+}
+
+/**
+ * @brief Finds the bytes of a block which may end a delimiter that changes the given lexical
+ *        state. A byte is found if the bytes before it in the block match the rest of the
+ *        delimiter, the first bytes of the block are found as they may continue the previous one.
+ * @param pLexer The lexical state.
+ * @param masks A mask of the positions of every byte located for the lexer.
+ * @param state The lexical state.
+ * @return A mask of the positions which may end a delimiter.
+ */
+static inline uint64_t delimitersMask(Lexer const * const pLexer,
+                                      uint64_t const masks[LEXER_BYTES_CAPACITY + 1],
+                                      int const state)
+{
+    uint64_t events = 0;
+    for (size_t i = 0; i < pLexer->delimitersNumbers[state]; ++i)
+    {
+        unsigned char const * const indexes = pLexer->delimiters[state][i];
+        uint64_t mask = masks[indexes[0]];
+#pragma GCC unroll 4
+        for (size_t distance = 1; distance < VALIDATOR_MAX_COMMENT_LENGTH; ++distance)
+        {
+            mask &= (masks[indexes[distance]] << distance) | (((uint64_t) 1 << distance) - 1);
+        }
+        events |= mask;
+    }
+    return events;
+}
+
+/**
+ * @brief Finds the escaped bytes of a block, which are the bytes right after an odd sequence of
+ *        backslashes. The sequences are found by adding their starts to them, as simdjson does,
+ *        so the carry of the addition passes the end of every sequence.
+ * @param pLexer The lexical state, which carries an escape to the next block.
+ * @param escapes A mask of the backslash positions in the block.
+ * @param length The number of bytes in the block.
+ * @return A mask of the escaped positions in the block.
+ */
+static inline uint64_t escapedMask(Lexer * const pLexer, uint64_t const escapes,
+                                   size_t const length)
+{
+    uint64_t const starts = escapes & ~(escapes << 1);
+    uint64_t const evenStartsMask = EVEN_BITS ^ pLexer->escapedCarry;
+    uint64_t const evenCarries = escapes + (starts & evenStartsMask);
+    unsigned long long oddCarries;
+    uint64_t const carry = __builtin_uaddll_overflow(escapes, starts & ~evenStartsMask,
+                                                     &oddCarries);
+    oddCarries |= pLexer->escapedCarry;
+
+    uint64_t const escaped = (evenCarries & ~escapes & ~EVEN_BITS) |
+                             (oddCarries & ~escapes & EVEN_BITS);
+    pLexer->escapedCarry = (length == BLOCK_SIZE) ? carry : (escaped >> length) & 1;
+    return escaped;
+}
+
+/**
+ * @brief Applies the Parenthesis and the lexical bytes located by a scanner to the given Stack.
+ *        The delimiters which may end the current lexical state are applied in order, and the
+ *        Parenthesis between every two of them are applied at once if they are in the code.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param block The block of data the masks refer to.
+ * @param parenthesis A mask of the Parenthesis positions in the block.
+ * @param masks A mask of the positions of every byte located for the lexer.
+ * @param length The number of bytes in the block.
+ * @return 0 if the Parenthesis do not break the required parenthesis structure, 1 if they do and
+ *         2 if the Stack exceeds its depth limit or the memory.
+ */
+static inline int applyLexicalBlock(ParenthesisStack * const pStack,
+                                    unsigned char const * const block, uint64_t parenthesis,
+                                    uint64_t const masks[LEXER_BYTES_CAPACITY + 1],
+                                    size_t const length)
+{
+    Lexer * const pLexer = pStack->pLexer;
+    uint64_t escaped = 0;
+    if (masks[ESCAPE_INDEX] != 0 || pLexer->escapedCarry != 0)
+    {
+        escaped = escapedMask(pLexer, masks[ESCAPE_INDEX], length);
+    }
+
+    // The positions up to the last applied delimiter, which are skipped once the state changes.
+    uint64_t applied = 0;
+    int state = pLexer->state;
+    uint64_t events = delimitersMask(pLexer, masks, state) & ~escaped;
+    while (1)
+    {
+        // The lowest event bit, or 0 if there is none, so everything is below it.
+        uint64_t const event = events & (0 - events);
+        uint64_t const before = parenthesis & (event - 1);
+        if (state == CODE_STATE && before != 0)
+        {
+            int const result = applyParenthesis(pStack, block, before, pStack->pAlphabet->plain);
+            if (result != VALIDATOR_VALID)
+            {
+                return result;
+            }
+        }
+        if (event == 0)
+        {
+            return VALIDATOR_VALID;
+        }
+
+        applied = event | (event - 1);
+        parenthesis &= ~applied;
+        events &= events - 1;
+        lexCharacter(pStack, block + __builtin_ctzll(event));
+        if (pLexer->state != state)
+        {
+            state = pLexer->state;
+            events = delimitersMask(pLexer, masks, state) & ~escaped & ~applied;
+        }
+    }
+}
+
+/**
+ * @brief Selects a scanner by its name.
+ * @param name The name of the scanner, or NULL for the widest scanner the CPU supports.
+ * @param pAlphabet The alphabet the scanner locates, or NULL for any alphabet.
+ * @return The selected scanner, or NULL if the scanner is unknown or unsupported by the CPU.
+ */
+static ScanFunction selectScanner(char const * const name,
+                                  ParenthesisAlphabet const * const pAlphabet)
+{
+    int const specialization = (pAlphabet != NULL) ? pAlphabet->specialization :
+                                                     GENERIC_ALPHABET;
+    ScanFunction const scalarScanner = (specialization == LEXICAL_ALPHABET) ? scanLexicalScalar :
+                                                                              scanScalar;
+
+#ifdef VECTOR_SCANNERS
+    // The scanners of every width, indexed by the specialization of the alphabet.
+    static ScanFunction const sse2Scanners[] = {scanSse2, scanSse2Default, scanSse2Braces,
+                                                scanLexicalSse2};
+    static ScanFunction const avx2Scanners[] = {scanAvx2, scanAvx2Default, scanAvx2Braces,
+                                                scanLexicalAvx2};
+
+    __builtin_cpu_init();
+    int const hasAvx2 = __builtin_cpu_supports("avx2");
+    int const hasSse2 = __builtin_cpu_supports("sse2");
+
+    if (name == NULL)
+    {
+        return hasAvx2 ? avx2Scanners[specialization] :
+               hasSse2 ? sse2Scanners[specialization] : scalarScanner;
+    }
+    if (strcmp(name, VALIDATOR_AVX2_SCANNER) == 0)
+    {
+        return hasAvx2 ? avx2Scanners[specialization] : NULL;
+    }
+    if (strcmp(name, VALIDATOR_SSE2_SCANNER) == 0)
+    {
+        return hasSse2 ? sse2Scanners[specialization] : NULL;
+    }
+#endif
+
+    if (name == NULL || strcmp(name, VALIDATOR_SCALAR_SCANNER) == 0)
+    {
+        return scalarScanner;
+    }
+    return NULL;
+}
+
+/**
+ * @brief A scanner which classifies the data byte by byte.
+ */
+static int scanScalar(ParenthesisStack * const pStack, unsigned char const * const data,
+                      size_t const length)
+{
+    for (size_t offset = 0; offset < length; offset += BLOCK_SIZE)
+    {
+        size_t const blockLength = length - offset < BLOCK_SIZE ? length - offset : BLOCK_SIZE;
+        int const result = applyParenthesis(pStack, data + offset,
+                                            scalarMask(pStack->pAlphabet, data + offset,
+                                                       blockLength), 0);
+        if (result != VALIDATOR_VALID)
+        {
+            return result;
+        }
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief A scanner which classifies the data byte by byte, skipping literals and comments.
+ */
+static int scanLexicalScalar(ParenthesisStack * const pStack, unsigned char const * const data,
+                             size_t const length)
+{
+    for (size_t offset = 0; offset < length; offset += BLOCK_SIZE)
+    {
+        unsigned char const * const block = data + offset;
+        size_t const blockLength = length - offset < BLOCK_SIZE ? length - offset : BLOCK_SIZE;
+        uint64_t masks[LEXER_BYTES_CAPACITY + 1];
+        lexicalMasks(pStack->pLexer, block, blockLength, masks);
+        int const result = applyLexicalBlock(pStack, block,
+                                             scalarMask(pStack->pAlphabet, block, blockLength),
+                                             masks, blockLength);
+        if (result != VALIDATOR_VALID)
+        {
+            return result;
+        }
+    }
+    return VALIDATOR_VALID;
+}
+
+#ifdef VECTOR_SCANNERS
+
+/**
+ * @brief Classifies 16 bytes using SSE2 byte comparisons.
+ * @param block The block of data to classify.
+ * @param needles The bytes which end a Parenthesis, each repeated over a whole vector.
+ * @param needlesNumber The number of needles.
+ * @return A mask of the Parenthesis positions in the block.
+ */
+__attribute__((target("sse2")))
+static inline uint64_t sse2Mask(unsigned char const * const block, __m128i const * const needles,
+                                size_t const needlesNumber)
+{
+    __m128i const bytes = _mm_loadu_si128((__m128i const *) block);
+    __m128i matches = _mm_setzero_si128();
+#pragma GCC unroll 32
+    for (size_t i = 0; i < needlesNumber; ++i)
+    {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, needles[i]));
+    }
+    return (uint64_t) (unsigned int) _mm_movemask_epi8(matches);
+}
+
+/**
+ * @brief Scans the data 16 bytes at a time using SSE2 instructions, this is the body of the SSE2
+ *        scanners. When it is inlined with constant triggers the comparisons are unrolled.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param data The data to check.
+ * @param length The number of bytes in the data.
+ * @param triggers The bytes which end a Parenthesis.
+ * @param triggersNumber The number of triggers.
+ * @param plain Non zero if the alphabet has neither Parenthesis of a few bytes nor Parenthesis
+ *        which both open and close.
+ * @return 0 if the data does not break the required parenthesis structure, 1 if it does and
+ *         2 if the Stack exceeds its depth limit or the memory.
+ */
+__attribute__((target("sse2"), always_inline))
+static inline int scanSse2Blocks(ParenthesisStack * const pStack,
+                                 unsigned char const * const data, size_t const length,
+                                 unsigned char const * const triggers,
+                                 size_t const triggersNumber, int const plain)
+{
+    __m128i needles[2 * VALIDATOR_MAX_PAIRS];
+#pragma GCC unroll 32
+    for (size_t i = 0; i < triggersNumber; ++i)
+    {
+        needles[i] = _mm_set1_epi8((char) triggers[i]);
+    }
+
+    size_t offset = 0;
+    for ( ; offset + BLOCK_SIZE <= length; offset += BLOCK_SIZE)
+    {
+        uint64_t const mask = sse2Mask(data + offset, needles, triggersNumber) |
+                              sse2Mask(data + offset + 16, needles, triggersNumber) << 16 |
+                              sse2Mask(data + offset + 32, needles, triggersNumber) << 32 |
+                              sse2Mask(data + offset + 48, needles, triggersNumber) << 48;
+        int const result = applyParenthesis(pStack, data + offset, mask, plain);
+        if (result != VALIDATOR_VALID)
+        {
+            return result;
+        }
+    }
+    return applyParenthesis(pStack, data + offset,
+                            scalarMask(pStack->pAlphabet, data + offset, length - offset), plain);
+}
+
+/**
+ * @brief A scanner which classifies the data 16 bytes at a time using SSE2 instructions.
+ */
+__attribute__((target("sse2")))
+static int scanSse2(ParenthesisStack * const pStack, unsigned char const * const data,
+                    size_t const length)
+{
+    return scanSse2Blocks(pStack, data, length, pStack->pAlphabet->triggers,
+                          pStack->pAlphabet->triggersNumber, 0);
+}
+
+/**
+ * @brief A scanner of the default alphabet which classifies the data 16 bytes at a time using
+ *        SSE2 instructions.
+ */
+__attribute__((target("sse2")))
+static int scanSse2Default(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length)
+{
+    return scanSse2Blocks(pStack, data, length,
+                          (unsigned char const *) VALIDATOR_DEFAULT_PAIRS,
+                          sizeof(VALIDATOR_DEFAULT_PAIRS) - 1, 1);
+}
+
+/**
+ * @brief A scanner of the braces alphabet which classifies the data 16 bytes at a time using
+ *        SSE2 instructions.
+ */
+__attribute__((target("sse2")))
+static int scanSse2Braces(ParenthesisStack * const pStack, unsigned char const * const data,
+                          size_t const length)
+{
+    return scanSse2Blocks(pStack, data, length, (unsigned char const *) BRACES_PAIRS,
+                          sizeof(BRACES_PAIRS) - 1, 1);
+}
+
+/**
+ * @brief Classifies BLOCK_SIZE bytes using SSE2 byte comparisons.
+ * @param block The block of data to classify.
+ * @param needles The bytes to locate, each repeated over a whole vector.
+ * @param needlesNumber The number of needles.
+ * @return A mask of the positions of the needles in the block.
+ */
+__attribute__((target("sse2"), always_inline))
+static inline uint64_t sse2BlockMask(unsigned char const * const block,
+                                     __m128i const * const needles, size_t const needlesNumber)
+{
+    return sse2Mask(block, needles, needlesNumber) |
+           sse2Mask(block + 16, needles, needlesNumber) << 16 |
+           sse2Mask(block + 32, needles, needlesNumber) << 32 |
+           sse2Mask(block + 48, needles, needlesNumber) << 48;
+}
+
+/**
+ * @brief A scanner which classifies the data 16 bytes at a time using SSE2 instructions, skipping
+ *        literals and comments.
+ */
+__attribute__((target("sse2")))
+static int scanLexicalSse2(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length)
+{
+    ParenthesisAlphabet const * const pAlphabet = pStack->pAlphabet;
+    Lexer const * const pLexer = pStack->pLexer;
+    __m128i needles[2 * VALIDATOR_MAX_PAIRS];
+    for (size_t i = 0; i < pAlphabet->triggersNumber; ++i)
+    {
+        needles[i] = _mm_set1_epi8((char) pAlphabet->triggers[i]);
+    }
+    __m128i bytes[LEXER_BYTES_CAPACITY];
+    for (size_t i = 0; i < pLexer->bytesNumber; ++i)
+    {
+        bytes[i] = _mm_set1_epi8((char) pLexer->bytes[i]);
+    }
+
+    size_t offset = 0;
+    for ( ; offset + BLOCK_SIZE <= length; offset += BLOCK_SIZE)
+    {
+        unsigned char const * const block = data + offset;
+        uint64_t masks[LEXER_BYTES_CAPACITY + 1];
+        masks[ANY_INDEX] = ~(uint64_t) 0;
+        for (size_t i = 0; i < pLexer->bytesNumber; ++i)
+        {
+            masks[i] = sse2BlockMask(block, &bytes[i], 1);
+        }
+        int const result = applyLexicalBlock(pStack, block,
+                                             sse2BlockMask(block, needles,
+                                                           pAlphabet->triggersNumber),
+                                             masks, BLOCK_SIZE);
+        if (result != VALIDATOR_VALID)
+        {
+            return result;
+        }
+    }
+    return scanLexicalScalar(pStack, data + offset, length - offset);
+}
+
+/**
+ * @brief Classifies 32 bytes using AVX2 byte comparisons.
+ * @param block The block of data to classify.
+ * @param needles The bytes which end a Parenthesis, each repeated over a whole vector.
+ * @param needlesNumber The number of needles.
+ * @return A mask of the Parenthesis positions in the block.
+ */
+__attribute__((target("avx2")))
+static inline uint64_t avx2Mask(unsigned char const * const block, __m256i const * const needles,
+                                size_t const needlesNumber)
+{
+    __m256i const bytes = _mm256_loadu_si256((__m256i const *) block);
+    __m256i matches = _mm256_setzero_si256();
+#pragma GCC unroll 32
+    for (size_t i = 0; i < needlesNumber; ++i)
+    {
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(bytes, needles[i]));
+    }
+    return (uint64_t) (unsigned int) _mm256_movemask_epi8(matches);
+}
+
+/**
+ * @brief Scans the data 32 bytes at a time using AVX2 instructions, this is the body of the AVX2
+ *        scanners. When it is inlined with constant triggers the comparisons are unrolled.
+ * @param pStack The Stack of the currently opened Parenthesis.
+ * @param data The data to check.
+ * @param length The number of bytes in the data.
+ * @param triggers The bytes which end a Parenthesis.
+ * @param triggersNumber The number of triggers.
+ * @param plain Non zero if the alphabet has neither Parenthesis of a few bytes nor Parenthesis
+ *        which both open and close.
+ * @return 0 if the data does not break the required parenthesis structure, 1 if it does and
+ *         2 if the Stack exceeds its depth limit or the memory.
+ */
+__attribute__((target("avx2"), always_inline))
+static inline int scanAvx2Blocks(ParenthesisStack * const pStack,
+                                 unsigned char const * const data, size_t const length,
+                                 unsigned char const * const triggers,
+                                 size_t const triggersNumber, int const plain)
+{
+    __m256i needles[2 * VALIDATOR_MAX_PAIRS];
+#pragma GCC unroll 32
+    for (size_t i = 0; i < triggersNumber; ++i)
+    {
+        needles[i] = _mm256_set1_epi8((char) triggers[i]);
+    }
+
+    size_t offset = 0;
+    for ( ; offset + BLOCK_SIZE <= length; offset += BLOCK_SIZE)
+    {
+        uint64_t const mask = avx2Mask(data + offset, needles, triggersNumber) |
+                              avx2Mask(data + offset + 32, needles, triggersNumber) << 32;
+        int const result = applyParenthesis(pStack, data + offset, mask, plain);
+        if (result != VALIDATOR_VALID)
+        {
+            return result;
+        }
+    }
+    return applyParenthesis(pStack, data + offset,
+                            scalarMask(pStack->pAlphabet, data + offset, length - offset), plain);
+}
+
+/**
+ * @brief A scanner which classifies the data 32 bytes at a time using AVX2 instructions.
+ */
+__attribute__((target("avx2")))
+static int scanAvx2(ParenthesisStack * const pStack, unsigned char const * const data,
+                    size_t const length)
+{
+    return scanAvx2Blocks(pStack, data, length, pStack->pAlphabet->triggers,
+                          pStack->pAlphabet->triggersNumber, 0);
+}
+
+/**
+ * @brief A scanner of the default alphabet which classifies the data 32 bytes at a time using
+ *        AVX2 instructions.
+ */
+__attribute__((target("avx2")))
+static int scanAvx2Default(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length)
+{
+    return scanAvx2Blocks(pStack, data, length,
+                          (unsigned char const *) VALIDATOR_DEFAULT_PAIRS,
+                          sizeof(VALIDATOR_DEFAULT_PAIRS) - 1, 1);
+}
+
+/**
+ * @brief A scanner of the braces alphabet which classifies the data 32 bytes at a time using
+ *        AVX2 instructions.
+ */
+__attribute__((target("avx2")))
+static int scanAvx2Braces(ParenthesisStack * const pStack, unsigned char const * const data,
+                          size_t const length)
+{
+    return scanAvx2Blocks(pStack, data, length, (unsigned char const *) BRACES_PAIRS,
+                          sizeof(BRACES_PAIRS) - 1, 1);
+}
+
+/**
+ * @brief Classifies BLOCK_SIZE bytes using AVX2 byte comparisons.
+ * @param block The block of data to classify.
+ * @param needles The bytes to locate, each repeated over a whole vector.
+ * @param needlesNumber The number of needles.
+ * @return A mask of the positions of the needles in the block.
+ */
+__attribute__((target("avx2"), always_inline))
+static inline uint64_t avx2BlockMask(unsigned char const * const block,
+                                     __m256i const * const needles, size_t const needlesNumber)
+{
+    return avx2Mask(block, needles, needlesNumber) |
+           avx2Mask(block + 32, needles, needlesNumber) << 32;
+}
+
+/**
+ * @brief A scanner which classifies the data 32 bytes at a time using AVX2 instructions, skipping
+ *        literals and comments.
+ */
+__attribute__((target("avx2")))
+static int scanLexicalAvx2(ParenthesisStack * const pStack, unsigned char const * const data,
+                           size_t const length)
+{
+    ParenthesisAlphabet const * const pAlphabet = pStack->pAlphabet;
+    Lexer const * const pLexer = pStack->pLexer;
+    __m256i needles[2 * VALIDATOR_MAX_PAIRS];
+    for (size_t i = 0; i < pAlphabet->triggersNumber; ++i)
+    {
+        needles[i] = _mm256_set1_epi8((char) pAlphabet->triggers[i]);
+    }
+    __m256i bytes[LEXER_BYTES_CAPACITY];
+    for (size_t i = 0; i < pLexer->bytesNumber; ++i)
+    {
+        bytes[i] = _mm256_set1_epi8((char) pLexer->bytes[i]);
+    }
+
+    size_t offset = 0;
+    for ( ; offset + BLOCK_SIZE <= length; offset += BLOCK_SIZE)
+    {
+        unsigned char const * const block = data + offset;
+        uint64_t masks[LEXER_BYTES_CAPACITY + 1];
+        masks[ANY_INDEX] = ~(uint64_t) 0;
+        for (size_t i = 0; i < pLexer->bytesNumber; ++i)
+        {
+            masks[i] = avx2BlockMask(block, &bytes[i], 1);
+        }
+        int const result = applyLexicalBlock(pStack, block,
+                                             avx2BlockMask(block, needles,
+                                                           pAlphabet->triggersNumber),
+                                             masks, BLOCK_SIZE);
+        if (result != VALIDATOR_VALID)
+        {
+            return result;
+        }
+    }
+    return scanLexicalScalar(pStack, data + offset, length - offset);
+}
+
+#endif
+
+
+/*----=  Parenthesis Stack  =-----*/
+
+
+/**
+ * @brief Push an Opening-Parenthesis kind to the top of the given Stack, the Stack grows if
+ *        it is full.
+ * @param pStack The Stack to push to.
+ * @param kind The kind of the opened Parenthesis.
+ * @return 0 if the kind was pushed, 2 if the Stack exceeds its depth limit or the memory.
+ */
+static int pushParenthesis(ParenthesisStack * const pStack, int const kind)
+{
+    if (pStack->size == pStack->maxDepth && pStack->maxDepth != VALIDATOR_UNLIMITED_DEPTH)
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    // Double the capacity of the Stack when it is full, so it is bounded by twice the depth.
+    if (pStack->size == pStack->capacity)
+    {
+        size_t capacity = pStack->capacity ? pStack->capacity * 2 : INITIAL_STACK_CAPACITY;
+        unsigned char * kinds = realloc(pStack->kinds, capacity / KINDS_PER_BYTE);
+        if (kinds == NULL)
+        {
+            return VALIDATOR_LIMIT_EXCEEDED;
+        }
+        pStack->kinds = kinds;
+
+        if (pStack->tracksPositions)
+        {
+            ValidatorPosition * positions = realloc(pStack->positions,
+                                                    capacity * sizeof(ValidatorPosition));
+            if (positions == NULL)
+            {
+                return VALIDATOR_LIMIT_EXCEEDED;
+            }
+            pStack->positions = positions;
+        }
+        pStack->capacity = capacity;
+    }
+
+    size_t const byteIndex = pStack->size / KINDS_PER_BYTE;
+    int const shift = (int) (pStack->size % KINDS_PER_BYTE) * KIND_BITS;
+    pStack->kinds[byteIndex] = (unsigned char) ((pStack->kinds[byteIndex] &
+                                                 ~(KIND_MASK << shift)) | (kind << shift));
+    pStack->size++;
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Remove the Opening-Parenthesis kind at the top of the given Stack.
+ * @param pStack The Stack to pop from, it must not be empty.
+ * @return The kind of the removed Parenthesis.
+ */
+static int popParenthesis(ParenthesisStack * const pStack)
+{
+    pStack->size--;
+    return parenthesisAt(pStack, pStack->size);
+}
+
+/**
+ * @brief Returns the Opening-Parenthesis kind at the given index of the given Stack.
+ * @param pStack The Stack to read from.
+ * @param index The index to read, it must be smaller than the size of the Stack.
+ * @return The kind of the Parenthesis.
+ */
+static int parenthesisAt(ParenthesisStack const * const pStack, size_t const index)
+{
+    int const shift = (int) (index % KINDS_PER_BYTE) * KIND_BITS;
+    return (pStack->kinds[index / KINDS_PER_BYTE] >> shift) & KIND_MASK;
+}
+
+/**
+ * @brief Sets the position of the Parenthesis at the top of the given Stack, which keeps
+ *        positions. The line of the position is not known yet.
+ * @param pStack The Stack to set.
+ * @param offset The offset of the Parenthesis in the stream.
+ */
+static void setTopPosition(ParenthesisStack * const pStack, unsigned long long const offset)
+{
+    ValidatorPosition * const pPosition = &pStack->positions[pStack->size - 1];
+    pPosition->offset = offset;
+    pPosition->line = VALIDATOR_UNKNOWN_LINE;
+    pPosition->column = VALIDATOR_UNKNOWN_LINE;
+}
+
+/**
+ * @brief Records the Opening-Parenthesis just pushed to the given Stack in its profile and its
+ *        index, those which are kept.
+ * @param pStack The Stack.
+ * @param offset The offset of the Parenthesis in the stream.
+ * @param kind The kind of the Parenthesis.
+ * @return 0 if the Parenthesis was recorded, 2 if there is not enough memory.
+ */
+static int annotateOpener(ParenthesisStack * const pStack, unsigned long long const offset,
+                          int const kind)
+{
+    if (pStack->pProfile != NULL && profileOpener(pStack, offset))
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+    if (pStack->pIndex != NULL)
+    {
+        return openPair(pStack->pIndex, offset, kind);
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Records the Closing-Parenthesis which just closed the top of the given Stack in its
+ *        profile and its index, those which are kept.
+ * @param pStack The Stack, after the pair was popped.
+ * @param offset The offset of the Parenthesis in the stream.
+ * @return 0 if the Parenthesis was recorded, 2 if there is not enough memory.
+ */
+static int annotateCloser(ParenthesisStack * const pStack, unsigned long long const offset)
+{
+    if (pStack->pProfile != NULL)
+    {
+        profileCloser(pStack, offset);
+    }
+    if (pStack->pIndex != NULL)
+    {
+        return closePair(pStack->pIndex, offset);
+    }
+    return VALIDATOR_VALID;
+}
+
+
+/*----=  Depth Profile  =-----*/
+
+
+/**
+ * @brief Adds the given count to the counter of the given index, the counters grow if needed.
+ * @param pCounts The counters.
+ * @param index The index of the counter.
+ * @param count The count to add.
+ * @return 0 if the count was added, 2 if there is not enough memory.
+ */
+static int countDepths(DepthCounts * const pCounts, size_t const index,
+                       unsigned long long const count)
+{
+    if (index >= pCounts->capacity)
+    {
+        size_t capacity = pCounts->capacity ? pCounts->capacity : INITIAL_STACK_CAPACITY;
+        while (capacity <= index)
+        {
+            capacity *= 2;
+        }
+        unsigned long long * const counts = realloc(pCounts->counts,
+                                                    capacity * sizeof(unsigned long long));
+        if (counts == NULL)
+        {
+            return VALIDATOR_LIMIT_EXCEEDED;
+        }
+        memset(counts + pCounts->capacity, 0,
+               (capacity - pCounts->capacity) * sizeof(unsigned long long));
+        pCounts->counts = counts;
+        pCounts->capacity = capacity;
+    }
+
+    pCounts->counts[index] += count;
+    if (index >= pCounts->number)
+    {
+        pCounts->number = index + 1;
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Profiles the Opening-Parenthesis just pushed to the given Stack, which keeps a profile.
+ * @param pStack The Stack.
+ * @param offset The offset of the Parenthesis in the stream.
+ * @return 0 if the Parenthesis was profiled, 2 if there is not enough memory.
+ */
+static int profileOpener(ParenthesisStack * const pStack, unsigned long long const offset)
+{
+    DepthProfile * const pProfile = pStack->pProfile;
+    pProfile->applied = 1;
+    pProfile->opened = 1;
+    pProfile->lastOpener = offset;
+
+    // As in 'countDepth', the unmatched Closing-Parenthesis lowered the start of the chunk.
+    size_t const closed = (pStack->pUnmatched != NULL) ? pStack->pUnmatched->size : 0;
+    if (pStack->size > closed)
+    {
+        return countDepths(&pProfile->deeper, pStack->size - closed - 1, 1);
+    }
+    return countDepths(&pProfile->shallower, closed - pStack->size, 1);
+}
+
+/**
+ * @brief Profiles the Closing-Parenthesis just applied to the given Stack, which keeps a
+ *        profile. If it closed the last Opening-Parenthesis applied, their pair is a region.
+ * @param pStack The Stack, after the pair was popped.
+ * @param offset The offset of the Parenthesis in the stream.
+ */
+static void profileCloser(ParenthesisStack * const pStack, unsigned long long const offset)
+{
+    DepthProfile * const pProfile = pStack->pProfile;
+    if (pProfile->opened)
+    {
+        size_t const closed = (pStack->pUnmatched != NULL) ? pStack->pUnmatched->size : 0;
+        keepRegion(pProfile, (long long) pStack->size + 1 - (long long) closed,
+                   pProfile->lastOpener, offset);
+    }
+    else if (!pProfile->applied)
+    {
+        pProfile->closesFirst = 1;
+        pProfile->firstCloser = offset;
+    }
+    pProfile->applied = 1;
+    pProfile->opened = 0;
+}
+
+/**
+ * @brief Keeps the given region in the given profile, if it is among its deepest regions.
+ * @param pProfile The profile.
+ * @param depth The depth of the region.
+ * @param opener The offset of the Opening-Parenthesis of the region.
+ * @param closer The offset of the Closing-Parenthesis of the region.
+ */
+static void keepRegion(DepthProfile * const pProfile, long long const depth,
+                       unsigned long long const opener, unsigned long long const closer)
+{
+    // The regions are sorted, so a region which is not deeper than the last one is dropped at
+    // once, and the order does not depend on the order the regions are kept in.
+    ProfileRegion * const regions = pProfile->regions;
+    size_t index = pProfile->regionsNumber;
+    while (index > 0 && (regions[index - 1].depth < depth ||
+                         (regions[index - 1].depth == depth && regions[index - 1].opener > opener)))
+    {
+        index--;
+    }
+    if (index >= pProfile->regionsCapacity)
+    {
+        return;
+    }
+
+    if (pProfile->regionsNumber < pProfile->regionsCapacity)
+    {
+        pProfile->regionsNumber++;
+    }
+    memmove(&regions[index + 1], &regions[index],
+            (pProfile->regionsNumber - 1 - index) * sizeof(ProfileRegion));
+    regions[index].depth = depth;
+    regions[index].opener = opener;
+    regions[index].closer = closer;
+}
+
+/**
+ * @brief Merges the profile of the next chunk of data into the given profile.
+ * @param pProfile The profile of all the previous chunks.
+ * @param pChunk The profile of the next chunk, relative to its start.
+ * @param base The depth the chunk starts at.
+ * @return 0 if the profile was merged, 2 if there is not enough memory.
+ */
+static int mergeChunkProfile(DepthProfile * const pProfile, DepthProfile const * const pChunk,
+                             size_t const base)
+{
+    // A pair split between the chunks is a region if the chunk starts by closing it.
+    if (pProfile->opened && pChunk->closesFirst)
+    {
+        keepRegion(pProfile, (long long) base, pProfile->lastOpener, pChunk->firstCloser);
+    }
+    if (pChunk->applied)
+    {
+        pProfile->applied = 1;
+        pProfile->opened = pChunk->opened;
+        pProfile->lastOpener = pChunk->lastOpener;
+    }
+
+    // Every depth below the start of the chunk closed a Parenthesis of the previous chunks, so
+    // the shifted depths are at least 1.
+    for (size_t i = 0; i < pChunk->deeper.number; ++i)
+    {
+        if (countDepths(&pProfile->deeper, base + i, pChunk->deeper.counts[i]))
+        {
+            return VALIDATOR_LIMIT_EXCEEDED;
+        }
+    }
+    for (size_t i = 0; i < pChunk->shallower.number; ++i)
+    {
+        if (countDepths(&pProfile->deeper, base - i - 1, pChunk->shallower.counts[i]))
+        {
+            return VALIDATOR_LIMIT_EXCEEDED;
+        }
+    }
+    for (size_t i = 0; i < pChunk->regionsNumber; ++i)
+    {
+        ProfileRegion const * const pRegion = &pChunk->regions[i];
+        keepRegion(pProfile, (long long) base + pRegion->depth, pRegion->opener,
+                   pRegion->closer);
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Clears the given profile, keeping its memory.
+ * @param pProfile The profile to clear.
+ */
+static void clearProfile(DepthProfile * const pProfile)
+{
+    if (pProfile->deeper.number != 0)
+    {
+        memset(pProfile->deeper.counts, 0, pProfile->deeper.number * sizeof(unsigned long long));
+    }
+    pProfile->deeper.number = 0;
+    pProfile->regionsNumber = 0;
+    pProfile->applied = 0;
+    pProfile->opened = 0;
+    pProfile->closesFirst = 0;
+}
+
+/**
+ * @brief Releases the memory of the given profile.
+ * @param pProfile The profile to release.
+ */
+static void releaseProfile(DepthProfile * const pProfile)
+{
+    free(pProfile->deeper.counts);
+    free(pProfile->shallower.counts);
+}
+
+
+/*----=  Pair Index  =-----*/
+
+
+/**
+ * @brief Grows the given array to hold at least the given number of elements, doubling its
+ *        capacity.
+ * @param pArray The path of the array.
+ * @param pCapacity The path of the number of elements allocated.
+ * @param number The number of elements needed.
+ * @param elementSize The number of bytes of an element.
+ * @return 0 if the array holds the elements, 2 if there is not enough memory.
+ */
+static int growArray(void ** const pArray, size_t * const pCapacity, size_t const number,
+                     size_t const elementSize)
+{
+    if (number <= *pCapacity)
+    {
+        return VALIDATOR_VALID;
+    }
+
+    size_t capacity = *pCapacity ? *pCapacity : INITIAL_STACK_CAPACITY;
+    while (capacity < number)
+    {
+        capacity *= 2;
+    }
+    void * const array = realloc(*pArray, capacity * elementSize);
+    if (array == NULL)
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+    *pArray = array;
+    *pCapacity = capacity;
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Adds an open pair to the given index, inside its innermost open pair.
+ * @param pIndex The index.
+ * @param opener The offset of the Opening-Parenthesis of the pair.
+ * @param kind The kind of the pair.
+ * @return 0 if the pair was added, 2 if there is not enough memory.
+ */
+static int openPair(PairIndex * const pIndex, unsigned long long const opener, int const kind)
+{
+    if (growArray((void **) &pIndex->entries, &pIndex->entriesCapacity,
+                  pIndex->entriesNumber + 1, sizeof(IndexEntry)))
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    IndexEntry * const pEntry = &pIndex->entries[pIndex->entriesNumber];
+    pEntry->opener = opener;
+    pEntry->closer = pIndex->innermost;
+    pEntry->kind = kind;
+    pIndex->innermost = pIndex->entriesNumber++;
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Closes the innermost open pair of the given index. The index of a stream encodes its
+ *        pairs once none is open.
+ * @param pIndex The index, which has an open pair.
+ * @param closer The offset of the Closing-Parenthesis of the pair.
+ * @return 0 if the pair was closed, 2 if there is not enough memory.
+ */
+static int closePair(PairIndex * const pIndex, unsigned long long const closer)
+{
+    IndexEntry * const pEntry = &pIndex->entries[pIndex->innermost];
+    pIndex->innermost = (size_t) pEntry->closer;
+    pEntry->closer = closer;
+
+    // Only the outermost pair closing completes all the entries, which are then in the order
+    // they are encoded in. A chunk cannot tell if its outermost pairs are enclosed by others.
+    if (pIndex->encodes && pIndex->innermost == NO_ENTRY)
+    {
+        return encodePairs(pIndex);
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Encodes all the entries of the given index, none of which is open.
+ * @param pIndex The index.
+ * @return 0 if the entries were encoded, 2 if there is not enough memory.
+ */
+static int encodePairs(PairIndex * const pIndex)
+{
+    size_t const blocksNumber = (size_t) ((pIndex->pairsNumber + pIndex->entriesNumber +
+                                           VALIDATOR_INDEX_BLOCK_PAIRS - 1) /
+                                          VALIDATOR_INDEX_BLOCK_PAIRS);
+    if (growArray((void **) &pIndex->bytes, &pIndex->bytesCapacity,
+                  pIndex->bytesLength + pIndex->entriesNumber * 2 * MAX_VARINT_LENGTH, 1) ||
+        growArray((void **) &pIndex->blocks, &pIndex->blocksCapacity, blocksNumber,
+                  sizeof(uint64_t)))
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    for (size_t i = 0; i < pIndex->entriesNumber; ++i)
+    {
+        IndexEntry const * const pEntry = &pIndex->entries[i];
+        if (pIndex->pairsNumber % VALIDATOR_INDEX_BLOCK_PAIRS == 0)
+        {
+            pIndex->blocks[pIndex->pairsNumber / VALIDATOR_INDEX_BLOCK_PAIRS] =
+                pIndex->bytesLength;
+            pIndex->lastOpener = 0;
+        }
+        unsigned char * const bytes = pIndex->bytes + pIndex->bytesLength;
+        size_t length = writeVarint(bytes, pEntry->opener - pIndex->lastOpener);
+        length += writeVarint(bytes + length, (pEntry->closer - pEntry->opener) *
+                                              VALIDATOR_MAX_PAIRS + (unsigned) pEntry->kind);
+        pIndex->bytesLength += length;
+        pIndex->lastOpener = pEntry->opener;
+        pIndex->pairsNumber++;
+    }
+    pIndex->entriesNumber = 0;
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Writes the given number as an unsigned LEB128 varint.
+ * @param bytes The address to write to, with room for MAX_VARINT_LENGTH bytes.
+ * @param value The number.
+ * @return The number of bytes written.
+ */
+static size_t writeVarint(unsigned char * const bytes, unsigned long long value)
+{
+    size_t length = 0;
+    while (value >= VARINT_CONTINUATION)
+    {
+        bytes[length++] = (unsigned char) (value | VARINT_CONTINUATION);
+        value >>= VARINT_BITS;
+    }
+    bytes[length++] = (unsigned char) value;
+    return length;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 varint.
+ * @param pBytes The path of the address to read from, which is advanced past the varint.
+ * @param end The address right after the last byte which may be read.
+ * @param pValue The path to store the number in.
+ * @return 0 if the varint was read, 1 if it does not end before 'end' or exceeds 64 bits.
+ */
+static int readVarint(unsigned char const ** const pBytes, unsigned char const * const end,
+                      unsigned long long * const pValue)
+{
+    unsigned long long value = 0;
+    for (int shift = 0; *pBytes < end && shift < MAX_VARINT_LENGTH * VARINT_BITS;
+         shift += VARINT_BITS)
+    {
+        unsigned char const byte = *(*pBytes)++;
+        value |= (unsigned long long) (byte & ~VARINT_CONTINUATION) << shift;
+        if (!(byte & VARINT_CONTINUATION))
+        {
+            *pValue = value;
+            return VALIDATOR_VALID;
+        }
+    }
+    return VALIDATOR_INVALID;
+}
+
+/**
+ * @brief Merges the pairs of the next chunk of data into the given index, after the
+ *        Closing-Parenthesis at the start of the chunk closed the pairs of the previous chunks.
+ * @param pIndex The index of all the previous chunks.
+ * @param pChunk The pairs of the next chunk.
+ * @return 0 if the pairs were merged, 2 if there is not enough memory.
+ */
+static int mergeChunkIndex(PairIndex * const pIndex, PairIndex const * const pChunk)
+{
+    if (growArray((void **) &pIndex->entries, &pIndex->entriesCapacity,
+                  pIndex->entriesNumber + pChunk->entriesNumber, sizeof(IndexEntry)))
+    {
+        return VALIDATOR_LIMIT_EXCEEDED;
+    }
+
+    // The entries of the chunk follow those of the previous chunks. An outermost pair of the
+    // chunk which is still open was opened after its last unmatched Closing-Parenthesis, so it
+    // is enclosed by the innermost pair left open by the previous chunks.
+    size_t const shift = pIndex->entriesNumber;
+    if (pChunk->entriesNumber != 0)
+    {
+        memcpy(pIndex->entries + shift, pChunk->entries,
+               pChunk->entriesNumber * sizeof(IndexEntry));
+    }
+    size_t entry = pChunk->innermost;
+    while (entry != NO_ENTRY)
+    {
+        size_t const enclosing = (size_t) pChunk->entries[entry].closer;
+        pIndex->entries[shift + entry].closer = (enclosing == NO_ENTRY) ? pIndex->innermost :
+                                                                          shift + enclosing;
+        entry = enclosing;
+    }
+    pIndex->entriesNumber += pChunk->entriesNumber;
+    if (pChunk->innermost != NO_ENTRY)
+    {
+        pIndex->innermost = shift + pChunk->innermost;
+    }
+
+    if (pIndex->innermost == NO_ENTRY)
+    {
+        return encodePairs(pIndex);
+    }
+    return VALIDATOR_VALID;
+}
+
+/**
+ * @brief Clears the given index, keeping its memory.
+ * @param pIndex The index to clear.
+ */
+static void clearIndex(PairIndex * const pIndex)
+{
+    pIndex->entriesNumber = 0;
+    pIndex->innermost = NO_ENTRY;
+    pIndex->bytesLength = 0;
+    pIndex->pairsNumber = 0;
+    pIndex->lastOpener = 0;
+}
+
+/**
+ * @brief Releases the memory of the given index.
+ * @param pIndex The index to release.
+ */
+static void releaseIndex(PairIndex * const pIndex)
+{
+    free(pIndex->entries);
+    free(pIndex->bytes);
+    free(pIndex->blocks);
+}
+
+
+#ifdef VALIDATOR_STATISTICS
+
+/**
+ * @brief Raises the maximal depth of the given Stack to its current depth, which does not count
+ *        the Parenthesis closed by its unmatched Closing-Parenthesis.
+ * @param pStack The Stack to count.
+ */
+static void countDepth(ParenthesisStack * const pStack)
+{
+    // A chunk collects unmatched Closing-Parenthesis only while it has no opened Parenthesis,
+    // so each of them lowered the depth below the start of the chunk before the current ones.
+    size_t const closed = (pStack->pUnmatched != NULL) ? pStack->pUnmatched->size : 0;
+    if (pStack->size > closed && pStack->size - closed > pStack->deepest)
+    {
+        pStack->deepest = pStack->size - closed;
+    }
+}
+
+#endif
@@ -0,0 +1,500 @@
+/**
+ * @file ParenthesisValidator.h
+ * @author Itai Tagar <itagar>
+ * @version 1.2
+ * @date 09 Aug 2016
+ *
+ * @brief A library that verify data satisfies a desired parenthesis structure.
+ *
+ * @section LICENSE
+ * This program is free to use in every operation system.
+ *
+ * @section DESCRIPTION
+ * A library that verify data satisfies a desired parenthesis structure.
+ * A Validator holds the state of a single stream of data, the data is fed to it in parts of any
+ * size and the verdict is given once the stream ends. The Validator does not buffer the data,
+ * and any number of Validators may be used at the same time.
+ * The Parenthesis pairs are configurable. A pair may consist of UTF-8 characters of a few bytes,
+ * and a pair whose two Parenthesis are the same character, such as quotes, closes when it is
+ * the innermost opened pair and opens otherwise.
+ * Optionally, the Parenthesis inside string and character literals and inside comments are
+ * skipped, which suits source code and JSON-like text.
+ * When the stream breaks the structure, the Validator reports the first violation, its offset in
+ * the stream and, if requested, the position of the Opening-Parenthesis involved and the line and
+ * column of both.
+ * If the library is built with VALIDATOR_STATISTICS defined, a Validator also counts the bytes it
+ * scanned, the Parenthesis it applied and the maximal nesting depth, otherwise the counters are
+ * not compiled at all.
+ * Optionally, a Validator keeps the depth profile of its stream: the maximal nesting depth, the
+ * number of Opening-Parenthesis reaching every range of depths, and the deepest regions, which
+ * are the pairs that enclose no other Parenthesis, so they are the peaks of the depth. The depth
+ * is the size of the Stack the Validator keeps anyway, and the chunks scanned in parallel keep
+ * their profiles relative to their start, which are shifted by the depth they start at when
+ * they are merged, so the profile costs no additional pass over the data.
+ * Optionally, a Validator builds the index of the pairs of its stream, the offsets of the two
+ * Parenthesis and the kind of every pair, in the order of their Opening-Parenthesis. A pair is
+ * recorded when its Opening-Parenthesis is pushed to the Stack and completed when it is popped,
+ * and the pairs are encoded once no pair is left open, so the index is built in the same pass
+ * and holds only the pairs of the outermost open pair. The encoded index is laid out as a file,
+ * which may be written and mapped as it is, see ValidatorIndexHeader.
+ * Usage:       ParenthesisValidator * pValidator = validatorCreate(&options);
+ *              while (<more data>)
+ *              {
+ *                  validatorFeed(pValidator, data, length);
+ *              }
+ *              int result = validatorFinish(pValidator);
+ *              validatorDestroy(pValidator);
+ */
+
+#ifndef PARENTHESIS_VALIDATOR_H
+#define PARENTHESIS_VALIDATOR_H
+
+
+/*----=  Includes  =-----*/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*----=  Definitions  =-----*/
+
+
+/**
+ * @def VALIDATOR_VALID 0
+ * @brief A Flag for data which satisfies the required parenthesis structure.
+ */
+#define VALIDATOR_VALID 0
+
+/**
+ * @def VALIDATOR_INVALID 1
+ * @brief A Flag for data which does not satisfy the required parenthesis structure.
+ */
+#define VALIDATOR_INVALID 1
+
+/**
+ * @def VALIDATOR_LIMIT_EXCEEDED 2
+ * @brief A Flag for data which could not be analyzed due to the nesting depth limit or due to
+ *        lack of memory.
+ */
+#define VALIDATOR_LIMIT_EXCEEDED 2
+
+/**
+ * @def VALIDATOR_UNLIMITED_DEPTH 0
+ * @brief A Macro that sets the nesting depth limit value which means there is no limit.
+ */
+#define VALIDATOR_UNLIMITED_DEPTH 0
+
+/**
+ * @def VALIDATOR_DEFAULT_PAIRS "()[]<>{}"
+ * @brief A Macro that sets the Parenthesis pairs used if none are given.
+ */
+#define VALIDATOR_DEFAULT_PAIRS "()[]<>{}"
+
+/**
+ * @def VALIDATOR_MAX_PAIRS 16
+ * @brief A Macro that sets the maximal number of Parenthesis pairs.
+ */
+#define VALIDATOR_MAX_PAIRS 16
+
+/**
+ * @def VALIDATOR_MAX_PARENTHESIS_LENGTH 4
+ * @brief A Macro that sets the maximal number of bytes of a single Parenthesis, which is the
+ *        length of the longest UTF-8 character.
+ */
+#define VALIDATOR_MAX_PARENTHESIS_LENGTH 4
+
+/**
+ * @def VALIDATOR_MAX_COMMENT_LENGTH 4
+ * @brief A Macro that sets the maximal number of bytes of the prefix of line comments.
+ */
+#define VALIDATOR_MAX_COMMENT_LENGTH 4
+
+/**
+ * @def VALIDATOR_NO_ERROR 0
+ * @brief A Flag for a stream which does not break the required parenthesis structure.
+ */
+#define VALIDATOR_NO_ERROR 0
+
+/**
+ * @def VALIDATOR_MISMATCHED_PAIR 1
+ * @brief A Flag for a Closing-Parenthesis which does not match the last Opening-Parenthesis.
+ */
+#define VALIDATOR_MISMATCHED_PAIR 1
+
+/**
+ * @def VALIDATOR_STRAY_CLOSER 2
+ * @brief A Flag for a Closing-Parenthesis which has no Opening-Parenthesis to close.
+ */
+#define VALIDATOR_STRAY_CLOSER 2
+
+/**
+ * @def VALIDATOR_UNCLOSED_OPENER 3
+ * @brief A Flag for an Opening-Parenthesis which is left open at the end of the stream.
+ */
+#define VALIDATOR_UNCLOSED_OPENER 3
+
+/**
+ * @def VALIDATOR_UNKNOWN_LINE 0
+ * @brief A Macro that sets the line and column of a position which were not computed.
+ */
+#define VALIDATOR_UNKNOWN_LINE 0
+
+/**
+ * @def VALIDATOR_SCALAR_SCANNER "scalar"
+ * @brief A Macro that sets the name of the byte by byte scanner.
+ */
+#define VALIDATOR_SCALAR_SCANNER "scalar"
+
+/**
+ * @def VALIDATOR_SSE2_SCANNER "sse2"
+ * @brief A Macro that sets the name of the 16 bytes vector scanner.
+ */
+#define VALIDATOR_SSE2_SCANNER "sse2"
+
+/**
+ * @def VALIDATOR_AVX2_SCANNER "avx2"
+ * @brief A Macro that sets the name of the 32 bytes vector scanner.
+ */
+#define VALIDATOR_AVX2_SCANNER "avx2"
+
+/**
+ * @def VALIDATOR_PROFILE_BUCKETS 64
+ * @brief A Macro that sets the number of ranges of depths in the histogram of a profile, each
+ *        range is twice as wide as the previous one, so they cover every depth.
+ */
+#define VALIDATOR_PROFILE_BUCKETS 64
+
+/**
+ * @def VALIDATOR_MAX_REGIONS 64
+ * @brief A Macro that sets the maximal number of deepest regions kept in a profile.
+ */
+#define VALIDATOR_MAX_REGIONS 64
+
+/**
+ * @def VALIDATOR_INDEX_MAGIC "CPI1"
+ * @brief A Macro that sets the bytes which start an index of pairs.
+ */
+#define VALIDATOR_INDEX_MAGIC "CPI1"
+
+/**
+ * @def VALIDATOR_INDEX_MAGIC_LENGTH 4
+ * @brief A Macro that sets the number of bytes of VALIDATOR_INDEX_MAGIC.
+ */
+#define VALIDATOR_INDEX_MAGIC_LENGTH 4
+
+/**
+ * @def VALIDATOR_INDEX_BLOCK_PAIRS 64
+ * @brief A Macro that sets the number of pairs in a block of an index, every block is found
+ *        through the table of the index, so a pair is decoded after at most this many others.
+ */
+#define VALIDATOR_INDEX_BLOCK_PAIRS 64
+
+
+/*----=  Type Definitions  =-----*/
+
+
+/**
+ * @brief The state of the validation of a single stream of data.
+ */
+typedef struct ParenthesisValidator ParenthesisValidator;
+
+/**
+ * @brief The options of a Validator.
+ */
+typedef struct ValidatorOptions
+{
+    /** The maximal nesting depth allowed in the data, or VALIDATOR_UNLIMITED_DEPTH. */
+    size_t maxDepth;
+    /** The name of the scanner locating the Parenthesis, or NULL for the widest scanner the CPU
+     *  supports. */
+    char const * scanner;
+    /** The number of threads scanning large parts of data, 0 and 1 both mean this thread. */
+    size_t threads;
+    /** Non zero for keeping the offset of every opened Parenthesis, so a violation reports the
+     *  Opening-Parenthesis involved. */
+    int trackOpeners;
+    /** Non zero for counting the lines of every fed part, so the positions in a violation have
+     *  a line and a column. Not needed if the whole stream is still available when the
+     *  violation is reported, see 'validatorLocate'. */
+    int countLines;
+    /** The Parenthesis pairs as a UTF-8 string, each Opening-Parenthesis is followed by its
+     *  Closing-Parenthesis, or NULL for VALIDATOR_DEFAULT_PAIRS. */
+    char const * pairs;
+    /** Non zero for skipping the Parenthesis inside literals and comments: strings in double
+     *  quotes and characters in single quotes, both with backslash escapes and both ending at
+     *  the end of the line, C-style block comments and line comments. */
+    int lexical;
+    /** The prefix of line comments when skipping literals and comments, e.g. "//" or "#", or
+     *  NULL for none. */
+    char const * lineComment;
+    /** Non zero for keeping the depth profile of the stream, see 'validatorProfile'. */
+    int profile;
+    /** The number of deepest regions kept in the profile, at most VALIDATOR_MAX_REGIONS. */
+    size_t regions;
+    /** Non zero for building the index of the pairs of the stream, see 'validatorIndex'. */
+    int index;
+} ValidatorOptions;
+
+/**
+ * @brief A position in a stream of data.
+ */
+typedef struct ValidatorPosition
+{
+    /** The number of bytes in the stream before the position. */
+    unsigned long long offset;
+    /** The line of the position starting from 1, or VALIDATOR_UNKNOWN_LINE. */
+    unsigned long long line;
+    /** The column of the position starting from 1, or VALIDATOR_UNKNOWN_LINE. */
+    unsigned long long column;
+} ValidatorPosition;
+
+/**
+ * @brief The first violation of the required parenthesis structure in a stream.
+ */
+typedef struct ValidatorError
+{
+    /** The kind of the violation, VALIDATOR_NO_ERROR if there is none. */
+    int kind;
+    /** The position of the breaking Closing-Parenthesis, or the end of the stream for an
+     *  unclosed Opening-Parenthesis. */
+    ValidatorPosition position;
+    /** The breaking Closing-Parenthesis, or an empty string for an unclosed
+     *  Opening-Parenthesis. */
+    char found[VALIDATOR_MAX_PARENTHESIS_LENGTH + 1];
+    /** The Closing-Parenthesis which was expected instead, or an empty string for a stray one. */
+    char expected[VALIDATOR_MAX_PARENTHESIS_LENGTH + 1];
+    /** Non zero if the position of the Opening-Parenthesis involved is known. */
+    int hasOpener;
+    /** The position of the Opening-Parenthesis involved. */
+    ValidatorPosition opener;
+} ValidatorError;
+
+/**
+ * @brief A pair of Parenthesis which encloses no other Parenthesis.
+ */
+typedef struct ValidatorRegion
+{
+    /** The depth of the pair, 1 for a pair which is not enclosed by another. */
+    unsigned long long depth;
+    /** The offset of the Opening-Parenthesis of the pair. */
+    unsigned long long opener;
+    /** The offset of the Closing-Parenthesis of the pair. */
+    unsigned long long closer;
+} ValidatorRegion;
+
+/**
+ * @brief The depth profile of a stream.
+ */
+typedef struct ValidatorProfile
+{
+    /** The maximal nesting depth reached. */
+    unsigned long long maxDepth;
+    /** The number of Opening-Parenthesis reaching every range of depths, entry i counts the
+     *  depths from 2^i up to 2^(i + 1) - 1. */
+    unsigned long long histogram[VALIDATOR_PROFILE_BUCKETS];
+    /** The number of deepest regions. */
+    size_t regionsNumber;
+    /** The deepest regions, the deepest first and the earliest first among regions of the same
+     *  depth. */
+    ValidatorRegion regions[VALIDATOR_MAX_REGIONS];
+} ValidatorProfile;
+
+/**
+ * @brief A pair of Parenthesis in an index.
+ */
+typedef struct ValidatorPair
+{
+    /** The offset of the Opening-Parenthesis of the pair. */
+    unsigned long long opener;
+    /** The offset of the Closing-Parenthesis of the pair. */
+    unsigned long long closer;
+    /** The kind of the pair, its index in the Parenthesis pairs. */
+    int kind;
+} ValidatorPair;
+
+/**
+ * @brief The header of an index of pairs.
+ *        The header is followed by the pairs, in the order of their Opening-Parenthesis, and
+ *        by the table of the offsets of the blocks of VALIDATOR_INDEX_BLOCK_PAIRS pairs from the
+ *        start of the index, which is aligned to 8 bytes. A pair is two unsigned LEB128 varints:
+ *        the distance of its Opening-Parenthesis from that of the previous pair of its block, or
+ *        its offset for the first pair of a block, and the distance of its Closing-Parenthesis
+ *        from its Opening-Parenthesis times VALIDATOR_MAX_PAIRS plus its kind. The numbers of
+ *        the header and the table are in the byte order of the machine.
+ */
+typedef struct ValidatorIndexHeader
+{
+    /** The bytes of VALIDATOR_INDEX_MAGIC. */
+    char magic[VALIDATOR_INDEX_MAGIC_LENGTH];
+    /** The number of pairs in a block, VALIDATOR_INDEX_BLOCK_PAIRS. */
+    uint32_t blockPairs;
+    /** The number of pairs. */
+    uint64_t pairsNumber;
+    /** The number of blocks. */
+    uint64_t blocksNumber;
+    /** The offset of the table of blocks from the start of the index. */
+    uint64_t tableOffset;
+} ValidatorIndexHeader;
+
+#ifdef VALIDATOR_STATISTICS
+
+/**
+ * @brief The counters of a Validator.
+ */
+typedef struct ValidatorStatistics
+{
+    /** The number of bytes scanned, which stops at the first violation. */
+    unsigned long long bytes;
+    /** The number of Parenthesis applied, excluding those inside skipped literals and comments. */
+    unsigned long long parenthesis;
+    /** The maximal nesting depth reached. */
+    unsigned long long maxDepth;
+} ValidatorStatistics;
+
+#endif
+
+
+/*----=  Validator  =-----*/
+
+
+/**
+ * @brief Checks if the scanner with the given name is known and supported by the CPU.
+ * @param name The name of the scanner, or NULL for the widest scanner the CPU supports.
+ * @return 1 if the scanner is supported, 0 otherwise.
+ */
+int validatorScannerSupported(char const * const name);
+
+/**
+ * @brief Checks if the given Parenthesis pairs form a valid alphabet: an even number of UTF-8
+ *        characters, at most VALIDATOR_MAX_PAIRS pairs, where no two different characters end
+ *        with the same byte.
+ * @param pairs The Parenthesis pairs, or NULL for VALIDATOR_DEFAULT_PAIRS.
+ * @return 1 if the pairs are valid, 0 otherwise.
+ */
+int validatorPairsSupported(char const * const pairs);
+
+/**
+ * @brief Checks if literals and comments may be skipped with the given Parenthesis pairs and
+ *        prefix of line comments: the pairs must be valid, the prefix must be at most
+ *        VALIDATOR_MAX_COMMENT_LENGTH bytes, and no Parenthesis may end with a quote, a
+ *        backslash, a byte of a comment delimiter or a new line.
+ * @param pairs The Parenthesis pairs, or NULL for VALIDATOR_DEFAULT_PAIRS.
+ * @param lineComment The prefix of line comments, or NULL for none.
+ * @return 1 if the lexical options are valid, 0 otherwise.
+ */
+int validatorLexerSupported(char const * const pairs, char const * const lineComment);
+
+/**
+ * @brief Creates a Validator for a new stream of data.
+ * @param pOptions The options of the Validator.
+ * @return The new Validator, or NULL if its scanner, its pairs or its lexical options are not
+ *         supported or there is not enough memory.
+ */
+ParenthesisValidator * validatorCreate(ValidatorOptions const * const pOptions);
+
+/**
+ * @brief Feeds the next part of the stream to the given Validator.
+ *        Once the stream breaks the required parenthesis structure the rest of it is ignored.
+ * @param pValidator The Validator of the stream.
+ * @param data The next part of the stream.
+ * @param length The number of bytes in the data.
+ * @return 0 if the stream does not break the required parenthesis structure so far, 1 if it
+ *         does and 2 if the stream exceeds the nesting depth limit or the memory.
+ */
+int validatorFeed(ParenthesisValidator * const pValidator, void const * const data,
+                  size_t const length);
+
+/**
+ * @brief Gives the verdict of the given Validator, assuming its stream has ended.
+ * @param pValidator The Validator of the stream.
+ * @return 0 if the stream satisfies the required parenthesis structure, 1 if it does not and
+ *         2 if the stream exceeds the nesting depth limit or the memory.
+ */
+int validatorFinish(ParenthesisValidator const * const pValidator);
+
+/**
+ * @brief Reports the first violation of the required parenthesis structure in the stream of the
+ *        given Validator, assuming its stream has ended.
+ * @param pValidator The Validator of the stream.
+ * @param pError The address to store the violation in.
+ * @return The kind of the violation, VALIDATOR_NO_ERROR if there is none.
+ */
+int validatorError(ParenthesisValidator const * const pValidator, ValidatorError * const pError);
+
+/**
+ * @brief Computes the line and the column of the given position, by counting the lines of the
+ *        given stream up to the position's offset.
+ * @param data The whole stream of data the position refers to.
+ * @param length The number of bytes in the stream.
+ * @param pPosition The position to compute, its offset must be set.
+ */
+void validatorLocate(void const * const data, size_t const length,
+                     ValidatorPosition * const pPosition);
+
+/**
+ * @brief Reads the depth profile of the given Validator, which keeps one. The profile is
+ *        complete only for a stream which satisfies the required parenthesis structure.
+ * @param pValidator The Validator of the stream.
+ * @param pProfile The address to store the profile in.
+ * @return 0 if the profile was stored, 1 if the Validator does not keep one.
+ */
+int validatorProfile(ParenthesisValidator const * const pValidator,
+                     ValidatorProfile * const pProfile);
+
+/**
+ * @brief Returns the number of bytes of the index of the pairs of the given Validator.
+ * @param pValidator The Validator of the stream.
+ * @return The number of bytes, or 0 if the Validator does not build an index.
+ */
+size_t validatorIndexSize(ParenthesisValidator const * const pValidator);
+
+/**
+ * @brief Stores the index of the pairs of the given Validator, which builds one. The index is
+ *        complete only for a stream which satisfies the required parenthesis structure.
+ * @param pValidator The Validator of the stream.
+ * @param index The address to store the index in, of 'validatorIndexSize' bytes aligned to 8.
+ * @return 0 if the index was stored, 1 if the Validator does not build one.
+ */
+int validatorIndex(ParenthesisValidator const * const pValidator, void * const index);
+
+/**
+ * @brief Finds a pair in the given index by its ordinal, which is the number of
+ *        Opening-Parenthesis before the pair's own, so a parser counting the Opening-Parenthesis
+ *        it meets finds the end of every scope without scanning for it.
+ *        Only the block of the pair is decoded, the index is checked as far as it is read.
+ * @param index The index, as stored by 'validatorIndex', aligned to 8 bytes.
+ * @param length The number of bytes in the index.
+ * @param ordinal The ordinal of the pair.
+ * @param pPair The address to store the pair in.
+ * @return 0 if the pair was found, 1 if the index holds no such pair or is not valid.
+ */
+int validatorIndexPair(void const * const index, size_t const length,
+                       unsigned long long const ordinal, ValidatorPair * const pPair);
+
+#ifdef VALIDATOR_STATISTICS
+
+/**
+ * @brief Reads the counters of the given Validator.
+ * @param pValidator The Validator of the stream.
+ * @param pStatistics The address to store the counters in.
+ */
+void validatorStatistics(ParenthesisValidator const * const pValidator,
+                         ValidatorStatistics * const pStatistics);
+
+#endif
+
+/**
+ * @brief Resets the given Validator, so it can be used for a new stream of data.
+ * @param pValidator The Validator to reset.
+ */
+void validatorReset(ParenthesisValidator * const pValidator);
+
+/**
+ * @brief Releases the given Validator.
+ * @param pValidator The Validator to release, may be NULL.
+ */
+void validatorDestroy(ParenthesisValidator * const pValidator);
+
+
+#endif